@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 // Forward declarations for FreeType
 typedef struct FT_FaceRec_* FT_Face;
@@ -84,6 +85,37 @@ public:
     Result<Font*> getFont(const unsigned char* data, size_t dataLen,
                           const std::string& fontName, float fontSize = 32.0f) noexcept;
 
+    /**
+     * @brief Get an incrementally built font from raw font data (embedded PDF fonts).
+     * The atlas starts empty and only grows by the glyphs passed to addGlyphs(),
+     * so it is shared append-only by every document using the font. A previously
+     * persisted atlas for the same font data is reloaded from the disk cache.
+     * Embedded subsets often share a name, so the font is registered as
+     * "fontName#<data hash>"; that is the RichText family name to use.
+     * @param fontName Font name from the document
+     * @param family Receives the registered family name
+     */
+    Result<Font*> getIncrementalFont(const unsigned char* data, size_t dataLen,
+                                     const std::string& fontName, float fontSize = 32.0f,
+                                     std::string* family = nullptr) noexcept;
+
+    /**
+     * @brief Family name getIncrementalFont() registers the font data under.
+     * Lets a document key its fonts before the atlas exists (on a worker).
+     */
+    static std::string incrementalFamily(const unsigned char* data, size_t dataLen,
+                                         const std::string& fontName) noexcept;
+
+    /**
+     * @brief Rasterize the missing glyphs of an incremental font and upload them.
+     */
+    Result<void> addGlyphs(Font* font, const std::vector<uint32_t>& codepoints) noexcept;
+
+    /**
+     * @brief Save incremental fonts that gained glyphs to the disk cache.
+     */
+    void persistIncrementalFonts() noexcept;
+
     /**
      * @brief Load a font from a prebuilt atlas (for Android/Web).
      * @param atlasPath Path to the atlas image file (.png or .lz4)
@@ -155,6 +187,13 @@ private:
 
     WebGPUContext::Ptr _ctx;
     std::unordered_map<FontCacheKey, std::unique_ptr<Font>, FontCacheKeyHash> fontCache_;
+
+    // Incremental fonts: disk cache path and glyph count when last saved
+    struct IncrementalFont {
+        std::string cachePath;
+        size_t savedGlyphs = 0;
+    };
+    std::unordered_map<Font*, IncrementalFont> incrementalFonts_;
     FontCacheKey defaultFontKey_;
     bool hasDefaultFont_ = false;
     std::string cacheDir_;
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vector>
 #include <set>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 // Forward declaration for FreeType
@@ -64,6 +65,19 @@ public:
     bool generate(const unsigned char* data, size_t dataLen,
                   const std::string& fontName, float fontSize, uint32_t atlasSize = 4096);
 
+    // Incremental atlas for embedded (e.g. PDF) fonts: starts empty, glyphs
+    // are rasterized on demand with addGlyphs(). Keeps its own copy of the
+    // font data. If an atlas was already loaded (loadAtlas from the disk
+    // cache) its glyphs are kept and new ones are packed after them.
+    bool initIncremental(const unsigned char* data, size_t dataLen,
+                         const std::string& fontName, float fontSize, uint32_t atlasSize = 2048);
+    bool isIncremental() const { return _incremental; }
+
+    // Rasterize the codepoints that are not in the atlas yet, MSDF generation
+    // runs in parallel. Returns the number of glyphs added; upload them with
+    // uploadPendingGlyphs().
+    size_t addGlyphs(const std::vector<uint32_t>& codepoints);
+
     // Save atlas to PNG and metrics to JSON
     bool saveAtlas(const std::string& atlasPath, const std::string& metricsPath) const;
 #endif
@@ -74,8 +88,9 @@ public:
     // Create WebGPU texture from atlas
     bool createTexture(WGPUDevice device, WGPUQueue queue);
 
-    // Create glyph metadata SSBO buffer
-    bool createGlyphMetadataBuffer(WGPUDevice device);
+    // Create glyph metadata SSBO buffer, with room for at least `capacity`
+    // glyphs so appended glyphs can be written in place
+    bool createGlyphMetadataBuffer(WGPUDevice device, uint32_t capacity = 0);
 
     // Font style flags
     enum Style : uint8_t {
@@ -115,7 +130,7 @@ public:
     WGPUBuffer getGlyphMetadataBuffer() const { return _glyphMetadataBuffer; }
     uint32_t getGlyphCount() const { return static_cast<uint32_t>(_glyphMetadata.size()); }
     
-    // Get the glyph count that the GPU buffer was created with
+    // Get the glyph slots of the GPU buffer (>= uploaded glyphs)
     // Use this for bind group size to avoid buffer overflow
     uint32_t getBufferGlyphCount() const { return _bufferGlyphCount; }
     
@@ -156,6 +171,16 @@ private:
     // Pending glyphs that need to be uploaded to GPU
     std::set<uint32_t> _pendingGlyphs;
 
+    // Atlas rows written since the last upload, [min, max)
+    uint32_t _dirtyMinY = UINT32_MAX;
+    uint32_t _dirtyMaxY = 0;
+    void markDirtyRows(int y, int h);
+
+    // Incremental mode (embedded fonts): the face is loaded from _fontData
+    bool _incremental = false;
+    std::vector<unsigned char> _fontData;
+    double _unitsPerEm = 1000.0;
+
     // Track failed codepoints to avoid repeated lookups
     std::set<uint32_t> _failedCodepoints;
 
@@ -201,8 +226,9 @@ private:
     float _lineHeight = 0.0f;
     float _pixelRange = 4.0f;  // MSDF pixel range (higher = better AA quality)
     
-    // Track the glyph count the buffer was created with
+    // Glyph slots in the metadata buffer, and how many hold uploaded metadata
     uint32_t _bufferGlyphCount = 0;
+    uint32_t _uploadedGlyphCount = 0;
     // Version incremented when GPU resources change
     uint32_t _resourceVersion = 0;
 
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// GlyphLineIndex - glyph instances bucketed by text line, for culling
+//
+// Instances are added in ascending line order (their baseline, or any
+// per-line y), each with its vertical extent. Lines keep contiguous
+// instance ranges, so the lines that can intersect a viewport map to one
+// range [first, last) that can be drawn with a single instanced draw.
+//
+// The extent used for the test is the largest one seen above and below any
+// baseline, so a tall glyph widens the margin for every line but is never
+// culled while visible.
+//-----------------------------------------------------------------------------
+class GlyphLineIndex {
+public:
+    struct Line {
+        float baseline;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    void clear() {
+        _lines.clear();
+        _count = 0;
+        _above = 0.0f;
+        _below = 0.0f;
+    }
+
+    // Next instance; `baseline` must not decrease between calls
+    void add(float baseline, float top, float bottom) {
+        if (_lines.empty() || _lines.back().baseline != baseline) {
+            _lines.push_back({baseline, _count, 0});
+        }
+        _lines.back().count++;
+        _count++;
+        _above = std::max(_above, baseline - top);
+        _below = std::max(_below, bottom - baseline);
+    }
+
+    // Instances on lines that can intersect [top, bottom); empty as {n, n}
+    std::pair<uint32_t, uint32_t> visible(float top, float bottom) const {
+        // A line spans [baseline - _above, baseline + _below]
+        auto byBaseline = [](float y, const Line& l) { return y < l.baseline; };
+        auto lo = std::upper_bound(_lines.begin(), _lines.end(), top - _below, byBaseline);
+        auto hi = std::lower_bound(_lines.begin(), _lines.end(), bottom + _above,
+                                   [](const Line& l, float y) { return l.baseline < y; });
+        if (lo >= hi) {
+            return {_count, _count};
+        }
+        uint32_t last = hi == _lines.end() ? _count : hi->first;
+        return {lo->first, last};
+    }
+
+    size_t lineCount() const { return _lines.size(); }
+    uint32_t instanceCount() const { return _count; }
+    const std::vector<Line>& lines() const { return _lines; }
+
+private:
+    std::vector<Line> _lines;
+    uint32_t _count = 0;
+    float _above = 0.0f;  // Largest extent above a baseline
+    float _below = 0.0f;  // Largest extent below a baseline
+};
+
+} // namespace yetty
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// LruCache - least-recently-used map bounded by a total cost budget
+//
+// Each entry carries a caller supplied cost (usually its size in bytes).
+// Inserting past the budget evicts the least recently used entries; the
+// entry just inserted is never evicted, so a single oversized value still
+// fits. An optional callback sees evicted entries (to release GPU handles
+// and the like), and an optional predicate pins entries that must stay
+// (still in use elsewhere); pinned entries count towards the budget but
+// are skipped by eviction.
+//
+// Not thread-safe - guard with a mutex when shared between threads.
+//-----------------------------------------------------------------------------
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+public:
+    using EvictFn = std::function<void(const K&, V&)>;
+    using PinFn = std::function<bool(const K&, const V&)>;
+
+    explicit LruCache(size_t budget, EvictFn onEvict = nullptr)
+        : _budget(budget), _onEvict(std::move(onEvict)) {}
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // Lookup, marks the entry as most recently used. nullptr on miss.
+    V* get(const K& key) {
+        auto it = _map.find(key);
+        if (it == _map.end()) {
+            return nullptr;
+        }
+        _order.splice(_order.begin(), _order, it->second);
+        return &it->second->value;
+    }
+
+    // Lookup without touching the LRU order
+    const V* peek(const K& key) const {
+        auto it = _map.find(key);
+        return it == _map.end() ? nullptr : &it->second->value;
+    }
+
+    bool contains(const K& key) const { return _map.count(key) != 0; }
+
+    // Insert or replace, then evict down to the budget
+    V& put(const K& key, V value, size_t cost) {
+        if (auto it = _map.find(key); it != _map.end()) {
+            _cost -= it->second->cost;
+            _order.erase(it->second);
+            _map.erase(it);
+        }
+        _order.push_front(Entry{key, std::move(value), cost});
+        _map.emplace(key, _order.begin());
+        _cost += cost;
+        trim();
+        return _order.front().value;
+    }
+
+    bool erase(const K& key) {
+        auto it = _map.find(key);
+        if (it == _map.end()) {
+            return false;
+        }
+        _cost -= it->second->cost;
+        _order.erase(it->second);
+        _map.erase(it);
+        return true;
+    }
+
+    void clear() {
+        _order.clear();
+        _map.clear();
+        _cost = 0;
+    }
+
+    void setBudget(size_t budget) {
+        _budget = budget;
+        trim();
+    }
+
+    void setPinned(PinFn pinned) { _pinned = std::move(pinned); }
+
+    // Evict from the cold end down to the budget, skipping pinned entries
+    // and always keeping the most recent one. Called on every put(); call
+    // it directly when entries stop being pinned.
+    void trim() {
+        if (_order.empty()) {
+            return;
+        }
+        auto it = std::prev(_order.end());
+        while (_cost > _budget && it != _order.begin()) {
+            auto victim = it--;
+            if (_pinned && _pinned(victim->key, victim->value)) {
+                continue;
+            }
+            if (_onEvict) {
+                _onEvict(victim->key, victim->value);
+            }
+            _cost -= victim->cost;
+            _map.erase(victim->key);
+            _order.erase(victim);
+        }
+    }
+
+    size_t budget() const { return _budget; }
+    size_t cost() const { return _cost; }
+    size_t size() const { return _map.size(); }
+    bool empty() const { return _map.empty(); }
+
+private:
+    struct Entry {
+        K key;
+        V value;
+        size_t cost;
+    };
+
+    size_t _budget;
+    size_t _cost = 0;
+    EvictFn _onEvict;
+    PinFn _pinned;
+    std::list<Entry> _order;  // Front = most recently used
+    std::unordered_map<K, typename std::list<Entry>::iterator, Hash> _map;
+};
+
+} // namespace yetty
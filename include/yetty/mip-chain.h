@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// CPU mip chain generation for RGBA8 images
+//
+// Downsampling is an area-weighted box filter over premultiplied alpha, so
+// arbitrary ratios average every covered source pixel and transparent
+// edges do not bleed dark fringes. Runs off the render thread.
+//-----------------------------------------------------------------------------
+
+struct MipLevel {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;  // RGBA8, tightly packed rows
+};
+
+// Box filter `src` (RGBA8, width x height) to exactly dstWidth x dstHeight.
+// Only shrinks; a target larger than the source on an axis keeps that axis.
+MipLevel downsampleRGBA8(const uint8_t* src, uint32_t width, uint32_t height,
+                         uint32_t dstWidth, uint32_t dstHeight);
+
+// Base level no larger than maxWidth x maxHeight (per axis, aspect is not
+// preserved since widgets stretch to their cell area), followed by halved
+// levels down to 1x1.
+std::vector<MipLevel> buildMipChainRGBA8(const uint8_t* src, uint32_t width, uint32_t height,
+                                         uint32_t maxWidth, uint32_t maxHeight);
+
+} // namespace yetty
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <yetty/result.hpp>
+#include <yetty/shm-payload.h>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -22,7 +23,8 @@ enum class OscCommandType {
     Kill,       // kill --id <id> | --plugin <name>
     Stop,       // stop --id <id> | --plugin <name>
     Start,      // start --id <id> | --plugin <name>
-    Update,     // update --id <id>
+    Update,     // update --id <id> [--shm <token> --shm-size <n> --shm-crc <hex>]
+    Append,     // append --id <id> [--shm ...] - incremental data, no re-init
     Unknown
 };
 
@@ -33,6 +35,7 @@ struct CreateArgs {
     int32_t height = 0;     // 0 = stretch to edge
     std::string plugin;
     bool relative = false;  // Position relative to cursor
+    ShmPayloadRef shm;      // Out-of-band payload (--shm/--memfd)
 };
 
 struct ListArgs {
@@ -42,6 +45,7 @@ struct ListArgs {
 struct TargetArgs {
     std::string id;         // Target specific layer by ID
     std::string plugin;     // Target all layers of a plugin type
+    ShmPayloadRef shm;      // Out-of-band payload for update (--shm/--memfd)
 };
 
 struct OscCommand {
@@ -50,7 +54,7 @@ struct OscCommand {
     // Command-specific args (use appropriate one based on type)
     CreateArgs create;
     ListArgs list;
-    TargetArgs target;      // For kill, stop, start, update
+    TargetArgs target;      // For kill, stop, start, update, append
 
     // Plugin-specific args (raw string, passed to plugin)
     std::string pluginArgs;
@@ -97,9 +101,17 @@ private:
     // Parse list command args
     Result<ListArgs> parseListArgs(const std::vector<std::string>& tokens);
 
-    // Parse target args (for kill, stop, start, update)
+    // Parse target args (for kill, stop, start, update, append)
     Result<TargetArgs> parseTargetArgs(const std::vector<std::string>& tokens);
 
+    // Parse one shared memory payload option at tokens[i] (--shm, --memfd,
+    // --shm-size, --shm-crc). Returns false if tokens[i] is not one of them.
+    Result<bool> parseShmOption(const std::vector<std::string>& tokens, size_t& i,
+                                ShmPayloadRef& shm);
+
+    // Validate a complete shared memory reference (all fields present)
+    Result<void> validateShmRef(const ShmPayloadRef& shm);
+
     // Split sequence by semicolon into fields
     std::vector<std::string> splitFields(const std::string& sequence);
 
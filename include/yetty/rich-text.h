@@ -2,8 +2,10 @@
 
 #include <yetty/font.h>
 #include <yetty/font-manager.h>
+#include <yetty/glyph-line-index.h>
 #include <yetty/result.hpp>
 #include <webgpu/webgpu.h>
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
@@ -85,6 +87,10 @@ public:
     // Set default font family (used when TextChar/TextSpan has empty fontFamily)
     void setDefaultFontFamily(const std::string& family) { defaultFontFamily_ = family; }
 
+    // Font a character/span with this family and style is drawn with (empty
+    // family = default), for callers that lay out text themselves
+    Font* resolveFont(const std::string& fontFamily, Font::Style style);
+
     // Set background color (renders a quad behind all text)
     void setBackgroundColor(const glm::vec4& color) { backgroundColor_ = color; hasBackground_ = true; }
     void clearBackgroundColor() { hasBackground_ = false; }
@@ -133,6 +139,8 @@ public:
     // Query
     //-------------------------------------------------------------------------
     uint32_t getGlyphCount() const { return glyphCount_; }
+    uint32_t getDrawnGlyphCount() const { return drawnGlyphCount_; }  // After culling, last frame
+    uint64_t getUploadedBytes() const { return uploadedBytes_; }  // Glyph data written to the GPU
     bool isEmpty() const { return spans_.empty() && chars_.empty(); }
 
 private:
@@ -147,9 +155,6 @@ private:
     void layoutChars(float viewWidth, float viewHeight);
     void buildGlyphInstances();
 
-    // Resolve font for a character/span
-    Font* resolveFont(const std::string& fontFamily, Font::Style style);
-
     // Decode UTF-8 codepoint from string
     static uint32_t decodeUTF8(const uint8_t*& ptr, const uint8_t* end);
 
@@ -164,12 +169,18 @@ private:
     //-------------------------------------------------------------------------
     // Font-grouped rendering
     //-------------------------------------------------------------------------
+    // All batches share one storage buffer; each owns the instance range
+    // [firstInstance, firstInstance + instanceCount) of instances_, sorted
+    // by line so render() draws only the lines inside the viewport
     struct FontGlyphBatch {
         Font* font = nullptr;
-        std::vector<GlyphInstance> glyphs;
-        WGPUBindGroup bindGroup = nullptr;     // Per-font bind group (for font atlas)
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+        GlyphLineIndex lines;
     };
     std::vector<FontGlyphBatch> fontBatches_;  // Grouped by font for rendering
+    std::vector<GlyphInstance> instances_;     // Built by layout, batch after batch
+    std::vector<GlyphInstance> uploaded_;      // What glyphBuffer_ holds now
 
     //-------------------------------------------------------------------------
     // Layout state
@@ -190,16 +201,26 @@ private:
     WGPURenderPipeline pipeline_ = nullptr;
     WGPUBindGroupLayout bindGroupLayout_ = nullptr;
     WGPUBuffer uniformBuffer_ = nullptr;
-    WGPUBuffer glyphBuffer_ = nullptr;         // Shared glyph buffer, re-uploaded per batch
+    WGPUBuffer glyphBuffer_ = nullptr;         // Persistent, partitioned by font batch
     WGPUSampler sampler_ = nullptr;
     uint32_t glyphCount_ = 0;                  // Total glyph count across all batches
     uint32_t glyphBufferCapacity_ = 0;
+    uint64_t uploadedBytes_ = 0;
+    uint32_t drawnGlyphCount_ = 0;
 
     // Cache for bind groups per font (avoid recreating every frame)
     std::map<Font*, WGPUBindGroup> fontBindGroups_;
     // Track font resource versions to detect when bind groups need recreation
     std::map<Font*, uint32_t> fontResourceVersions_;
 
+    // Last uniforms written; scrolling only rewrites these
+    std::array<float, 12> lastUniforms_ = {};
+    bool uniformsValid_ = false;
+
+    // Clean runs shorter than this between dirty instances are uploaded too,
+    // trading a few bytes for fewer writes
+    static constexpr size_t UPLOAD_MERGE_GAP = 64;
+
     static constexpr float pixelRange_ = 4.0f;
     bool initialized_ = false;
     bool gpuResourcesDirty_ = true;
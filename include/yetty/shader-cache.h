@@ -0,0 +1,131 @@
+#pragma once
+
+#include <yetty/lru-cache.h>
+#include <webgpu/webgpu.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// ShaderCache - device wide dedup of shader modules and render pipelines
+//
+// Every widget instance used to compile its own copy of the same WGSL and
+// build an identical pipeline. The create* calls here take the descriptors
+// the wgpuDeviceCreate* calls take and have the same contract: the returned
+// handle carries a reference the caller releases as before, or is nullptr
+// on failure. Equal requests share one object.
+//
+// Keys are structural: modules by their WGSL text, bind group layouts by
+// their entries, pipeline layouts by their (cached) bind group layouts and
+// pipelines by modules, entry points, layout, vertex buffers, primitive,
+// multisample and color target state (format, blend, write mask).
+// Descriptors the cache can not key exactly (extension chains, pipeline
+// constants, depth/stencil, objects that did not come from this cache) are
+// passed straight to the device.
+//
+// Owned by WebGPUContext so core widgets and plugins reach it through the
+// context. Thread-safe.
+//-----------------------------------------------------------------------------
+class ShaderCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t uncached = 0;
+        size_t shaderModules = 0;
+        size_t pipelines = 0;
+    };
+
+    // Bound on each table; least recently requested entries go first
+    static constexpr size_t MAX_ENTRIES = 256;
+
+    explicit ShaderCache(WGPUDevice device);
+    ~ShaderCache();
+
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    WGPUShaderModule createShaderModule(const WGPUShaderModuleDescriptor* desc);
+    WGPUBindGroupLayout createBindGroupLayout(const WGPUBindGroupLayoutDescriptor* desc);
+    WGPUPipelineLayout createPipelineLayout(const WGPUPipelineLayoutDescriptor* desc);
+    WGPURenderPipeline createRenderPipeline(const WGPURenderPipelineDescriptor* desc);
+
+    // Drop the cache's references; handles given out stay valid
+    void clear();
+
+    Stats stats() const;
+
+private:
+    // Owns one reference of a handle, released when the entry is evicted
+    template <typename T, void (*Release)(T)>
+    class Ref {
+    public:
+        explicit Ref(T handle) : _handle(handle) {}
+        Ref(Ref&& other) noexcept : _handle(other._handle) { other._handle = nullptr; }
+        Ref& operator=(Ref&& other) noexcept {
+            if (this != &other) {
+                reset();
+                _handle = other._handle;
+                other._handle = nullptr;
+            }
+            return *this;
+        }
+        ~Ref() { reset(); }
+
+        T get() const { return _handle; }
+
+    private:
+        void reset() {
+            if (_handle) Release(_handle);
+            _handle = nullptr;
+        }
+        T _handle;
+    };
+
+    // Cached object plus the id other keys refer to it by. Ids are never
+    // reused, so keys naming an evicted object simply stop matching.
+    template <typename T, void (*Release)(T)>
+    struct Entry {
+        Ref<T, Release> handle;
+        uint64_t id;
+    };
+
+    template <typename T, void (*Release)(T)>
+    struct Table {
+        explicit Table(std::unordered_map<T, uint64_t>& ids)
+            : cache(MAX_ENTRIES, [&ids](const std::string&, Entry<T, Release>& e) {
+                  ids.erase(e.handle.get());
+              }) {}
+        LruCache<std::string, Entry<T, Release>> cache;
+    };
+
+    using ModuleTable = Table<WGPUShaderModule, wgpuShaderModuleRelease>;
+    using BindGroupLayoutTable = Table<WGPUBindGroupLayout, wgpuBindGroupLayoutRelease>;
+    using PipelineLayoutTable = Table<WGPUPipelineLayout, wgpuPipelineLayoutRelease>;
+    using PipelineTable = Table<WGPURenderPipeline, wgpuRenderPipelineRelease>;
+
+    bool renderPipelineKey(const WGPURenderPipelineDescriptor* desc, std::string& key) const;
+
+    WGPUDevice _device;
+    mutable std::mutex _mutex;
+
+    std::unordered_map<WGPUShaderModule, uint64_t> _moduleIds;
+    std::unordered_map<WGPUBindGroupLayout, uint64_t> _bindGroupLayoutIds;
+    std::unordered_map<WGPUPipelineLayout, uint64_t> _pipelineLayoutIds;
+    std::unordered_map<WGPURenderPipeline, uint64_t> _pipelineIds;
+
+    ModuleTable _modules{_moduleIds};
+    BindGroupLayoutTable _bindGroupLayouts{_bindGroupLayoutIds};
+    PipelineLayoutTable _pipelineLayouts{_pipelineLayoutIds};
+    PipelineTable _pipelines{_pipelineIds};
+
+    uint64_t _nextId = 1;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+    uint64_t _uncached = 0;
+};
+
+} // namespace yetty
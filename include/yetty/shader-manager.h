@@ -8,6 +8,7 @@
 namespace yetty {
 
 class WebGPUContext;
+class ShaderCache;
 
 //-----------------------------------------------------------------------------
 // Global uniforms - shared by all shaders, updated once per frame
@@ -33,8 +34,10 @@ public:
     ShaderManager() = default;
     ~ShaderManager();
 
-    // Initialize with device and shader search path
-    Result<void> init(WGPUDevice device, const std::string& shaderPath);
+    // Initialize with device and shader search path. With a cache, modules
+    // are shared with widgets compiling the same source.
+    Result<void> init(WGPUDevice device, const std::string& shaderPath,
+                      ShaderCache* cache = nullptr);
     void dispose();
 
     // Get compiled fragment shader by name (loads and caches)
@@ -73,8 +76,10 @@ private:
     Result<WGPUShaderModule> loadShader(const std::string& filename);
     Result<void> createQuadVertexShader();
     Result<void> createGlobalUniformBuffer();
+    WGPUShaderModule compile(const WGPUShaderModuleDescriptor* desc);
 
     WGPUDevice _device = nullptr;
+    ShaderCache* _cache = nullptr;
     std::string _shaderPath;
 
     // Shared vertex shader for all quad-based rendering
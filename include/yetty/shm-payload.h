@@ -0,0 +1,136 @@
+#pragma once
+
+#include <yetty/lru-cache.h>
+#include <yetty/result.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// ShmPayloadRef - out-of-band payload reference carried by an OSC command
+//
+// Generic args (create/update):
+//   --shm TOKEN          POSIX shm object "/yetty-TOKEN"
+//   --memfd PID:FD       memfd named "yetty-TOKEN", held open by process PID
+//   --shm-size N         payload size in bytes
+//   --shm-crc HEX        CRC-32 (zlib polynomial) of the payload bytes
+//-----------------------------------------------------------------------------
+struct ShmPayloadRef {
+    std::string token;
+    uint64_t size = 0;
+    uint32_t crc = 0;
+    bool hasCrc = false;
+    int32_t pid = 0;    // memfd only
+    int32_t fd = -1;    // memfd only
+
+    bool empty() const { return token.empty(); }
+    bool isMemfd() const { return pid > 0 && fd >= 0; }
+};
+
+//-----------------------------------------------------------------------------
+// ShmPayload - read-only view of a client-provided shared memory object
+//
+// Large widget payloads (images, plots, video/PDF documents) skip the base94
+// OSC encoding and libvterm's string fragment reassembly: the client writes
+// raw bytes into a memfd or POSIX shm object and only sends a reference.
+//
+// Security model:
+//   - the object must be owned by our effective UID
+//   - the token is one-shot: the Terminal rejects tokens it has already seen
+//     (ShmTokenSet), and POSIX objects are unlinked as soon as they are opened
+//   - the bytes must match the advertised size and CRC-32, and must not
+//     change after they were verified:
+//       memfd: must carry F_SEAL_SHRINK|F_SEAL_GROW|F_SEAL_WRITE, so it is
+//              mapped in place (zero-copy)
+//       POSIX: cannot be sealed, so the payload is copied into our memory
+//              with read() (a concurrent ftruncate can't SIGBUS us) and the
+//              copy is what gets verified
+//
+// Widgets see the payload through Widget::payloadView().
+//-----------------------------------------------------------------------------
+class ShmPayload {
+public:
+    using Ptr = std::shared_ptr<const ShmPayload>;
+
+    static Result<Ptr> open(const ShmPayloadRef& ref) noexcept;
+
+    ~ShmPayload();
+
+    ShmPayload(const ShmPayload&) = delete;
+    ShmPayload& operator=(const ShmPayload&) = delete;
+
+    const uint8_t* data() const { return static_cast<const uint8_t*>(_addr); }
+    size_t size() const { return _size; }
+    std::string_view view() const {
+        return std::string_view(static_cast<const char*>(_addr), _size);
+    }
+
+    // CRC-32 as advertised in --shm-crc (same as Python's zlib.crc32)
+    static uint32_t crc32(const void* data, size_t size) noexcept;
+
+    // Tokens are restricted to [A-Za-z0-9_-] so they can't escape the
+    // "yetty-" object namespace
+    static bool isValidToken(const std::string& token) noexcept;
+
+    //-------------------------------------------------------------------------
+    // Scope - makes a mapping visible to widgets constructed on this thread
+    //
+    // Plugin createWidget() only carries a std::string payload, so the
+    // Terminal installs the mapping for the duration of the create call and
+    // the Widget constructor picks it up via current().
+    //-------------------------------------------------------------------------
+    class Scope {
+    public:
+        explicit Scope(Ptr payload) noexcept;
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Ptr _prev;
+    };
+
+    static Ptr current() noexcept;
+
+private:
+    ShmPayload(void* addr, size_t size) noexcept : _addr(addr), _size(size), _mapped(true) {}
+    ShmPayload(std::unique_ptr<uint8_t[]> copy, size_t size) noexcept
+        : _addr(copy.get()), _size(size), _copy(std::move(copy)) {}
+
+    void* _addr = nullptr;
+    size_t _size = 0;
+    bool _mapped = false;               // _addr is an mmap of a sealed memfd
+    std::unique_ptr<uint8_t[]> _copy;   // Owns _addr when not mapped
+};
+
+//-----------------------------------------------------------------------------
+// ShmTokenSet - recently used one-shot shm tokens
+//
+// Bounded so a client streaming payloads can't grow it forever; the oldest
+// tokens are forgotten first. A forgotten POSIX token can't be replayed
+// anyway (the object was unlinked on open), and a memfd token only maps
+// what the client still holds open.
+//-----------------------------------------------------------------------------
+class ShmTokenSet {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit ShmTokenSet(size_t capacity = DEFAULT_CAPACITY) : _tokens(capacity) {}
+
+    // True the first time `token` is seen, false on reuse
+    bool claim(const std::string& token) {
+        if (_tokens.get(token)) return false;
+        _tokens.put(token, true, 1);
+        return true;
+    }
+
+    size_t size() const { return _tokens.size(); }
+
+private:
+    LruCache<std::string, bool> _tokens;
+};
+
+} // namespace yetty
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// SpscQueue - bounded lock-free single-producer/single-consumer ring
+//
+// One thread may push, one (other) thread may pop/peek. Slots are allocated
+// once, so T should be cheap to move (pointers, handles, small structs).
+//
+// Used to hand decoded frames from worker threads to the render thread
+// without taking a lock on the render path.
+//-----------------------------------------------------------------------------
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : _slots(capacity + 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return _slots.size() - 1; }
+
+    // Producer side. Returns false (and leaves value untouched) when full.
+    bool tryPush(T&& value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t next = advance(tail);
+        if (next == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        _slots[tail] = std::move(value);
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) {
+        T copy = value;
+        return tryPush(std::move(copy));
+    }
+
+    // Consumer side. Returns false when empty.
+    bool tryPop(T& out) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(_slots[head]);
+        _head.store(advance(head), std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: oldest element without removing it, nullptr when empty
+    T* front() {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &_slots[head];
+    }
+
+    // Approximate when called concurrently with push/pop
+    size_t size() const {
+        size_t head = _head.load(std::memory_order_acquire);
+        size_t tail = _tail.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + _slots.size() - head;
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    size_t advance(size_t i) const { return i + 1 == _slots.size() ? 0 : i + 1; }
+
+    // Keep the indices on separate cache lines, they are written by
+    // different threads
+    static constexpr size_t CACHE_LINE = 64;
+    alignas(CACHE_LINE) std::atomic<size_t> _head{0};
+    alignas(CACHE_LINE) std::atomic<size_t> _tail{0};
+    std::vector<T> _slots;
+};
+
+} // namespace yetty
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <yetty/font.h>
+#include <yetty/lru-cache.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// ShapedRun - advances of a run of text at one font, style and pixel size.
+// A negative advance marks a codepoint the font has no glyph for; such
+// codepoints are skipped and do not count towards `width`.
+//-----------------------------------------------------------------------------
+struct ShapedRun {
+    std::vector<float> advances;
+    float width = 0.0f;
+};
+
+//-----------------------------------------------------------------------------
+// TextLayoutCache - process-wide LRU cache of shaped runs
+//
+// Rich-text layout measures words one glyph at a time; the same words come
+// up again and again (headings, labels, code keywords), in one widget and
+// across widgets. Runs are keyed by font, its resource version (bumped when
+// glyphs are added), style, pixel size and the UTF-32 text, and are handed
+// out as shared pointers so eviction never invalidates a run in use.
+//
+// Thread-safe; shared() is the instance all widgets use.
+//-----------------------------------------------------------------------------
+class TextLayoutCache {
+public:
+    static constexpr size_t DEFAULT_BUDGET = 4 * 1024 * 1024;
+
+    explicit TextLayoutCache(size_t budget = DEFAULT_BUDGET) : _cache(budget) {}
+
+    TextLayoutCache(const TextLayoutCache&) = delete;
+    TextLayoutCache& operator=(const TextLayoutCache&) = delete;
+
+    static TextLayoutCache& shared() {
+        static TextLayoutCache cache;
+        return cache;
+    }
+
+    // Cached run, measured on a miss with `measure(codepoint)`, which returns
+    // the advance at `size` or a negative value when the glyph is missing.
+    // `font` only identifies the metrics and is never dereferenced.
+    template <typename MeasureFn>
+    std::shared_ptr<const ShapedRun> shape(const void* font, uint32_t fontVersion,
+                                           Font::Style style, float size,
+                                           std::u32string_view text,
+                                           MeasureFn&& measure) {
+        // Keyed by hash; the entry holds the full key to rule out collisions
+        size_t key = hashKey(font, fontVersion, style, size, text);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (auto* hit = _cache.get(key); hit && hit->font == font &&
+                hit->fontVersion == fontVersion && hit->style == style &&
+                hit->size == size && hit->text == text) {
+                _hits++;
+                return hit->run;
+            }
+            _misses++;
+        }
+
+        // Measure unlocked; a racing miss on the same key just stores it twice
+        auto run = std::make_shared<ShapedRun>();
+        run->advances.reserve(text.size());
+        for (uint32_t codepoint : text) {
+            float advance = measure(codepoint);
+            run->advances.push_back(advance);
+            if (advance > 0.0f) run->width += advance;
+        }
+
+        size_t cost = sizeof(Entry) + sizeof(ShapedRun) +
+                      text.size() * (sizeof(char32_t) + sizeof(float));
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cache.put(key, Entry{font, fontVersion, style, size, std::u32string(text), run}, cost);
+        return run;
+    }
+
+    // Shape with `font`'s own glyph metrics, scaled to `size` pixels
+    std::shared_ptr<const ShapedRun> shape(const Font* font, Font::Style style, float size,
+                                           std::u32string_view text) {
+        float scale = size / font->getFontSize();
+        return shape(font, font->getResourceVersion(), style, size, text,
+                     [font, style, scale](uint32_t codepoint) {
+                         const auto* metrics = font->getGlyph(codepoint, style);
+                         return metrics ? metrics->_advance * scale : -1.0f;
+                     });
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cache.clear();
+    }
+
+    void setBudget(size_t budget) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cache.setBudget(budget);
+    }
+
+    // Counters, for tuning the budget
+    uint64_t hits() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hits;
+    }
+    uint64_t misses() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _misses;
+    }
+    double hitRate() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint64_t total = _hits + _misses;
+        return total ? static_cast<double>(_hits) / total : 0.0;
+    }
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _cache.size();
+    }
+    size_t cost() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _cache.cost();
+    }
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _hits = 0;
+        _misses = 0;
+    }
+
+private:
+    struct Entry {
+        const void* font;
+        uint32_t fontVersion;
+        Font::Style style;
+        float size;
+        std::u32string text;
+        std::shared_ptr<const ShapedRun> run;
+    };
+
+    static size_t hashKey(const void* font, uint32_t fontVersion, Font::Style style,
+                          float size, std::u32string_view text) {
+        auto mix = [](size_t h, size_t v) {
+            return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        };
+        size_t h = std::hash<std::u32string_view>{}(text);
+        h = mix(h, std::hash<const void*>{}(font));
+        h = mix(h, fontVersion);
+        h = mix(h, static_cast<size_t>(style));
+        return mix(h, std::hash<float>{}(size));
+    }
+
+    mutable std::mutex _mutex;
+    LruCache<size_t, Entry> _cache;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+};
+
+} // namespace yetty
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <yetty/result.hpp>
+#include <yetty/shader-cache.h>
 #include <webgpu/webgpu.h>
 #include <memory>
 #if !YETTY_ANDROID
@@ -39,6 +40,9 @@ public:
     uint32_t getSurfaceWidth() const noexcept { return width_; }
     uint32_t getSurfaceHeight() const noexcept { return height_; }
 
+    // Shared shader modules and pipelines for everything on this device
+    ShaderCache& shaderCache() noexcept { return *shaderCache_; }
+
     Result<WGPUTextureView> getCurrentTextureView() noexcept;
     void present() noexcept;
     
@@ -72,6 +76,7 @@ private:
     WGPUQueue queue_ = nullptr;
     WGPUSurface surface_ = nullptr;
     WGPUTextureFormat surfaceFormat_ = WGPUTextureFormat_BGRA8Unorm;
+    std::unique_ptr<ShaderCache> shaderCache_;
 
 #if YETTY_WEB
     WGPUSwapChain swapChain_ = nullptr;
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <yetty/result.hpp>
+#include <yetty/shm-payload.h>
 #include <webgpu/webgpu.h>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <atomic>
 #include <mutex>
 
@@ -168,6 +170,25 @@ public:
     PositionMode getPositionMode() const { return _positionMode; }
     void setPositionMode(PositionMode mode) { _positionMode = mode; }
 
+    // Pixel rect from the cell position. Relative widgets scroll with the
+    // content, so they move down by the rows the view is scrolled back.
+    void placeOnGrid(float cellWidth, float cellHeight, int scrollOffset) {
+        float pixelY = static_cast<float>(_y) * cellHeight;
+        if (_positionMode == PositionMode::Relative && scrollOffset > 0) {
+            pixelY += scrollOffset * cellHeight;
+        }
+        setPixelPosition(static_cast<float>(_x) * cellWidth, pixelY);
+        setPixelSize(static_cast<uint32_t>(_widthCells * cellWidth),
+                     static_cast<uint32_t>(_heightCells * cellHeight));
+    }
+
+    // Whether the pixel rect overlaps a view of the given size; off-screen
+    // widgets are prepared and rendered with on=false
+    bool isOnScreen(float viewWidth, float viewHeight) const {
+        return _pixelX < viewWidth && _pixelX + _pixelWidth > 0.0f &&
+               _pixelY < viewHeight && _pixelY + _pixelHeight > 0.0f;
+    }
+
     ScreenType getScreenType() const { return _screenType; }
     void setScreenType(ScreenType type) { _screenType = type; }
 
@@ -195,11 +216,27 @@ public:
     void setName(const std::string& n) { _name = n; }
 
     const std::string& getPayload() const { return _payload; }
-    void setPayload(const std::string& p) { _payload = p; }
+    void setPayload(const std::string& p) { _payload = p; _shmPayload.reset(); }
+
+    // Out-of-band payload (shared memory side channel), replaces _payload
+    const ShmPayload::Ptr& getShmPayload() const { return _shmPayload; }
+    void setShmPayload(ShmPayload::Ptr p) { _shmPayload = std::move(p); _payload.clear(); }
+
+    // Payload bytes regardless of transport - zero-copy for shm payloads
+    std::string_view payloadView() const {
+        return _shmPayload ? _shmPayload->view() : std::string_view(_payload);
+    }
 
     // For re-initialization after setPayload()
     Result<void> reinit() { return init(); }
 
+    // Incremental data (OSC "append") - widgets with streaming state override
+    // this instead of being disposed and re-initialized on every update
+    virtual Result<void> append(std::string_view data) {
+        (void)data;
+        return Err<void>(_name + ": append not supported");
+    }
+
     Plugin* getParent() const { return _parent; }
     void setParent(Plugin* p) { _parent = p; }
 
@@ -218,10 +255,11 @@ protected:
         , _pixelHeight(params.heightCells * params.cellHeight)
         , _positionMode(params.mode)
         , _id(_nextId++)
+        , _shmPayload(ShmPayload::current())
     {}
 
     // Default constructor for subclasses that don't need params yet
-    Widget() : _id(_nextId++) {}
+    Widget() : _id(_nextId++), _shmPayload(ShmPayload::current()) {}
 
     //-------------------------------------------------------------------------
     // init() - NO ARGUMENTS, works on members, CAN fail
@@ -258,6 +296,7 @@ protected:
     bool _dirty = true;
 
     std::string _payload;
+    ShmPayload::Ptr _shmPayload;  // Set when the payload arrived via shared memory
     std::string _args;
     std::mutex _mutex;
 
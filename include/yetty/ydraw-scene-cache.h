@@ -0,0 +1,75 @@
+#pragma once
+
+#include <yetty/lru-cache.h>
+#include <yetty/ydraw-types.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// YDrawCompiledScene - everything parse() produces from one piece of content
+//-----------------------------------------------------------------------------
+
+struct YDrawCompiledScene {
+    std::vector<YDrawPrimitiveGPU> primitives;
+    std::unordered_map<std::string, YDrawStruct> structs;
+    std::unordered_map<std::string, YDrawWidget> widgets;
+};
+
+//-----------------------------------------------------------------------------
+// YDrawSceneCache - content-addressed cache of compiled scenes
+//
+// Keyed by a hash of the raw YAML/SVG text; the text itself is kept to rule
+// out collisions. Re-sent or re-instantiated scenes then skip parsing. The
+// process wide instance is shared by all YDraw renderers and is safe to use
+// from several threads.
+//-----------------------------------------------------------------------------
+
+class YDrawSceneCache {
+public:
+    using ScenePtr = std::shared_ptr<const YDrawCompiledScene>;
+
+    static constexpr size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+    static YDrawSceneCache& instance();
+
+    explicit YDrawSceneCache(size_t budget = DEFAULT_BUDGET);
+
+    // nullptr on miss
+    ScenePtr find(std::string_view content);
+    void insert(std::string_view content, ScenePtr scene);
+    void clear();
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+    size_t size() const;
+
+private:
+    struct Key {
+        uint64_t hash;
+        size_t length;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return static_cast<size_t>(k.hash ^ k.length); }
+    };
+    struct Entry {
+        std::string content;
+        ScenePtr scene;
+    };
+
+    static Key keyFor(std::string_view content);
+
+    mutable std::mutex _mutex;
+    LruCache<Key, Entry, KeyHash> _cache;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+};
+
+} // namespace yetty
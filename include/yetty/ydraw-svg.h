@@ -0,0 +1,29 @@
+#pragma once
+
+#include <yetty/ydraw-types.h>
+#include <string_view>
+#include <vector>
+
+namespace yetty::ydraw {
+
+//-----------------------------------------------------------------------------
+// SVG loading
+//
+// Single pass tokenizer over the raw text, no regex and no DOM. Supported:
+// circle, ellipse, rect, line, polyline, polygon and path (M L H V Q T C S
+// A Z, absolute and relative). Paths become stroked segments and curves.
+// Polygons and subpaths closed with Z are also filled with triangles from
+// ear clipping, each subpath on its own: holes are filled over and open
+// subpaths are not filled. Transforms, groups styles and CSS are not
+// applied.
+//
+// Appends to `out`, returns the number of primitives added.
+//-----------------------------------------------------------------------------
+
+size_t parseSvg(std::string_view svg, std::vector<YDrawPrimitiveGPU>& out);
+
+// "#rgb", "#rrggbb", "#rrggbbaa" or a basic color keyword. "none" yields
+// transparent black.
+bool parseSvgColor(std::string_view color, float out[4]);
+
+} // namespace yetty::ydraw
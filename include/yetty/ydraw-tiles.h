@@ -0,0 +1,58 @@
+#pragma once
+
+#include <yetty/ydraw-types.h>
+#include <cstdint>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// YDrawTileBins - per-tile primitive lists for the 2D fragment pass
+//
+// The widget is split into TILE_SIZE x TILE_SIZE pixel tiles. Every 2D
+// primitive is added to the tiles its (stroke and antialias inflated) AABB
+// touches, so a fragment only evaluates the SDFs that can actually cover it.
+// Indices within a tile stay in ascending order, which keeps the painter's
+// order of the unbinned loop and therefore the exact same output.
+//
+// data() layout, uploaded as-is into one storage buffer:
+//   [0 .. tiles]      absolute start offset of each tile's list (+ end)
+//   [tiles+1 .. ]     primitive indices
+//
+// 3D primitives are not binned, they are raymarched as a whole scene.
+//-----------------------------------------------------------------------------
+
+class YDrawTileBins {
+public:
+    static constexpr uint32_t TILE_SIZE = 16;
+
+    // Rebuild bins for a widget of width x height pixels
+    void build(const std::vector<YDrawPrimitiveGPU>& prims, float width, float height);
+
+    // Pixel space AABB [minX, minY, maxX, maxY] outside of which the primitive
+    // contributes nothing. Returns false for 3D primitives.
+    static bool bounds(const YDrawPrimitiveGPU& prim, float out[4]);
+
+    uint32_t tilesX() const { return _tilesX; }
+    uint32_t tilesY() const { return _tilesY; }
+    bool has3D() const { return _has3D; }
+
+    // Primitive indices of tile (tx, ty), as [begin, end)
+    const uint32_t* tileBegin(uint32_t tx, uint32_t ty) const {
+        return _data.data() + _data[ty * _tilesX + tx];
+    }
+    const uint32_t* tileEnd(uint32_t tx, uint32_t ty) const {
+        return _data.data() + _data[ty * _tilesX + tx + 1];
+    }
+
+    const std::vector<uint32_t>& data() const { return _data; }
+
+private:
+    uint32_t _tilesX = 0;
+    uint32_t _tilesY = 0;
+    bool _has3D = false;
+    std::vector<uint32_t> _data;
+    std::vector<uint32_t> _counts;  // Scratch, kept to avoid reallocating
+};
+
+} // namespace yetty
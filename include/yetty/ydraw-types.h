@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// YDraw Primitive Types - 2D and 3D SDFs (Inigo Quilez)
+//-----------------------------------------------------------------------------
+
+enum class YDrawPrimitiveType : uint32_t {
+    // 2D Primitives
+    Circle2D = 0,
+    Box2D = 1,
+    Segment2D = 2,
+    Triangle2D = 3,
+    Bezier2D = 4,         // Quadratic bezier
+    Arc2D = 5,            // Circular arc
+    Ellipse2D = 6,
+    CubicBezier2D = 7,
+    EllipseArc2D = 8,     // Elliptical arc (for SVG arc command)
+    Polygon2D = 9,
+
+    // 3D Primitives (iquilezles.org)
+    Sphere3D = 100,
+    Box3D = 101,
+    BoxFrame3D = 102,
+    Torus3D = 103,
+    CappedTorus3D = 104,
+    Cylinder3D = 105,
+    CappedCylinder3D = 106,
+    RoundedCylinder3D = 107,
+    Capsule3D = 108,
+    Cone3D = 109,
+    CappedCone3D = 110,
+    RoundCone3D = 111,
+    Plane3D = 112,
+    HexPrism3D = 113,
+    TriPrism3D = 114,
+    Octahedron3D = 115,
+    Pyramid3D = 116,
+    Ellipsoid3D = 117,
+    Rhombus3D = 118,
+    Link3D = 119,
+};
+
+struct YDrawStyle {
+    float fill[4] = {1.0f, 1.0f, 1.0f, 1.0f};      // RGBA
+    float stroke[4] = {0.0f, 0.0f, 0.0f, 0.0f};    // RGBA (alpha 0 = no stroke)
+    float stroke_width = 0.0f;
+    float round = 0.0f;
+    float rotate = 0.0f;  // degrees
+    float _pad = 0.0f;
+};
+
+// GPU-side primitive data (padded to 16-byte alignment)
+struct YDrawPrimitiveGPU {
+    uint32_t type;
+    float params[15];  // Flexible params based on type
+    YDrawStyle style;  // 48 bytes
+};
+
+//-----------------------------------------------------------------------------
+// YAML AST Types for YDraw
+//-----------------------------------------------------------------------------
+
+struct YDrawStruct {
+    std::string name;
+    std::vector<std::string> args;
+    std::unordered_map<std::string, std::string> defaults;
+    std::string body_yaml;  // Raw YAML for lazy evaluation
+};
+
+struct YDrawWidget {
+    std::string name;
+    std::vector<std::string> args;
+    std::unordered_map<std::string, std::string> defaults;
+    std::string body_yaml;  // Raw YAML for lazy evaluation
+};
+
+} // namespace yetty
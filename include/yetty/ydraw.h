@@ -1,6 +1,8 @@
 #pragma once
 
 #include <yetty/result.hpp>
+#include <yetty/ydraw-types.h>
+#include <yetty/ydraw-tiles.h>
 #include <yetty/webgpu-context.h>
 #include <webgpu/webgpu.h>
 #include <vector>
@@ -9,88 +11,12 @@
 
 namespace yetty {
 
-//-----------------------------------------------------------------------------
-// YDraw Primitive Types - 2D and 3D SDFs (Inigo Quilez)
-//-----------------------------------------------------------------------------
-
-enum class YDrawPrimitiveType : uint32_t {
-    // 2D Primitives
-    Circle2D = 0,
-    Box2D = 1,
-    Segment2D = 2,
-    Triangle2D = 3,
-    Bezier2D = 4,         // Quadratic bezier
-    Arc2D = 5,            // Circular arc
-    Ellipse2D = 6,
-    CubicBezier2D = 7,
-    EllipseArc2D = 8,     // Elliptical arc (for SVG arc command)
-    Polygon2D = 9,
-
-    // 3D Primitives (iquilezles.org)
-    Sphere3D = 100,
-    Box3D = 101,
-    BoxFrame3D = 102,
-    Torus3D = 103,
-    CappedTorus3D = 104,
-    Cylinder3D = 105,
-    CappedCylinder3D = 106,
-    RoundedCylinder3D = 107,
-    Capsule3D = 108,
-    Cone3D = 109,
-    CappedCone3D = 110,
-    RoundCone3D = 111,
-    Plane3D = 112,
-    HexPrism3D = 113,
-    TriPrism3D = 114,
-    Octahedron3D = 115,
-    Pyramid3D = 116,
-    Ellipsoid3D = 117,
-    Rhombus3D = 118,
-    Link3D = 119,
-};
-
-struct YDrawStyle {
-    float fill[4] = {1.0f, 1.0f, 1.0f, 1.0f};      // RGBA
-    float stroke[4] = {0.0f, 0.0f, 0.0f, 0.0f};    // RGBA (alpha 0 = no stroke)
-    float stroke_width = 0.0f;
-    float round = 0.0f;
-    float rotate = 0.0f;  // degrees
-    float _pad = 0.0f;
-};
-
-// GPU-side primitive data (padded to 16-byte alignment)
-struct YDrawPrimitiveGPU {
-    uint32_t type;
-    float params[15];  // Flexible params based on type
-    YDrawStyle style;  // 48 bytes
-};
-
-//-----------------------------------------------------------------------------
-// YAML AST Types for YDraw
-//-----------------------------------------------------------------------------
-
-struct YDrawStruct {
-    std::string name;
-    std::vector<std::string> args;
-    std::unordered_map<std::string, std::string> defaults;
-    std::string body_yaml;  // Raw YAML for lazy evaluation
-};
-
-struct YDrawWidget {
-    std::string name;
-    std::vector<std::string> args;
-    std::unordered_map<std::string, std::string> defaults;
-    std::string body_yaml;  // Raw YAML for lazy evaluation
-};
-
 //-----------------------------------------------------------------------------
 // YDrawRenderer - Core 2D/3D SDF rendering
 //-----------------------------------------------------------------------------
 
 class YDrawRenderer {
 public:
-    static constexpr size_t MAX_PRIMITIVES = 256;
-
     YDrawRenderer();
     ~YDrawRenderer();
 
@@ -104,6 +30,9 @@ public:
     // Add primitives programmatically
     void addPrimitive(const YDrawPrimitiveGPU& prim);
 
+    // Replace an existing primitive, only its slot is re-uploaded
+    void setPrimitive(size_t index, const YDrawPrimitiveGPU& prim);
+
     // Parse content (YAML or SVG)
     Result<void> parse(const std::string& content);
 
@@ -124,6 +53,10 @@ public:
 
 private:
     Result<void> createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat);
+    Result<void> createBindGroup(WGPUDevice device);
+    Result<void> ensurePrimitiveCapacity(WGPUDevice device, size_t count);
+    void markDirty(size_t begin, size_t end);
+    Result<void> uploadTiles(WebGPUContext& ctx, float width, float height);
     Result<void> parseYAML(const std::string& yaml);
     Result<void> parseSVG(const std::string& svg);
 
@@ -139,7 +72,15 @@ private:
 
     // Primitives to render
     std::vector<YDrawPrimitiveGPU> _primitives;
-    bool _primitives_dirty = true;
+    // Primitives not yet uploaded, [begin, end) - empty when begin == end
+    size_t _dirty_begin = 0;
+    size_t _dirty_end = 0;
+    bool _bins_dirty = true;
+
+    // Per-tile primitive lists, rebuilt on content or size change
+    YDrawTileBins _tile_bins;
+    float _binned_width = -1.0f;
+    float _binned_height = -1.0f;
 
     float _time = 0.0f;
 
@@ -148,6 +89,10 @@ private:
     WGPUBindGroup _bind_group = nullptr;
     WGPUBuffer _uniform_buffer = nullptr;
     WGPUBuffer _primitive_buffer = nullptr;
+    size_t _primitive_capacity = 0;  // In primitives
+    WGPUBindGroupLayout _bind_group_layout = nullptr;
+    WGPUBuffer _tile_buffer = nullptr;
+    size_t _tile_buffer_size = 0;
 
     WGPUTextureFormat _current_format = WGPUTextureFormat_Undefined;
     bool _gpu_initialized = false;
@@ -0,0 +1,61 @@
+#include "child-widget-layout.h"
+#include <ytrace/ytrace.hpp>
+#include <vector>
+
+namespace yetty {
+
+void ChildWidgetLayout::applyMarkerPositions(GPUScreen& screen,
+                                             const std::vector<WidgetPtr>& widgets) {
+    // GPUScreen tracks widget markers as cells change; reapply positions
+    // only when a marker was added, removed or moved
+    uint64_t generation = screen.widgetPositionsGeneration();
+    if (generation == _positionsGeneration) return;
+    _positionsGeneration = generation;
+
+    const auto& positions = screen.widgetPositions();
+    ydebug("ChildWidgetLayout: {} widget positions for {} child widgets",
+           positions.size(), widgets.size());
+
+    for (const auto& widget : widgets) {
+        auto it = positions.find(static_cast<uint16_t>(widget->id()));
+        if (it == positions.end()) continue;
+        const WidgetPosition& pos = it->second;
+        if (widget->getX() != pos.col || widget->getY() != pos.row) {
+            ydebug("ChildWidgetLayout: widget {} position updated ({},{}) -> ({},{})",
+                   pos.widgetId, widget->getX(), widget->getY(), pos.col, pos.row);
+            widget->setPosition(pos.col, pos.row);
+        }
+    }
+}
+
+void ChildWidgetLayout::remove(uint32_t widgetId) {
+    std::erase_if(_placed, [widgetId](const Placed& p) { return p.widget->id() == widgetId; });
+}
+
+const std::vector<ChildWidgetLayout::Placed>& ChildWidgetLayout::place(
+        GPUScreen& screen, const std::vector<WidgetPtr>& widgets, ScreenType currentScreen,
+        float cellWidth, float cellHeight) {
+    _placed.clear();
+    if (widgets.empty()) return _placed;
+
+    applyMarkerPositions(screen, widgets);
+
+    int scrollOffset = screen.getScrollOffset();
+    float viewW = static_cast<float>(screen.getCols()) * cellWidth;
+    float viewH = static_cast<float>(screen.getRows()) * cellHeight;
+    for (const auto& widget : widgets) {
+        if (!widget->isVisible()) continue;
+        if (widget->getScreenType() != currentScreen) continue;
+
+        widget->placeOnGrid(cellWidth, cellHeight, scrollOffset);
+        bool on = widget->isOnScreen(viewW, viewH);
+
+        ydebug("ChildWidgetLayout: widget '{}' grid=({},{}) -> pixel=({},{}) size={}x{} on={}",
+               widget->name(), widget->getX(), widget->getY(), widget->getPixelX(),
+               widget->getPixelY(), widget->getPixelWidth(), widget->getPixelHeight(), on);
+        _placed.push_back({widget, on});
+    }
+    return _placed;
+}
+
+} // namespace yetty
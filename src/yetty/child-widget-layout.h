@@ -0,0 +1,47 @@
+#pragma once
+
+#include <yetty/widget.h>
+#include "gpu-screen.h"
+#include <cstdint>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// ChildWidgetLayout - per-frame placement of a terminal's child widgets
+//
+// Terminal::prepareFrame calls place(): marker positions tracked by the
+// GPUScreen are applied when they changed, then every visible widget of the
+// current screen gets its pixel rect from the grid and the scroll offset.
+// A widget is on while any part of it is in the view; widgets scrolled into
+// history are off so they pause. Terminal::render draws placed() with the
+// same flags.
+//-----------------------------------------------------------------------------
+class ChildWidgetLayout {
+public:
+    struct Placed {
+        WidgetPtr widget;
+        bool on = false;
+    };
+
+    const std::vector<Placed>& place(GPUScreen& screen, const std::vector<WidgetPtr>& widgets,
+                                     ScreenType currentScreen, float cellWidth, float cellHeight);
+
+    // Widgets laid out by the last place(), in render order
+    const std::vector<Placed>& placed() const { return _placed; }
+
+    // Apply marker positions on the next place() even if they did not
+    // change (a widget was added)
+    void invalidate() { _positionsGeneration = UINT64_MAX; }
+
+    // Drop a removed widget so render() does not draw it this frame
+    void remove(uint32_t widgetId);
+
+private:
+    void applyMarkerPositions(GPUScreen& screen, const std::vector<WidgetPtr>& widgets);
+
+    uint64_t _positionsGeneration = UINT64_MAX;  // Last applied GPUScreen marker state
+    std::vector<Placed> _placed;
+};
+
+} // namespace yetty
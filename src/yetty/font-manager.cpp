@@ -619,6 +619,92 @@ Result<Font*> FontManager::getFont(const unsigned char* data, size_t dataLen,
 #endif
 }
 
+Result<Font*> FontManager::getIncrementalFont(const unsigned char* data, size_t dataLen,
+                                               const std::string& fontName, float fontSize,
+                                               std::string* family) noexcept {
+#if !YETTY_USE_PREBUILT_ATLAS
+    if (!data || dataLen == 0) {
+        return Err<Font*>("Invalid font data");
+    }
+
+    // Two documents can embed different subsets under the same name; the
+    // data hash keeps their atlases (and FT faces) apart. Keyed like
+    // getFont(data, ...) so RichText resolves it by the combined name.
+    FontCacheKey key;
+    key.familyName = incrementalFamily(data, dataLen, fontName);
+    key.styleName = "";
+    key.numGlyphs = 0;
+    key.unitsPerEM = 0;
+    if (family) {
+        *family = key.familyName;
+    }
+
+    auto it = fontCache_.find(key);
+    if (it != fontCache_.end()) {
+        return Ok(it->second.get());
+    }
+
+    // Separate from the eager atlases
+    std::string cachePath = getCachePath(fontName, fontSize, data, dataLen) + "-inc";
+
+    std::unique_ptr<Font> font;
+    if (auto diskResult = loadFromDiskCache(cachePath)) {
+        font = std::move(*diskResult);
+        ydebug("FontManager: incremental font '{}' from disk cache", fontName);
+    } else {
+        font = std::make_unique<Font>();
+    }
+
+    bool fresh = font->getTexture() == nullptr;
+    if (!font->initIncremental(data, dataLen, fontName, fontSize)) {
+        return Err<Font*>("Failed to load embedded font '" + fontName + "'");
+    }
+    if (fresh) {
+        if (!font->createTexture(_ctx->getDevice(), _ctx->getQueue())) {
+            return Err<Font*>("Failed to create font texture for embedded font");
+        }
+        if (!font->createGlyphMetadataBuffer(_ctx->getDevice())) {
+            return Err<Font*>("Failed to create glyph metadata buffer for embedded font");
+        }
+    }
+
+    Font* ptr = font.get();
+    incrementalFonts_[ptr] = IncrementalFont{cachePath, font->getGlyphCount()};
+    fontCache_[key] = std::move(font);
+    return Ok(ptr);
+#else
+    (void)data; (void)dataLen; (void)fontName; (void)fontSize; (void)family;
+    return Err<Font*>("Font loading from data not available on this platform");
+#endif
+}
+
+Result<void> FontManager::addGlyphs(Font* font, const std::vector<uint32_t>& codepoints) noexcept {
+#if !YETTY_USE_PREBUILT_ATLAS
+    if (!font || !font->isIncremental()) {
+        return Ok();
+    }
+    if (font->addGlyphs(codepoints) == 0) {
+        return Ok();
+    }
+    if (!font->uploadPendingGlyphs(_ctx->getDevice(), _ctx->getQueue())) {
+        return Err<void>("Failed to upload new glyphs");
+    }
+    return Ok();
+#else
+    (void)font; (void)codepoints;
+    return Ok();
+#endif
+}
+
+void FontManager::persistIncrementalFonts() noexcept {
+    for (auto& [font, state] : incrementalFonts_) {
+        if (font->getGlyphCount() == state.savedGlyphs) continue;
+        if (saveToDiskCache(font, state.cachePath)) {
+            state.savedGlyphs = font->getGlyphCount();
+        }
+    }
+}
+
 Result<Font*> FontManager::loadFromAtlas(const std::string& atlasPath,
                                           const std::string& metricsPath,
                                           const std::string& fontName) noexcept {
@@ -703,12 +789,14 @@ void FontManager::unloadFont(const std::string& family, Font::Style style) noexc
             }
         }
 
+        incrementalFonts_.erase(it->second.get());
         fontCache_.erase(it);
         yinfo("FontManager: unloaded font '{}' {}", family, static_cast<int>(style));
     }
 }
 
 void FontManager::unloadAll() noexcept {
+    incrementalFonts_.clear();
     fontCache_.clear();
     hasDefaultFont_ = false;
     ydebug("FontManager: unloaded all fonts");
@@ -749,6 +837,11 @@ std::string FontManager::getCacheDir() const noexcept {
 #endif
 }
 
+std::string FontManager::incrementalFamily(const unsigned char* data, size_t dataLen,
+                                           const std::string& fontName) noexcept {
+    return fontName + "#" + computeHash(data, dataLen);
+}
+
 std::string FontManager::computeHash(const unsigned char* data, size_t dataLen) noexcept {
     // Simple FNV-1a hash for speed
     uint64_t hash = 14695981039346656037ULL;
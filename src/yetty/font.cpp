@@ -24,7 +24,9 @@
 #include <sstream>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <thread>
 
 namespace yetty {
 
@@ -1083,6 +1085,235 @@ bool Font::generate(const unsigned char* data, size_t dataLen,
     return true;
 }
 
+//-----------------------------------------------------------------------------
+// Incremental atlas (embedded fonts)
+//-----------------------------------------------------------------------------
+
+bool Font::initIncremental(const unsigned char* data, size_t dataLen,
+                           const std::string& fontName, float fontSize, uint32_t atlasSize) {
+    if (!data || dataLen == 0) {
+        yerror("Font::initIncremental: null or empty font data for '{}'", fontName);
+        return false;
+    }
+
+    // FreeType reads the face from this buffer for as long as it is open
+    _fontData.assign(data, data + dataLen);
+
+    if (!_freetypeHandle) {
+        _freetypeHandle = msdfgen::initializeFreetype();
+    }
+    if (!_freetypeHandle) {
+        yerror("Failed to initialize msdfgen FreeType");
+        return false;
+    }
+
+    msdfgen::FontHandle* font = msdfgen::loadFontData(
+        static_cast<msdfgen::FreetypeHandle*>(_freetypeHandle),
+        _fontData.data(), static_cast<int>(_fontData.size()));
+    if (!font) {
+        yerror("Failed to load font '{}' from data", fontName);
+        return false;
+    }
+    _primaryFont = font;
+
+    msdfgen::FontMetrics metrics;
+    msdfgen::getFontMetrics(metrics, font, msdfgen::FONT_SCALING_NONE);
+    _unitsPerEm = metrics.emSize > 0 ? metrics.emSize : 1000.0;
+
+    if (_atlasData.empty()) {
+        // Fresh atlas; a cached one keeps its size, glyphs and shelf state
+        _fontSize = fontSize;
+        _atlasWidth = atlasSize;
+        _atlasHeight = atlasSize;
+        _atlasData.assign(static_cast<size_t>(_atlasWidth) * _atlasHeight * 4, 0);
+        _lineHeight = static_cast<float>(metrics.lineHeight * _fontSize / _unitsPerEm);
+        _shelfX = _atlasPadding;
+        _shelfY = _atlasPadding;
+        _shelfHeight = 0;
+        buildGlyphIndexMap();
+    }
+
+    _incremental = true;
+    yinfo("Font::initIncremental: '{}' ({} bytes, {} cached glyphs)", fontName, dataLen, _glyphs.size());
+    return true;
+}
+
+size_t Font::addGlyphs(const std::vector<uint32_t>& codepoints) {
+    if (!_incremental || !_primaryFont) {
+        return 0;
+    }
+
+    msdfgen::FontHandle* font = static_cast<msdfgen::FontHandle*>(_primaryFont);
+    double fontScale = _fontSize / _unitsPerEm;
+    int padding = static_cast<int>(std::ceil(_pixelRange));
+
+    // Load shapes - the FreeType face is not thread-safe, this part is serial
+    std::vector<PackedGlyph> glyphs;
+    std::set<uint32_t> seen;
+    for (uint32_t codepoint : codepoints) {
+        if (_glyphs.count(codepoint) || _failedCodepoints.count(codepoint) || !seen.insert(codepoint).second) {
+            continue;
+        }
+
+        // Subset fonts only contain the glyphs they use, don't map to .notdef
+        msdfgen::GlyphIndex glyphIndex;
+        PackedGlyph pg;
+        double advance = 0.0;
+        if (!msdfgen::getGlyphIndex(glyphIndex, font, codepoint) ||
+            !msdfgen::loadGlyph(pg.shape, font, glyphIndex, msdfgen::FONT_SCALING_NONE, &advance)) {
+            _failedCodepoints.insert(codepoint);
+            continue;
+        }
+
+        pg.codepoint = codepoint;
+        pg.style = Regular;
+        pg.fontScale = fontScale;
+        pg.advance = advance * fontScale;
+        pg.atlasX = pg.atlasY = 0;
+        pg.boundsL = pg.boundsB = pg.boundsR = pg.boundsT = 0;
+        pg.bearingX = pg.bearingY = 0;
+        pg.sizeX = pg.sizeY = 0;
+        pg.atlasW = pg.atlasH = 0;
+
+        if (!pg.shape.contours.empty()) {
+            pg.shape.normalize();
+            msdfgen::Shape::Bounds bounds = pg.shape.getBounds();
+            pg.boundsL = bounds.l;
+            pg.boundsB = bounds.b;
+            pg.boundsR = bounds.r;
+            pg.boundsT = bounds.t;
+            pg.bearingX = bounds.l * fontScale;
+            pg.bearingY = bounds.t * fontScale;
+            pg.sizeX = (bounds.r - bounds.l) * fontScale;
+            pg.sizeY = (bounds.t - bounds.b) * fontScale;
+            pg.atlasW = static_cast<int>(std::ceil(pg.sizeX)) + padding * 2;
+            pg.atlasH = static_cast<int>(std::ceil(pg.sizeY)) + padding * 2;
+        }
+        glyphs.push_back(std::move(pg));
+    }
+
+    if (glyphs.empty()) {
+        return 0;
+    }
+
+    // Pack tallest first, continuing the shelf where the last batch ended
+    std::sort(glyphs.begin(), glyphs.end(), [](const PackedGlyph& a, const PackedGlyph& b) {
+        return a.atlasH > b.atlasH;
+    });
+
+    std::vector<PackedGlyph*> toRender;
+    for (auto& glyph : glyphs) {
+        if (glyph.atlasW <= 0 || glyph.atlasH <= 0) continue;
+
+        int pw = glyph.atlasW + _atlasPadding;
+        int ph = glyph.atlasH + _atlasPadding;
+        if (_shelfX + pw > static_cast<int>(_atlasWidth)) {
+            _shelfX = _atlasPadding;
+            _shelfY += _shelfHeight + _atlasPadding;
+            _shelfHeight = 0;
+        }
+        if (_shelfY + ph > static_cast<int>(_atlasHeight)) {
+            ywarn("Font::addGlyphs: atlas full, dropping U+{:04X}", glyph.codepoint);
+            _failedCodepoints.insert(glyph.codepoint);
+            glyph.atlasW = -1;  // Not packed
+            continue;
+        }
+        glyph.atlasX = _shelfX;
+        glyph.atlasY = _shelfY;
+        _shelfX += pw;
+        _shelfHeight = std::max(_shelfHeight, ph);
+        toRender.push_back(&glyph);
+    }
+
+    // Generate MSDFs in parallel - every glyph writes its own atlas rectangle
+    auto renderGlyph = [this, padding](PackedGlyph& glyph) {
+        glyph.shape.normalize();
+        msdfgen::edgeColoringSimple(glyph.shape, 3.0);
+
+        double scale = glyph.fontScale;
+        msdfgen::Bitmap<float, 3> msdf(glyph.atlasW, glyph.atlasH);
+        msdfgen::Vector2 translate(padding - glyph.boundsL * scale, padding - glyph.boundsB * scale);
+        msdfgen::generateMSDF(msdf, glyph.shape, _pixelRange, scale, translate);
+
+        // Copy to atlas with Y-flip
+        for (int y = 0; y < glyph.atlasH; ++y) {
+            int atlasY = glyph.atlasY + (glyph.atlasH - 1 - y);
+            for (int x = 0; x < glyph.atlasW; ++x) {
+                size_t idx = (static_cast<size_t>(atlasY) * _atlasWidth + glyph.atlasX + x) * 4;
+                _atlasData[idx + 0] = static_cast<uint8_t>(std::clamp(msdf(x, y)[0] * 255.0f, 0.0f, 255.0f));
+                _atlasData[idx + 1] = static_cast<uint8_t>(std::clamp(msdf(x, y)[1] * 255.0f, 0.0f, 255.0f));
+                _atlasData[idx + 2] = static_cast<uint8_t>(std::clamp(msdf(x, y)[2] * 255.0f, 0.0f, 255.0f));
+                _atlasData[idx + 3] = 255;
+            }
+        }
+    };
+
+    constexpr size_t GLYPHS_PER_THREAD = 16;
+    size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                          (toRender.size() + GLYPHS_PER_THREAD - 1) / GLYPHS_PER_THREAD);
+    std::atomic<size_t> nextGlyph{0};
+    auto worker = [&] {
+        for (size_t i; (i = nextGlyph.fetch_add(1)) < toRender.size();) {
+            renderGlyph(*toRender[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Metrics; new glyphs are appended so existing indices stay valid
+    size_t added = 0;
+    for (const auto& glyph : glyphs) {
+        if (glyph.atlasW < 0) continue;
+
+        GlyphMetrics m;
+        if (glyph.atlasW > 0 && glyph.atlasH > 0) {
+            m._uvMin = glm::vec2(static_cast<float>(glyph.atlasX) / _atlasWidth,
+                                 static_cast<float>(glyph.atlasY) / _atlasHeight);
+            m._uvMax = glm::vec2(static_cast<float>(glyph.atlasX + glyph.atlasW) / _atlasWidth,
+                                 static_cast<float>(glyph.atlasY + glyph.atlasH) / _atlasHeight);
+            markDirtyRows(glyph.atlasY, glyph.atlasH);
+        } else {
+            m._uvMin = m._uvMax = glm::vec2(0);
+        }
+        m._size = glm::vec2(static_cast<float>(glyph.atlasW), static_cast<float>(glyph.atlasH));
+        m._bearing = glm::vec2(static_cast<float>(glyph.bearingX - padding),
+                               static_cast<float>(glyph.boundsT * glyph.fontScale + padding));
+        m._advance = static_cast<float>(glyph.advance);
+        _glyphs[glyph.codepoint] = m;
+
+        _codepointToIndex[glyph.codepoint] = static_cast<uint16_t>(_glyphMetadata.size());
+        GlyphMetadataGPU gpu;
+        gpu._uvMinX = m._uvMin.x;
+        gpu._uvMinY = m._uvMin.y;
+        gpu._uvMaxX = m._uvMax.x;
+        gpu._uvMaxY = m._uvMax.y;
+        gpu._sizeX = m._size.x;
+        gpu._sizeY = m._size.y;
+        gpu._bearingX = m._bearing.x;
+        gpu._bearingY = m._bearing.y;
+        gpu._advance = m._advance;
+        gpu._pad = 0.0f;
+        _glyphMetadata.push_back(gpu);
+
+        _pendingGlyphs.insert(glyph.codepoint);
+        added++;
+    }
+
+    ydebug("Font::addGlyphs: rasterized {} glyphs on {} threads", added, threadCount);
+    return added;
+}
+
+void Font::markDirtyRows(int y, int h) {
+    _dirtyMinY = std::min(_dirtyMinY, static_cast<uint32_t>(y));
+    _dirtyMaxY = std::max(_dirtyMaxY, std::min(static_cast<uint32_t>(y + h), _atlasHeight));
+}
+
 bool Font::saveAtlas(const std::string& atlasPath, const std::string& metricsPath) const {
     if (_atlasData.empty()) {
         std::cerr << "No atlas data to save" << std::endl;
@@ -1434,6 +1665,9 @@ bool Font::loadGlyphFromFont(const std::string& fontPath, uint32_t codepoint) {
     m._advance = static_cast<float>(advance * fontScale);
 
     _glyphs[codepoint] = m;
+    if (atlasW > 0 && atlasH > 0) {
+        markDirtyRows(atlasY, atlasH);
+    }
 
     // Add to index map and GPU metadata
     uint16_t index = static_cast<uint16_t>(_glyphMetadata.size());
@@ -1506,42 +1740,66 @@ bool Font::loadMissingGlyph(uint32_t codepoint) {
     return false;
 }
 
+static constexpr uint32_t MIN_GLYPH_METADATA_CAPACITY = 256;
+
 bool Font::uploadPendingGlyphs(WGPUDevice device, WGPUQueue queue) {
     if (_pendingGlyphs.empty()) {
         return true;
     }
 
-    // Re-upload entire atlas texture
-    // (A more efficient approach would be to only upload the changed regions)
+    // Upload only the band of rows the new glyphs were written to
     if (_texture) {
+        uint32_t firstRow = 0;
+        uint32_t rowCount = _atlasHeight;
+        if (_dirtyMaxY > _dirtyMinY) {
+            firstRow = _dirtyMinY;
+            rowCount = _dirtyMaxY - _dirtyMinY;
+        }
+        size_t rowBytes = static_cast<size_t>(_atlasWidth) * 4;
+
         WGPUTexelCopyTextureInfo dest = {};
         dest.texture = _texture;
         dest.mipLevel = 0;
-        dest.origin = {0, 0, 0};
+        dest.origin = {0, firstRow, 0};
         dest.aspect = WGPUTextureAspect_All;
 
         WGPUTexelCopyBufferLayout layout = {};
         layout.offset = 0;
         layout.bytesPerRow = _atlasWidth * 4;
-        layout.rowsPerImage = _atlasHeight;
-
-        WGPUExtent3D extent = {_atlasWidth, _atlasHeight, 1};
-        wgpuQueueWriteTexture(queue, &dest, _atlasData.data(), _atlasData.size(), &layout, &extent);
-    }
-
-    // Re-upload glyph metadata buffer
-    if (_glyphMetadataBuffer) {
-        // We need to recreate the buffer since it may have grown
-        wgpuBufferRelease(_glyphMetadataBuffer);
-        _glyphMetadataBuffer = nullptr;
-    }
-
-    if (!createGlyphMetadataBuffer(device)) {
-        std::cerr << "Failed to recreate glyph metadata buffer" << std::endl;
-        return false;
+        layout.rowsPerImage = rowCount;
+
+        WGPUExtent3D extent = {_atlasWidth, rowCount, 1};
+        wgpuQueueWriteTexture(queue, &dest, _atlasData.data() + firstRow * rowBytes,
+                              rowCount * rowBytes, &layout, &extent);
+    }
+    _dirtyMinY = UINT32_MAX;
+    _dirtyMaxY = 0;
+
+    // Glyph metadata is append-only: write the new entries in place and
+    // only recreate the buffer (and with it the bind groups) when it is
+    // full, growing geometrically
+    uint32_t count = static_cast<uint32_t>(_glyphMetadata.size());
+    if (!_glyphMetadataBuffer || count > _bufferGlyphCount) {
+        uint32_t capacity = std::max(_bufferGlyphCount, MIN_GLYPH_METADATA_CAPACITY);
+        while (capacity < count) capacity *= 2;
+
+        if (_glyphMetadataBuffer) {
+            wgpuBufferRelease(_glyphMetadataBuffer);
+            _glyphMetadataBuffer = nullptr;
+        }
+        if (!createGlyphMetadataBuffer(device, capacity)) {
+            yerror("Failed to grow glyph metadata buffer to {} glyphs", capacity);
+            return false;
+        }
+    } else if (count > _uploadedGlyphCount) {
+        wgpuQueueWriteBuffer(queue, _glyphMetadataBuffer,
+                             _uploadedGlyphCount * sizeof(GlyphMetadataGPU),
+                             _glyphMetadata.data() + _uploadedGlyphCount,
+                             (count - _uploadedGlyphCount) * sizeof(GlyphMetadataGPU));
+        _uploadedGlyphCount = count;
     }
 
-    std::cout << "Uploaded " << _pendingGlyphs.size() << " pending glyphs to GPU" << std::endl;
+    ydebug("Uploaded {} pending glyphs to GPU", _pendingGlyphs.size());
     _pendingGlyphs.clear();
 
     return true;
@@ -1853,6 +2111,7 @@ void Font::buildGlyphIndexMap() {
     _italicCodepointToIndex.clear();
     _boldItalicCodepointToIndex.clear();
     _glyphMetadata.clear();
+    _uploadedGlyphCount = 0;  // Rewrite the whole buffer on the next upload
 
     // Helper lambda to add glyphs from a map to the metadata array
     auto addGlyphsFromMap = [this](const std::unordered_map<uint32_t, GlyphMetrics>& glyphMap,
@@ -1995,13 +2254,16 @@ uint16_t Font::getGlyphIndex(uint32_t codepoint, bool bold, bool italic) {
     return getGlyphIndex(codepoint, style);
 }
 
-bool Font::createGlyphMetadataBuffer(WGPUDevice device) {
+bool Font::createGlyphMetadataBuffer(WGPUDevice device, uint32_t capacity) {
     if (_glyphMetadata.empty()) {
         std::cerr << "No glyph metadata to create buffer from" << std::endl;
         return false;
     }
 
-    size_t bufferSize = _glyphMetadata.size() * sizeof(GlyphMetadataGPU);
+    uint32_t count = static_cast<uint32_t>(_glyphMetadata.size());
+    uint32_t slots = std::max(count, capacity);
+    size_t dataSize = count * sizeof(GlyphMetadataGPU);
+    size_t bufferSize = slots * sizeof(GlyphMetadataGPU);
 
     WGPUBufferDescriptor bufDesc = {};
     bufDesc.label = WGPU_STR("glyph metadata");
@@ -2015,12 +2277,14 @@ bool Font::createGlyphMetadataBuffer(WGPUDevice device) {
         return false;
     }
 
+    // Slots past the glyph count stay zeroed until glyphs are appended
     void* mapped = wgpuBufferGetMappedRange(_glyphMetadataBuffer, 0, bufferSize);
-    memcpy(mapped, _glyphMetadata.data(), bufferSize);
+    memcpy(mapped, _glyphMetadata.data(), dataSize);
     wgpuBufferUnmap(_glyphMetadataBuffer);
     
-    // Track the glyph count this buffer was created with
-    _bufferGlyphCount = static_cast<uint32_t>(_glyphMetadata.size());
+    // Track the slots of this buffer and what is in it
+    _bufferGlyphCount = slots;
+    _uploadedGlyphCount = count;
     // Increment version so renderables know to recreate their bind groups
     _resourceVersion++;
 
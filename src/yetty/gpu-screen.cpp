@@ -42,7 +42,9 @@ GPUScreen::GPUScreen(int rows, int cols, Font* font, size_t maxScrollback)
     pen_.bg = defaultBg_;
 
     // Cache space glyph index to avoid repeated lookups in hot paths
+#ifndef YETTY_SERVER_BUILD
     cachedSpaceGlyph_ = font_ ? font_->getGlyphIndex(' ') : 0;
+#endif
 
     // Allocate buffers
     resize(rows, cols);
@@ -151,6 +153,9 @@ void GPUScreen::resize(int rows, int cols) {
         }
     }
     
+    // Markers that survived the copy are at new cell indices
+    rebuildMarkers();
+
     // Clamp cursor to new dimensions
     if (cursorRow_ >= rows) cursorRow_ = rows - 1;
     if (cursorCol_ >= cols) cursorCol_ = cols - 1;
@@ -364,6 +369,8 @@ void GPUScreen::pushLineToScrollback(int row) {
     }
 
     // Scan this row for widget markers - if found, track in scrolledOutWidgets_
+    // once the ones already there have moved up
+    std::vector<ScrolledOutWidget> scrolledOut;
     yinfo("GPUScreen::pushLineToScrollback: scanning row {} for markers", row);
     for (int col = 0; col < cols_; col++) {
         if (visibleGlyphs_[srcOffset + col] == GLYPH_PLUGIN) {
@@ -379,7 +386,7 @@ void GPUScreen::pushLineToScrollback(int row) {
                 yinfo("GPUScreen::pushLineToScrollback: VALID marker! widget {} at row={} col={} -> scrolledOutWidgets_ with y=-1",
                        widgetId, row, col);
                 // Add with Y = -1 (just scrolled out)
-                scrolledOutWidgets_.push_back({widgetId, -1, col});
+                scrolledOut.push_back({widgetId, -1, col});
             } else {
                 yinfo("GPUScreen::pushLineToScrollback: marker validation FAILED fg[2]={} fg[3]={} bg[0]={} bg[1]={}",
                       visibleFgColors_[colorIdx + 2], visibleFgColors_[colorIdx + 3],
@@ -434,6 +441,9 @@ void GPUScreen::pushLineToScrollback(int row) {
     if (!scrolledOutWidgets_.empty()) {
         yinfo("GPUScreen::pushLineToScrollback: decrementing Y for {} scrolled-out widgets", scrolledOutWidgets_.size());
     }
+    if (!scrolledOutWidgets_.empty()) {
+        markersChanged();
+    }
     auto it = scrolledOutWidgets_.begin();
     while (it != scrolledOutWidgets_.end()) {
         int oldY = it->y;
@@ -450,6 +460,10 @@ void GPUScreen::pushLineToScrollback(int row) {
             ++it;
         }
     }
+    if (!scrolledOut.empty()) {
+        scrolledOutWidgets_.insert(scrolledOutWidgets_.end(), scrolledOut.begin(), scrolledOut.end());
+        markersChanged();
+    }
 
     // Limit scrollback size
     while (scrollback_.size() > maxScrollback_) {
@@ -481,6 +495,11 @@ void GPUScreen::setCell(int row, int col, uint16_t glyph,
     // Bounds check on buffers
     if (idx >= visibleGlyphs_.size()) return;
 
+    // Overwriting a marker cell removes the marker
+    if (visibleGlyphs_[idx] == GLYPH_PLUGIN) {
+        forgetMarker(idx);
+    }
+
     visibleGlyphs_[idx] = glyph;
 
     size_t colorIdx = idx * 4;
@@ -548,9 +567,13 @@ int GPUScreen::onPutglyph(VTermGlyphInfo* info, VTermPos pos, void* user) {
     if (cp == 0) cp = ' ';
 
     // Get glyph index from font
+#ifndef YETTY_SERVER_BUILD
     uint16_t glyphIdx = self->font_
         ? self->font_->getGlyphIndex(cp, self->pen_.bold, self->pen_.italic)
         : static_cast<uint16_t>(cp);
+#else
+    uint16_t glyphIdx = static_cast<uint16_t>(cp);
+#endif
 
     // Get colors from current pen
     uint8_t fgR, fgG, fgB, bgR, bgG, bgB;
@@ -649,6 +672,10 @@ int GPUScreen::onMoveRect(VTermRect dest, VTermRect src, void* user) {
     if (src.start_col < 0 || src.end_col > cols) return 1;
     if (dest.start_col < 0 || dest.start_col + width > cols) return 1;
 
+    if (!self->markerCells_.empty()) {
+        self->moveMarkers(dest, src);
+    }
+
     // Ultra-fast path: full-width move starting at column 0
     // Memory is fully contiguous - single memmove for entire region
     if (src.start_col == 0 && dest.start_col == 0 && width == cols) {
@@ -939,6 +966,8 @@ void GPUScreen::setWidgetMarker(int row, int col, uint16_t widgetId) {
     visibleBgColors_[colorIdx + 2] = 0xAA;
     visibleBgColors_[colorIdx + 3] = 0xAA;
 
+    markerCells_[static_cast<uint32_t>(idx)] = widgetId;
+    markersChanged();
     hasDamage_ = true;
 }
 
@@ -959,29 +988,80 @@ void GPUScreen::trackScrolledOutWidget(uint16_t widgetId, int col) {
     // Start tracking with y = -1 (just above visible area)
     ydebug("GPUScreen::trackScrolledOutWidget: widget {} col={} y=-1", widgetId, col);
     scrolledOutWidgets_.push_back({widgetId, -1, col});
+    markersChanged();
 }
 
-std::vector<WidgetPosition> GPUScreen::scanWidgetPositions() const {
-    std::vector<WidgetPosition> positions;
+const std::unordered_map<uint16_t, WidgetPosition>& GPUScreen::widgetPositions() {
+    if (!widgetPositionsDirty_) return widgetPositions_;
 
-    // When scrolled back, scan the composed view buffer (includes scrollback content)
-    // Otherwise scan the visible buffer directly
-    const uint16_t* glyphs;
-    const uint8_t* fgColors;
-    const uint8_t* bgColors;
+    // Same precedence as applying scanWidgetPositions() in order: later
+    // visible cells win, scrolled-out widgets win over the visible screen
+    widgetPositions_.clear();
+    for (const auto& [idx, widgetId] : markerCells_) {
+        int row = static_cast<int>(idx) / cols_;
+        int col = static_cast<int>(idx) % cols_;
+        widgetPositions_[widgetId] = {widgetId, row, col};
+    }
+    for (const auto& sow : scrolledOutWidgets_) {
+        widgetPositions_[sow.widgetId] = {sow.widgetId, sow.y, sow.col};
+    }
+    widgetPositionsDirty_ = false;
+    return widgetPositions_;
+}
 
-    if (scrollOffset_ > 0) {
-        // Ensure view buffer is composed
-        const_cast<GPUScreen*>(this)->composeViewBuffer();
-        glyphs = viewGlyphs_.data();
-        fgColors = viewFgColors_.data();
-        bgColors = viewBgColors_.data();
-    } else {
-        glyphs = visibleGlyphs_.data();
-        fgColors = visibleFgColors_.data();
-        bgColors = visibleBgColors_.data();
+void GPUScreen::forgetMarker(size_t idx) {
+    if (markerCells_.erase(static_cast<uint32_t>(idx))) {
+        markersChanged();
     }
+}
 
+void GPUScreen::moveMarkers(const VTermRect& dest, const VTermRect& src) {
+    // Cells are copied, so markers in src stay and show up shifted in dest;
+    // whatever dest held before is overwritten
+    int dRow = dest.start_row - src.start_row;
+    int dCol = dest.start_col - src.start_col;
+    int height = src.end_row - src.start_row;
+    int width = src.end_col - src.start_col;
+    auto inside = [](int row, int col, int top, int left, int h, int w) {
+        return row >= top && row < top + h && col >= left && col < left + w;
+    };
+
+    std::vector<std::pair<uint32_t, uint16_t>> moved;
+    bool changed = false;
+    for (auto it = markerCells_.begin(); it != markerCells_.end();) {
+        int row = static_cast<int>(it->first) / cols_;
+        int col = static_cast<int>(it->first) % cols_;
+        if (inside(row, col, src.start_row, src.start_col, height, width)) {
+            moved.emplace_back(static_cast<uint32_t>(cellIndex(row + dRow, col + dCol)), it->second);
+        }
+        if (inside(row, col, dest.start_row, dest.start_col, height, width)) {
+            it = markerCells_.erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    for (const auto& [idx, widgetId] : moved) {
+        markerCells_[idx] = widgetId;
+    }
+    if (changed || !moved.empty()) {
+        markersChanged();
+    }
+}
+
+void GPUScreen::rebuildMarkers() {
+    markerCells_.clear();
+    std::vector<WidgetPosition> positions;
+    scanMarkers(visibleGlyphs_.data(), visibleFgColors_.data(), visibleBgColors_.data(), positions);
+    for (const auto& pos : positions) {
+        markerCells_[static_cast<uint32_t>(cellIndex(pos.row, pos.col))] = pos.widgetId;
+    }
+    markersChanged();
+}
+
+void GPUScreen::scanMarkers(const uint16_t* glyphs, const uint8_t* fgColors,
+                            const uint8_t* bgColors,
+                            std::vector<WidgetPosition>& positions) const {
     int numCells = rows_ * cols_;
 
     // Helper lambda to validate and extract widget marker
@@ -1029,6 +1109,21 @@ std::vector<WidgetPosition> GPUScreen::scanWidgetPositions() const {
             extractWidget(i);
         }
     }
+}
+
+std::vector<WidgetPosition> GPUScreen::scanWidgetPositions() const {
+    std::vector<WidgetPosition> positions;
+
+    // When scrolled back, scan the composed view buffer (includes scrollback content)
+    // Otherwise scan the visible buffer directly
+    if (scrollOffset_ > 0) {
+        // Ensure view buffer is composed
+        const_cast<GPUScreen*>(this)->composeViewBuffer();
+        scanMarkers(viewGlyphs_.data(), viewFgColors_.data(), viewBgColors_.data(), positions);
+    } else {
+        scanMarkers(visibleGlyphs_.data(), visibleFgColors_.data(), visibleBgColors_.data(),
+                    positions);
+    }
 
     // Include widgets from helper struct (markers scrolled into scrollback)
     if (!scrolledOutWidgets_.empty()) {
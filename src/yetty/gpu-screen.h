@@ -4,7 +4,9 @@
 #include <vector>
 #include <deque>
 #include <functional>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include "terminal-backend.h"  // For ScrollbackStyle, ScrollbackLine
 
 extern "C" {
@@ -119,6 +121,15 @@ public:
     // Scan for widget markers (SIMD optimized) - returns all found positions
     std::vector<WidgetPosition> scanWidgetPositions() const;
 
+    // Widget ID -> marker position, kept up to date by the State callbacks
+    // instead of scanning. Rows are live-screen rows, negative for markers
+    // scrolled into scrollback; a marker present twice (mid-moverect)
+    // reports its last cell in row-major order.
+    const std::unordered_map<uint16_t, WidgetPosition>& widgetPositions();
+
+    // Bumped whenever a marker is added, removed or moves
+    uint64_t widgetPositionsGeneration() const { return markerGeneration_; }
+
     // Track widget whose marker has scrolled into scrollback
     // Called by Terminal when widget Y goes from 0 to -1
     void trackScrolledOutWidget(uint16_t widgetId, int col);
@@ -187,6 +198,17 @@ private:
                visibleBgColors_[colorIdx + 1] == 0xAA;
     }
 
+    // Incremental marker tracking
+    void scanMarkers(const uint16_t* glyphs, const uint8_t* fgColors, const uint8_t* bgColors,
+                     std::vector<WidgetPosition>& positions) const;
+    void forgetMarker(size_t idx);
+    void moveMarkers(const VTermRect& dest, const VTermRect& src);
+    void rebuildMarkers();
+    void markersChanged() {
+        widgetPositionsDirty_ = true;
+        markerGeneration_++;
+    }
+
     // Scrollback helpers
     void pushLineToScrollback(int row);
     void composeViewBuffer();
@@ -254,6 +276,13 @@ private:
     // Track widgets whose markers have scrolled into scrollback
     std::vector<ScrolledOutWidget> scrolledOutWidgets_;
 
+    // Marker cells on the visible screen (cell index -> widget ID, ordered
+    // row-major) and the ID -> position map derived from them on demand
+    std::map<uint32_t, uint16_t> markerCells_;
+    std::unordered_map<uint16_t, WidgetPosition> widgetPositions_;
+    bool widgetPositionsDirty_ = true;
+    uint64_t markerGeneration_ = 0;
+
     // Pre-allocated scratch buffers for onMoveRect (avoid allocation per call)
     std::vector<uint16_t> scratchGlyphs_;
     std::vector<uint8_t> scratchFgColors_;
@@ -0,0 +1,130 @@
+#include <yetty/mip-chain.h>
+#include <algorithm>
+#include <cmath>
+
+namespace yetty {
+
+namespace {
+
+struct Tap {
+    uint32_t index;
+    float weight;
+};
+
+// For each of `dst` output pixels, the source pixels it covers and by how
+// much. Output pixel i spans [i * scale, (i + 1) * scale) in source space.
+struct Taps {
+    std::vector<uint32_t> begin;  // dst + 1 offsets into taps
+    std::vector<Tap> taps;
+    float scale = 1.0f;
+
+    Taps(uint32_t src, uint32_t dst) {
+        scale = static_cast<float>(src) / static_cast<float>(dst);
+        begin.reserve(dst + 1);
+        taps.reserve(static_cast<size_t>(std::ceil(scale) + 1) * dst);
+        for (uint32_t i = 0; i < dst; i++) {
+            begin.push_back(static_cast<uint32_t>(taps.size()));
+            double lo = static_cast<double>(i) * src / dst;
+            double hi = static_cast<double>(i + 1) * src / dst;
+            uint32_t first = static_cast<uint32_t>(lo);
+            uint32_t last = std::min(src - 1, static_cast<uint32_t>(std::ceil(hi)) - 1);
+            for (uint32_t s = first; s <= last; s++) {
+                double w = std::min<double>(hi, s + 1) - std::max<double>(lo, s);
+                if (w > 0.0) taps.push_back({s, static_cast<float>(w)});
+            }
+        }
+        begin.push_back(static_cast<uint32_t>(taps.size()));
+    }
+};
+
+// Horizontally filter one source row into premultiplied float RGBA
+void filterRow(const uint8_t* row, const Taps& h, std::vector<float>& out) {
+    uint32_t width = static_cast<uint32_t>(h.begin.size() - 1);
+    out.assign(static_cast<size_t>(width) * 4, 0.0f);
+    for (uint32_t x = 0; x < width; x++) {
+        float* o = &out[x * 4];
+        for (uint32_t t = h.begin[x]; t < h.begin[x + 1]; t++) {
+            const uint8_t* p = row + h.taps[t].index * 4;
+            float wa = h.taps[t].weight * p[3];
+            o[0] += wa * p[0];
+            o[1] += wa * p[1];
+            o[2] += wa * p[2];
+            o[3] += wa;
+        }
+    }
+}
+
+} // namespace
+
+MipLevel downsampleRGBA8(const uint8_t* src, uint32_t width, uint32_t height,
+                         uint32_t dstWidth, uint32_t dstHeight) {
+    MipLevel level;
+    if (!src || width == 0 || height == 0) return level;
+
+    dstWidth = std::clamp<uint32_t>(dstWidth, 1, width);
+    dstHeight = std::clamp<uint32_t>(dstHeight, 1, height);
+    level.width = dstWidth;
+    level.height = dstHeight;
+    level.pixels.resize(static_cast<size_t>(dstWidth) * dstHeight * 4);
+
+    if (dstWidth == width && dstHeight == height) {
+        std::copy(src, src + level.pixels.size(), level.pixels.begin());
+        return level;
+    }
+
+    Taps h(width, dstWidth);
+    Taps v(height, dstHeight);
+    float norm = 1.0f / (h.scale * v.scale);
+    size_t srcStride = static_cast<size_t>(width) * 4;
+
+    // One output row at a time; neighbouring output rows share at most one
+    // source row, so keep the last filtered one around
+    std::vector<float> acc(static_cast<size_t>(dstWidth) * 4);
+    std::vector<float> row;
+    uint32_t rowIndex = UINT32_MAX;
+
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (uint32_t t = v.begin[y]; t < v.begin[y + 1]; t++) {
+            const Tap& tap = v.taps[t];
+            if (tap.index != rowIndex) {
+                filterRow(src + tap.index * srcStride, h, row);
+                rowIndex = tap.index;
+            }
+            for (size_t i = 0; i < acc.size(); i++) acc[i] += tap.weight * row[i];
+        }
+
+        uint8_t* out = &level.pixels[static_cast<size_t>(y) * dstWidth * 4];
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            const float* a = &acc[x * 4];
+            float alpha = a[3] * norm;
+            // Un-premultiply: color sums were weighted by alpha
+            float inv = a[3] > 0.0f ? 1.0f / a[3] : 0.0f;
+            for (int c = 0; c < 3; c++) {
+                out[x * 4 + c] = static_cast<uint8_t>(std::clamp(a[c] * inv + 0.5f, 0.0f, 255.0f));
+            }
+            out[x * 4 + 3] = static_cast<uint8_t>(std::clamp(alpha + 0.5f, 0.0f, 255.0f));
+        }
+    }
+    return level;
+}
+
+std::vector<MipLevel> buildMipChainRGBA8(const uint8_t* src, uint32_t width, uint32_t height,
+                                         uint32_t maxWidth, uint32_t maxHeight) {
+    std::vector<MipLevel> chain;
+    if (!src || width == 0 || height == 0) return chain;
+
+    chain.push_back(downsampleRGBA8(src, width, height,
+                                    std::max<uint32_t>(maxWidth, 1),
+                                    std::max<uint32_t>(maxHeight, 1)));
+    while (chain.back().width > 1 || chain.back().height > 1) {
+        const MipLevel& prev = chain.back();
+        MipLevel next = downsampleRGBA8(prev.pixels.data(), prev.width, prev.height,
+                                        std::max<uint32_t>(prev.width / 2, 1),
+                                        std::max<uint32_t>(prev.height / 2, 1));
+        chain.push_back(std::move(next));
+    }
+    return chain;
+}
+
+} // namespace yetty
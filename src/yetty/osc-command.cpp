@@ -188,6 +188,14 @@ Result<OscCommand> OscCommandParser::parseGenericArgs(const std::vector<std::str
         }
         cmd.target = *result;
     }
+    else if (command == "append") {
+        cmd.type = OscCommandType::Append;
+        auto result = parseTargetArgs(tokens);
+        if (!result) {
+            return Err<OscCommand>("append: " + error_msg(result));
+        }
+        cmd.target = *result;
+    }
     else {
         return Err<OscCommand>("unknown command: " + command);
     }
@@ -225,7 +233,13 @@ Result<CreateArgs> OscCommandParser::parseCreateArgs(const std::vector<std::stri
             args.relative = true;
         }
         else {
-            return Err<CreateArgs>("unknown option: " + token);
+            auto shmRes = parseShmOption(tokens, i, args.shm);
+            if (!shmRes) {
+                return Err<CreateArgs>(error_msg(shmRes));
+            }
+            if (!*shmRes) {
+                return Err<CreateArgs>("unknown option: " + token);
+            }
         }
     }
 
@@ -233,6 +247,10 @@ Result<CreateArgs> OscCommandParser::parseCreateArgs(const std::vector<std::stri
         return Err<CreateArgs>("--plugin/-p is required");
     }
 
+    if (auto res = validateShmRef(args.shm); !res) {
+        return Err<CreateArgs>(error_msg(res));
+    }
+
     return Ok(args);
 }
 
@@ -268,7 +286,13 @@ Result<TargetArgs> OscCommandParser::parseTargetArgs(const std::vector<std::stri
             args.plugin = tokens[i];
         }
         else {
-            return Err<TargetArgs>("unknown option: " + token);
+            auto shmRes = parseShmOption(tokens, i, args.shm);
+            if (!shmRes) {
+                return Err<TargetArgs>(error_msg(shmRes));
+            }
+            if (!*shmRes) {
+                return Err<TargetArgs>("unknown option: " + token);
+            }
         }
     }
 
@@ -276,9 +300,69 @@ Result<TargetArgs> OscCommandParser::parseTargetArgs(const std::vector<std::stri
         return Err<TargetArgs>("--id or --plugin is required");
     }
 
+    if (auto res = validateShmRef(args.shm); !res) {
+        return Err<TargetArgs>(error_msg(res));
+    }
+
     return Ok(args);
 }
 
+Result<bool> OscCommandParser::parseShmOption(const std::vector<std::string>& tokens,
+                                              size_t& i, ShmPayloadRef& shm) {
+    const auto& token = tokens[i];
+
+    if (token != "--shm" && token != "--memfd" &&
+        token != "--shm-size" && token != "--shm-crc") {
+        return Ok(false);
+    }
+    if (++i >= tokens.size()) return Err<bool>("missing value for " + token);
+    const auto& value = tokens[i];
+
+    try {
+        if (token == "--shm") {
+            shm.token = value;
+        }
+        else if (token == "--memfd") {
+            // PID:FD of the client process holding the memfd open
+            size_t colon = value.find(':');
+            if (colon == std::string::npos) return Err<bool>("--memfd expects PID:FD");
+            shm.pid = std::stoi(value.substr(0, colon));
+            shm.fd = std::stoi(value.substr(colon + 1));
+        }
+        else if (token == "--shm-size") {
+            shm.size = std::stoull(value);
+        }
+        else {
+            shm.crc = static_cast<uint32_t>(std::stoul(value, nullptr, 16));
+            shm.hasCrc = true;
+        }
+    } catch (...) {
+        return Err<bool>("invalid value for " + token + ": " + value);
+    }
+
+    return Ok(true);
+}
+
+Result<void> OscCommandParser::validateShmRef(const ShmPayloadRef& shm) {
+    bool any = !shm.token.empty() || shm.size != 0 || shm.hasCrc || shm.fd >= 0;
+    if (!any) {
+        return Ok();
+    }
+    if (!ShmPayload::isValidToken(shm.token)) {
+        return Err<void>("--shm: missing or invalid token");
+    }
+    if (shm.size == 0) {
+        return Err<void>("--shm-size is required with --shm");
+    }
+    if (!shm.hasCrc) {
+        return Err<void>("--shm-crc is required with --shm");
+    }
+    if (shm.fd >= 0 && shm.pid <= 0) {
+        return Err<void>("--memfd: invalid PID");
+    }
+    return Ok();
+}
+
 //-----------------------------------------------------------------------------
 // Base94 encoding/decoding
 //-----------------------------------------------------------------------------
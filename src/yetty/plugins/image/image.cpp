@@ -10,6 +10,68 @@
 
 namespace yetty {
 
+//-----------------------------------------------------------------------------
+// ImageTexture
+//-----------------------------------------------------------------------------
+
+Result<ImageTexture::Ptr> ImageTexture::create(WebGPUContext& ctx,
+                                               const std::vector<MipLevel>& levels) noexcept {
+    auto t = Ptr(new ImageTexture());
+    if (auto res = t->init(ctx, levels); !res) {
+        return Err<Ptr>("Failed to create ImageTexture", res);
+    }
+    return Ok(t);
+}
+
+ImageTexture::~ImageTexture() {
+    if (view_) wgpuTextureViewRelease(view_);
+    if (texture_) wgpuTextureRelease(texture_);
+}
+
+Result<void> ImageTexture::init(WebGPUContext& ctx, const std::vector<MipLevel>& levels) {
+    if (levels.empty()) return Err<void>("ImageTexture: no mip levels");
+
+    width_ = levels[0].width;
+    height_ = levels[0].height;
+
+    WGPUTextureDescriptor texDesc = {};
+    texDesc.size.width = width_;
+    texDesc.size.height = height_;
+    texDesc.size.depthOrArrayLayers = 1;
+    texDesc.mipLevelCount = static_cast<uint32_t>(levels.size());
+    texDesc.sampleCount = 1;
+    texDesc.dimension = WGPUTextureDimension_2D;
+    texDesc.format = WGPUTextureFormat_RGBA8Unorm;
+    texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
+
+    texture_ = wgpuDeviceCreateTexture(ctx.getDevice(), &texDesc);
+    if (!texture_) return Err<void>("Failed to create texture");
+
+    for (uint32_t i = 0; i < levels.size(); i++) {
+        const MipLevel& level = levels[i];
+        WGPUTexelCopyTextureInfo dst = {};
+        dst.texture = texture_;
+        dst.mipLevel = i;
+        WGPUTexelCopyBufferLayout layout = {};
+        layout.bytesPerRow = level.width * 4;
+        layout.rowsPerImage = level.height;
+        WGPUExtent3D extent = {level.width, level.height, 1};
+        wgpuQueueWriteTexture(ctx.getQueue(), &dst, level.pixels.data(),
+                              level.pixels.size(), &layout, &extent);
+        bytes_ += level.pixels.size();
+    }
+
+    WGPUTextureViewDescriptor viewDesc = {};
+    viewDesc.format = WGPUTextureFormat_RGBA8Unorm;
+    viewDesc.dimension = WGPUTextureViewDimension_2D;
+    viewDesc.mipLevelCount = texDesc.mipLevelCount;
+    viewDesc.arrayLayerCount = 1;
+    view_ = wgpuTextureCreateView(texture_, &viewDesc);
+    if (!view_) return Err<void>("Failed to create texture view");
+
+    return Ok();
+}
+
 //-----------------------------------------------------------------------------
 // ImagePlugin
 //-----------------------------------------------------------------------------
@@ -25,6 +87,10 @@ Result<PluginPtr> ImagePlugin::create() noexcept {
 }
 
 Result<void> ImagePlugin::pluginInit() noexcept {
+    // Only the cache holds an unreferenced texture
+    textures_.setPinned([](const TextureKey&, const CachedTexture& entry) {
+        return entry.texture.use_count() > 1;
+    });
     _initialized = true;
     return Ok();
 }
@@ -33,6 +99,8 @@ Result<void> ImagePlugin::dispose() {
     if (auto res = Plugin::dispose(); !res) {
         return Err<void>("Failed to dispose ImagePlugin", res);
     }
+    textures_.clear();
+    placeholder_.reset();
     _initialized = false;
     return Ok();
 }
@@ -52,7 +120,40 @@ Result<WidgetPtr> ImagePlugin::createWidget(
     (void)widgetName;
     yfunc();
     yinfo("payload size={} x={} y={} w={} h={}", payload.size(), x, y, widthCells, heightCells);
-    return Image::create(factory, fontManager, loop, x, y, widthCells, heightCells, pluginArgs, payload);
+    return Image::create(factory, fontManager, loop, x, y, widthCells, heightCells, pluginArgs, payload, this);
+}
+
+ImagePlugin::TextureKey ImagePlugin::textureKey(size_t payloadHash, size_t payloadSize,
+                                                uint32_t width, uint32_t height) {
+    return TextureKey{payloadHash, payloadSize, width, height};
+}
+
+ImageTexture::Ptr ImagePlugin::findTexture(const TextureKey& key, std::string_view payload) {
+    auto* hit = textures_.get(key);
+    if (!hit || hit->payload != payload) return nullptr;
+    return hit->texture;
+}
+
+void ImagePlugin::addTexture(const TextureKey& key, std::string_view payload,
+                             ImageTexture::Ptr texture) {
+    size_t cost = sizeof(CachedTexture) + payload.size() + texture->bytes();
+    textures_.put(key, CachedTexture{std::string(payload), std::move(texture)}, cost);
+}
+
+void ImagePlugin::trimTextures() {
+    textures_.trim();
+}
+
+ImageTexture::Ptr ImagePlugin::placeholderTexture(WebGPUContext& ctx) {
+    if (!placeholder_) {
+        auto result = ImageTexture::create(ctx, {MipLevel{1, 1, {48, 48, 48, 160}}});
+        if (!result) {
+            ywarn("ImagePlugin: {}", result.error().message());
+            return nullptr;
+        }
+        placeholder_ = *result;
+    }
+    return placeholder_;
 }
 
 //-----------------------------------------------------------------------------
@@ -62,64 +163,228 @@ Result<WidgetPtr> ImagePlugin::createWidget(
 Image::~Image() { (void)dispose(); }
 
 Result<void> Image::init() {
-    if (_payload.empty()) {
+    std::string_view payload = payloadView();
+    if (payload.empty()) {
         return Err<void>("Image: empty payload");
     }
 
     (void)dispose();
 
-    auto result = loadImage(_payload);
-    if (!result) {
-        return result;
+    // Only the header: enough for the cache key, decoding waits for a miss
+    int channels = 0;
+    if (!stbi_info_from_memory(reinterpret_cast<const unsigned char*>(payload.data()),
+                               static_cast<int>(payload.size()),
+                               &imageWidth_, &imageHeight_, &channels) ||
+        imageWidth_ <= 0 || imageHeight_ <= 0) {
+        return Err<void>(std::string("Failed to load image: ") + stbi_failure_reason());
     }
+    payloadHash_ = std::hash<std::string_view>()(payload);
 
-    yinfo("Image: loaded {}x{} ({} channels)", imageWidth_, imageHeight_, imageChannels_);
+    yinfo("Image: {}x{} ({} channels)", imageWidth_, imageHeight_, channels);
     return Ok();
 }
 
-Result<void> Image::loadImage(const std::string& data) {
+Result<void> Image::loadImage(std::string_view data) {
     if (imageData_) {
         stbi_image_free(imageData_);
         imageData_ = nullptr;
     }
 
+    int width = 0, height = 0, channels = 0;
     imageData_ = stbi_load_from_memory(
         reinterpret_cast<const unsigned char*>(data.data()),
         static_cast<int>(data.size()),
-        &imageWidth_, &imageHeight_, &imageChannels_, 4);
+        &width, &height, &channels, 4);
 
     if (!imageData_) {
         return Err<void>(std::string("Failed to load image: ") + stbi_failure_reason());
     }
-
-    imageChannels_ = 4;
+    if (width != imageWidth_ || height != imageHeight_) {
+        stbi_image_free(imageData_);
+        imageData_ = nullptr;
+        return Err<void>("Image: decoded size does not match the header");
+    }
     return Ok();
 }
 
 Result<void> Image::dispose() {
-    if (bindGroup_) { wgpuBindGroupRelease(bindGroup_); bindGroup_ = nullptr; }
-    if (pipeline_) { wgpuRenderPipelineRelease(pipeline_); pipeline_ = nullptr; }
-    if (uniformBuffer_) { wgpuBufferRelease(uniformBuffer_); uniformBuffer_ = nullptr; }
-    if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
-    if (textureView_) { wgpuTextureViewRelease(textureView_); textureView_ = nullptr; }
-    if (texture_) { wgpuTextureRelease(texture_); texture_ = nullptr; }
+    // The worker reads the payload and imageData_
+    stopWorker();
+    releaseGPUResources();
     if (imageData_) { stbi_image_free(imageData_); imageData_ = nullptr; }
-    gpuInitialized_ = false;
+    decoded_ = false;
+    decodeError_.clear();
+    requestPending_ = false;
+    readyMips_.clear();
+    mipsReady_ = false;
     return Ok();
 }
 
+void Image::releaseTexture() {
+    wantKey_ = {};
+    wantWidth_ = 0;
+    wantHeight_ = 0;
+    boundTexture_ = nullptr;
+    if (texture_) {
+        texture_.reset();
+        // Ours may now be unreferenced and over the budget
+        if (plugin_) plugin_->trimTextures();
+    }
+}
+
 void Image::releaseGPUResources() {
-    // Release GPU resources but keep imageData_ for restoration
+    // Release GPU resources; the texture stays in the plugin cache for a while
+    releaseTexture();
     if (bindGroup_) { wgpuBindGroupRelease(bindGroup_); bindGroup_ = nullptr; }
+    if (bindGroupLayout_) { wgpuBindGroupLayoutRelease(bindGroupLayout_); bindGroupLayout_ = nullptr; }
     if (pipeline_) { wgpuRenderPipelineRelease(pipeline_); pipeline_ = nullptr; }
     if (uniformBuffer_) { wgpuBufferRelease(uniformBuffer_); uniformBuffer_ = nullptr; }
     if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
-    if (textureView_) { wgpuTextureViewRelease(textureView_); textureView_ = nullptr; }
-    if (texture_) { wgpuTextureRelease(texture_); texture_ = nullptr; }
+    if (gpuInitialized_) yinfo("Image: GPU resources released");
     gpuInitialized_ = false;
-    yinfo("Image: GPU resources released");
+    lastRect_[0] = lastRect_[1] = lastRect_[2] = lastRect_[3] = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Decode and mip generation (worker thread)
+//-----------------------------------------------------------------------------
+
+void Image::startWorker() {
+    workerStop_ = false;
+    worker_ = std::thread([this] { workerLoop(); });
+}
+
+void Image::stopWorker() {
+    if (!worker_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex_);
+        workerStop_ = true;
+    }
+    workerCv_.notify_one();
+    worker_.join();
 }
 
+void Image::workerLoop() {
+    auto res = loadImage(payloadView());
+    {
+        std::lock_guard<std::mutex> lock(workerMutex_);
+        if (!res) {
+            decodeError_ = error_msg(res);
+            return;
+        }
+        decoded_ = true;
+    }
+    ydebug("Image: decoded {}x{}", imageWidth_, imageHeight_);
+
+    std::unique_lock<std::mutex> lock(workerMutex_);
+    while (true) {
+        workerCv_.wait(lock, [this] { return workerStop_ || requestPending_; });
+        if (workerStop_) break;
+
+        uint32_t maxWidth = requestWidth_;
+        uint32_t maxHeight = requestHeight_;
+        requestPending_ = false;
+        lock.unlock();
+
+        auto chain = buildMipChainRGBA8(imageData_, imageWidth_, imageHeight_, maxWidth, maxHeight);
+        ydebug("Image: built {} mip levels, base {}x{}", chain.size(),
+               chain.empty() ? 0 : chain[0].width, chain.empty() ? 0 : chain[0].height);
+
+        lock.lock();
+        readyMips_ = std::move(chain);
+        mipsReady_ = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Texture selection (render thread)
+//-----------------------------------------------------------------------------
+
+Result<void> Image::updateTexture(WebGPUContext& ctx) {
+    // Grow only: a smaller display samples the lower mips instead
+    if (_pixelWidth > 0 && _pixelHeight > 0) {
+        uint32_t width = std::min<uint32_t>(imageWidth_, _pixelWidth * MAX_OVERSAMPLE);
+        uint32_t height = std::min<uint32_t>(imageHeight_, _pixelHeight * MAX_OVERSAMPLE);
+        if (width > wantWidth_ || height > wantHeight_) {
+            wantWidth_ = std::max(width, wantWidth_);
+            wantHeight_ = std::max(height, wantHeight_);
+            wantKey_ = ImagePlugin::textureKey(payloadHash_, payloadView().size(), wantWidth_, wantHeight_);
+
+            if (auto cached = plugin_->findTexture(wantKey_, payloadView())) {
+                // Shown elsewhere already: no decode, no upload
+                ydebug("Image: texture cache hit {}x{}", wantWidth_, wantHeight_);
+                texture_ = std::move(cached);
+                plugin_->trimTextures();
+            } else {
+                if (!worker_.joinable()) startWorker();
+                std::lock_guard<std::mutex> lock(workerMutex_);
+                requestWidth_ = wantWidth_;
+                requestHeight_ = wantHeight_;
+                requestPending_ = true;
+                workerCv_.notify_one();
+            }
+        }
+    }
+
+    std::vector<MipLevel> mips;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex_);
+        if (!decodeError_.empty()) {
+            std::string msg = std::move(decodeError_);
+            decodeError_.clear();
+            return Err<void>(msg);
+        }
+        if (mipsReady_) {
+            mips = std::move(readyMips_);
+            readyMips_.clear();
+            mipsReady_ = false;
+        }
+    }
+
+    // Results for an outgrown size are dropped, a newer request is queued
+    if (!mips.empty() && mips[0].width == std::min<uint32_t>(imageWidth_, wantWidth_) &&
+        mips[0].height == std::min<uint32_t>(imageHeight_, wantHeight_)) {
+        // Another widget may have uploaded the same key meanwhile
+        ImageTexture::Ptr texture = plugin_->findTexture(wantKey_, payloadView());
+        if (!texture) {
+            auto result = ImageTexture::create(ctx, mips);
+            if (!result) return Err<void>("Image: failed to upload texture", result);
+            texture = *result;
+            plugin_->addTexture(wantKey_, payloadView(), texture);
+        }
+        texture_ = std::move(texture);
+        plugin_->trimTextures();
+    }
+
+    ImageTexture::Ptr show = texture_ ? texture_ : plugin_->placeholderTexture(ctx);
+    if (!show) return Err<void>("Image: no texture");
+    if (show.get() != boundTexture_) {
+        return bindTexture(ctx, show);
+    }
+    return Ok();
+}
+
+Result<void> Image::bindTexture(WebGPUContext& ctx, const ImageTexture::Ptr& texture) {
+    if (bindGroup_) { wgpuBindGroupRelease(bindGroup_); bindGroup_ = nullptr; }
+    boundTexture_ = nullptr;
+
+    WGPUBindGroupEntry bgE[3] = {};
+    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = 16;
+    bgE[1].binding = 1; bgE[1].sampler = sampler_;
+    bgE[2].binding = 2; bgE[2].textureView = texture->view();
+    WGPUBindGroupDescriptor bgDesc = {};
+    bgDesc.layout = bindGroupLayout_; bgDesc.entryCount = 3; bgDesc.entries = bgE;
+    bindGroup_ = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
+    if (!bindGroup_) return Err<void>("Failed to create bind group");
+
+    boundTexture_ = texture.get();
+    return Ok();
+}
+
+//-----------------------------------------------------------------------------
+// Rendering
+//-----------------------------------------------------------------------------
+
 Result<void> Image::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) {
     // Handle on/off transitions for GPU resource management
     if (!on && wasOn_) {
@@ -135,7 +400,7 @@ Result<void> Image::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool
         gpuInitialized_ = false;
     }
 
-    if (!on || failed_ || !_visible || !imageData_) return Ok();
+    if (!on || failed_ || !_visible || !plugin_) return Ok();
 
     if (!gpuInitialized_) {
         if (auto res = createPipeline(ctx, ctx.getSurfaceFormat()); !res) {
@@ -145,6 +410,11 @@ Result<void> Image::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool
         gpuInitialized_ = true;
     }
 
+    if (auto res = updateTexture(ctx); !res) {
+        failed_ = true;
+        return res;
+    }
+
     if (!pipeline_ || !uniformBuffer_ || !bindGroup_) {
         failed_ = true;
         return Err<void>("Image: pipeline resources not initialized");
@@ -180,39 +450,12 @@ Result<void> Image::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool
 Result<void> Image::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat) {
     WGPUDevice device = ctx.getDevice();
 
-    WGPUTextureDescriptor texDesc = {};
-    texDesc.size.width = imageWidth_;
-    texDesc.size.height = imageHeight_;
-    texDesc.size.depthOrArrayLayers = 1;
-    texDesc.mipLevelCount = 1;
-    texDesc.sampleCount = 1;
-    texDesc.dimension = WGPUTextureDimension_2D;
-    texDesc.format = WGPUTextureFormat_RGBA8Unorm;
-    texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
-
-    texture_ = wgpuDeviceCreateTexture(device, &texDesc);
-    if (!texture_) return Err<void>("Failed to create texture");
-
-    WGPUTexelCopyTextureInfo dst = {};
-    dst.texture = texture_;
-    WGPUTexelCopyBufferLayout layout = {};
-    layout.bytesPerRow = imageWidth_ * 4;
-    layout.rowsPerImage = imageHeight_;
-    WGPUExtent3D extent = {(uint32_t)imageWidth_, (uint32_t)imageHeight_, 1};
-    wgpuQueueWriteTexture(ctx.getQueue(), &dst, imageData_,
-                          imageWidth_ * imageHeight_ * 4, &layout, &extent);
-
-    WGPUTextureViewDescriptor viewDesc = {};
-    viewDesc.format = WGPUTextureFormat_RGBA8Unorm;
-    viewDesc.dimension = WGPUTextureViewDimension_2D;
-    viewDesc.mipLevelCount = 1;
-    viewDesc.arrayLayerCount = 1;
-    textureView_ = wgpuTextureCreateView(texture_, &viewDesc);
-    if (!textureView_) return Err<void>("Failed to create texture view");
-
     WGPUSamplerDescriptor samplerDesc = {};
     samplerDesc.minFilter = WGPUFilterMode_Linear;
     samplerDesc.magFilter = WGPUFilterMode_Linear;
+    samplerDesc.mipmapFilter = WGPU_MIPMAP_FILTER_LINEAR;
+    samplerDesc.lodMinClamp = 0.0f;
+    samplerDesc.lodMaxClamp = 32.0f;
     samplerDesc.addressModeU = WGPUAddressMode_ClampToEdge;
     samplerDesc.addressModeV = WGPUAddressMode_ClampToEdge;
     samplerDesc.addressModeW = WGPUAddressMode_ClampToEdge;
@@ -250,7 +493,7 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
     wgslDesc.code = WGPU_STR(shaderCode);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
     WGPUBindGroupLayoutEntry entries[3] = {};
@@ -264,20 +507,12 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
 
     WGPUBindGroupLayoutDescriptor bglDesc = {};
     bglDesc.entryCount = 3; bglDesc.entries = entries;
-    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
-    if (!bgl) { wgpuShaderModuleRelease(shaderModule); return Err<void>("Failed to create bgl"); }
+    bindGroupLayout_ = ctx.shaderCache().createBindGroupLayout(&bglDesc);
+    if (!bindGroupLayout_) { wgpuShaderModuleRelease(shaderModule); return Err<void>("Failed to create bgl"); }
 
     WGPUPipelineLayoutDescriptor plDesc = {};
-    plDesc.bindGroupLayoutCount = 1; plDesc.bindGroupLayouts = &bgl;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
-
-    WGPUBindGroupEntry bgE[3] = {};
-    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = 16;
-    bgE[1].binding = 1; bgE[1].sampler = sampler_;
-    bgE[2].binding = 2; bgE[2].textureView = textureView_;
-    WGPUBindGroupDescriptor bgDesc = {};
-    bgDesc.layout = bgl; bgDesc.entryCount = 3; bgDesc.entries = bgE;
-    bindGroup_ = wgpuDeviceCreateBindGroup(device, &bgDesc);
+    plDesc.bindGroupLayoutCount = 1; plDesc.bindGroupLayouts = &bindGroupLayout_;
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
 
     WGPURenderPipelineDescriptor pipelineDesc = {};
     pipelineDesc.layout = pipelineLayout;
@@ -300,10 +535,9 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
     pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
     pipelineDesc.multisample.count = 1; pipelineDesc.multisample.mask = ~0u;
 
-    pipeline_ = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    pipeline_ = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(shaderModule);
-    wgpuBindGroupLayoutRelease(bgl);
     wgpuPipelineLayoutRelease(pipelineLayout);
 
     if (!pipeline_) return Err<void>("Failed to create render pipeline");
@@ -1,12 +1,52 @@
 #pragma once
 
 #include <yetty/plugin.h>
+#include <yetty/lru-cache.h>
+#include <yetty/mip-chain.h>
 #include <webgpu/webgpu.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace yetty {
 
 class Image;
 
+//-----------------------------------------------------------------------------
+// ImageTexture - an uploaded mip chain. Shared by every Image widget that
+// shows the same payload at the same base size.
+//-----------------------------------------------------------------------------
+class ImageTexture {
+public:
+    using Ptr = std::shared_ptr<ImageTexture>;
+
+    static Result<Ptr> create(WebGPUContext& ctx, const std::vector<MipLevel>& levels) noexcept;
+
+    ~ImageTexture();
+
+    ImageTexture(const ImageTexture&) = delete;
+    ImageTexture& operator=(const ImageTexture&) = delete;
+
+    WGPUTextureView view() const { return view_; }
+    uint32_t width() const { return width_; }
+    uint32_t height() const { return height_; }
+    size_t bytes() const { return bytes_; }
+
+private:
+    ImageTexture() = default;
+    Result<void> init(WebGPUContext& ctx, const std::vector<MipLevel>& levels);
+
+    WGPUTexture texture_ = nullptr;
+    WGPUTextureView view_ = nullptr;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    size_t bytes_ = 0;
+};
+
 //-----------------------------------------------------------------------------
 // ImagePlugin
 //-----------------------------------------------------------------------------
@@ -33,9 +73,44 @@ public:
         const std::string& payload
     ) override;
 
+    // Texture cache keyed by payload content and base level size. Entries
+    // keep the payload and a hit must match it, so a hash collision is a
+    // miss. Textures a widget still shows are pinned; the rest are evicted
+    // least recently used first once the cache holds more than
+    // TEXTURE_CACHE_BUDGET bytes.
+    struct TextureKey {
+        size_t payloadHash = 0;
+        size_t payloadSize = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool operator==(const TextureKey&) const = default;
+    };
+    static TextureKey textureKey(size_t payloadHash, size_t payloadSize,
+                                 uint32_t width, uint32_t height);
+    ImageTexture::Ptr findTexture(const TextureKey& key, std::string_view payload);
+    void addTexture(const TextureKey& key, std::string_view payload, ImageTexture::Ptr texture);
+    void trimTextures();
+
+    // Drawn until a widget's own texture is ready
+    ImageTexture::Ptr placeholderTexture(WebGPUContext& ctx);
+
+    static constexpr size_t TEXTURE_CACHE_BUDGET = 64 * 1024 * 1024;
+
 private:
-    ImagePlugin() noexcept = default;
+    ImagePlugin() noexcept : textures_(TEXTURE_CACHE_BUDGET) {}
     Result<void> pluginInit() noexcept;
+
+    struct TextureKeyHash {
+        size_t operator()(const TextureKey& k) const {
+            return k.payloadHash ^ (k.payloadSize * 31) ^ (size_t(k.width) << 20) ^ k.height;
+        }
+    };
+    struct CachedTexture {
+        std::string payload;
+        ImageTexture::Ptr texture;
+    };
+    LruCache<TextureKey, CachedTexture, TextureKeyHash> textures_;
+    ImageTexture::Ptr placeholder_;
 };
 
 //-----------------------------------------------------------------------------
@@ -43,8 +118,14 @@ private:
 //
 // Two-phase construction:
 //   1. Constructor (private) - stores payload
-//   2. init() (private) - no args, loads image
+//   2. init() (private) - no args, reads the image header
 //   3. create() (public) - factory
+//
+// The texture comes from the plugin's cache when another widget already
+// shows the same payload at the same size. Otherwise a worker thread
+// decodes the payload and box filters a mip chain whose base is at most
+// MAX_OVERSAMPLE times the displayed size; a placeholder is drawn until it
+// is uploaded. The chain is rebuilt only when the widget grows past it.
 //-----------------------------------------------------------------------------
 class Image : public Widget {
 public:
@@ -57,13 +138,15 @@ public:
         uint32_t widthCells,
         uint32_t heightCells,
         const std::string& pluginArgs,
-        const std::string& payload
+        const std::string& payload,
+        ImagePlugin* plugin
     ) {
         (void)factory;
         (void)fontManager;
         (void)loop;
         (void)pluginArgs;
         auto w = std::shared_ptr<Image>(new Image(payload));
+        w->plugin_ = plugin;
         w->_x = x;
         w->_y = y;
         w->_widthCells = widthCells;
@@ -85,21 +168,56 @@ private:
         _payload = payload;
     }
 
+    // Base level resolution relative to the displayed size
+    static constexpr uint32_t MAX_OVERSAMPLE = 2;
+
     Result<void> init() override;
 
-    Result<void> loadImage(const std::string& data);
+    Result<void> loadImage(std::string_view data);
     Result<void> createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat);
+    Result<void> updateTexture(WebGPUContext& ctx);
+    Result<void> bindTexture(WebGPUContext& ctx, const ImageTexture::Ptr& texture);
+    void releaseTexture();
 
-    unsigned char* imageData_ = nullptr;
+    // Worker thread
+    void startWorker();
+    void stopWorker();
+    void workerLoop();
+
+    ImagePlugin* plugin_ = nullptr;
+
+    // From the image header, read in init()
     int imageWidth_ = 0;
     int imageHeight_ = 0;
-    int imageChannels_ = 0;
+    size_t payloadHash_ = 0;
+
+    // Written by the worker before decoded_ is set, read-only afterwards
+    unsigned char* imageData_ = nullptr;
+
+    // Shared with the worker, guarded by workerMutex_
+    std::thread worker_;
+    std::mutex workerMutex_;
+    std::condition_variable workerCv_;
+    bool workerStop_ = false;
+    bool decoded_ = false;
+    std::string decodeError_;
+    uint32_t requestWidth_ = 0;
+    uint32_t requestHeight_ = 0;
+    bool requestPending_ = false;
+    std::vector<MipLevel> readyMips_;
+    bool mipsReady_ = false;
+
+    // Render thread
+    ImageTexture::Ptr texture_;          // Our texture, shared through the cache
+    ImageTexture* boundTexture_ = nullptr; // What bindGroup_ samples
+    ImagePlugin::TextureKey wantKey_;    // Cache key of the size we are waiting for
+    uint32_t wantWidth_ = 0;
+    uint32_t wantHeight_ = 0;
 
     WGPURenderPipeline pipeline_ = nullptr;
+    WGPUBindGroupLayout bindGroupLayout_ = nullptr;
     WGPUBindGroup bindGroup_ = nullptr;
     WGPUBuffer uniformBuffer_ = nullptr;
-    WGPUTexture texture_ = nullptr;
-    WGPUTextureView textureView_ = nullptr;
     WGPUSampler sampler_ = nullptr;
 
     bool gpuInitialized_ = false;
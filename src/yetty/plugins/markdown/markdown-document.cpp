@@ -0,0 +1,417 @@
+#include "markdown-document.h"
+#include <algorithm>
+#include <cmath>
+
+namespace yetty::plugins {
+
+namespace {
+
+uint32_t decodeUTF8(const uint8_t*& ptr, const uint8_t* end) {
+    if (ptr >= end) return 0;
+
+    uint32_t codepoint = 0;
+    if ((*ptr & 0x80) == 0) {
+        codepoint = *ptr++;
+    } else if ((*ptr & 0xE0) == 0xC0) {
+        codepoint = (*ptr++ & 0x1F) << 6;
+        if (ptr < end) codepoint |= (*ptr++ & 0x3F);
+    } else if ((*ptr & 0xF0) == 0xE0) {
+        codepoint = (*ptr++ & 0x0F) << 12;
+        if (ptr < end) codepoint |= (*ptr++ & 0x3F) << 6;
+        if (ptr < end) codepoint |= (*ptr++ & 0x3F);
+    } else if ((*ptr & 0xF8) == 0xF0) {
+        codepoint = (*ptr++ & 0x07) << 18;
+        if (ptr < end) codepoint |= (*ptr++ & 0x3F) << 12;
+        if (ptr < end) codepoint |= (*ptr++ & 0x3F) << 6;
+        if (ptr < end) codepoint |= (*ptr++ & 0x3F);
+    } else {
+        ptr++;  // Invalid, skip
+        return 0xFFFD;  // Replacement character
+    }
+    return codepoint;
+}
+
+glm::vec4 spanColor(const ParsedSpan& span) {
+    if (span.isCode) {
+        return glm::vec4(0.6f, 0.8f, 0.6f, 1.0f);  // Green for code
+    }
+    if (span.style == Font::Bold || span.style == Font::BoldItalic) {
+        return glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);  // Bright white for bold
+    }
+    return glm::vec4(0.9f, 0.9f, 0.9f, 1.0f);  // Slightly dimmer for regular
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// Content
+//-----------------------------------------------------------------------------
+
+void MarkdownDocument::clear() {
+    _blocks.clear();
+    _openLine.clear();
+    _hasOpenLine = false;
+}
+
+void MarkdownDocument::setContent(std::string_view content) {
+    clear();
+    append(content);
+}
+
+void MarkdownDocument::append(std::string_view text) {
+    if (text.empty()) return;
+
+    // An unterminated last line is parsed again together with the new text
+    size_t first = _blocks.size();
+    std::string joined;
+    if (_hasOpenLine) {
+        _blocks.pop_back();
+        first--;
+        joined = std::move(_openLine);
+        joined.append(text);
+        text = joined;
+        _openLine.clear();
+        _hasOpenLine = false;
+    }
+
+    size_t start = 0;
+    for (size_t nl = text.find('\n'); nl != std::string_view::npos; nl = text.find('\n', start)) {
+        addLine(text.substr(start, nl - start));
+        start = nl + 1;
+    }
+    if (start < text.size()) {
+        _openLine = std::string(text.substr(start));
+        _hasOpenLine = true;
+        addLine(_openLine);
+    }
+
+    updatePositions(first);
+}
+
+void MarkdownDocument::addLine(std::string_view line) {
+    Block block;
+    block.hash = std::hash<std::string_view>{}(line);
+    block.line = parseLine(std::string(line));
+    block.height = estimateHeight(block.line);
+    _blocks.push_back(std::move(block));
+    _linesParsed++;
+}
+
+//-----------------------------------------------------------------------------
+// Parser
+//-----------------------------------------------------------------------------
+
+ParsedLine MarkdownDocument::parseLine(std::string line) {
+    ParsedLine textLine;
+
+    // Check for headers
+    int headerLevel = 0;
+    size_t i = 0;
+    while (i < line.size() && line[i] == '#') {
+        headerLevel++;
+        i++;
+    }
+    if (headerLevel > 0 && i < line.size() && line[i] == ' ') {
+        line = line.substr(i + 1);
+        textLine.scale = 1.0f + (0.15f * (7 - std::min(headerLevel, 6)));
+    }
+
+    // Check for bullet list
+    bool isBullet = false;
+    if (line.size() >= 2 && (line[0] == '-' || line[0] == '*') && line[1] == ' ') {
+        isBullet = true;
+        textLine.indent = 20.0f;
+        line = line.substr(2);
+    }
+
+    // Parse inline styles
+    size_t pos = 0;
+    while (pos < line.size()) {
+        ParsedSpan span;
+
+        // Check for code
+        if (line[pos] == '`') {
+            size_t end = line.find('`', pos + 1);
+            if (end != std::string::npos) {
+                span.text = line.substr(pos + 1, end - pos - 1);
+                span.isCode = true;
+                span.style = Font::Regular;
+                textLine.spans.push_back(span);
+                pos = end + 1;
+                continue;
+            }
+        }
+
+        // Check for bold+italic (***text***)
+        if (pos + 2 < line.size() && line.substr(pos, 3) == "***") {
+            size_t end = line.find("***", pos + 3);
+            if (end != std::string::npos) {
+                span.text = line.substr(pos + 3, end - pos - 3);
+                span.style = Font::BoldItalic;
+                textLine.spans.push_back(span);
+                pos = end + 3;
+                continue;
+            }
+        }
+
+        // Check for bold (**text**)
+        if (pos + 1 < line.size() && line.substr(pos, 2) == "**") {
+            size_t end = line.find("**", pos + 2);
+            if (end != std::string::npos) {
+                span.text = line.substr(pos + 2, end - pos - 2);
+                span.style = Font::Bold;
+                textLine.spans.push_back(span);
+                pos = end + 2;
+                continue;
+            }
+        }
+
+        // Check for italic (*text*)
+        if (line[pos] == '*') {
+            size_t end = line.find('*', pos + 1);
+            if (end != std::string::npos) {
+                span.text = line.substr(pos + 1, end - pos - 1);
+                span.style = Font::Italic;
+                textLine.spans.push_back(span);
+                pos = end + 1;
+                continue;
+            }
+        }
+
+        // Regular text - find next special character
+        size_t next = line.find_first_of("*`", pos);
+        if (next == std::string::npos) next = line.size();
+        if (next > pos) {
+            span.text = line.substr(pos, next - pos);
+            span.style = (headerLevel > 0) ? Font::Bold : Font::Regular;
+            textLine.spans.push_back(span);
+            pos = next;
+        } else {
+            // Unmatched special char - treat as literal and skip
+            span.text = std::string(1, line[pos]);
+            span.style = Font::Regular;
+            textLine.spans.push_back(span);
+            pos++;
+        }
+    }
+
+    // Add bullet if needed
+    if (isBullet && !textLine.spans.empty()) {
+        ParsedSpan bullet;
+        bullet.text = "\xE2\x80\xA2 ";  // Unicode bullet
+        bullet.style = Font::Regular;
+        bullet.isBullet = true;
+        textLine.spans.insert(textLine.spans.begin(), bullet);
+    }
+
+    // Add empty span for empty lines (paragraph break)
+    if (textLine.spans.empty()) {
+        ParsedSpan empty;
+        empty.text = "";
+        empty.style = Font::Regular;
+        textLine.spans.push_back(empty);
+    }
+
+    return textLine;
+}
+
+//-----------------------------------------------------------------------------
+// Layout
+//-----------------------------------------------------------------------------
+
+void MarkdownDocument::setFontSize(float size) {
+    if (size == _fontSize) return;
+    _fontSize = size;
+    for (auto& block : _blocks) {
+        block.layout.reset();
+        block.height = estimateHeight(block.line);
+    }
+    updatePositions(0);
+}
+
+void MarkdownDocument::setWidth(float width) {
+    if (width == _width) return;
+    _width = width;
+    invalidateLayouts();
+}
+
+void MarkdownDocument::invalidateLayouts() {
+    // Blocks that fit unwrapped at the new width lay out exactly the same
+    for (auto& block : _blocks) {
+        if (block.layout && (block.layout->wrapped || block.layout->naturalWidth > _width)) {
+            block.layout.reset();
+            block.height = estimateHeight(block.line);
+        }
+    }
+    updatePositions(0);
+}
+
+bool MarkdownDocument::layoutRange(float top, float bottom) {
+    if (_blocks.empty() || _width <= 0.0f) return false;
+
+    bool changed = false;
+    size_t i = blockAt(top);
+    float y = _blocks[i].y;
+    for (; i < _blocks.size() && y < bottom; ++i) {
+        Block& block = _blocks[i];
+        block.y = y;
+        changed = ensureLayout(block) || changed;
+        y += block.height;
+    }
+    if (changed) {
+        updatePositions(i);
+    }
+    return changed;
+}
+
+bool MarkdownDocument::ensureLayout(Block& block) {
+    if (block.layout) return false;
+
+    // Width-independent entry first, then the one for this width
+    if (auto* hit = _cache.get(cacheKey(block.hash, 0.0f, _fontSize));
+        hit && matches(*hit, block, 0.0f) && hit->layout->naturalWidth <= _width) {
+        block.layout = hit->layout;
+        _cacheHits++;
+    } else if (auto* hitW = _cache.get(cacheKey(block.hash, _width, _fontSize));
+               hitW && matches(*hitW, block, _width)) {
+        block.layout = hitW->layout;
+        _cacheHits++;
+    } else {
+        auto layout = std::make_shared<const BlockLayout>(layoutBlock(block.line));
+        float width = layout->wrapped ? _width : 0.0f;
+        size_t cost = sizeof(CacheEntry) + sizeof(BlockLayout) +
+                      layout->glyphs.size() * sizeof(BlockGlyph);
+        for (const auto& span : block.line.spans) cost += sizeof(ParsedSpan) + span.text.size();
+        _cache.put(cacheKey(block.hash, width, _fontSize),
+                   CacheEntry{block.hash, width, _fontSize, block.line, layout}, cost);
+        block.layout = std::move(layout);
+        _blocksLaidOut++;
+    }
+
+    block.height = block.layout->height;
+    return true;
+}
+
+bool MarkdownDocument::matches(const CacheEntry& entry, const Block& block, float width) const {
+    return entry.hash == block.hash && entry.width == width && entry.fontSize == _fontSize &&
+           entry.line == block.line;
+}
+
+BlockLayout MarkdownDocument::layoutBlock(const ParsedLine& line) const {
+    BlockLayout out;
+    float size = _fontSize * line.scale;
+    float lh = lineHeight(line);
+    float baseline = size;  // From the row top; leaves room for ascenders
+    float x = line.indent;
+    float natural = line.indent;
+    int row = 0;
+
+    // Spans flow one after another, wrapping back to the indent
+    std::u32string text;
+    for (const auto& span : line.spans) {
+        glm::vec4 color = spanColor(span);
+        text.clear();
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(span.text.data());
+        const uint8_t* end = ptr + span.text.size();
+        while (ptr < end) {
+            uint32_t codepoint = decodeUTF8(ptr, end);
+            if (codepoint == 0 || codepoint == '\r' || codepoint == '\n') continue;
+            text.push_back(codepoint);
+        }
+
+        // Measured a word (plus trailing spaces) at a time
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t wordEnd = pos;
+            while (wordEnd < text.size() && text[wordEnd] != ' ') wordEnd++;
+            while (wordEnd < text.size() && text[wordEnd] == ' ') wordEnd++;
+            std::u32string_view word(text.data() + pos, wordEnd - pos);
+            auto run = measureWord(word, span.style, size);
+
+            for (size_t i = 0; i < word.size(); ++i) {
+                float advance = run->advances[i];
+                if (advance < 0.0f) continue;
+
+                natural += advance;
+                if (x + advance > _width && x > line.indent) {
+                    x = line.indent;
+                    row++;
+                    out.wrapped = true;
+                }
+
+                out.glyphs.push_back({word[i], x, row * lh + baseline, size, color, span.style});
+                x += advance;
+            }
+            pos = wordEnd;
+        }
+    }
+
+    out.naturalWidth = natural;
+    out.height = (row + 1) * lh;
+    return out;
+}
+
+std::shared_ptr<const ShapedRun> MarkdownDocument::measureWord(std::u32string_view word,
+                                                               Font::Style style,
+                                                               float size) const {
+    if (_measure) {
+        if (auto run = _measure(word, style, size); run && run->advances.size() == word.size()) {
+            return run;
+        }
+    }
+
+    // Without metrics use a rough monospace estimate; without a font, skip
+    auto run = std::make_shared<ShapedRun>();
+    if (_measure) {
+        run->advances.assign(word.size(), -1.0f);
+    } else {
+        run->advances.assign(word.size(), size * 0.6f);
+        run->width = word.size() * size * 0.6f;
+    }
+    return run;
+}
+
+float MarkdownDocument::estimateHeight(const ParsedLine& line) const {
+    float lh = lineHeight(line);
+    if (_width <= 0.0f) return lh;
+
+    size_t bytes = 0;
+    for (const auto& span : line.spans) {
+        bytes += span.text.size();
+    }
+    float approxWidth = line.indent + bytes * _fontSize * line.scale * 0.6f;
+    return std::max(1.0f, std::ceil(approxWidth / _width)) * lh;
+}
+
+void MarkdownDocument::updatePositions(size_t from) {
+    float y = 0.0f;
+    if (from > 0 && from <= _blocks.size()) {
+        y = _blocks[from - 1].y + _blocks[from - 1].height;
+    }
+    for (size_t i = from; i < _blocks.size(); ++i) {
+        _blocks[i].y = y;
+        y += _blocks[i].height;
+    }
+}
+
+size_t MarkdownDocument::blockAt(float y) const {
+    if (_blocks.empty()) return 0;
+    auto it = std::upper_bound(_blocks.begin(), _blocks.end(), y,
+                               [](float v, const Block& b) { return v < b.y; });
+    if (it == _blocks.begin()) return 0;
+    return static_cast<size_t>(it - _blocks.begin()) - 1;
+}
+
+float MarkdownDocument::contentHeight() const {
+    if (_blocks.empty()) return 0.0f;
+    return _blocks.back().y + _blocks.back().height;
+}
+
+size_t MarkdownDocument::cacheKey(size_t hash, float width, float fontSize) {
+    auto mix = [](size_t h, size_t v) {
+        return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+    };
+    return mix(mix(hash, std::hash<float>{}(width)), std::hash<float>{}(fontSize));
+}
+
+} // namespace yetty::plugins
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <yetty/font.h>
+#include <yetty/lru-cache.h>
+#include <yetty/text-layout-cache.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yetty::plugins {
+
+//-----------------------------------------------------------------------------
+// ParsedSpan - a run of styled text from markdown parsing
+//-----------------------------------------------------------------------------
+struct ParsedSpan {
+    std::string text;
+    Font::Style style = Font::Regular;
+    uint8_t headerLevel = 0;  // 0=normal, 1-6=header
+    bool isCode = false;
+    bool isBullet = false;
+
+    bool operator==(const ParsedSpan&) const = default;
+};
+
+//-----------------------------------------------------------------------------
+// ParsedLine - a line of text with styled spans from markdown parsing
+//-----------------------------------------------------------------------------
+struct ParsedLine {
+    std::vector<ParsedSpan> spans;
+    float indent = 0.0f;
+    float scale = 1.0f;  // For headers
+
+    bool operator==(const ParsedLine&) const = default;
+};
+
+//-----------------------------------------------------------------------------
+// BlockLayout - one block laid out at a width. Glyph positions are relative
+// to the block's top left; `naturalWidth` is how wide it is unwrapped.
+//-----------------------------------------------------------------------------
+struct BlockGlyph {
+    uint32_t codepoint;
+    float x, y;
+    float size;
+    glm::vec4 color;
+    Font::Style style;
+};
+
+struct BlockLayout {
+    std::vector<BlockGlyph> glyphs;
+    float height = 0.0f;
+    float naturalWidth = 0.0f;
+    bool wrapped = false;
+};
+
+//-----------------------------------------------------------------------------
+// MarkdownDocument - parsed markdown blocks (one per source line) with
+// incremental, lazily computed layout
+//
+// Appending parses only the new text plus the last line if it was still
+// open. Blocks are laid out on demand by layoutRange(); the rest carry an
+// estimated height so scroll extents stay sensible. Layouts are cached by
+// the line's content hash and the width: a block that fits unwrapped is
+// stored width-independent, so resizing only re-lays out lines that wrap.
+// Entries keep the full key and the parsed line to rule out collisions.
+//-----------------------------------------------------------------------------
+class MarkdownDocument {
+public:
+    // Advances of a word at pixel size `size`; negative advances mark
+    // glyphs the font lacks, which are skipped as RichText does
+    using MeasureFn = std::function<std::shared_ptr<const ShapedRun>(
+        std::u32string_view word, Font::Style style, float size)>;
+
+    struct Block {
+        ParsedLine line;
+        size_t hash = 0;                           // Of the source line
+        float y = 0.0f;                            // Top, in document coordinates
+        float height = 0.0f;                       // Laid out, or estimated
+        std::shared_ptr<const BlockLayout> layout; // Valid for the current width
+    };
+
+    static constexpr size_t LAYOUT_CACHE_BUDGET = 8 * 1024 * 1024;
+
+    MarkdownDocument() : _cache(LAYOUT_CACHE_BUDGET) {}
+
+    MarkdownDocument(const MarkdownDocument&) = delete;
+    MarkdownDocument& operator=(const MarkdownDocument&) = delete;
+
+    void setMeasure(MeasureFn measure) { _measure = std::move(measure); }
+
+    // Layout parameters; changing either drops layouts that no longer apply
+    void setFontSize(float size);
+    void setWidth(float width);
+    float width() const { return _width; }
+
+    // Content
+    void clear();
+    void setContent(std::string_view content);
+    void append(std::string_view text);
+
+    // Lay out every block intersecting [top, bottom). True if any block was
+    // laid out, which may have moved the blocks after it.
+    bool layoutRange(float top, float bottom);
+
+    // Index of the block containing document y (clamped to the last block)
+    size_t blockAt(float y) const;
+
+    size_t blockCount() const { return _blocks.size(); }
+    const Block& block(size_t i) const { return _blocks[i]; }
+    float contentHeight() const;
+
+    // Counters, for tests and benchmarks
+    uint64_t linesParsed() const { return _linesParsed; }
+    uint64_t blocksLaidOut() const { return _blocksLaidOut; }
+    uint64_t cacheHits() const { return _cacheHits; }
+
+    static ParsedLine parseLine(std::string line);
+
+private:
+    void addLine(std::string_view line);
+    bool ensureLayout(Block& block);
+    BlockLayout layoutBlock(const ParsedLine& line) const;
+    std::shared_ptr<const ShapedRun> measureWord(std::u32string_view word, Font::Style style,
+                                                 float size) const;
+    float estimateHeight(const ParsedLine& line) const;
+    float lineHeight(const ParsedLine& line) const { return _fontSize * 1.4f * line.scale; }
+    void invalidateLayouts();
+    void updatePositions(size_t from);
+
+    struct CacheEntry {
+        size_t hash;
+        float width;  // 0 for layouts that fit unwrapped
+        float fontSize;
+        ParsedLine line;
+        std::shared_ptr<const BlockLayout> layout;
+    };
+
+    static size_t cacheKey(size_t hash, float width, float fontSize);
+    bool matches(const CacheEntry& entry, const Block& block, float width) const;
+
+    MeasureFn _measure;
+    float _fontSize = 16.0f;
+    float _width = 0.0f;
+
+    std::vector<Block> _blocks;
+    std::string _openLine;      // Last line, not yet terminated by a newline
+    bool _hasOpenLine = false;
+
+    LruCache<size_t, CacheEntry> _cache;
+
+    uint64_t _linesParsed = 0;
+    uint64_t _blocksLaidOut = 0;
+    uint64_t _cacheHits = 0;
+};
+
+} // namespace yetty::plugins
@@ -90,8 +90,12 @@ Result<void> Markdown::init() {
         content = buffer.str();
     }
 
-    parseMarkdown(content);
-    std::cout << "Markdown: parsed " << _parsedLines.size() << " lines" << std::endl;
+    _document.setFontSize(_baseSize);
+    _document.setMeasure([this](std::u32string_view word, Font::Style style, float size) {
+        return shapeWord(word, style, size);
+    });
+    _document.setContent(content);
+    std::cout << "Markdown: parsed " << _document.blockCount() << " lines" << std::endl;
     return Ok();
 }
 
@@ -100,194 +104,69 @@ Result<void> Markdown::dispose() {
         _richText->dispose();
         _richText.reset();
     }
+    std::fill(std::begin(_fonts), std::end(_fonts), nullptr);
+    _windowDirty = true;
     _initialized = false;
     _failed = false;
     return Ok();
 }
 
-//-----------------------------------------------------------------------------
-// Markdown Parser
-//-----------------------------------------------------------------------------
-
-void Markdown::parseMarkdown(const std::string& content) {
-    _parsedLines.clear();
-
-    std::istringstream stream(content);
-    std::string line;
-
-    while (std::getline(stream, line)) {
-        ParsedLine textLine;
-
-        // Check for headers
-        int headerLevel = 0;
-        size_t i = 0;
-        while (i < line.size() && line[i] == '#') {
-            headerLevel++;
-            i++;
-        }
-        if (headerLevel > 0 && i < line.size() && line[i] == ' ') {
-            line = line.substr(i + 1);
-            textLine.scale = 1.0f + (0.15f * (7 - std::min(headerLevel, 6)));
-        }
-
-        // Check for bullet list
-        bool isBullet = false;
-        if (line.size() >= 2 && (line[0] == '-' || line[0] == '*') && line[1] == ' ') {
-            isBullet = true;
-            textLine.indent = 20.0f;
-            line = line.substr(2);
-        }
-
-        // Parse inline styles
-        size_t pos = 0;
-        while (pos < line.size()) {
-            ParsedSpan span;
-
-            // Check for code
-            if (line[pos] == '`') {
-                size_t end = line.find('`', pos + 1);
-                if (end != std::string::npos) {
-                    span.text = line.substr(pos + 1, end - pos - 1);
-                    span.isCode = true;
-                    span.style = Font::Regular;
-                    textLine.spans.push_back(span);
-                    pos = end + 1;
-                    continue;
-                }
-            }
-
-            // Check for bold+italic (***text***)
-            if (pos + 2 < line.size() && line.substr(pos, 3) == "***") {
-                size_t end = line.find("***", pos + 3);
-                if (end != std::string::npos) {
-                    span.text = line.substr(pos + 3, end - pos - 3);
-                    span.style = Font::BoldItalic;
-                    textLine.spans.push_back(span);
-                    pos = end + 3;
-                    continue;
-                }
-            }
-
-            // Check for bold (**text**)
-            if (pos + 1 < line.size() && line.substr(pos, 2) == "**") {
-                size_t end = line.find("**", pos + 2);
-                if (end != std::string::npos) {
-                    span.text = line.substr(pos + 2, end - pos - 2);
-                    span.style = Font::Bold;
-                    textLine.spans.push_back(span);
-                    pos = end + 2;
-                    continue;
-                }
-            }
-
-            // Check for italic (*text*)
-            if (line[pos] == '*') {
-                size_t end = line.find('*', pos + 1);
-                if (end != std::string::npos) {
-                    span.text = line.substr(pos + 1, end - pos - 1);
-                    span.style = Font::Italic;
-                    textLine.spans.push_back(span);
-                    pos = end + 1;
-                    continue;
-                }
-            }
-
-            // Regular text - find next special character
-            size_t next = line.find_first_of("*`", pos);
-            if (next == std::string::npos) next = line.size();
-            if (next > pos) {
-                span.text = line.substr(pos, next - pos);
-                span.style = (headerLevel > 0) ? Font::Bold : Font::Regular;
-                textLine.spans.push_back(span);
-                pos = next;
-            } else {
-                // Unmatched special char - treat as literal and skip
-                span.text = std::string(1, line[pos]);
-                span.style = Font::Regular;
-                textLine.spans.push_back(span);
-                pos++;
-            }
-        }
-
-        // Add bullet if needed
-        if (isBullet && !textLine.spans.empty()) {
-            ParsedSpan bullet;
-            bullet.text = "\xE2\x80\xA2 ";  // Unicode bullet
-            bullet.style = Font::Regular;
-            bullet.isBullet = true;
-            textLine.spans.insert(textLine.spans.begin(), bullet);
-        }
-
-        // Add empty span for empty lines (paragraph break)
-        if (textLine.spans.empty()) {
-            ParsedSpan empty;
-            empty.text = "";
-            empty.style = Font::Regular;
-            textLine.spans.push_back(empty);
-        }
-
-        _parsedLines.push_back(textLine);
-    }
+Result<void> Markdown::append(std::string_view data) {
+    _document.append(data);
+    _windowDirty = true;
+    return Ok();
 }
 
 //-----------------------------------------------------------------------------
-// Build RichText spans from parsed markdown
+// Layout
 //-----------------------------------------------------------------------------
 
-void Markdown::buildRichTextSpans(float fontSize, float maxWidth) {
-    if (!_richText) {
-        ywarn("Markdown::buildRichTextSpans: _richText is null!");
-        return;
+std::shared_ptr<const ShapedRun> Markdown::shapeWord(std::u32string_view word,
+                                                    Font::Style style, float size) {
+    Font*& font = _fonts[style];
+    if (!font && _richText) {
+        font = _richText->resolveFont("", style);
     }
+    if (!font) return nullptr;
 
-    ydebug("Markdown::buildRichTextSpans: {} lines, fontSize={}, maxWidth={}",
-                  _parsedLines.size(), fontSize, maxWidth);
-
-    _richText->clear();
+    // Shared with every other rich-text widget using this font
+    return TextLayoutCache::shared().shape(font, style, size, word);
+}
 
-    float cursorY = 0.0f;
-    float lineHeight = fontSize * 1.4f;
-    int spanCount = 0;
-
-    for (const auto& line : _parsedLines) {
-        float cursorX = line.indent;
-        float scale = line.scale;
-        float scaledLineHeight = lineHeight * scale;
-        float scaledSize = fontSize * scale;
-
-        for (const auto& pspan : line.spans) {
-            TextSpan span;
-            span.text = pspan.text;
-            span.x = cursorX;
-            span.y = cursorY;
-            span.size = scaledSize;
-            span.style = pspan.style;
-            span.wrap = true;
-            span.maxWidth = maxWidth - cursorX;
-            span.lineHeight = scaledLineHeight;
-
-            // Set colors based on style
-            if (pspan.isCode) {
-                span.color = glm::vec4(0.6f, 0.8f, 0.6f, 1.0f);  // Green for code
-            } else if (pspan.style == Font::Bold || pspan.style == Font::BoldItalic) {
-                span.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);  // Bright white for bold
-            } else {
-                span.color = glm::vec4(0.9f, 0.9f, 0.9f, 1.0f);  // Slightly dimmer for regular
-            }
-
-            _richText->addSpan(span);
-            spanCount++;
-
-            // Advance cursor (approximate - RichText will do proper layout)
-            // This is just for inline spans on the same line
-            cursorX += pspan.text.length() * scaledSize * 0.5f;
+void Markdown::updateWindow(float scrollTop, float viewHeight) {
+    bool changed = _document.layoutRange(scrollTop, scrollTop + viewHeight);
+    bool inside = scrollTop >= _windowTop && scrollTop + viewHeight <= _windowBottom;
+    if (!changed && inside && !_windowDirty) return;
+
+    // One screen of margin each way so short scrolls reuse the window
+    _windowTop = std::max(0.0f, scrollTop - viewHeight);
+    _windowBottom = scrollTop + 2.0f * viewHeight;
+    _document.layoutRange(_windowTop, _windowBottom);
+
+    std::vector<TextChar> chars;
+    for (size_t i = _document.blockAt(_windowTop); i < _document.blockCount(); ++i) {
+        const auto& block = _document.block(i);
+        if (block.y >= _windowBottom) break;
+        if (!block.layout) continue;
+
+        for (const auto& g : block.layout->glyphs) {
+            TextChar ch;
+            ch.codepoint = g.codepoint;
+            ch.x = g.x;
+            ch.y = block.y + g.y;
+            ch.size = g.size;
+            ch.color = g.color;
+            ch.style = g.style;
+            chars.push_back(ch);
         }
-
-        cursorY += scaledLineHeight;
     }
 
-    yinfo("Markdown::buildRichTextSpans: added {} spans", spanCount);
-    _richText->setNeedsLayout();
+    _richText->clear();
+    _richText->addChars(chars);
+    _windowDirty = false;
+
+    ydebug("Markdown::updateWindow: [{}, {}) {} glyphs, {} blocks laid out, {} cache hits",
+           _windowTop, _windowBottom, chars.size(), _document.blocksLaidOut(), _document.cacheHits());
 }
 
 //-----------------------------------------------------------------------------
@@ -321,11 +200,25 @@ Result<void> Markdown::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bo
         _initialized = true;
     }
 
-    if (_lastLayoutWidth != _pixelWidth) {
-        buildRichTextSpans(_baseSize, static_cast<float>(_pixelWidth));
-        _lastLayoutWidth = _pixelWidth;
+    float width = static_cast<float>(_pixelWidth);
+    float viewHeight = static_cast<float>(_pixelHeight);
+    if (width != _document.width()) {
+        // Keep the block at the top of the view in place across the reflow
+        float scroll = _richText->getScrollOffset();
+        size_t anchor = _document.blockAt(scroll);
+        float offset = _document.blockCount() ? scroll - _document.block(anchor).y : 0.0f;
+
+        _document.setWidth(width);
+        if (_document.blockCount()) {
+            _document.layoutRange(_document.block(anchor).y, _document.block(anchor).y + 1.0f);
+            const auto& block = _document.block(anchor);
+            _richText->setScrollOffset(block.y + std::min(offset, block.height));
+        }
+        _windowDirty = true;
     }
 
+    updateWindow(_richText->getScrollOffset(), viewHeight);
+
     return _richText->render(pass, ctx, ctx.getSurfaceWidth(), ctx.getSurfaceHeight(),
                              _pixelX, _pixelY, static_cast<float>(_pixelWidth), static_cast<float>(_pixelHeight));
 }
@@ -344,7 +237,7 @@ bool Markdown::onMouseScroll(float xoffset, float yoffset, int mods) {
     _richText->scroll(-scrollAmount);
 
     // Clamp scroll
-    float maxScroll = std::max(0.0f, _richText->getContentHeight() - static_cast<float>(_pixelHeight));
+    float maxScroll = std::max(0.0f, _document.contentHeight() - static_cast<float>(_pixelHeight));
     if (_richText->getScrollOffset() > maxScroll) {
         _richText->setScrollOffset(maxScroll);
     }
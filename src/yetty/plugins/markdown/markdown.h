@@ -3,6 +3,7 @@
 #include <yetty/plugin.h>
 #include <yetty/font.h>
 #include <yetty/rich-text.h>
+#include "markdown-document.h"
 #include <string>
 #include <vector>
 
@@ -47,28 +48,13 @@ private:
     FontManager* _fontManager = nullptr;
 };
 
-//-----------------------------------------------------------------------------
-// ParsedSpan - a run of styled text from markdown parsing
-//-----------------------------------------------------------------------------
-struct ParsedSpan {
-    std::string text;
-    Font::Style style = Font::Regular;
-    uint8_t headerLevel = 0;  // 0=normal, 1-6=header
-    bool isCode = false;
-    bool isBullet = false;
-};
-
-//-----------------------------------------------------------------------------
-// ParsedLine - a line of text with styled spans from markdown parsing
-//-----------------------------------------------------------------------------
-struct ParsedLine {
-    std::vector<ParsedSpan> spans;
-    float indent = 0.0f;
-    float scale = 1.0f;  // For headers
-};
-
 //-----------------------------------------------------------------------------
 // Markdown - single markdown document widget (uses RichText for rendering)
+//
+// Layout is per block and lazy (see MarkdownDocument): RichText only gets
+// the glyphs of a window one screen above and below the viewport, rebuilt
+// when scrolling leaves it or a resize/append changes the blocks in it.
+// append() (OSC "append") parses just the new text.
 //-----------------------------------------------------------------------------
 class Markdown : public Widget {
 public:
@@ -106,6 +92,8 @@ public:
     void prepareFrame(WebGPUContext& ctx, bool on) override;
     Result<void> render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) override;
 
+    Result<void> append(std::string_view data) override;
+
     // Mouse scrolling
     bool onMouseScroll(float xoffset, float yoffset, int mods) override;
     bool wantsMouse() const override { return true; }
@@ -118,15 +106,21 @@ private:
 
     Result<void> init() override;
 
-    void parseMarkdown(const std::string& content);
-    void buildRichTextSpans(float fontSize, float maxWidth);
+    std::shared_ptr<const ShapedRun> shapeWord(std::u32string_view word, Font::Style style,
+                                               float size);
+    void updateWindow(float scrollTop, float viewHeight);
 
     MarkdownPlugin* _plugin = nullptr;
-    std::vector<ParsedLine> _parsedLines;
+    MarkdownDocument _document;
     RichText::Ptr _richText;
+    Font* _fonts[4] = {};  // By Font::Style
+
+    // Document range whose glyphs RichText currently holds
+    float _windowTop = 0.0f;
+    float _windowBottom = 0.0f;
+    bool _windowDirty = true;
 
     float _baseSize = 16.0f;
-    float _lastLayoutWidth = 0.0f;
     bool _initialized = false;
     bool _failed = false;
 };
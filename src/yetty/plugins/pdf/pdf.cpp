@@ -23,10 +23,32 @@ extern "C" {
 
 namespace yetty {
 
+//-----------------------------------------------------------------------------
+// MuPDF locking - required for fz_clone_context() and for using the clones
+// from several threads
+//-----------------------------------------------------------------------------
+
+struct MupdfLocks {
+    std::mutex mutexes[FZ_LOCK_MAX];
+    fz_locks_context callbacks;
+
+    MupdfLocks() {
+        callbacks.user = this;
+        callbacks.lock = [](void* user, int lock) {
+            static_cast<MupdfLocks*>(user)->mutexes[lock].lock();
+        };
+        callbacks.unlock = [](void* user, int lock) {
+            static_cast<MupdfLocks*>(user)->mutexes[lock].unlock();
+        };
+    }
+};
+
 //-----------------------------------------------------------------------------
 // PDFPlugin
 //-----------------------------------------------------------------------------
 
+PDFPlugin::PDFPlugin() noexcept = default;
+
 PDFPlugin::~PDFPlugin() { (void)dispose(); }
 
 Result<PluginPtr> PDFPlugin::create() noexcept {
@@ -39,7 +61,8 @@ Result<PluginPtr> PDFPlugin::create() noexcept {
 
 Result<void> PDFPlugin::pluginInit() noexcept {
     // Create MuPDF context
-    fz_context* mctx = fz_new_context(nullptr, nullptr, FZ_STORE_UNLIMITED);
+    _fzLocks = std::make_unique<MupdfLocks>();
+    fz_context* mctx = fz_new_context(nullptr, &_fzLocks->callbacks, FZ_STORE_UNLIMITED);
     if (!mctx) {
         return Err<void>("Failed to create MuPDF context");
     }
@@ -121,8 +144,8 @@ Result<WidgetPtr> Pdf::create(
     (void)factory;
     (void)fontManager;
     (void)loop;
-    (void)pluginArgs;
     auto w = std::shared_ptr<Pdf>(new Pdf(payload, plugin, ctx));
+    w->_persistFonts = pluginArgs.find("--no-font-cache") == std::string::npos;
     w->_x = x;
     w->_y = y;
     w->_widthCells = widthCells;
@@ -134,7 +157,8 @@ Result<WidgetPtr> Pdf::create(
 }
 
 Result<void> Pdf::init() {
-    if (_payload.empty()) {
+    // Payload is a file path, or the PDF bytes when sent via shared memory
+    if (_payload.empty() && !_shmPayload) {
         return Err<void>("Pdf: empty payload");
     }
 
@@ -144,6 +168,9 @@ Result<void> Pdf::init() {
 }
 
 Result<void> Pdf::dispose() {
+    // The worker uses the document
+    stopWorker();
+
     if (_doc) {
         fz_drop_document(MCTX, MDOC);
         _doc = nullptr;
@@ -154,8 +181,23 @@ Result<void> Pdf::dispose() {
         _richText.reset();
     }
 
-    _pages.clear();
-    _fontNameMap.clear();
+    _page.reset();
+    _shownPage = -1;
+    _pageCache.clear();
+    _extractQueue.clear();
+    _requestedPage = -1;
+    _requestedReady.reset();
+    _pendingFonts.clear();
+    _fontKeyMap.clear();
+
+    // Atlases stay with the FontManager (shared by documents using the same
+    // font), keep what this document rasterized for the next run
+    if (!_docFonts.empty() && _persistFonts) {
+        if (auto fontMgr = _plugin->getFontManager()) {
+            fontMgr->persistIncrementalFonts();
+        }
+    }
+    _docFonts.clear();
     _initialized = false;
     _failed = false;
     return Ok();
@@ -170,111 +212,221 @@ Result<void> Pdf::loadPDF(const std::string& path) {
         return Err<void>("MuPDF context not initialized");
     }
 
-    fz_try(MCTX) { _doc = fz_open_document(MCTX, path.c_str()); }
-    fz_catch(MCTX) { return Err<void>("Failed to open PDF: " + path); }
+    if (_shmPayload) {
+        // Open straight from the mapping - the document keeps the stream,
+        // which stays valid as long as this widget holds _shmPayload
+        fz_stream* stm = nullptr;
+        fz_var(stm);
+        fz_try(MCTX) {
+            stm = fz_open_memory(MCTX, _shmPayload->data(), _shmPayload->size());
+            _doc = fz_open_document_with_stream(MCTX, "application/pdf", stm);
+        }
+        fz_always(MCTX) { fz_drop_stream(MCTX, stm); }
+        fz_catch(MCTX) { return Err<void>("Failed to open PDF from shared memory"); }
+    } else {
+        fz_try(MCTX) { _doc = fz_open_document(MCTX, path.c_str()); }
+        fz_catch(MCTX) { return Err<void>("Failed to open PDF: " + path); }
+    }
 
     _pageCount = fz_count_pages(MCTX, MDOC);
     if (_pageCount <= 0) {
         return Err<void>("PDF has no pages");
     }
 
-    yinfo("Pdf: loaded {} with {} pages", path, _pageCount);
+    yinfo("Pdf: loaded {} with {} pages", _shmPayload ? "<shm>" : path, _pageCount);
 
-    // Extract first page content
-    return extractPageContent(0);
+    startWorker();
+    requestPage(0);
+    return Ok();
 }
 
 //-----------------------------------------------------------------------------
 // Font Registration
 //-----------------------------------------------------------------------------
 
-std::string Pdf::registerFont(void* fzFont) {
+std::string Pdf::registerFont(void* fzCtx, void* fzFont) {
     if (!fzFont) return "";
 
     // Check if already registered
-    auto it = _fontNameMap.find(fzFont);
-    if (it != _fontNameMap.end()) {
+    auto it = _fontKeyMap.find(fzFont);
+    if (it != _fontKeyMap.end()) {
         return it->second;
     }
 
+    fz_context* mctx = static_cast<fz_context*>(fzCtx);
     fz_font* font = static_cast<fz_font*>(fzFont);
-    std::string fontName = fz_font_name(MCTX, font);
+    std::string fontName = fz_font_name(mctx, font);
 
     // Get embedded font data from MuPDF's fz_buffer
     // This avoids using MuPDF's FT_Face directly which has lock callback issues
     if (!font->buffer) {
         ywarn("Pdf: no font buffer for font '{}'", fontName);
-        _fontNameMap[fzFont] = "";
+        _fontKeyMap[fzFont] = "";
         return "";
     }
 
     unsigned char* fontData = nullptr;
-    size_t fontDataLen = fz_buffer_storage(MCTX, font->buffer, &fontData);
+    size_t fontDataLen = fz_buffer_storage(mctx, font->buffer, &fontData);
     if (!fontData || fontDataLen == 0) {
         ywarn("Pdf: no font data for font '{}'", fontName);
-        _fontNameMap[fzFont] = "";
+        _fontKeyMap[fzFont] = "";
         return "";
     }
 
-    // Store the font name and data for later atlas generation
-    _fontNameMap[fzFont] = fontName;
+    // Embedded subsets often share a name; key by name and data hash, the
+    // same family the FontManager registers. The render thread generates
+    // the atlas.
+    std::string fontKey = FontManager::incrementalFamily(fontData, fontDataLen, fontName);
+    _fontKeyMap[fzFont] = fontKey;
     PendingFont pf;
     pf.data.assign(fontData, fontData + fontDataLen);
     pf.name = fontName;
-    _pendingFonts[fzFont] = std::move(pf);
+    pf.key = fontKey;
+    {
+        std::lock_guard<std::mutex> lock(_workerMutex);
+        _pendingFonts.push_back(std::move(pf));
+    }
 
-    ydebug("Pdf: collected font '{}' ({} bytes)", fontName, fontDataLen);
-    return fontName;
+    ydebug("Pdf: collected font '{}' ({} bytes)", fontKey, fontDataLen);
+    return fontKey;
 }
 
 Result<void> Pdf::generateFontAtlases() {
+    std::vector<PendingFont> fonts;
+    {
+        std::lock_guard<std::mutex> lock(_workerMutex);
+        fonts.swap(_pendingFonts);
+    }
+    if (fonts.empty()) {
+        return Ok();
+    }
+
     auto fontMgr = _plugin->getFontManager();
     if (!fontMgr) {
         return Err<void>("No FontManager available");
     }
 
-    for (auto& [fzFont, pendingFont] : _pendingFonts) {
-        yinfo("Pdf: generating atlas for font '{}'", pendingFont.name);
-        auto result = fontMgr->getFont(pendingFont.data.data(), pendingFont.data.size(),
-                                        pendingFont.name, 32.0f);
+    for (auto& pendingFont : fonts) {
+        // Glyphs are rasterized on demand by ensureGlyphs()
+        ydebug("Pdf: registering incremental atlas for font '{}'", pendingFont.name);
+        std::string family;
+        auto result = fontMgr->getIncrementalFont(pendingFont.data.data(), pendingFont.data.size(),
+                                                  pendingFont.name, 32.0f, &family);
         if (!result || !*result) {
             ywarn("Pdf: failed to generate atlas for font '{}': {}", pendingFont.name,
                          result ? "null font" : result.error().message());
-            // Mark as failed - will use fallback
-            _fontNameMap[fzFont] = "";
+            // Not a doc font - its chars use the default font
+            continue;
         }
+        _docFonts[pendingFont.key] = DocFont{*result, std::move(family)};
     }
 
-    _pendingFonts.clear();
     return Ok();
 }
 
+void Pdf::ensureGlyphs(const ExtractedPage& page) {
+    if (_docFonts.empty()) return;
+
+    auto fontMgr = _plugin->getFontManager();
+    if (!fontMgr) return;
+
+    // Font::addGlyphs skips codepoints already in the atlas
+    std::unordered_map<Font*, std::vector<uint32_t>> wanted;
+    for (const auto& ch : page.chars) {
+        if (ch.codepoint < 0x20) continue;
+        auto it = _docFonts.find(ch.fontKey);
+        if (it == _docFonts.end()) continue;
+        wanted[it->second.font].push_back(ch.codepoint);
+    }
+
+    for (auto& [font, codepoints] : wanted) {
+        if (auto res = fontMgr->addGlyphs(font, codepoints); !res) {
+            ywarn("Pdf: failed to add glyphs: {}", res.error().message());
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
-// Page Content Extraction
+// Page Extraction (worker thread)
 //-----------------------------------------------------------------------------
 
-Result<void> Pdf::extractPageContent(int pageNum) {
-    if (!_doc || pageNum < 0 || pageNum >= _pageCount) {
-        return Err<void>("Invalid page number");
+void Pdf::startWorker() {
+    _workerStop = false;
+    _worker = std::thread([this] { workerLoop(); });
+}
+
+void Pdf::stopWorker() {
+    if (!_worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(_workerMutex);
+        _workerStop = true;
     }
+    _workerCv.notify_one();
+    _worker.join();
+}
 
-    _currentPage = pageNum;
-    _pages.clear();
+void Pdf::workerLoop() {
+    // Contexts must not be shared between threads; the clone shares the
+    // plugin context's store and locks
+    fz_context* wctx = fz_clone_context(MCTX);
+    if (!wctx) {
+        yerror("Pdf: failed to clone MuPDF context, pages will not load");
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_workerMutex);
+    while (true) {
+        _workerCv.wait(lock, [this] { return _workerStop || !_extractQueue.empty(); });
+        if (_workerStop) break;
+
+        int pageNum = _extractQueue.front();
+        _extractQueue.erase(_extractQueue.begin());
+        if (PagePtr* cached = _pageCache.get(pageNum)) {
+            if (pageNum == _requestedPage) _requestedReady = *cached;
+            continue;
+        }
+
+        lock.unlock();
+        PagePtr page = extractPage(wctx, pageNum);
+        lock.lock();
+
+        _pageCache.put(pageNum, page, pageCost(*page));
+        if (pageNum == _requestedPage) {
+            _requestedReady = page;
+        }
+    }
+    lock.unlock();
+
+    fz_drop_context(wctx);
+}
+
+size_t Pdf::pageCost(const ExtractedPage& page) {
+    size_t bytes = sizeof(ExtractedPage) + page.chars.capacity() * sizeof(ExtractedChar);
+    for (const auto& ch : page.chars) {
+        bytes += ch.fontKey.size();
+    }
+    return bytes;
+}
+
+Pdf::PagePtr Pdf::extractPage(void* fzCtx, int pageNum) {
+    fz_context* mctx = static_cast<fz_context*>(fzCtx);
+    auto pdfPage = std::make_shared<ExtractedPage>();
 
     fz_page* page = nullptr;
     fz_stext_page* textPage = nullptr;
+    fz_var(page);
+    fz_var(textPage);
 
-    fz_try(MCTX) {
-        page = fz_load_page(MCTX, MDOC, pageNum);
-        fz_rect bounds = fz_bound_page(MCTX, page);
+    fz_try(mctx) {
+        page = fz_load_page(mctx, MDOC, pageNum);
+        fz_rect bounds = fz_bound_page(mctx, page);
 
-        ExtractedPage pdfPage;
-        pdfPage.width = bounds.x1 - bounds.x0;
-        pdfPage.height = bounds.y1 - bounds.y0;
+        pdfPage->width = bounds.x1 - bounds.x0;
+        pdfPage->height = bounds.y1 - bounds.y0;
 
         // Extract text using structured text
         fz_stext_options opts = {0};
-        textPage = fz_new_stext_page_from_page(MCTX, page, &opts);
+        textPage = fz_new_stext_page_from_page(mctx, page, &opts);
 
         for (fz_stext_block* block = textPage->first_block; block; block = block->next) {
             if (block->type != FZ_STEXT_BLOCK_TEXT) continue;
@@ -288,33 +440,84 @@ Result<void> Pdf::extractPageContent(int pageNum) {
                     textChar.size = ch->size;
                     textChar.color = 0xFF000000;  // Default black
 
-                    // Register font and get family name
+                    // Register font and key the char by it
                     if (ch->font) {
-                        textChar.fontFamily = registerFont(ch->font);
-                        textChar.bold = fz_font_is_bold(MCTX, ch->font);
-                        textChar.italic = fz_font_is_italic(MCTX, ch->font);
+                        textChar.fontKey = registerFont(mctx, ch->font);
+                        textChar.bold = fz_font_is_bold(mctx, ch->font);
+                        textChar.italic = fz_font_is_italic(mctx, ch->font);
                     }
 
-                    pdfPage.chars.push_back(textChar);
+                    pdfPage->chars.push_back(textChar);
                 }
             }
         }
+        pdfPage->chars.shrink_to_fit();
 
-        _pages.push_back(std::move(pdfPage));
-        yinfo("Pdf: extracted {} characters from page {}",
-                     _pages[0].chars.size(), pageNum);
+        ydebug("Pdf: extracted {} characters from page {}", pdfPage->chars.size(), pageNum);
+    }
+    fz_always(mctx) {
+        if (textPage) fz_drop_stext_page(mctx, textPage);
+        if (page) fz_drop_page(mctx, page);
+    }
+    fz_catch(mctx) {
+        // Cached as an empty page so it is not retried on every request
+        ywarn("Pdf: failed to extract page {}", pageNum);
+        pdfPage = std::make_shared<ExtractedPage>();
+    }
+
+    return pdfPage;
+}
 
-        // Generate font atlases AFTER extraction but still inside fz_try
-        // This matches pdf-old's approach
-        if (auto res = generateFontAtlases(); !res) {
-            ywarn("Pdf: font atlas generation failed: {}", res.error().message());
+//-----------------------------------------------------------------------------
+// Page Switching (render thread)
+//-----------------------------------------------------------------------------
+
+void Pdf::requestPage(int pageNum) {
+    if (!_doc || pageNum < 0 || pageNum >= _pageCount) return;
+
+    _currentPage = pageNum;
+    {
+        // Requested page first, then neighbours nearest first, favouring
+        // the reading direction
+        std::lock_guard<std::mutex> lock(_workerMutex);
+        _requestedPage = pageNum;
+        _requestedReady.reset();
+        _extractQueue.clear();
+        for (int d = 0; d <= PREFETCH_PAGES; d++) {
+            for (int p : {pageNum + d, pageNum - d}) {
+                if (p < 0 || p >= _pageCount || _pageCache.contains(p)) continue;
+                if (std::find(_extractQueue.begin(), _extractQueue.end(), p) != _extractQueue.end()) continue;
+                _extractQueue.push_back(p);
+            }
         }
     }
-    fz_always(MCTX) {
-        if (textPage) fz_drop_stext_page(MCTX, textPage);
-        if (page) fz_drop_page(MCTX, page);
+    _workerCv.notify_one();
+
+    pollPage();
+}
+
+void Pdf::pollPage() {
+    if (_shownPage == _currentPage) return;
+
+    PagePtr page;
+    {
+        std::lock_guard<std::mutex> lock(_workerMutex);
+        if (PagePtr* cached = _pageCache.get(_currentPage)) {
+            page = *cached;
+        } else if (_requestedPage == _currentPage) {
+            page = _requestedReady;
+        }
+    }
+    if (!page) return;  // Keep showing the previous page until it is ready
+
+    // Fonts first seen on this page (or a prefetched one)
+    if (auto res = generateFontAtlases(); !res) {
+        ywarn("Pdf: font atlas generation failed: {}", res.error().message());
     }
-    fz_catch(MCTX) { return Err<void>("Failed to extract page content"); }
+    ensureGlyphs(*page);
+
+    _page = std::move(page);
+    _shownPage = _currentPage;
 
     // Force re-layout
     _lastViewWidth = 0;
@@ -322,8 +525,6 @@ Result<void> Pdf::extractPageContent(int pageNum) {
     if (_richText) {
         _richText->clear();
     }
-
-    return Ok();
 }
 
 //-----------------------------------------------------------------------------
@@ -331,11 +532,12 @@ Result<void> Pdf::extractPageContent(int pageNum) {
 //-----------------------------------------------------------------------------
 
 void Pdf::buildRichTextContent(float viewWidth) {
-    if (!_richText || _pages.empty()) return;
+    if (!_richText || !_page) return;
 
     _richText->clear();
 
-    const auto& page = _pages[0];
+    const auto& page = *_page;
+    if (page.width <= 0.0f) return;
     float pdfWidth = page.width;
     float pdfHeight = page.height;
 
@@ -371,7 +573,9 @@ void Pdf::buildRichTextContent(float viewWidth) {
         textChar.y = screenY;
         textChar.size = fontSize;
         textChar.color = glm::vec4(r, g, b, a);
-        textChar.fontFamily = ch.fontFamily;
+        // Fonts without an atlas (no data, generation failed) use the default
+        auto doc = _docFonts.find(ch.fontKey);
+        textChar.fontFamily = doc != _docFonts.end() ? doc->second.family : std::string();
 
         // Determine style
         if (ch.bold && ch.italic) {
@@ -427,6 +631,9 @@ Result<void> Pdf::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on
         _initialized = true;
     }
 
+    // Swap in the requested page once the worker has extracted it
+    pollPage();
+
     // Re-layout if view size changed
     if (_lastViewWidth != _pixelWidth || _lastViewHeight != _pixelHeight) {
         buildRichTextContent(static_cast<float>(_pixelWidth));
@@ -483,13 +690,13 @@ bool Pdf::onKey(int key, int scancode, int action, int mods) {
     // Page Up/Down for navigation
     if (key == 266) {  // GLFW_KEY_PAGE_UP
         if (_currentPage > 0) {
-            (void)extractPageContent(_currentPage - 1);
+            requestPage(_currentPage - 1);
             _scrollOffset = 0;
             return true;
         }
     } else if (key == 267) {  // GLFW_KEY_PAGE_DOWN
         if (_currentPage < _pageCount - 1) {
-            (void)extractPageContent(_currentPage + 1);
+            requestPage(_currentPage + 1);
             _scrollOffset = 0;
             return true;
         }
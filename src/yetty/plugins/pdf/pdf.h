@@ -2,16 +2,21 @@
 
 #include <yetty/plugin.h>
 #include <yetty/rich-text.h>
+#include <yetty/lru-cache.h>
 #include <webgpu/webgpu.h>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace yetty {
 
 class Pdf;
 class FontManager;
+struct MupdfLocks;
 
 //-----------------------------------------------------------------------------
 // PDFPlugin - renders PDF documents using RichText
@@ -41,18 +46,27 @@ public:
 
     FontManager* getFontManager();
 
+    // Created with locking callbacks, so widgets can fz_clone_context() it
+    // for their extraction threads
     void* getMupdfContext() const noexcept { return _fzCtx; }
 
 private:
-    PDFPlugin() noexcept = default;
+    PDFPlugin() noexcept;
     Result<void> pluginInit() noexcept;
 
     void* _fzCtx = nullptr;  // fz_context*
+    std::unique_ptr<MupdfLocks> _fzLocks;
     FontManager* _fontManager = nullptr;
 };
 
 //-----------------------------------------------------------------------------
 // Pdf - single PDF document widget using RichText for rendering
+//
+// Pages are extracted (fz_stext_page -> ExtractedPage) on a worker thread
+// with its own cloned fz_context. The worker extracts the requested page
+// first and then prefetches its neighbours into a memory bounded LRU cache;
+// the render thread only swaps in finished pages, so flipping pages never
+// blocks on MuPDF. The document is only touched by the worker once it runs.
 //-----------------------------------------------------------------------------
 class Pdf : public Widget {
 public:
@@ -90,11 +104,18 @@ private:
     Result<void> init() override;
 
     Result<void> loadPDF(const std::string& path);
-    Result<void> extractPageContent(int pageNum);
     void buildRichTextContent(float viewWidth);
 
+    // Render thread: show page (cached, or once the worker has it)
+    void requestPage(int pageNum);
+    void pollPage();
+
+    // Extraction worker
+    void startWorker();
+    void stopWorker();
+    void workerLoop();
+
     // Font registration with FontManager
-    std::string registerFont(void* fzFont);
     Result<void> generateFontAtlases();
 
     PDFPlugin* _plugin = nullptr;
@@ -110,25 +131,56 @@ private:
         float x, y;              // PDF coordinates
         float size;              // Font size in PDF points
         uint32_t color;          // ARGB color
-        std::string fontFamily;  // Registered font family name
+        std::string fontKey;     // Document font, "name#<data hash>"; empty = default
         bool bold = false;
         bool italic = false;
     };
 
     struct ExtractedPage {
-        float width, height;
+        float width = 0.0f, height = 0.0f;  // Zero when extraction failed
         std::vector<ExtractedChar> chars;
     };
-
-    std::vector<ExtractedPage> _pages;
-    std::unordered_map<void*, std::string> _fontNameMap;  // fz_font* -> family name
+    using PagePtr = std::shared_ptr<const ExtractedPage>;
 
     // Store font data instead of FT_Face to avoid MuPDF lock callback issues
     struct PendingFont {
         std::vector<unsigned char> data;
         std::string name;
+        std::string key;  // FontManager::incrementalFamily(data, name)
+    };
+
+    // Worker thread only: extraction with the cloned context
+    PagePtr extractPage(void* fzCtx, int pageNum);
+    std::string registerFont(void* fzCtx, void* fzFont);
+    static size_t pageCost(const ExtractedPage& page);
+
+    // Render thread: rasterize the page's glyphs into the incremental atlases
+    void ensureGlyphs(const ExtractedPage& page);
+
+    static constexpr int PREFETCH_PAGES = 2;                     // Pages ahead and behind
+    static constexpr size_t PAGE_CACHE_BUDGET = 32 * 1024 * 1024;  // Bytes of extracted text
+
+    PagePtr _page;        // Page on screen
+    int _shownPage = -1;  // Page number of _page
+
+    // Shared with the worker, guarded by _workerMutex
+    std::thread _worker;
+    std::mutex _workerMutex;
+    std::condition_variable _workerCv;
+    bool _workerStop = false;
+    std::vector<int> _extractQueue;  // Requested page first, then prefetch
+    int _requestedPage = -1;
+    PagePtr _requestedReady;         // _requestedPage once extracted, even if evicted
+    LruCache<int, PagePtr> _pageCache{PAGE_CACHE_BUDGET};
+    std::vector<PendingFont> _pendingFonts;  // Seen by the worker, atlas not generated yet
+
+    std::unordered_map<void*, std::string> _fontKeyMap;  // fz_font* -> font key (worker)
+    struct DocFont {
+        Font* font = nullptr;
+        std::string family;                               // Registered RichText family
     };
-    std::unordered_map<void*, PendingFont> _pendingFonts;  // fz_font* -> font data for deferred atlas generation
+    std::unordered_map<std::string, DocFont> _docFonts;   // Font key -> atlas (render thread)
+    bool _persistFonts = true;                            // Save grown atlases on dispose
 
     // RichText for rendering
     RichText::Ptr _richText;
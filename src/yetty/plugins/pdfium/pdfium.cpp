@@ -2,6 +2,7 @@
 #include <yetty/yetty.h>
 #include <yetty/webgpu-context.h>
 #include <yetty/font-manager.h>
+#include <yetty/wgpu-compat.h>
 #include <ytrace/ytrace.hpp>
 #include <algorithm>
 #include <cmath>
@@ -84,6 +85,8 @@ Result<WidgetPtr> PdfiumPlugin::createWidget(
 PdfiumWidget::PdfiumWidget(const std::string& payload, PdfiumPlugin* plugin) noexcept
     : _plugin(plugin) {
     _payload = payload;
+    // Evicting a tile in view would recycle a layer drawn this frame
+    _tileCache.setPinned([this](const TileKey& key, const uint32_t&) { return _viewTiles.contains(key); });
 }
 
 PdfiumWidget::~PdfiumWidget() { (void)dispose(); }
@@ -103,8 +106,13 @@ Result<WidgetPtr> PdfiumWidget::create(
     (void)factory;
     (void)fontManager;
     (void)loop;
-    (void)pluginArgs;
     auto w = std::shared_ptr<PdfiumWidget>(new PdfiumWidget(payload, plugin));
+    w->_persistFonts = pluginArgs.find("--no-font-cache") == std::string::npos;
+    if (pluginArgs.find("--raster") != std::string::npos) {
+        w->_mode = RenderMode::Raster;
+    } else if (pluginArgs.find("--text") != std::string::npos) {
+        w->_mode = RenderMode::Text;
+    }
     w->_x = x;
     w->_y = y;
     w->_widthCells = widthCells;
@@ -126,7 +134,12 @@ Result<void> PdfiumWidget::init() {
 }
 
 Result<void> PdfiumWidget::dispose() {
+    // The tile worker renders from the document
+    stopTileWorker();
+    releaseTileResources();
+
     if (_doc) {
+        std::lock_guard<std::mutex> lock(_plugin->pdfiumMutex());
         FPDF_CloseDocument(static_cast<FPDF_DOCUMENT>(_doc));
         _doc = nullptr;
     }
@@ -137,10 +150,17 @@ Result<void> PdfiumWidget::dispose() {
     }
 
     _pages.clear();
-    _fontNameMap.clear();
-    _fontInfoToFamily.clear();
+    _fontKeyMap.clear();
     _processedFonts.clear();
     _pendingFonts.clear();
+
+    // Atlases stay with the FontManager, keep what this document rasterized
+    if (!_docFonts.empty() && _persistFonts) {
+        if (auto fontMgr = _plugin->getFontManager()) {
+            fontMgr->persistIncrementalFonts();
+        }
+    }
+    _docFonts.clear();
     _initialized = false;
     _failed = false;
     return Ok();
@@ -176,8 +196,8 @@ std::string PdfiumWidget::registerFont(FPDF_FONT font) {
     if (!font) return "";
 
     // Check if we already processed this font
-    auto it = _fontNameMap.find(font);
-    if (it != _fontNameMap.end()) {
+    auto it = _fontKeyMap.find(font);
+    if (it != _fontKeyMap.end()) {
         return it->second;
     }
 
@@ -202,8 +222,7 @@ std::string PdfiumWidget::registerFont(FPDF_FONT font) {
     int isEmbedded = FPDFFont_GetIsEmbedded(font);
     if (!isEmbedded) {
         yinfo("PdfiumWidget: font '{}' is not embedded, will use system fallback", fontFamily);
-        _fontNameMap[font] = "";  // Empty = use default
-        _fontInfoToFamily[baseName] = "";
+        _fontKeyMap[font] = "";  // Empty = use default
         return "";
     }
 
@@ -211,8 +230,7 @@ std::string PdfiumWidget::registerFont(FPDF_FONT font) {
     size_t dataLen = 0;
     if (!FPDFFont_GetFontData(font, nullptr, 0, &dataLen) || dataLen == 0) {
         ywarn("PdfiumWidget: failed to get font data size for '{}'", fontFamily);
-        _fontNameMap[font] = "";
-        _fontInfoToFamily[baseName] = "";
+        _fontKeyMap[font] = "";
         return "";
     }
 
@@ -221,24 +239,25 @@ std::string PdfiumWidget::registerFont(FPDF_FONT font) {
     size_t actualLen = 0;
     if (!FPDFFont_GetFontData(font, fontData.data(), fontData.size(), &actualLen)) {
         ywarn("PdfiumWidget: failed to extract font data for '{}'", fontFamily);
-        _fontNameMap[font] = "";
-        _fontInfoToFamily[baseName] = "";
+        _fontKeyMap[font] = "";
         return "";
     }
 
     yinfo("PdfiumWidget: extracted embedded font '{}' ({} bytes)", fontFamily, actualLen);
 
+    // Embedded subsets often share a name; key by name and data hash, the
+    // same family the FontManager registers
+    std::string fontKey = FontManager::incrementalFamily(fontData.data(), actualLen, fontFamily);
+
     // Store for later atlas generation (need FontManager from plugin)
     PendingFont pending;
     pending.data = std::move(fontData);
     pending.name = fontFamily;
+    pending.key = fontKey;
     _pendingFonts[font] = std::move(pending);
-    _fontNameMap[font] = fontFamily;
+    _fontKeyMap[font] = fontKey;
 
-    // Map base font name to family name for FPDFText lookups
-    _fontInfoToFamily[baseName] = fontFamily;
-
-    return fontFamily;
+    return fontKey;
 }
 
 Result<void> PdfiumWidget::generateFontAtlases() {
@@ -252,21 +271,18 @@ Result<void> PdfiumWidget::generateFontAtlases() {
     }
 
     for (auto& [font, pending] : _pendingFonts) {
-        // Check if font already registered
-        if (fontMgr->hasFont(pending.name)) {
-            yinfo("PdfiumWidget: font '{}' already in cache", pending.name);
-            continue;
-        }
-
-        // Generate MSDF atlas for the embedded font
-        yinfo("PdfiumWidget: generating MSDF atlas for '{}'...", pending.name);
-        auto result = fontMgr->getFont(pending.data.data(), pending.data.size(), pending.name, 32.0f);
+        // Empty atlas (or the one already shared in the FontManager), glyphs
+        // are rasterized per page by ensureGlyphs()
+        std::string family;
+        auto result = fontMgr->getIncrementalFont(pending.data.data(), pending.data.size(),
+                                                  pending.name, 32.0f, &family);
         if (!result) {
             ywarn("PdfiumWidget: failed to generate atlas for '{}': {}", pending.name, result.error().message());
             // Mark as failed - will use default font
-            _fontNameMap[font] = "";
+            _fontKeyMap[font] = "";
         } else {
-            yinfo("PdfiumWidget: successfully generated atlas for '{}'", pending.name);
+            ydebug("PdfiumWidget: incremental atlas for '{}'", pending.key);
+            _docFonts[pending.key] = DocFont{*result, std::move(family)};
         }
     }
 
@@ -274,6 +290,28 @@ Result<void> PdfiumWidget::generateFontAtlases() {
     return Ok();
 }
 
+void PdfiumWidget::ensureGlyphs(const ExtractedPage& page) {
+    if (_docFonts.empty()) return;
+
+    FontManager* fontMgr = _plugin->getFontManager();
+    if (!fontMgr) return;
+
+    // Font::addGlyphs skips codepoints already in the atlas
+    std::unordered_map<Font*, std::vector<uint32_t>> wanted;
+    for (const auto& ch : page.chars) {
+        if (ch.codepoint < 0x20) continue;
+        auto it = _docFonts.find(ch.fontKey);
+        if (it == _docFonts.end()) continue;
+        wanted[it->second.font].push_back(ch.codepoint);
+    }
+
+    for (auto& [font, codepoints] : wanted) {
+        if (auto res = fontMgr->addGlyphs(font, codepoints); !res) {
+            ywarn("PdfiumWidget: failed to add glyphs: {}", res.error().message());
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Font Extraction from Page Objects
 //-----------------------------------------------------------------------------
@@ -317,6 +355,9 @@ Result<void> PdfiumWidget::extractPageContent(int pageNum) {
     _currentPage = pageNum;
     _pages.clear();
 
+    // The tile worker may be rendering another tile right now
+    std::lock_guard<std::mutex> pdfiumLock(_plugin->pdfiumMutex());
+
     FPDF_PAGE page = FPDF_LoadPage(static_cast<FPDF_DOCUMENT>(_doc), pageNum);
     if (!page) {
         return Err<void>("Failed to load page");
@@ -330,12 +371,24 @@ Result<void> PdfiumWidget::extractPageContent(int pageNum) {
     pdfPage.width = static_cast<float>(pageWidth);
     pdfPage.height = static_cast<float>(pageHeight);
 
-    // Extract embedded fonts from page objects FIRST
-    extractFontsFromPage(page);
+    // Images don't survive the text path, rasterize such pages
+    _raster = _mode == RenderMode::Raster;
+    if (_mode == RenderMode::Auto) {
+        int objCount = FPDFPage_CountObjects(page);
+        for (int i = 0; i < objCount && !_raster; i++) {
+            FPDF_PAGEOBJECT obj = FPDFPage_GetObject(page, i);
+            _raster = obj && FPDFPageObj_GetType(obj) == FPDF_PAGEOBJ_IMAGE;
+        }
+    }
+
+    if (!_raster) {
+        // Extract embedded fonts from page objects FIRST
+        extractFontsFromPage(page);
 
-    // Generate MSDF atlases for extracted fonts
-    if (auto res = generateFontAtlases(); !res) {
-        ywarn("PdfiumWidget: failed to generate font atlases: {}", res.error().message());
+        // Generate MSDF atlases for extracted fonts
+        if (auto res = generateFontAtlases(); !res) {
+            ywarn("PdfiumWidget: failed to generate font atlases: {}", res.error().message());
+        }
     }
 
     // Load text page for character extraction
@@ -451,21 +504,16 @@ Result<void> PdfiumWidget::extractPageContent(int pageNum) {
             debugCount++;
         }
 
-        // Get font info (name and flags)
-        char fontInfoName[256] = {0};
+        // Get font flags
         int flags = 0;
-        unsigned long fontNameLen = FPDFText_GetFontInfo(textPage, i, fontInfoName, sizeof(fontInfoName), &flags);
-        (void)fontNameLen;
-
-        // Look up registered font family from the font info name
-        std::string fontInfoStr = fontInfoName;
-        auto fontIt = _fontInfoToFamily.find(fontInfoStr);
-        if (fontIt != _fontInfoToFamily.end()) {
-            textChar.fontFamily = fontIt->second;
-        } else {
-            // Font not found in our map - use default
-            textChar.fontFamily = "";
-        }
+        FPDFText_GetFontInfo(textPage, i, nullptr, 0, &flags);
+
+        // Key by the char's own font object, registered by extractFontsFromPage
+        // (font names are not unique within a document)
+        FPDF_PAGEOBJECT textObj = FPDFText_GetTextObject(textPage, i);
+        FPDF_FONT charFont = textObj ? FPDFTextObj_GetFont(textObj) : nullptr;
+        auto fontIt = charFont ? _fontKeyMap.find(charFont) : _fontKeyMap.end();
+        textChar.fontKey = fontIt != _fontKeyMap.end() ? fontIt->second : std::string();
 
         // Determine bold/italic from font flags
         // PDF font flags: bit 19 = force bold, bit 7 = italic
@@ -487,8 +535,16 @@ Result<void> PdfiumWidget::extractPageContent(int pageNum) {
     FPDFText_ClosePage(textPage);
     FPDF_ClosePage(page);
 
+    // Scanned pages have no text layer at all
+    if (_mode == RenderMode::Auto && pdfPage.chars.empty()) {
+        _raster = true;
+    }
+    if (!_raster) {
+        ensureGlyphs(pdfPage);
+    }
     _pages.push_back(std::move(pdfPage));
-    yinfo("PdfiumWidget: extracted {} valid characters from page {}", _pages[0].chars.size(), pageNum);
+    yinfo("PdfiumWidget: extracted {} valid characters from page {} ({} mode)",
+          _pages[0].chars.size(), pageNum, _raster ? "raster" : "text");
 
     // Force re-layout
     _lastViewWidth = 0;
@@ -554,7 +610,7 @@ void PdfiumWidget::buildRichTextContent(float viewWidth) {
         if (debugCount < 10) {
             yinfo("PdfiumWidget: screen[{}] cp={} ('{}') baseline=({:.1f},{:.1f}) pdfiumAscent={:.1f} fontSize={:.1f} font={}",
                   debugCount, ch.codepoint, (ch.codepoint > 31 && ch.codepoint < 127) ? (char)ch.codepoint : '?',
-                  baselineScreenX, baselineScreenY, pdfiumAscent, fontSize, ch.fontFamily);
+                  baselineScreenX, baselineScreenY, pdfiumAscent, fontSize, ch.fontKey);
             debugCount++;
         }
 
@@ -566,7 +622,8 @@ void PdfiumWidget::buildRichTextContent(float viewWidth) {
         textChar.y = baselineScreenY - pdfiumAscent;  // Glyph TOP = baseline - ascent (screen Y-down)
         textChar.size = fontSize;
         textChar.color = glm::vec4(r, g, b, a);
-        textChar.fontFamily = ch.fontFamily;
+        auto doc = _docFonts.find(ch.fontKey);
+        textChar.fontFamily = doc != _docFonts.end() ? doc->second.family : std::string();
         // prePositioned=true: position is glyph top-left (computed from PDFium's ascent)
         textChar.prePositioned = true;
         // Set target size from charbox
@@ -605,6 +662,10 @@ Result<void> PdfiumWidget::render(WGPURenderPassEncoder pass, WebGPUContext& ctx
     if (!on || _failed || !_visible) return Ok();
     if (_pixelWidth <= 0 || _pixelHeight <= 0) return Ok();
 
+    if (_raster) {
+        return renderTiles(pass, ctx);
+    }
+
     // Create RichText if needed
     if (!_richText) {
         auto fontMgr = _plugin->getFontManager();
@@ -637,6 +698,484 @@ Result<void> PdfiumWidget::render(WGPURenderPassEncoder pass, WebGPUContext& ctx
                              _pixelX, _pixelY, static_cast<float>(_pixelWidth), static_cast<float>(_pixelHeight));
 }
 
+//-----------------------------------------------------------------------------
+// Raster Tiles (render thread)
+//-----------------------------------------------------------------------------
+
+Result<void> PdfiumWidget::renderTiles(WGPURenderPassEncoder pass, WebGPUContext& ctx) {
+    if (_pages.empty() || _pages[0].width <= 0.0f) return Ok();
+    const auto& page = _pages[0];
+
+    if (!_tilePipeline) {
+        if (auto res = createTilePipeline(ctx); !res) {
+            _failed = true;
+            return Err<void>("PdfiumWidget: failed to create tile pipeline", res);
+        }
+    }
+    if (!_tileWorker.joinable()) {
+        startTileWorker();
+    }
+
+    // Same fit-to-width scale as the text path
+    float scale = static_cast<float>(_pixelWidth) / page.width * _zoom;
+    int scaleKey = static_cast<int>(std::lround(scale * 1000.0f));
+    _documentHeight = std::ceil(page.height * scale);
+    float maxScroll = std::max(0.0f, _documentHeight - static_cast<float>(_pixelHeight));
+    _scrollOffset = std::clamp(_scrollOffset, 0.0f, maxScroll);
+
+    // Pin this frame's tiles before uploads evict
+    _viewTiles = visibleTiles(page, scale, scaleKey, scale);
+    uploadFinishedTiles(ctx);
+
+    std::vector<TileInstance> instances;
+
+    // Page background, shows until the tiles arrive
+    {
+        float sw = static_cast<float>(ctx.getSurfaceWidth());
+        float sh = static_cast<float>(ctx.getSurfaceHeight());
+        float w = std::min(static_cast<float>(_pixelWidth), std::ceil(page.width * scale));
+        float h = std::clamp(_documentHeight - _scrollOffset, 0.0f, static_cast<float>(_pixelHeight));
+        TileInstance bg = {};
+        bg.rect[0] = _pixelX / sw * 2.0f - 1.0f;
+        bg.rect[1] = 1.0f - _pixelY / sh * 2.0f;
+        bg.rect[2] = w / sw * 2.0f;
+        bg.rect[3] = h / sh * 2.0f;
+        bg.layer = BACKGROUND_LAYER;
+        instances.push_back(bg);
+    }
+
+    float surfaceW = static_cast<float>(ctx.getSurfaceWidth());
+    float surfaceH = static_cast<float>(ctx.getSurfaceHeight());
+
+    // Previous zoom level stretched underneath while the new tiles render
+    if (_fallbackScaleKey != 0 && _fallbackScaleKey != scaleKey) {
+        appendTileInstances(instances, page, _fallbackScale, _fallbackScaleKey, scale,
+                            surfaceW, surfaceH, nullptr);
+    }
+
+    std::vector<TileJob> missing;
+    if (appendTileInstances(instances, page, scale, scaleKey, scale, surfaceW, surfaceH, &missing)) {
+        _fallbackScale = scale;
+        _fallbackScaleKey = scaleKey;
+    }
+    queueTiles(std::move(missing));
+
+    if (instances.size() > MAX_TILE_INSTANCES) {
+        instances.resize(MAX_TILE_INSTANCES);
+    }
+    size_t bytes = instances.size() * sizeof(TileInstance);
+    if (instances.size() != _lastInstances.size() ||
+        std::memcmp(instances.data(), _lastInstances.data(), bytes) != 0) {
+        wgpuQueueWriteBuffer(ctx.getQueue(), _tileInstanceBuffer, 0, instances.data(), bytes);
+        _lastInstances = instances;
+    }
+
+    // Tiles overhang the widget, clip them (clamped to screen)
+    float sx = std::max(0.0f, _pixelX);
+    float sy = std::max(0.0f, _pixelY);
+    float sw = std::min(static_cast<float>(_pixelWidth), ctx.getSurfaceWidth() - sx);
+    float sh = std::min(static_cast<float>(_pixelHeight), ctx.getSurfaceHeight() - sy);
+    if (sw <= 0 || sh <= 0) return Ok();
+
+    wgpuRenderPassEncoderSetScissorRect(pass, static_cast<uint32_t>(sx), static_cast<uint32_t>(sy),
+                                        static_cast<uint32_t>(sw), static_cast<uint32_t>(sh));
+    wgpuRenderPassEncoderSetPipeline(pass, _tilePipeline);
+    wgpuRenderPassEncoderSetBindGroup(pass, 0, _tileBindGroup, 0, nullptr);
+    wgpuRenderPassEncoderDraw(pass, 6, static_cast<uint32_t>(instances.size()), 0, 0);
+    wgpuRenderPassEncoderSetScissorRect(pass, 0, 0, ctx.getSurfaceWidth(), ctx.getSurfaceHeight());
+
+    return Ok();
+}
+
+// Tiles of the page rendered at 'tileScale' that intersect the view (laid
+// out at 'viewScale')
+PdfiumWidget::TileRange PdfiumWidget::visibleTiles(const ExtractedPage& page, float tileScale,
+                                                   int tileScaleKey, float viewScale) const {
+    TileRange range;
+    range.page = _currentPage;
+    range.scaleKey = tileScaleKey;
+    range.pageW = static_cast<int>(std::ceil(page.width * tileScale));
+    range.pageH = static_cast<int>(std::ceil(page.height * tileScale));
+    if (range.pageW <= 0 || range.pageH <= 0) return range;
+
+    int tilesX = (range.pageW + TILE_SIZE - 1) / TILE_SIZE;
+    range.tilesY = (range.pageH + TILE_SIZE - 1) / TILE_SIZE;
+
+    // View rectangle in tile pixels
+    float ratio = viewScale / tileScale;
+    float top = _scrollOffset / ratio;
+    float bottom = (_scrollOffset + static_cast<float>(_pixelHeight)) / ratio;
+    float right = static_cast<float>(_pixelWidth) / ratio;
+
+    range.tx1 = std::min(tilesX, static_cast<int>(std::ceil(right / TILE_SIZE)));
+    range.ty0 = std::clamp(static_cast<int>(top) / TILE_SIZE, 0, range.tilesY - 1);
+    range.ty1 = std::clamp(static_cast<int>(std::ceil(bottom)) / TILE_SIZE, 0, range.tilesY - 1);
+    return range;
+}
+
+// Adds the resident tiles of the page rendered at 'tileScale' that intersect
+// the view (laid out at 'viewScale'). With 'missing' set, tiles that still
+// need rendering are collected there - visible rows first, then one row of
+// prefetch on either side, no more than the layers left next to the drawn
+// tiles. Returns true when every visible tile was drawn.
+bool PdfiumWidget::appendTileInstances(std::vector<TileInstance>& out, const ExtractedPage& page,
+                                       float tileScale, int tileScaleKey, float viewScale,
+                                       float surfaceW, float surfaceH,
+                                       std::vector<TileJob>* missing) {
+    TileRange range = visibleTiles(page, tileScale, tileScaleKey, viewScale);
+    if (range.pageW <= 0 || range.pageH <= 0) return true;
+
+    int pageW = range.pageW;
+    int pageH = range.pageH;
+    float ratio = viewScale / tileScale;
+
+    bool complete = true;
+    size_t drawn = 0;
+    for (int ty = range.ty0; ty <= range.ty1; ty++) {
+        for (int tx = 0; tx < range.tx1; tx++) {
+            TileKey key{_currentPage, tileScaleKey, tx, ty};
+
+            // Only tiles of the current zoom level count as recently used
+            const uint32_t* layer = missing ? _tileCache.get(key) : _tileCache.peek(key);
+            if (!layer) {
+                if (missing) {
+                    missing->push_back(TileJob{key, pageW, pageH});
+                }
+                complete = false;
+                continue;
+            }
+
+            int coveredW = std::min(TILE_SIZE, pageW - tx * TILE_SIZE);
+            int coveredH = std::min(TILE_SIZE, pageH - ty * TILE_SIZE);
+            float x = _pixelX + tx * TILE_SIZE * ratio;
+            float y = _pixelY + ty * TILE_SIZE * ratio - _scrollOffset;
+
+            TileInstance inst = {};
+            inst.rect[0] = x / surfaceW * 2.0f - 1.0f;
+            inst.rect[1] = 1.0f - y / surfaceH * 2.0f;
+            inst.rect[2] = coveredW * ratio / surfaceW * 2.0f;
+            inst.rect[3] = coveredH * ratio / surfaceH * 2.0f;
+            inst.uvMax[0] = static_cast<float>(coveredW) / TILE_SIZE;
+            inst.uvMax[1] = static_cast<float>(coveredH) / TILE_SIZE;
+            inst.layer = *layer;
+            out.push_back(inst);
+            drawn++;
+        }
+    }
+
+    if (missing) {
+        for (int ty : {range.ty0 - 1, range.ty1 + 1}) {
+            if (ty < 0 || ty >= range.tilesY) continue;
+            for (int tx = 0; tx < range.tx1; tx++) {
+                TileKey key{_currentPage, tileScaleKey, tx, ty};
+                if (!_tileCache.contains(key)) {
+                    missing->push_back(TileJob{key, pageW, pageH});
+                }
+            }
+        }
+
+        // Drawn tiles are pinned; more jobs than free layers would evict
+        // each other on upload and render over and over
+        size_t room = TILE_LAYERS > drawn ? TILE_LAYERS - drawn : 0;
+        if (missing->size() > room) {
+            missing->resize(room);
+        }
+    }
+
+    return complete;
+}
+
+void PdfiumWidget::queueTiles(std::vector<TileJob> jobs) {
+    bool pending = false;
+    {
+        std::lock_guard<std::mutex> lock(_tileMutex);
+        if (_tileInFlight) {
+            jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                                      [&](const TileJob& j) { return j.key == *_tileInFlight; }),
+                       jobs.end());
+        }
+        // Finished but not uploaded yet
+        for (const auto& done : _finishedTiles) {
+            jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                                      [&](const TileJob& j) { return j.key == done.key; }),
+                       jobs.end());
+        }
+        // Replaces what was queued: tiles scrolled out of view are dropped
+        _tileJobs = std::move(jobs);
+        pending = !_tileJobs.empty();
+    }
+    if (pending) {
+        _tileCv.notify_one();
+    }
+}
+
+void PdfiumWidget::uploadFinishedTiles(WebGPUContext& ctx) {
+    std::vector<RenderedTile> finished;
+    {
+        std::lock_guard<std::mutex> lock(_tileMutex);
+        finished.swap(_finishedTiles);
+    }
+
+    for (auto& tile : finished) {
+        if (_tileCache.contains(tile.key)) continue;  // Rendered twice
+
+        // A full cache evicts its coldest tile out of view here, freeing a layer
+        _tileCache.put(tile.key, BACKGROUND_LAYER, 1);
+        if (_freeLayers.empty()) {
+            _tileCache.erase(tile.key);
+            continue;
+        }
+        uint32_t layer = _freeLayers.back();
+        _freeLayers.pop_back();
+        *_tileCache.get(tile.key) = layer;
+
+        WGPUTexelCopyTextureInfo dst = {};
+        dst.texture = _tileTexture;
+        dst.origin = {0, 0, layer};
+        dst.aspect = WGPUTextureAspect_All;
+        WGPUTexelCopyBufferLayout layout = {};
+        layout.bytesPerRow = TILE_SIZE * 4;
+        layout.rowsPerImage = TILE_SIZE;
+        WGPUExtent3D extent = {TILE_SIZE, TILE_SIZE, 1};
+        wgpuQueueWriteTexture(ctx.getQueue(), &dst, tile.pixels.data(), tile.pixels.size(), &layout, &extent);
+    }
+}
+
+Result<void> PdfiumWidget::createTilePipeline(WebGPUContext& ctx) {
+    WGPUDevice device = ctx.getDevice();
+
+    WGPUTextureDescriptor texDesc = {};
+    texDesc.size.width = TILE_SIZE;
+    texDesc.size.height = TILE_SIZE;
+    texDesc.size.depthOrArrayLayers = TILE_LAYERS;
+    texDesc.mipLevelCount = 1;
+    texDesc.sampleCount = 1;
+    texDesc.dimension = WGPUTextureDimension_2D;
+    texDesc.format = WGPUTextureFormat_RGBA8Unorm;
+    texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
+    _tileTexture = wgpuDeviceCreateTexture(device, &texDesc);
+    if (!_tileTexture) return Err<void>("Failed to create tile texture array");
+
+    WGPUTextureViewDescriptor viewDesc = {};
+    viewDesc.format = WGPUTextureFormat_RGBA8Unorm;
+    viewDesc.dimension = WGPUTextureViewDimension_2DArray;
+    viewDesc.mipLevelCount = 1;
+    viewDesc.arrayLayerCount = TILE_LAYERS;
+    _tileTextureView = wgpuTextureCreateView(_tileTexture, &viewDesc);
+    if (!_tileTextureView) return Err<void>("Failed to create tile texture view");
+
+    WGPUSamplerDescriptor samplerDesc = {};
+    samplerDesc.minFilter = WGPUFilterMode_Linear;
+    samplerDesc.magFilter = WGPUFilterMode_Linear;
+    samplerDesc.addressModeU = WGPUAddressMode_ClampToEdge;
+    samplerDesc.addressModeV = WGPUAddressMode_ClampToEdge;
+    samplerDesc.addressModeW = WGPUAddressMode_ClampToEdge;
+    samplerDesc.maxAnisotropy = 1;
+    _tileSampler = wgpuDeviceCreateSampler(device, &samplerDesc);
+    if (!_tileSampler) return Err<void>("Failed to create tile sampler");
+
+    WGPUBufferDescriptor bufDesc = {};
+    bufDesc.size = MAX_TILE_INSTANCES * sizeof(TileInstance);
+    bufDesc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+    _tileInstanceBuffer = wgpuDeviceCreateBuffer(device, &bufDesc);
+    if (!_tileInstanceBuffer) return Err<void>("Failed to create tile instance buffer");
+
+    const char* shaderCode = R"(
+struct Tile { rect: vec4<f32>, uvMax: vec2<f32>, layer: u32, pad: u32, }
+@group(0) @binding(0) var<storage, read> tiles: array<Tile>;
+@group(0) @binding(1) var texSampler: sampler;
+@group(0) @binding(2) var tex: texture_2d_array<f32>;
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) uv: vec2<f32>,
+    @location(1) @interpolate(flat) layer: u32,
+}
+@vertex fn vs_main(@builtin(vertex_index) vi: u32, @builtin(instance_index) ii: u32) -> VertexOutput {
+    var p = array<vec2<f32>,6>(vec2(0.,0.),vec2(1.,0.),vec2(1.,1.),vec2(0.,0.),vec2(1.,1.),vec2(0.,1.));
+    let pos = p[vi];
+    let t = tiles[ii];
+    var o: VertexOutput;
+    o.position = vec4(t.rect.x + pos.x * t.rect.z, t.rect.y - pos.y * t.rect.w, 0., 1.);
+    o.uv = pos * t.uvMax;
+    o.layer = t.layer;
+    return o;
+}
+@fragment fn fs_main(v: VertexOutput) -> @location(0) vec4<f32> {
+    // Sample before branching (uniform control flow); the background
+    // marker is masked into range and its result discarded
+    let c = textureSample(tex, texSampler, v.uv, v.layer & 0xFFu);
+    if (v.layer == 0xFFFFFFFFu) { return vec4(1., 1., 1., 1.); }
+    return c;
+}
+)";
+
+    WGPUShaderSourceWGSL wgslDesc = {};
+    wgslDesc.chain.sType = WGPUSType_ShaderSourceWGSL;
+    wgslDesc.code = WGPU_STR(shaderCode);
+    WGPUShaderModuleDescriptor shaderDesc = {};
+    shaderDesc.nextInChain = &wgslDesc.chain;
+    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    if (!shaderModule) return Err<void>("Failed to create tile shader module");
+
+    WGPUBindGroupLayoutEntry entries[3] = {};
+    entries[0].binding = 0; entries[0].visibility = WGPUShaderStage_Vertex;
+    entries[0].buffer.type = WGPUBufferBindingType_ReadOnlyStorage;
+    entries[1].binding = 1; entries[1].visibility = WGPUShaderStage_Fragment;
+    entries[1].sampler.type = WGPUSamplerBindingType_Filtering;
+    entries[2].binding = 2; entries[2].visibility = WGPUShaderStage_Fragment;
+    entries[2].texture.sampleType = WGPUTextureSampleType_Float;
+    entries[2].texture.viewDimension = WGPUTextureViewDimension_2DArray;
+
+    WGPUBindGroupLayoutDescriptor bglDesc = {};
+    bglDesc.entryCount = 3; bglDesc.entries = entries;
+    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
+    if (!bgl) { wgpuShaderModuleRelease(shaderModule); return Err<void>("Failed to create tile bgl"); }
+
+    WGPUPipelineLayoutDescriptor plDesc = {};
+    plDesc.bindGroupLayoutCount = 1; plDesc.bindGroupLayouts = &bgl;
+    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
+
+    WGPUBindGroupEntry bgE[3] = {};
+    bgE[0].binding = 0; bgE[0].buffer = _tileInstanceBuffer; bgE[0].size = bufDesc.size;
+    bgE[1].binding = 1; bgE[1].sampler = _tileSampler;
+    bgE[2].binding = 2; bgE[2].textureView = _tileTextureView;
+    WGPUBindGroupDescriptor bgDesc = {};
+    bgDesc.layout = bgl; bgDesc.entryCount = 3; bgDesc.entries = bgE;
+    _tileBindGroup = wgpuDeviceCreateBindGroup(device, &bgDesc);
+
+    WGPURenderPipelineDescriptor pipelineDesc = {};
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.vertex.module = shaderModule;
+    pipelineDesc.vertex.entryPoint = WGPU_STR("vs_main");
+    WGPUFragmentState fragState = {};
+    fragState.module = shaderModule; fragState.entryPoint = WGPU_STR("fs_main");
+    WGPUColorTargetState colorTarget = {};
+    colorTarget.format = ctx.getSurfaceFormat(); colorTarget.writeMask = WGPUColorWriteMask_All;
+    fragState.targetCount = 1; fragState.targets = &colorTarget;
+    pipelineDesc.fragment = &fragState;
+    pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+    pipelineDesc.multisample.count = 1; pipelineDesc.multisample.mask = ~0u;
+
+    _tilePipeline = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+
+    wgpuShaderModuleRelease(shaderModule);
+    wgpuBindGroupLayoutRelease(bgl);
+    wgpuPipelineLayoutRelease(pipelineLayout);
+
+    if (!_tileBindGroup || !_tilePipeline) return Err<void>("Failed to create tile render pipeline");
+
+    _freeLayers.clear();
+    for (uint32_t layer = TILE_LAYERS; layer > 0; layer--) {
+        _freeLayers.push_back(layer - 1);
+    }
+
+    ydebug("PdfiumWidget: tile pipeline created ({} layers)", TILE_LAYERS);
+    return Ok();
+}
+
+void PdfiumWidget::releaseTileResources() {
+    if (_tilePipeline) { wgpuRenderPipelineRelease(_tilePipeline); _tilePipeline = nullptr; }
+    if (_tileBindGroup) { wgpuBindGroupRelease(_tileBindGroup); _tileBindGroup = nullptr; }
+    if (_tileInstanceBuffer) { wgpuBufferRelease(_tileInstanceBuffer); _tileInstanceBuffer = nullptr; }
+    if (_tileSampler) { wgpuSamplerRelease(_tileSampler); _tileSampler = nullptr; }
+    if (_tileTextureView) { wgpuTextureViewRelease(_tileTextureView); _tileTextureView = nullptr; }
+    if (_tileTexture) { wgpuTextureRelease(_tileTexture); _tileTexture = nullptr; }
+
+    _tileCache.clear();
+    _freeLayers.clear();
+    _viewTiles = TileRange{};
+    _lastInstances.clear();
+    _fallbackScale = 0.0f;
+    _fallbackScaleKey = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Raster Tiles (worker thread)
+//-----------------------------------------------------------------------------
+
+void PdfiumWidget::startTileWorker() {
+    _tileStop = false;
+    _tileWorker = std::thread([this] { tileWorkerLoop(); });
+}
+
+void PdfiumWidget::stopTileWorker() {
+    if (!_tileWorker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(_tileMutex);
+        _tileStop = true;
+        _tileJobs.clear();
+    }
+    _tileCv.notify_one();
+    _tileWorker.join();
+    _tileInFlight.reset();
+    _finishedTiles.clear();
+}
+
+void PdfiumWidget::tileWorkerLoop() {
+    // PDFium calls below run under the plugin lock; the page stays loaded
+    // between tiles and is reloaded when the job moves to another page
+    FPDF_PAGE page = nullptr;
+    int loadedPage = -1;
+    FPDF_BITMAP bitmap = nullptr;
+
+    for (;;) {
+        TileJob job;
+        {
+            std::unique_lock<std::mutex> lock(_tileMutex);
+            _tileInFlight.reset();
+            _tileCv.wait(lock, [this] { return _tileStop || !_tileJobs.empty(); });
+            if (_tileStop) break;
+            job = _tileJobs.front();
+            _tileJobs.erase(_tileJobs.begin());
+            _tileInFlight = job.key;
+        }
+
+        RenderedTile tile;
+        tile.key = job.key;
+        {
+            std::lock_guard<std::mutex> pdfiumLock(_plugin->pdfiumMutex());
+            if (loadedPage != job.key.page) {
+                if (page) FPDF_ClosePage(page);
+                page = FPDF_LoadPage(static_cast<FPDF_DOCUMENT>(_doc), job.key.page);
+                loadedPage = page ? job.key.page : -1;
+            }
+            if (!bitmap) {
+                bitmap = FPDFBitmap_Create(TILE_SIZE, TILE_SIZE, 0);
+            }
+            if (!page || !bitmap) {
+                ywarn("PdfiumWidget: cannot render tile of page {}", job.key.page);
+                continue;
+            }
+
+            // Render the whole page offset so that this tile lands at 0,0
+            FPDFBitmap_FillRect(bitmap, 0, 0, TILE_SIZE, TILE_SIZE, 0xFFFFFFFF);
+            FPDF_RenderPageBitmap(bitmap, page,
+                                  -job.key.tx * TILE_SIZE, -job.key.ty * TILE_SIZE,
+                                  job.pageWidthPx, job.pageHeightPx, 0,
+                                  FPDF_ANNOT | FPDF_REVERSE_BYTE_ORDER);
+
+            // RGBx with REVERSE_BYTE_ORDER, force opaque alpha
+            const uint8_t* src = static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap));
+            int stride = FPDFBitmap_GetStride(bitmap);
+            tile.pixels.resize(static_cast<size_t>(TILE_SIZE) * TILE_SIZE * 4);
+            for (int y = 0; y < TILE_SIZE; y++) {
+                uint8_t* dst = tile.pixels.data() + static_cast<size_t>(y) * TILE_SIZE * 4;
+                std::memcpy(dst, src + static_cast<size_t>(y) * stride, TILE_SIZE * 4);
+                for (int x = 0; x < TILE_SIZE; x++) {
+                    dst[x * 4 + 3] = 255;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_tileMutex);
+        _finishedTiles.push_back(std::move(tile));
+    }
+
+    std::lock_guard<std::mutex> pdfiumLock(_plugin->pdfiumMutex());
+    if (bitmap) FPDFBitmap_Destroy(bitmap);
+    if (page) FPDF_ClosePage(page);
+}
+
 //-----------------------------------------------------------------------------
 // Mouse Scroll
 //-----------------------------------------------------------------------------
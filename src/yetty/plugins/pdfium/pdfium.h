@@ -2,11 +2,16 @@
 
 #include <yetty/plugin.h>
 #include <yetty/rich-text.h>
+#include <yetty/lru-cache.h>
 #include <webgpu/webgpu.h>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <optional>
 #include <set>
 
 // Include PDFium headers for proper type declarations
@@ -46,16 +51,28 @@ public:
 
     FontManager* getFontManager() const { return _fontManager; }
 
+    // PDFium is not thread-safe: every FPDF call, from any widget or
+    // tile worker, is made with this lock held
+    std::mutex& pdfiumMutex() { return _pdfiumMutex; }
+
 private:
     PdfiumPlugin() noexcept = default;
     Result<void> pluginInit() noexcept;
 
     FontManager* _fontManager = nullptr;
     bool _libraryInitialized = false;
+    std::mutex _pdfiumMutex;
 };
 
 //-----------------------------------------------------------------------------
 // PdfiumWidget - single PDF document widget using RichText for rendering
+//
+// Pages with images (or without extractable text) are rasterized instead:
+// a worker renders TILE_SIZE tiles with FPDF_RenderPageBitmap at the
+// current zoom, tiles live in the layers of a texture array with LRU
+// eviction (tiles in view are pinned), and only the visible tiles are drawn. While zooming, tiles of
+// the last complete zoom level are stretched until the new ones arrive.
+// --raster / --text force a mode for every page.
 //-----------------------------------------------------------------------------
 class PdfiumWidget : public Widget {
 public:
@@ -114,7 +131,7 @@ private:
         float ascent;            // Distance from baseline to charbox TOP (positive)
         float size;              // Font size in PDF points
         uint32_t color;          // ARGB color
-        std::string fontFamily;  // Registered font family name
+        std::string fontKey;     // Document font, "name#<data hash>"; empty = default
         bool bold = false;
         bool italic = false;
     };
@@ -126,20 +143,124 @@ private:
 
     std::vector<ExtractedPage> _pages;
 
-    // Font tracking - map font pointer to registered family name
-    std::unordered_map<FPDF_FONT, std::string> _fontNameMap;
+    // Font tracking - map font pointer to its key
+    std::unordered_map<FPDF_FONT, std::string> _fontKeyMap;
     std::set<FPDF_FONT> _processedFonts;
 
-    // Map from font info name (FPDFText_GetFontInfo) to registered font family name
-    std::unordered_map<std::string, std::string> _fontInfoToFamily;
-
     // Store font data for deferred atlas generation
     struct PendingFont {
         std::vector<unsigned char> data;
         std::string name;
+        std::string key;  // FontManager::incrementalFamily(data, name)
     };
     std::unordered_map<FPDF_FONT, PendingFont> _pendingFonts;
 
+    // Incremental atlases, glyphs are added per extracted page
+    void ensureGlyphs(const ExtractedPage& page);
+    struct DocFont {
+        Font* font = nullptr;
+        std::string family;  // Registered RichText family
+    };
+    std::unordered_map<std::string, DocFont> _docFonts;  // Font key -> atlas
+    bool _persistFonts = true;  // Save grown atlases on dispose
+
+    //-------------------------------------------------------------------------
+    // Raster tiles
+    //-------------------------------------------------------------------------
+    enum class RenderMode { Auto, Text, Raster };
+
+    struct TileKey {
+        int page;
+        int scaleKey;  // Pixels per PDF point * 1000
+        int tx, ty;
+        bool operator==(const TileKey& o) const {
+            return page == o.page && scaleKey == o.scaleKey && tx == o.tx && ty == o.ty;
+        }
+    };
+    struct TileKeyHash {
+        size_t operator()(const TileKey& k) const {
+            size_t h = std::hash<int>()(k.page);
+            h = h * 31 + std::hash<int>()(k.scaleKey);
+            h = h * 31 + std::hash<int>()(k.tx);
+            return h * 31 + std::hash<int>()(k.ty);
+        }
+    };
+    // Tiles of one zoom level intersecting the view: columns [0, tx1),
+    // rows [ty0, ty1]
+    struct TileRange {
+        int page = -1;
+        int scaleKey = 0;
+        int pageW = 0, pageH = 0;  // Whole page in tile pixels
+        int tilesY = 0;
+        int tx1 = 0, ty0 = 0, ty1 = -1;
+        bool contains(const TileKey& k) const {
+            return k.page == page && k.scaleKey == scaleKey && k.tx >= 0 && k.tx < tx1 &&
+                   k.ty >= ty0 && k.ty <= ty1;
+        }
+    };
+    struct TileJob {
+        TileKey key;
+        int pageWidthPx, pageHeightPx;  // Whole page at the tile's scale
+    };
+    struct RenderedTile {
+        TileKey key;
+        std::vector<uint8_t> pixels;  // TILE_SIZE x TILE_SIZE RGBA
+    };
+    struct TileInstance {
+        float rect[4];   // x, y, w, h in NDC
+        float uvMax[2];  // Part of the tile covered by the page
+        uint32_t layer;  // BACKGROUND_LAYER draws the page background
+        uint32_t _pad;
+    };
+
+    static constexpr int TILE_SIZE = 256;
+    static constexpr uint32_t TILE_LAYERS = 256;  // 64 MiB, the default maxTextureArrayLayers
+    static constexpr uint32_t BACKGROUND_LAYER = 0xFFFFFFFFu;
+    static constexpr uint32_t MAX_TILE_INSTANCES = TILE_LAYERS * 2 + 1;
+
+    Result<void> renderTiles(WGPURenderPassEncoder pass, WebGPUContext& ctx);
+    Result<void> createTilePipeline(WebGPUContext& ctx);
+    void releaseTileResources();
+    void uploadFinishedTiles(WebGPUContext& ctx);
+    TileRange visibleTiles(const ExtractedPage& page, float tileScale, int tileScaleKey,
+                           float viewScale) const;
+    bool appendTileInstances(std::vector<TileInstance>& out, const ExtractedPage& page,
+                             float tileScale, int tileScaleKey, float viewScale,
+                             float surfaceW, float surfaceH, std::vector<TileJob>* missing);
+    void queueTiles(std::vector<TileJob> jobs);
+
+    void startTileWorker();
+    void stopTileWorker();
+    void tileWorkerLoop();
+
+    RenderMode _mode = RenderMode::Auto;
+    bool _raster = false;  // Current page is drawn from tiles
+
+    // Shared with the tile worker, guarded by _tileMutex
+    std::thread _tileWorker;
+    std::mutex _tileMutex;
+    std::condition_variable _tileCv;
+    bool _tileStop = false;
+    std::vector<TileJob> _tileJobs;            // Visible first, then prefetch
+    std::optional<TileKey> _tileInFlight;      // Being rendered by the worker
+    std::vector<RenderedTile> _finishedTiles;  // Waiting for upload
+
+    // Render thread: resident tiles -> texture array layer
+    std::vector<uint32_t> _freeLayers;
+    LruCache<TileKey, uint32_t, TileKeyHash> _tileCache{
+        TILE_LAYERS, [this](const TileKey&, uint32_t& layer) { _freeLayers.push_back(layer); }};
+    TileRange _viewTiles;  // Current zoom level in view, pinned in _tileCache
+    float _fallbackScale = 0.0f;  // Last zoom level with all visible tiles resident
+    int _fallbackScaleKey = 0;
+    std::vector<TileInstance> _lastInstances;
+
+    WGPUTexture _tileTexture = nullptr;
+    WGPUTextureView _tileTextureView = nullptr;
+    WGPUSampler _tileSampler = nullptr;
+    WGPUBuffer _tileInstanceBuffer = nullptr;
+    WGPUBindGroup _tileBindGroup = nullptr;
+    WGPURenderPipeline _tilePipeline = nullptr;
+
     // RichText for rendering
     RichText::Ptr _richText;
     float _documentHeight = 0.0f;
@@ -566,7 +566,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
     wgslDesc.code = WGPU_STR(shaderCode);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
     // Bind group layout
@@ -581,7 +581,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
     WGPUBindGroupLayoutDescriptor bglDesc = {};
     bglDesc.entryCount = 2;
     bglDesc.entries = entries;
-    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
+    WGPUBindGroupLayout bgl = ctx.shaderCache().createBindGroupLayout(&bglDesc);
     if (!bgl) {
         wgpuShaderModuleRelease(shaderModule);
         return Err<void>("Failed to create bind group layout");
@@ -591,7 +591,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 1;
     plDesc.bindGroupLayouts = &bgl;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
 
     // Bind group
     WGPUBindGroupEntry bgE[2] = {};
@@ -630,7 +630,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = ~0u;
 
-    pipeline_ = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    pipeline_ = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(shaderModule);
     wgpuBindGroupLayoutRelease(bgl);
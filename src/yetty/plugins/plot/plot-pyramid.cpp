@@ -0,0 +1,216 @@
+#include "plot-pyramid.h"
+#include <algorithm>
+#include <limits>
+
+namespace yetty {
+
+// Build: one task reduces an aligned chunk of 2^16 samples through the
+// lower levels; below this many samples it isn't worth waking the workers
+static constexpr uint32_t CHUNK_LEVELS = 16;
+static constexpr uint64_t PARALLEL_MIN = 1u << 18;
+
+static constexpr float INF = std::numeric_limits<float>::infinity();
+
+// Slots of a level holding `size` buckets of the ring: one more for a
+// window that does not start on a bucket boundary, rounded to a power of two
+static uint32_t levelSlots(uint32_t size) {
+    uint32_t slots = 2;
+    while (slots < size + 1) slots *= 2;
+    return slots;
+}
+
+PlotPyramid::~PlotPyramid() {
+    {
+        std::lock_guard<std::mutex> lock(_poolMutex);
+        _stop = true;
+    }
+    _poolCv.notify_all();
+    for (auto& worker : _workers) worker.join();
+}
+
+uint32_t PlotPyramid::bucketsFor(uint32_t capacity) {
+    uint32_t buckets = 0;
+    for (uint32_t size = capacity; size > 1;) {
+        size = (size + 1) / 2;
+        buckets += levelSlots(size);
+    }
+    return buckets;
+}
+
+void PlotPyramid::layout(uint32_t numPlots, uint32_t capacity) {
+    _numPlots = numPlots;
+    _capacity = capacity;
+    _levelOffset.assign(1, 0);
+    _levelSize.assign(1, capacity);
+    _buckets = 0;
+    _period = 1;
+
+    uint32_t size = capacity;
+    for (uint32_t level = 1; size > 1; ++level) {
+        size = (size + 1) / 2;
+        uint32_t slots = levelSlots(size);
+        _levelOffset.push_back(_buckets);
+        _levelSize.push_back(slots);
+        _buckets += slots;
+        _period = std::max(_period, slots << level);
+    }
+    _levels = static_cast<uint32_t>(_levelSize.size()) - 1;
+    _data.assign(static_cast<size_t>(_numPlots) * _buckets * 2, 0.0f);
+}
+
+void PlotPyramid::clear() {
+    _data.clear();
+    _levelOffset.clear();
+    _levelSize.clear();
+    _numPlots = 0;
+    _capacity = 0;
+    _levels = 0;
+    _buckets = 0;
+    _period = 1;
+}
+
+// Reduce buckets [k0, k1) of a level from the level below. Samples outside
+// the window [first, first + count) are left out; empty buckets end up
+// with min > max.
+void PlotPyramid::reduceLevel(const float* rings, uint64_t first, uint32_t count, uint32_t plot,
+                              uint32_t level, uint64_t k0, uint64_t k1) {
+    float* dst = _data.data() + (static_cast<size_t>(plot) * _buckets + _levelOffset[level]) * 2;
+    uint64_t mask = _levelSize[level] - 1;
+    uint64_t end = first + count;
+
+    if (level == 1) {
+        const float* src = rings + static_cast<size_t>(plot) * _capacity;
+        uint64_t s = std::max(k0 * 2, first);
+        uint32_t index = static_cast<uint32_t>(s % _capacity);
+        for (uint64_t k = k0; k < k1; ++k) {
+            float mn = INF, mx = -INF;
+            for (uint64_t e = std::min(k * 2 + 2, end); s < e; ++s) {
+                mn = std::min(mn, src[index]);
+                mx = std::max(mx, src[index]);
+                if (++index == _capacity) index = 0;
+            }
+            size_t slot = k & mask;
+            dst[slot * 2] = mn;
+            dst[slot * 2 + 1] = mx;
+        }
+        return;
+    }
+
+    const float* src = _data.data() + (static_cast<size_t>(plot) * _buckets + _levelOffset[level - 1]) * 2;
+    uint64_t childMask = _levelSize[level - 1] - 1;
+    uint64_t c0 = first >> (level - 1);
+    uint64_t c1 = count > 0 ? ((end - 1) >> (level - 1)) + 1 : c0;
+    for (uint64_t k = k0; k < k1; ++k) {
+        float mn = INF, mx = -INF;
+        for (uint64_t c = std::max(k * 2, c0), e = std::min(k * 2 + 2, c1); c < e; ++c) {
+            size_t slot = c & childMask;
+            mn = std::min(mn, src[slot * 2]);
+            mx = std::max(mx, src[slot * 2 + 1]);
+        }
+        size_t slot = k & mask;
+        dst[slot * 2] = mn;
+        dst[slot * 2 + 1] = mx;
+    }
+}
+
+void PlotPyramid::build(const float* rings, uint64_t first, uint32_t count) {
+    if (_levels == 0 || _numPlots == 0) return;
+
+    // Slots the window does not reach stay empty
+    for (size_t i = 0; i < _data.size(); i += 2) {
+        _data[i] = INF;
+        _data[i + 1] = -INF;
+    }
+    if (count == 0) return;
+    uint64_t end = first + count;
+
+    // Each task takes one aligned chunk of one plot through the lower
+    // levels, those chunks are independent. The few remaining top levels
+    // are reduced afterwards on this thread.
+    uint32_t chunkLevels = std::min(CHUNK_LEVELS, _levels);
+    uint64_t chunk0 = first >> chunkLevels;
+    uint32_t chunks = static_cast<uint32_t>(((end - 1) >> chunkLevels) - chunk0 + 1);
+    uint32_t tasks = _numPlots * chunks;
+
+    auto reduceChunk = [&](uint32_t task) {
+        uint32_t plot = task / chunks;
+        uint64_t chunk = chunk0 + task % chunks;
+        uint64_t s0 = std::max(first, chunk << chunkLevels);
+        uint64_t s1 = std::min(end, (chunk + 1) << chunkLevels);
+        for (uint32_t level = 1; level <= chunkLevels; ++level) {
+            reduceLevel(rings, first, count, plot, level, s0 >> level, ((s1 - 1) >> level) + 1);
+        }
+    };
+
+    if (tasks > 1 && uint64_t(_numPlots) * count >= PARALLEL_MIN) {
+        parallelFor(tasks, reduceChunk);
+    } else {
+        for (uint32_t t = 0; t < tasks; ++t) reduceChunk(t);
+    }
+
+    for (uint32_t level = chunkLevels + 1; level <= _levels; ++level) {
+        for (uint32_t plot = 0; plot < _numPlots; ++plot) {
+            reduceLevel(rings, first, count, plot, level, first >> level, ((end - 1) >> level) + 1);
+        }
+    }
+}
+
+void PlotPyramid::update(const float* rings, uint64_t first, uint32_t count, uint64_t start) {
+    uint64_t end = first + count;
+    start = std::max(start, first);
+    if (start >= end) return;
+
+    for (uint32_t level = 1; level <= _levels; ++level) {
+        for (uint32_t plot = 0; plot < _numPlots; ++plot) {
+            reduceLevel(rings, first, count, plot, level, start >> level, ((end - 1) >> level) + 1);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Build workers
+//-----------------------------------------------------------------------------
+
+void PlotPyramid::parallelFor(uint32_t tasks, const std::function<void(uint32_t)>& task) {
+    {
+        std::lock_guard<std::mutex> lock(_poolMutex);
+        if (_workers.empty()) {
+            uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+            for (uint32_t i = 1; i < threads; ++i) {
+                _workers.emplace_back([this] { workerLoop(); });
+            }
+        }
+        _task = &task;
+        _taskCount = tasks;
+        _nextTask = 0;
+        _busy = static_cast<uint32_t>(_workers.size());
+        ++_batch;
+    }
+    _poolCv.notify_all();
+
+    for (uint32_t t = _nextTask++; t < tasks; t = _nextTask++) task(t);
+
+    std::unique_lock<std::mutex> lock(_poolMutex);
+    _doneCv.wait(lock, [this] { return _busy == 0; });
+    _task = nullptr;
+}
+
+void PlotPyramid::workerLoop() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(_poolMutex);
+    while (true) {
+        _poolCv.wait(lock, [&] { return _stop || _batch != seen; });
+        if (_stop) return;
+        seen = _batch;
+        const auto* task = _task;
+        uint32_t tasks = _taskCount;
+
+        lock.unlock();
+        for (uint32_t t = _nextTask++; t < tasks; t = _nextTask++) (*task)(t);
+        lock.lock();
+
+        if (--_busy == 0) _doneCv.notify_one();
+    }
+}
+
+} // namespace yetty
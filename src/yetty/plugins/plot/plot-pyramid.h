@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// PlotPyramid - min/max level-of-detail pyramid over plot sample rings
+//
+// Samples are numbered in arrival order; the window holds `count` samples
+// starting at number `first`, and sample s lives at ring index
+// s % capacity. Bucket k of level L >= 1 covers samples
+// [k * 2^L, (k + 1) * 2^L), so after the ring wraps no bucket mixes the
+// newest samples with the oldest ones. Each level is a ring of
+// levelSize(L) = nextPow2(ceil(capacity / 2^L) + 1) slots, bucket k in slot
+// k % levelSize(L), which holds every bucket the window touches. Levels are
+// stored back to back per plot, so one plot's pyramid is buckets() pairs
+// starting at plot(p). Index 0 of the level tables is unused (level 0 is
+// the ring).
+//
+// period() is a multiple of levelSize(L) * 2^L for every level: the bucket
+// slots of sample first + i follow from first % period() + i.
+//
+// Only samples in the window are reduced; buckets without any end up with
+// min > max. Buckets at the old end of the window may still include
+// samples that have left it.
+//
+// Large builds run on worker threads started by the first one and parked
+// between builds.
+//-----------------------------------------------------------------------------
+class PlotPyramid {
+public:
+    PlotPyramid() = default;
+    ~PlotPyramid();
+
+    PlotPyramid(const PlotPyramid&) = delete;
+    PlotPyramid& operator=(const PlotPyramid&) = delete;
+
+    // Size the levels for numPlots rings of `capacity` samples, all zero
+    void layout(uint32_t numPlots, uint32_t capacity);
+    void clear();
+
+    // Rebuild every level from the window [first, first + count) of `rings`
+    // (numPlots * capacity samples)
+    void build(const float* rings, uint64_t first, uint32_t count);
+
+    // Refresh the buckets covering samples [start, first + count), the ones
+    // appended since the last build or update
+    void update(const float* rings, uint64_t first, uint32_t count, uint64_t start);
+
+    // Buckets per plot over all levels for a ring of `capacity` samples
+    static uint32_t bucketsFor(uint32_t capacity);
+
+    uint32_t levels() const { return _levels; }
+    uint32_t buckets() const { return _buckets; }
+    uint32_t levelOffset(uint32_t level) const { return _levelOffset[level]; }
+    uint32_t levelSize(uint32_t level) const { return _levelSize[level]; }
+    uint32_t period() const { return _period; }
+
+    // (min, max) pairs of one plot, buckets() of them
+    const float* plot(uint32_t p) const { return _data.data() + static_cast<size_t>(p) * _buckets * 2; }
+    bool empty() const { return _data.empty(); }
+
+private:
+    void reduceLevel(const float* rings, uint64_t first, uint32_t count, uint32_t plot,
+                     uint32_t level, uint64_t k0, uint64_t k1);
+
+    // Run task(0) .. task(tasks - 1) on the workers and this thread
+    void parallelFor(uint32_t tasks, const std::function<void(uint32_t)>& task);
+    void workerLoop();
+
+    std::vector<float> _data;
+    std::vector<uint32_t> _levelOffset;
+    std::vector<uint32_t> _levelSize;
+    uint32_t _numPlots = 0;
+    uint32_t _capacity = 0;
+    uint32_t _levels = 0;
+    uint32_t _buckets = 0;
+    uint32_t _period = 1;
+
+    // Build workers, guarded by _poolMutex
+    std::vector<std::thread> _workers;
+    std::mutex _poolMutex;
+    std::condition_variable _poolCv;  // New batch or stop
+    std::condition_variable _doneCv;  // A worker finished its share
+    const std::function<void(uint32_t)>* _task = nullptr;
+    uint32_t _taskCount = 0;
+    std::atomic<uint32_t> _nextTask{0};
+    uint64_t _batch = 0;
+    uint32_t _busy = 0;
+    bool _stop = false;
+};
+
+} // namespace yetty
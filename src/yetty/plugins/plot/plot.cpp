@@ -34,6 +34,9 @@ static const float DEFAULT_COLORS[16 * 4] = {
     0.6f, 0.6f, 0.6f, 1.0f,  // Gray
 };
 
+// Uniform buffer size (must match the Uniforms struct in render())
+static constexpr uint32_t UNIFORM_BUFFER_SIZE = 1040;
+
 //-----------------------------------------------------------------------------
 // PlotPlugin
 //-----------------------------------------------------------------------------
@@ -78,13 +81,13 @@ Result<WidgetPtr> PlotPlugin::createWidget(
     (void)widgetName;
     (void)factory;
     (void)loop;
-    (void)pluginArgs;
     yfunc();
-    yinfo("payload size={} x={} y={} w={} h={}", payload.size(), x, y, widthCells, heightCells);
+    yinfo("payload size={} x={} y={} w={} h={} pluginArgs='{}'", payload.size(), x, y,
+          widthCells, heightCells, pluginArgs);
 
     // Get default font for axis labels
     Font* font = fontManager ? fontManager->getDefaultFont() : nullptr;
-    auto result = Plot::create(payload, font);
+    auto result = Plot::create(payload, font, pluginArgs);
     if (result) {
         auto& widget = *result;
         widget->setPosition(x, y);
@@ -102,10 +105,12 @@ Plot::~Plot() {
 }
 
 Result<void> Plot::init() {
-    ydebug("Plot::init() called, payload.size={}", _payload.size());
+    // Shared memory payloads are parsed straight from the mapping
+    std::string_view payload = payloadView();
+    ydebug("Plot::init() called, payload.size={}", payload.size());
     std::memcpy(colors_, DEFAULT_COLORS, sizeof(colors_));
 
-    if (_payload.empty()) {
+    if (payload.empty()) {
         ydebug("Plot::init() empty payload, returning");
         return Ok();
     }
@@ -114,8 +119,8 @@ Result<void> Plot::init() {
     // Header size: 8 + 16 = 24 bytes
     constexpr size_t HEADER_SIZE = 24;
 
-    if (_payload.size() >= HEADER_SIZE) {
-        const uint8_t* data = reinterpret_cast<const uint8_t*>(_payload.data());
+    if (payload.size() >= HEADER_SIZE) {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(payload.data());
 
         uint32_t n, m;
         float xmin, xmax, ymin, ymax;
@@ -129,17 +134,17 @@ Result<void> Plot::init() {
         size_t expected_size = HEADER_SIZE + n * m * sizeof(float);
 
         // Check if this looks like valid binary data
-        if (n > 0 && n <= MAX_PLOTS && m > 0 && m <= 65536 &&
-            _payload.size() == expected_size &&
+        if (n > 0 && n <= MAX_PLOTS && m > 0 && m <= MAX_POINTS &&
+            fitsTexture(n, m) &&
+            payload.size() == expected_size &&
             std::isfinite(xmin) && std::isfinite(xmax) &&
             std::isfinite(ymin) && std::isfinite(ymax)) {
 
             numPlots_ = n;
-            numPoints_ = m;
-            data_.resize(numPlots_ * numPoints_);
+            resetRing(m, m);
             std::memcpy(data_.data(), data + HEADER_SIZE, numPlots_ * numPoints_ * sizeof(float));
             setViewport(xmin, xmax, ymin, ymax);
-            dataDirty_ = true;
+            fitDataX();
 
             yinfo("Plot: initialized from binary (N={}, M={}, viewport=[{},{},{},{}])",
                          numPlots_, numPoints_, xmin, xmax, ymin, ymax);
@@ -150,19 +155,25 @@ Result<void> Plot::init() {
     // Fallback: text format "N,M" or "N,M,xmin,xmax,ymin,ymax"
     uint32_t n = 0, m = 0;
     float xmin = 0, xmax = 1, ymin = 0, ymax = 1;
-    int parsed = sscanf(_payload.c_str(), "%u,%u,%f,%f,%f,%f",
+    std::string header(payload.substr(0, 256));
+    int parsed = sscanf(header.c_str(), "%u,%u,%f,%f,%f,%f",
                         &n, &m, &xmin, &xmax, &ymin, &ymax);
     if (parsed >= 2 && n > 0 && m > 0) {
         numPlots_ = std::min(n, MAX_PLOTS);
-        numPoints_ = m;
-        data_.resize(numPlots_ * numPoints_, 0.0f);
-        dataDirty_ = true;
+        // A streaming plot starts empty, M is its ring capacity
+        uint32_t capacity = std::min({m, MAX_POINTS,
+                                      MAX_TEXTURE_ROWS / numPlots_ * TEXTURE_ROW_WIDTH});
+        while (!fitsTexture(numPlots_, capacity)) {
+            capacity -= std::min(capacity - 1, TEXTURE_ROW_WIDTH);
+        }
+        resetRing(capacity, stream_ ? 0 : capacity);
         if (parsed >= 6) {
             setViewport(xmin, xmax, ymin, ymax);
         }
+        fitDataX();
     }
 
-    yinfo("Plot: initialized (N={}, M={})", numPlots_, numPoints_);
+    yinfo("Plot: initialized (N={}, M={}, stream={})", numPlots_, capacity_, stream_);
     return Ok();
 }
 
@@ -173,8 +184,14 @@ Result<void> Plot::dispose() {
     if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
     if (dataTextureView_) { wgpuTextureViewRelease(dataTextureView_); dataTextureView_ = nullptr; }
     if (dataTexture_) { wgpuTextureRelease(dataTexture_); dataTexture_ = nullptr; }
+    if (lodTextureView_) { wgpuTextureViewRelease(lodTextureView_); lodTextureView_ = nullptr; }
+    if (lodTexture_) { wgpuTextureRelease(lodTexture_); lodTexture_ = nullptr; }
     gpuInitialized_ = false;
     data_.clear();
+    pyramid_.clear();
+    numPoints_ = 0;
+    capacity_ = 0;
+    pendingCount_ = 0;
     return Ok();
 }
 
@@ -186,6 +203,8 @@ void Plot::releaseGPUResources() {
     if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
     if (dataTextureView_) { wgpuTextureViewRelease(dataTextureView_); dataTextureView_ = nullptr; }
     if (dataTexture_) { wgpuTextureRelease(dataTexture_); dataTexture_ = nullptr; }
+    if (lodTextureView_) { wgpuTextureViewRelease(lodTextureView_); lodTextureView_ = nullptr; }
+    if (lodTexture_) { wgpuTextureRelease(lodTexture_); lodTexture_ = nullptr; }
     gpuInitialized_ = false;
     dataDirty_ = true;  // Mark dirty to recreate texture data
     _ticksDirty = true;
@@ -201,16 +220,119 @@ Result<void> Plot::setData(const float* data, uint32_t numPlots, uint32_t numPoi
         return Err<void>("Invalid plot data");
     }
 
-    numPlots_ = std::min(numPlots, MAX_PLOTS);
-    numPoints_ = numPoints;
-    data_.resize(numPlots_ * numPoints_);
+    if (numPoints > MAX_POINTS ||
+        !fitsTexture(std::min(numPlots, MAX_PLOTS), numPoints)) {
+        return Err<void>("Plot: too many points");
+    }
+
+    uint32_t plots = std::min(numPlots, MAX_PLOTS);
+    if (gpuInitialized_ && (plots != numPlots_ || numPoints != capacity_)) {
+        // Texture size changes, recreate on next render
+        releaseGPUResources();
+    }
+    numPlots_ = plots;
+    resetRing(numPoints, numPoints);
     std::memcpy(data_.data(), data, numPlots_ * numPoints_ * sizeof(float));
-    dataDirty_ = true;
+    fitDataX();
 
     ydebug("Plot: data updated (N={}, M={})", numPlots_, numPoints_);
     return Ok();
 }
 
+void Plot::fitDataX() {
+    // Samples span the current X viewport, first to last
+    dataX0_ = xMin_;
+    dataXStep_ = numPoints_ > 1 ? (xMax_ - xMin_) / static_cast<float>(numPoints_ - 1) : 1.0f;
+    if (!(dataXStep_ > 0.0f) || !std::isfinite(dataXStep_)) {
+        dataXStep_ = 1.0f;
+    }
+}
+
+void Plot::resetRing(uint32_t capacity, uint32_t count) {
+    capacity_ = capacity;
+    numPoints_ = std::min(count, capacity);
+    ringHead_ = 0;
+    totalSamples_ = numPoints_;
+    pendingStart_ = 0;
+    pendingCount_ = 0;
+    data_.assign(static_cast<size_t>(numPlots_) * capacity_, 0.0f);
+    pyramid_.layout(numPlots_, capacity_);
+    dataDirty_ = true;
+}
+
+Result<void> Plot::appendSamples(const float* samples, uint32_t numPlots, uint32_t count) {
+    if (!samples || numPlots == 0 || count == 0) {
+        return Err<void>("Invalid plot samples");
+    }
+    if (capacity_ == 0 || numPlots != numPlots_) {
+        return Err<void>("Plot: append does not match plot layout (N=" +
+                         std::to_string(numPlots_) + ")");
+    }
+
+    // Only the newest 'capacity_' samples can survive this append
+    uint32_t skip = count > capacity_ ? count - capacity_ : 0;
+    uint32_t n = count - skip;
+
+    // Write position: one past the newest sample
+    uint32_t writePos = (ringHead_ + numPoints_) % capacity_;
+    uint32_t firstSpan = std::min(n, capacity_ - writePos);
+
+    for (uint32_t row = 0; row < numPlots_; ++row) {
+        const float* src = samples + static_cast<size_t>(row) * count + skip;
+        float* ring = data_.data() + static_cast<size_t>(row) * capacity_;
+        std::memcpy(ring + writePos, src, firstSpan * sizeof(float));
+        if (n > firstSpan) {
+            std::memcpy(ring, src + firstSpan, (n - firstSpan) * sizeof(float));
+        }
+    }
+
+    // Advance the ring; once full the oldest samples are overwritten
+    uint32_t overflow = numPoints_ + n > capacity_ ? numPoints_ + n - capacity_ : 0;
+    numPoints_ += n - overflow;
+    ringHead_ = (ringHead_ + overflow) % capacity_;
+    totalSamples_ += count;
+
+    // Accumulate the dirty range until the next frame uploads it
+    if (pendingCount_ == 0) {
+        pendingStart_ = writePos;
+    }
+    pendingCount_ = std::min(capacity_, pendingCount_ + n);
+    if (pendingCount_ == capacity_) {
+        dataDirty_ = true;
+        pendingCount_ = 0;
+    }
+
+    // Slide the X window with the data unless the user is panning
+    if (stream_ && !panning_ && numPoints_ > 0) {
+        xMin_ = static_cast<float>(totalSamples_ - numPoints_);
+        xMax_ = static_cast<float>(totalSamples_ - 1);
+        if (xMax_ <= xMin_) xMax_ = xMin_ + 1.0f;
+        _ticksDirty = true;
+    }
+    return Ok();
+}
+
+Result<void> Plot::append(std::string_view data) {
+    // Binary format: [uint32 N][uint32 K][N*K floats], plot-major
+    constexpr size_t HEADER_SIZE = 8;
+    if (data.size() < HEADER_SIZE) {
+        return Err<void>("Plot: append payload too small");
+    }
+
+    uint32_t n, k;
+    std::memcpy(&n, data.data() + 0, sizeof(uint32_t));
+    std::memcpy(&k, data.data() + 4, sizeof(uint32_t));
+    if (n == 0 || n > MAX_PLOTS || k == 0 ||
+        data.size() != HEADER_SIZE + static_cast<size_t>(n) * k * sizeof(float)) {
+        return Err<void>("Plot: malformed append payload");
+    }
+
+    // Payload bytes are not float-aligned
+    std::vector<float> samples(static_cast<size_t>(n) * k);
+    std::memcpy(samples.data(), data.data() + HEADER_SIZE, samples.size() * sizeof(float));
+    return appendSamples(samples.data(), n, k);
+}
+
 void Plot::setViewport(float xMin, float xMax, float yMin, float yMax) {
     xMin_ = xMin;
     xMax_ = xMax;
@@ -431,21 +553,144 @@ void Plot::calculateAxisTicks() {
     _ticksDirty = false;
 }
 
+//-----------------------------------------------------------------------------
+// Texture layout
+//-----------------------------------------------------------------------------
+
+uint32_t Plot::textureRowsPerPlot(uint32_t capacity) {
+    uint32_t width = std::clamp(capacity, 1u, TEXTURE_ROW_WIDTH);
+    uint32_t dataRows = std::max(1u, (capacity + width - 1) / width);
+    uint32_t lodRows = std::max(1u, (PlotPyramid::bucketsFor(capacity) + width - 1) / width);
+    return std::max(dataRows, lodRows);
+}
+
+//-----------------------------------------------------------------------------
+// Texture upload
+//-----------------------------------------------------------------------------
+
+// Upload texels [start, start + count) of one plot's region. Each plot
+// occupies rowsPerPlot rows of texWidth_ texels; src points at texel 'start'.
+void Plot::writeTexels(WGPUQueue queue, WGPUTexture texture, const float* src, uint32_t components,
+                       uint32_t rowsPerPlot, uint32_t plot, uint32_t start, uint32_t count) {
+    while (count > 0) {
+        uint32_t col = start % texWidth_;
+        uint32_t row = plot * rowsPerPlot + start / texWidth_;
+
+        WGPUTexelCopyTextureInfo dst = {};
+        dst.texture = texture;
+        dst.origin = {col, row, 0};
+        WGPUTexelCopyBufferLayout layout = {};
+        layout.bytesPerRow = texWidth_ * components * sizeof(float);
+
+        // Partial rows go one at a time, whole rows in a single write
+        uint32_t written;
+        WGPUExtent3D extent;
+        if (col != 0 || count < texWidth_) {
+            written = std::min(count, texWidth_ - col);
+            extent = {written, 1, 1};
+        } else {
+            uint32_t rows = count / texWidth_;
+            written = rows * texWidth_;
+            extent = {texWidth_, rows, 1};
+        }
+        layout.rowsPerImage = extent.height;
+
+        wgpuQueueWriteTexture(queue, &dst, src, written * components * sizeof(float), &layout, &extent);
+        src += written * components;
+        start += written;
+        count -= written;
+    }
+}
+
+// Upload ring indices [start, start + count) (no wrap-around)
+void Plot::uploadRange(WGPUQueue queue, uint32_t start, uint32_t count) {
+    for (uint32_t plot = 0; plot < numPlots_; ++plot) {
+        writeTexels(queue, dataTexture_, data_.data() + static_cast<size_t>(plot) * capacity_ + start,
+                    1, rowsPerPlot_, plot, start, count);
+    }
+}
+
+// Reduce the newest 'count' samples into the pyramid and upload the buckets
+// they touched
+void Plot::uploadLod(WGPUQueue queue, uint32_t count) {
+    uint64_t start = totalSamples_ - count;
+    pyramid_.update(data_.data(), totalSamples_ - numPoints_, numPoints_, start);
+
+    // The small top levels are contiguous at the end of each plot's pyramid,
+    // upload them in one piece instead of one write per level
+    uint32_t tailLevel = 1;
+    while (tailLevel <= pyramid_.levels() && pyramid_.levelSize(tailLevel) > texWidth_) ++tailLevel;
+
+    for (uint32_t plot = 0; plot < numPlots_; ++plot) {
+        const float* lod = pyramid_.plot(plot);
+        for (uint32_t level = 1; level < tailLevel; ++level) {
+            // Touched buckets, split where the level's ring of slots wraps
+            uint32_t slots = pyramid_.levelSize(level);
+            uint32_t n = static_cast<uint32_t>(((totalSamples_ - 1) >> level) - (start >> level) + 1);
+            uint32_t slot = static_cast<uint32_t>((start >> level) & (slots - 1));
+            uint32_t firstSpan = std::min(n, slots - slot);
+            uint32_t at = pyramid_.levelOffset(level) + slot;
+            writeTexels(queue, lodTexture_, lod + at * 2, 2, lodRowsPerPlot_, plot, at, firstSpan);
+            if (n > firstSpan) {
+                at = pyramid_.levelOffset(level);
+                writeTexels(queue, lodTexture_, lod + at * 2, 2, lodRowsPerPlot_, plot, at, n - firstSpan);
+            }
+        }
+        if (tailLevel <= pyramid_.levels()) {
+            uint32_t first = pyramid_.levelOffset(tailLevel);
+            writeTexels(queue, lodTexture_, lod + first * 2, 2, lodRowsPerPlot_, plot, first,
+                        pyramid_.buckets() - first);
+        }
+    }
+}
+
 Result<void> Plot::updateDataTexture(WebGPUContext& ctx) {
-    if (data_.empty() || numPlots_ == 0 || numPoints_ == 0) {
+    if (data_.empty() || numPlots_ == 0 || capacity_ == 0) {
         return Ok();
     }
 
-    WGPUTexelCopyTextureInfo dst = {};
-    dst.texture = dataTexture_;
-    WGPUTexelCopyBufferLayout layout = {};
-    layout.bytesPerRow = numPoints_ * sizeof(float);
-    layout.rowsPerImage = numPlots_;
-    WGPUExtent3D extent = {numPoints_, numPlots_, 1};
+    WGPUQueue queue = ctx.getQueue();
 
-    wgpuQueueWriteTexture(ctx.getQueue(), &dst, data_.data(),
-                          data_.size() * sizeof(float), &layout, &extent);
-    dataDirty_ = false;
+    if (dataDirty_) {
+        pyramid_.build(data_.data(), totalSamples_ - numPoints_, numPoints_);
+
+        if (rowsPerPlot_ == 1) {
+            // Whole NxM matrix in one write
+            WGPUTexelCopyTextureInfo dst = {};
+            dst.texture = dataTexture_;
+            WGPUTexelCopyBufferLayout layout = {};
+            layout.bytesPerRow = capacity_ * sizeof(float);
+            layout.rowsPerImage = numPlots_;
+            WGPUExtent3D extent = {capacity_, numPlots_, 1};
+
+            wgpuQueueWriteTexture(queue, &dst, data_.data(),
+                                  data_.size() * sizeof(float), &layout, &extent);
+        } else {
+            for (uint32_t plot = 0; plot < numPlots_; ++plot) {
+                writeTexels(queue, dataTexture_, data_.data() + static_cast<size_t>(plot) * capacity_,
+                            1, rowsPerPlot_, plot, 0, capacity_);
+            }
+        }
+        for (uint32_t plot = 0; plot < numPlots_ && pyramid_.buckets() > 0; ++plot) {
+            writeTexels(queue, lodTexture_, pyramid_.plot(plot), 2, lodRowsPerPlot_, plot, 0,
+                        pyramid_.buckets());
+        }
+        dataDirty_ = false;
+        pendingCount_ = 0;
+        return Ok();
+    }
+
+    // Streaming: only the samples appended since the last frame, split at
+    // the ring wrap-around
+    if (pendingCount_ > 0) {
+        uint32_t first = std::min(pendingCount_, capacity_ - pendingStart_);
+        uploadRange(queue, pendingStart_, first);
+        if (pendingCount_ > first) {
+            uploadRange(queue, 0, pendingCount_ - first);
+        }
+        uploadLod(queue, pendingCount_);
+        pendingCount_ = 0;
+    }
     return Ok();
 }
 
@@ -486,7 +731,7 @@ Result<void> Plot::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool o
         _ticksDirty = true;
     }
 
-    if (dataDirty_) {
+    if (dataDirty_ || pendingCount_ > 0) {
         if (auto res = updateDataTexture(ctx); !res) {
             return Err<void>("Plot: failed to update data texture", res);
         }
@@ -517,7 +762,8 @@ Result<void> Plot::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool o
         float gridEnabled;          // 4 bytes
         uint32_t numPlots;          // 4 bytes
         uint32_t numPoints;         // 4 bytes
-        uint32_t _pad[2];           // 8 bytes
+        uint32_t ringHead;          // 4 bytes
+        uint32_t capacity;          // 4 bytes
         float colors[16 * 4];       // 256 bytes = 320 bytes total
         // Axis label data (16-byte aligned arrays)
         float marginLeft;           // 4 bytes
@@ -532,8 +778,10 @@ Result<void> Plot::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool o
         uint32_t yTickCharCounts[12]; // 48 bytes
         float fontScale;            // 4 bytes
         float pixelRange;           // 4 bytes
-        float _pad2[2];             // 8 bytes
-    } uniforms;  // Total: 1024 bytes
+        float dataX[2];             // 8 bytes (X of first sample, X step)
+        uint32_t lod[4];            // 16 bytes (pyramid rows per plot, levels, phase, pad)
+    } uniforms;  // Total: 1040 bytes
+    static_assert(sizeof(uniforms) == UNIFORM_BUFFER_SIZE);
 
     std::memset(&uniforms, 0, sizeof(uniforms));
 
@@ -551,6 +799,8 @@ Result<void> Plot::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool o
     uniforms.gridEnabled = gridEnabled_ ? 1.0f : 0.0f;
     uniforms.numPlots = numPlots_;
     uniforms.numPoints = numPoints_;
+    uniforms.ringHead = ringHead_;
+    uniforms.capacity = capacity_;
     std::memcpy(uniforms.colors, colors_, sizeof(colors_));
 
     // Axis label data
@@ -583,6 +833,18 @@ Result<void> Plot::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool o
     uniforms.fontScale = 0.5f;  // Scale factor for axis labels
     uniforms.pixelRange = 4.0f; // MSDF pixel range (typical value)
 
+    if (stream_) {
+        // Samples are indexed by arrival: X of the oldest one in the ring
+        uniforms.dataX[0] = static_cast<float>(totalSamples_ - numPoints_);
+        uniforms.dataX[1] = 1.0f;
+    } else {
+        uniforms.dataX[0] = dataX0_;
+        uniforms.dataX[1] = dataXStep_;
+    }
+    uniforms.lod[0] = lodRowsPerPlot_;
+    uniforms.lod[1] = pyramid_.levels();
+    uniforms.lod[2] = static_cast<uint32_t>((totalSamples_ - numPoints_) % pyramid_.period());
+
     wgpuQueueWriteBuffer(ctx.getQueue(), uniformBuffer_, 0, &uniforms, sizeof(uniforms));
 
     // Draw using the shared render pass
@@ -596,9 +858,17 @@ Result<void> Plot::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool o
 Result<void> Plot::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat) {
     WGPUDevice device = ctx.getDevice();
 
-    // Create data texture (NxM, R32Float)
-    uint32_t texWidth = std::max(numPoints_, 1u);
-    uint32_t texHeight = std::max(numPlots_, 1u);
+    if (!fitsTexture(std::max(numPlots_, 1u), capacity_)) {
+        return Err<void>("Plot: " + std::to_string(numPlots_) + "x" + std::to_string(capacity_) +
+                         " points exceed the texture size limit");
+    }
+
+    // Create data texture (R32Float). Each plot takes ceil(M / width) rows so
+    // large rings stay within the device texture dimension limit.
+    texWidth_ = std::clamp(capacity_, 1u, TEXTURE_ROW_WIDTH);
+    rowsPerPlot_ = std::max(1u, (capacity_ + texWidth_ - 1) / texWidth_);
+    uint32_t texWidth = texWidth_;
+    uint32_t texHeight = std::max(numPlots_, 1u) * rowsPerPlot_;
 
     WGPUTextureDescriptor texDesc = {};
     texDesc.size.width = texWidth;
@@ -621,6 +891,17 @@ Result<void> Plot::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFo
     dataTextureView_ = wgpuTextureCreateView(dataTexture_, &viewDesc);
     if (!dataTextureView_) return Err<void>("Failed to create texture view");
 
+    // LOD pyramid texture (RG32Float min/max), same row width as the data
+    lodRowsPerPlot_ = std::max(1u, (pyramid_.buckets() + texWidth_ - 1) / texWidth_);
+    texDesc.size.height = std::max(numPlots_, 1u) * lodRowsPerPlot_;
+    texDesc.format = WGPUTextureFormat_RG32Float;
+    lodTexture_ = wgpuDeviceCreateTexture(device, &texDesc);
+    if (!lodTexture_) return Err<void>("Failed to create LOD texture");
+
+    viewDesc.format = WGPUTextureFormat_RG32Float;
+    lodTextureView_ = wgpuTextureCreateView(lodTexture_, &viewDesc);
+    if (!lodTextureView_) return Err<void>("Failed to create LOD texture view");
+
     // Sampler for data texture (nearest - R32Float is non-filterable)
     WGPUSamplerDescriptor samplerDesc = {};
     samplerDesc.minFilter = WGPUFilterMode_Nearest;
@@ -643,9 +924,11 @@ Result<void> Plot::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFo
     // + xTickCharCounts: 40 bytes
     // + yTickCharCounts: 40 bytes
     // + fontScale, pixelRange: 8 bytes
-    // Total: ~1024 bytes (round up for alignment)
+    // + dataX (first sample X, X step): 8 bytes
+    // + lod (pyramid rows per plot, levels): 16 bytes
+    // Total: 1040 bytes
     WGPUBufferDescriptor bufDesc = {};
-    bufDesc.size = 1024;  // Extended uniform buffer
+    bufDesc.size = UNIFORM_BUFFER_SIZE;  // Extended uniform buffer
     bufDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
     uniformBuffer_ = wgpuDeviceCreateBuffer(device, &bufDesc);
     if (!uniformBuffer_) return Err<void>("Failed to create uniform buffer");
@@ -661,7 +944,8 @@ struct Uniforms {
     gridEnabled: f32,
     numPlots: u32,
     numPoints: u32,
-    _pad: vec2<u32>,
+    ringHead: u32,
+    capacity: u32,
     colors: array<vec4<f32>, 16>,
     // Axis label data (after colors at offset 320)
     marginLeft: f32,
@@ -679,7 +963,8 @@ struct Uniforms {
     yTickCharCounts: array<vec4<u32>, 3>,
     fontScale: f32,
     pixelRange: f32,
-    _pad2: vec2<f32>,
+    dataX: vec2<f32>,   // X of the oldest sample, X step per sample
+    lod: vec4<u32>,     // pyramid rows per plot, pyramid levels, oldest sample % pyramid period
 }
 
 struct GlyphMetadata {
@@ -697,6 +982,7 @@ struct GlyphMetadata {
 @group(0) @binding(3) var fontTexture: texture_2d<f32>;
 @group(0) @binding(4) var fontSampler: sampler;
 @group(0) @binding(5) var<storage, read> glyphMetadata: array<GlyphMetadata>;
+@group(0) @binding(6) var lodTexture: texture_2d<f32>;
 
 struct VertexOutput {
     @builtin(position) position: vec4<f32>,
@@ -724,6 +1010,68 @@ fn distToSegment(p: vec2<f32>, a: vec2<f32>, b: vec2<f32>) -> f32 {
     return length(pa - ba * h);
 }
 
+// Y value at ring index p. The data texture holds one ring of u.capacity
+// samples per plot, wrapped onto rows of the texture width.
+fn ringY(plotIdx: u32, p: u32) -> f32 {
+    let width = textureDimensions(dataTexture).x;
+    let rowsPerPlot = (u.capacity + width - 1u) / width;
+    let texel = vec2<i32>(i32(p % width), i32(plotIdx * rowsPerPlot + p / width));
+    return textureLoad(dataTexture, texel, 0).r;
+}
+
+// Y value of the i-th oldest sample of a plot
+fn sampleY(plotIdx: u32, i: u32) -> f32 {
+    return ringY(plotIdx, (u.ringHead + i) % u.capacity);
+}
+
+// Min/max bucket of the pyramid (flat index over all levels of a plot)
+fn lodBucket(plotIdx: u32, b: u32) -> vec2<f32> {
+    let width = textureDimensions(lodTexture).x;
+    let texel = vec2<i32>(i32(b % width), i32(plotIdx * u.lod.x + b / width));
+    return textureLoad(lodTexture, texel, 0).rg;
+}
+
+// Slots of pyramid level l: a ring holding ceil(capacity / 2^l) buckets
+// plus one, rounded to a power of two (PlotPyramid::layout)
+fn levelSlots(l: u32) -> u32 {
+    let size = ((u.capacity - 1u) >> l) + 1u;
+    return 1u << (firstLeadingBit(size) + 1u);
+}
+
+// Min/max of the samples lo..hi (inclusive, oldest = 0). The level is picked
+// so that about 16 values are read however many samples the range covers.
+// Buckets group samples by arrival order, bucket k of level l in slot
+// k % levelSlots(l); u.lod.z places the oldest sample in that order.
+// Edge buckets may reach slightly past the range.
+fn sampleMinMax(plotIdx: u32, lo: u32, hi: u32) -> vec2<f32> {
+    let count = hi - lo + 1u;
+    var level = 0u;
+    if (count > 16u) {
+        level = min(firstLeadingBit((count - 1u) / 16u) + 1u, u.lod.y);
+    }
+
+    var mm = vec2<f32>(3.4e38, -3.4e38);
+    if (level == 0u) {
+        for (var i = lo; i <= hi; i = i + 1u) {
+            let y = sampleY(plotIdx, i);
+            mm = vec2<f32>(min(mm.x, y), max(mm.y, y));
+        }
+        return mm;
+    }
+
+    // Levels stored back to back
+    var offset = 0u;
+    for (var l = 1u; l < level; l = l + 1u) {
+        offset = offset + levelSlots(l);
+    }
+    let mask = levelSlots(level) - 1u;
+    for (var k = (u.lod.z + lo) >> level; k <= (u.lod.z + hi) >> level; k = k + 1u) {
+        let v = lodBucket(plotIdx, offset + (k & mask));
+        mm = vec2<f32>(min(mm.x, v.x), max(mm.y, v.y));
+    }
+    return mm;
+}
+
 // MSDF median for signed distance
 fn median(r: f32, g: f32, b: f32) -> f32 {
     return max(min(r, g), min(max(r, g), b));
@@ -936,37 +1284,57 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     }
 
     // Render each plot
-    let numPts = f32(u.numPoints);
     let halfWidth = u.lineWidth * 0.5;
+    let rangeX = u.viewport.y - u.viewport.x;
+    let rangeY = u.viewport.w - u.viewport.z;
+
+    // Sample index under this pixel and samples per pixel column
+    let samplesPerPixel = rangeX / (plotAreaW * u.dataX.y);
+    let center = (u.viewport.x + plotUV.x * rangeX - u.dataX.x) / u.dataX.y;
+    let lastIdx = i32(u.numPoints) - 1;
 
     for (var plotIdx: u32 = 0u; plotIdx < u.numPlots; plotIdx = plotIdx + 1u) {
         let plotColor = u.colors[plotIdx];
-        let plotV = (f32(plotIdx) + 0.5) / f32(u.numPlots);
 
         var minDist = 1e10;
 
-        for (var i: u32 = 0u; i < u.numPoints - 1u; i = i + 1u) {
-            let t0 = (f32(i) + 0.5) / numPts;
-            let t1 = (f32(i + 1u) + 0.5) / numPts;
+        if (samplesPerPixel <= 1.0) {
+            // Zoomed in: exact segments within reach of the line width
+            let reach = (halfWidth + 2.0) * samplesPerPixel + 1.0;
+            let lo = max(i32(floor(center - reach)), 0);
+            let hi = min(i32(ceil(center + reach)), lastIdx);
 
-            // Sample Y values from texture
-            let y0 = textureSampleLevel(dataTexture, dataSampler, vec2(t0, plotV), 0.0).r;
-            let y1 = textureSampleLevel(dataTexture, dataSampler, vec2(t1, plotV), 0.0).r;
+            for (var i = lo; i < hi; i = i + 1) {
+                let y0 = sampleY(plotIdx, u32(i));
+                let y1 = sampleY(plotIdx, u32(i + 1));
 
-            // Convert data coordinates to normalized [0,1]
-            let x0_data = u.viewport.x + t0 * (u.viewport.y - u.viewport.x);
-            let x1_data = u.viewport.x + t1 * (u.viewport.y - u.viewport.x);
-            let x0_norm = (x0_data - u.viewport.x) / (u.viewport.y - u.viewport.x);
-            let x1_norm = (x1_data - u.viewport.x) / (u.viewport.y - u.viewport.x);
-            let y0_norm = (y0 - u.viewport.z) / (u.viewport.w - u.viewport.z);
-            let y1_norm = (y1 - u.viewport.z) / (u.viewport.w - u.viewport.z);
+                // Convert data coordinates to normalized [0,1]
+                let x0_norm = (u.dataX.x + f32(i) * u.dataX.y - u.viewport.x) / rangeX;
+                let x1_norm = (u.dataX.x + f32(i + 1) * u.dataX.y - u.viewport.x) / rangeX;
+                let y0_norm = (y0 - u.viewport.z) / rangeY;
+                let y1_norm = (y1 - u.viewport.z) / rangeY;
 
-            // Convert to pixel coordinates within plot area
-            let p0 = vec2<f32>(plotAreaX + x0_norm * plotAreaW, (1.0 - y0_norm) * plotAreaH);
-            let p1 = vec2<f32>(plotAreaX + x1_norm * plotAreaW, (1.0 - y1_norm) * plotAreaH);
+                // Convert to pixel coordinates within plot area
+                let p0 = vec2<f32>(plotAreaX + x0_norm * plotAreaW, (1.0 - y0_norm) * plotAreaH);
+                let p1 = vec2<f32>(plotAreaX + x1_norm * plotAreaW, (1.0 - y1_norm) * plotAreaH);
 
-            let d = distToSegment(fragCoord, p0, p1);
-            minDist = min(minDist, d);
+                let d = distToSegment(fragCoord, p0, p1);
+                minDist = min(minDist, d);
+            }
+        } else {
+            // Zoomed out: min/max envelope of the samples in this column,
+            // widened by one sample on each side so columns connect
+            let lo = max(i32(floor(center - samplesPerPixel * 0.5)) - 1, 0);
+            let hi = min(i32(ceil(center + samplesPerPixel * 0.5)) + 1, lastIdx);
+
+            if (lo <= hi) {
+                let mm = sampleMinMax(plotIdx, u32(lo), u32(hi));
+                if (mm.x <= mm.y) {
+                    let top = (1.0 - (mm.y - u.viewport.z) / rangeY) * plotAreaH;
+                    let bottom = (1.0 - (mm.x - u.viewport.z) / rangeY) * plotAreaH;
+                    minDist = max(max(top - fragCoord.y, fragCoord.y - bottom), 0.0);
+                }
+            }
         }
 
         // Anti-aliased line
@@ -994,11 +1362,12 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     wgslDesc.code = WGPU_STR(shaderCode);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
-    // Bind group layout (6 bindings: uniforms, dataSampler, dataTexture, fontTexture, fontSampler, glyphMetadata)
-    WGPUBindGroupLayoutEntry entries[6] = {};
+    // Bind group layout (7 bindings: uniforms, dataSampler, dataTexture, fontTexture, fontSampler,
+    // glyphMetadata, lodTexture). Font bindings are only present with a font.
+    WGPUBindGroupLayoutEntry entries[7] = {};
     entries[0].binding = 0;
     entries[0].visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
     entries[0].buffer.type = WGPUBufferBindingType_Uniform;
@@ -1022,11 +1391,17 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     entries[5].binding = 5;
     entries[5].visibility = WGPUShaderStage_Fragment;
     entries[5].buffer.type = WGPUBufferBindingType_ReadOnlyStorage;
+    // LOD pyramid (min/max)
+    uint32_t lodEntry = _font ? 6 : 3;
+    entries[lodEntry].binding = 6;
+    entries[lodEntry].visibility = WGPUShaderStage_Fragment;
+    entries[lodEntry].texture.sampleType = WGPUTextureSampleType_UnfilterableFloat;
+    entries[lodEntry].texture.viewDimension = WGPUTextureViewDimension_2D;
 
     WGPUBindGroupLayoutDescriptor bglDesc = {};
-    bglDesc.entryCount = _font ? 6 : 3;  // Only include font bindings if font available
+    bglDesc.entryCount = lodEntry + 1;  // Only include font bindings if font available
     bglDesc.entries = entries;
-    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
+    WGPUBindGroupLayout bgl = ctx.shaderCache().createBindGroupLayout(&bglDesc);
     if (!bgl) {
         wgpuShaderModuleRelease(shaderModule);
         return Err<void>("Failed to create bind group layout");
@@ -1036,13 +1411,13 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 1;
     plDesc.bindGroupLayouts = &bgl;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
 
     // Bind group
-    WGPUBindGroupEntry bgE[6] = {};
+    WGPUBindGroupEntry bgE[7] = {};
     bgE[0].binding = 0;
     bgE[0].buffer = uniformBuffer_;
-    bgE[0].size = 1024;  // Extended uniform buffer
+    bgE[0].size = UNIFORM_BUFFER_SIZE;  // Extended uniform buffer
     bgE[1].binding = 1;
     bgE[1].sampler = sampler_;
     bgE[2].binding = 2;
@@ -1056,9 +1431,12 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
         bgE[4].sampler = _font->getSampler();
         bgE[5].binding = 5;
         bgE[5].buffer = _font->getGlyphMetadataBuffer();
-        bgE[5].size = _font->getGlyphCount() * sizeof(GlyphMetadataGPU);
+        bgE[5].size = _font->getBufferGlyphCount() * sizeof(GlyphMetadataGPU);
         entryCount = 6;
     }
+    bgE[entryCount].binding = 6;
+    bgE[entryCount].textureView = lodTextureView_;
+    entryCount++;
 
     WGPUBindGroupDescriptor bgDesc = {};
     bgDesc.layout = bgl;
@@ -1097,7 +1475,7 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = ~0u;
 
-    pipeline_ = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    pipeline_ = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(shaderModule);
     wgpuBindGroupLayoutRelease(bgl);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "plot-pyramid.h"
 #include <yetty/plugin.h>
 #include <yetty/font.h>
 #include <webgpu/webgpu.h>
@@ -52,6 +53,15 @@ private:
 //
 // The X axis is implicit: x[i] = i / (M-1) normalized to [0,1]
 //
+// Streaming mode (plugin args "--stream"): M is the ring capacity per plot.
+// Samples are appended through the OSC "append" command (see append()),
+// only the new texels are uploaded, and the shader reads the ring starting
+// at its head so the X window slides without re-sending history.
+//
+// Level of detail: a min/max pyramid of every ring is kept on the CPU and in
+// a second texture. The shader picks a level per pixel column from the
+// viewport, so its cost follows the plot width instead of the point count.
+//
 // Two-phase construction:
 //   1. Constructor (private) - stores payload
 //   2. init() (private) - no args, parses payload
@@ -62,9 +72,23 @@ public:
     static constexpr uint32_t MAX_PLOTS = 16;  // Maximum number of plots per layer
     static constexpr uint32_t MAX_TICKS = 10;  // Maximum ticks per axis
     static constexpr uint32_t MAX_LABEL_CHARS = 12;  // Max chars per label
+    static constexpr uint32_t MAX_POINTS = 1u << 24;  // Max points (ring capacity) per plot
+    static constexpr uint32_t TEXTURE_ROW_WIDTH = 4096;  // Long plots wrap onto several texture rows
+    static constexpr uint32_t MAX_TEXTURE_ROWS = 8192;   // WebGPU default maxTextureDimension2D
+
+    // Texture rows one plot with a ring of `capacity` samples takes: each
+    // plot starts on a fresh row, in the data and in the (slightly longer)
+    // LOD texture
+    static uint32_t textureRowsPerPlot(uint32_t capacity);
+
+    // Whether numPlots rings of `capacity` samples fit in MAX_TEXTURE_ROWS
+    static bool fitsTexture(uint32_t numPlots, uint32_t capacity) {
+        return uint64_t(numPlots) * textureRowsPerPlot(capacity) <= MAX_TEXTURE_ROWS;
+    }
 
-    static Result<WidgetPtr> create(const std::string& payload, Font* font = nullptr) {
-        auto w = std::shared_ptr<Plot>(new Plot(payload, font));
+    static Result<WidgetPtr> create(const std::string& payload, Font* font = nullptr,
+                                    const std::string& pluginArgs = "") {
+        auto w = std::shared_ptr<Plot>(new Plot(payload, font, pluginArgs));
         if (auto res = w->init(); !res) {
             return Err<WidgetPtr>("Failed to init Plot", res);
         }
@@ -83,6 +107,17 @@ public:
     // Data layout: row-major, data[row * M + col] = Y value for plot 'row' at point 'col'
     Result<void> setData(const float* data, uint32_t numPlots, uint32_t numPoints);
 
+    // Append samples to the ring of every plot (streaming mode)
+    // Data layout: plot-major, samples[row * count + i], count samples per plot.
+    // Appends are accumulated and uploaded once per frame.
+    Result<void> appendSamples(const float* samples, uint32_t numPlots, uint32_t count);
+
+    // OSC "append" payload: [uint32 N][uint32 K][N*K floats] (plot-major)
+    Result<void> append(std::string_view data) override;
+
+    bool isStreaming() const { return stream_; }
+    uint32_t pointCount() const { return numPoints_; }
+
     // Set viewport range
     void setViewport(float xMin, float xMax, float yMin, float yMax);
 
@@ -102,23 +137,58 @@ public:
     bool wantsMouse() const override { return true; }
 
 private:
-    explicit Plot(const std::string& payload, Font* font = nullptr)
+    explicit Plot(const std::string& payload, Font* font = nullptr,
+                  const std::string& pluginArgs = "")
         : _font(font) {
         _payload = payload;
+        stream_ = pluginArgs.find("--stream") != std::string::npos;
     }
 
     Result<void> init() override;
     Result<void> createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat);
     Result<void> updateDataTexture(WebGPUContext& ctx);
+    void writeTexels(WGPUQueue queue, WGPUTexture texture, const float* src, uint32_t components,
+                     uint32_t rowsPerPlot, uint32_t plot, uint32_t start, uint32_t count);
+    void uploadRange(WGPUQueue queue, uint32_t start, uint32_t count);
+    void uploadLod(WGPUQueue queue, uint32_t count);
+    void resetRing(uint32_t capacity, uint32_t count);
+    void fitDataX();
+
     void calculateAxisTicks();
     std::string formatTickValue(float value) const;
 
     // Plot data (CPU side, for updates)
+    // data_ holds numPlots_ rings of capacity_ samples; numPoints_ of them are
+    // valid, the oldest at index ringHead_. Non-streaming plots have
+    // capacity_ == numPoints_ and ringHead_ == 0.
     std::vector<float> data_;
     uint32_t numPlots_ = 0;
     uint32_t numPoints_ = 0;
     bool dataDirty_ = false;
 
+    // Streaming state
+    bool stream_ = false;
+    uint32_t capacity_ = 0;
+    uint32_t ringHead_ = 0;
+    uint64_t totalSamples_ = 0;  // Samples appended so far (X of the newest + 1)
+    uint32_t pendingStart_ = 0;  // Ring range appended since the last upload
+    uint32_t pendingCount_ = 0;
+
+    // X of the first sample and X step per sample (non-streaming plots map
+    // the samples onto the initial viewport)
+    float dataX0_ = 0.0f;
+    float dataXStep_ = 1.0f;
+
+    // Data texture layout: each plot occupies rowsPerPlot_ rows of texWidth_
+    uint32_t texWidth_ = 0;
+    uint32_t rowsPerPlot_ = 0;
+
+    // Min/max pyramid of the rings (buckets by arrival order, the oldest
+    // sample is number totalSamples_ - numPoints_), LOD texture has
+    // lodRowsPerPlot_ rows per plot
+    PlotPyramid pyramid_;
+    uint32_t lodRowsPerPlot_ = 0;
+
     // Viewport
     float xMin_ = 0.0f;
     float xMax_ = 1.0f;
@@ -163,6 +233,8 @@ private:
     WGPUBuffer uniformBuffer_ = nullptr;
     WGPUTexture dataTexture_ = nullptr;
     WGPUTextureView dataTextureView_ = nullptr;
+    WGPUTexture lodTexture_ = nullptr;
+    WGPUTextureView lodTextureView_ = nullptr;
     WGPUSampler sampler_ = nullptr;
 
     bool gpuInitialized_ = false;
@@ -0,0 +1,214 @@
+#include "interpreter.h"
+#include <ytrace/ytrace.hpp>
+#include <mutex>
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// Interpreter
+//-----------------------------------------------------------------------------
+
+// Capture swaps sys.stdout/sys.stderr of the whole interpreter, and the GIL
+// changes hands while code runs, so captured runs on one interpreter take
+// turns. Only the main interpreter is reached from several threads; an
+// isolated one belongs to its thread. Recursive for code that calls back
+// into execute().
+static std::recursive_mutex& mainCaptureMutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+static bool onMainInterpreter() {
+#if PY_VERSION_HEX >= 0x030C0000
+    return PyInterpreterState_Get() == PyInterpreterState_Main();
+#else
+    return true;
+#endif
+}
+
+bool Interpreter::isolationSupported() {
+#if PY_VERSION_HEX >= 0x030C0000
+    return true;
+#else
+    return false;
+#endif
+}
+
+Result<Interpreter::Ptr> Interpreter::create(bool isolated,
+                                             const std::vector<std::string>& sysPaths) noexcept {
+    auto interp = Ptr(new Interpreter());
+    if (isolated) {
+        if (auto res = interp->init(sysPaths); !res) {
+            ywarn("Python: {} - using the shared interpreter", error_msg(res));
+        }
+    }
+    return Ok(std::move(interp));
+}
+
+Result<void> Interpreter::init(const std::vector<std::string>& sysPaths) {
+#if PY_VERSION_HEX >= 0x030C0000
+    PyInterpreterConfig config = {
+        .use_main_obmalloc = 0,
+        .allow_fork = 0,
+        .allow_exec = 0,
+        .allow_threads = 1,
+        .allow_daemon_threads = 0,
+        .check_multi_interp_extensions = 1,
+        .gil = PyInterpreterConfig_OWN_GIL,
+    };
+
+    // Creating a subinterpreter needs an attached thread state. With its
+    // own GIL the caller's GIL is released by the call, so re-attach the
+    // main thread state afterwards to give it back cleanly.
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyThreadState* mainState = PyThreadState_Get();
+
+    PyThreadState* sub = nullptr;
+    PyStatus status = Py_NewInterpreterFromConfig(&sub, &config);
+    if (PyStatus_Exception(status) || !sub) {
+        PyGILState_Release(gstate);
+        return Err<void>(std::string("Failed to create subinterpreter: ") +
+                         (status.err_msg ? status.err_msg : "unknown error"));
+    }
+
+    // Paths the plugin added to the main interpreter at runtime
+    PyObject* path = PySys_GetObject("path");  // Borrowed
+    for (const auto& dir : sysPaths) {
+        PyObject* item = PyUnicode_FromString(dir.c_str());
+        if (path && item) {
+            PyList_Insert(path, 0, item);
+        }
+        Py_XDECREF(item);
+    }
+    PyErr_Clear();
+
+    PyEval_SaveThread();
+    PyEval_RestoreThread(mainState);
+    PyGILState_Release(gstate);
+
+    subState_ = sub;
+    yinfo("Python: created isolated subinterpreter with its own GIL");
+    return Ok();
+#else
+    (void)sysPaths;
+    return Err<void>("Isolated interpreters need Python 3.12 or newer");
+#endif
+}
+
+Interpreter::~Interpreter() {
+    if (subState_) {
+        PyEval_RestoreThread(subState_);
+        Py_EndInterpreter(subState_);
+        subState_ = nullptr;
+    }
+}
+
+Interpreter::Lock::Lock(Interpreter* interp)
+    : state_(interp ? interp->subState_ : nullptr) {
+    if (state_) {
+        PyEval_RestoreThread(state_);
+    } else {
+        gstate_ = static_cast<int>(PyGILState_Ensure());
+    }
+}
+
+Interpreter::Lock::~Lock() {
+    if (state_) {
+        PyEval_SaveThread();
+    } else {
+        PyGILState_Release(static_cast<PyGILState_STATE>(gstate_));
+    }
+}
+
+Result<std::string> Interpreter::execute(const std::string& code, PyObject* globals) {
+    Lock lock(this);
+    return runCaptured(code, globals);
+}
+
+Result<std::string> Interpreter::runCaptured(const std::string& code, PyObject* globals) {
+    if (!globals) {
+        PyObject* mainModule = PyImport_AddModule("__main__");  // Borrowed
+        if (!mainModule) {
+            PyErr_Clear();
+            return Err<std::string>("Failed to get Python __main__ module");
+        }
+        globals = PyModule_GetDict(mainModule);
+    }
+
+    std::unique_lock<std::recursive_mutex> capture(mainCaptureMutex(), std::defer_lock);
+    if (onMainInterpreter()) {
+        // Wait without the GIL, the thread capturing now needs it to finish
+        Py_BEGIN_ALLOW_THREADS
+        capture.lock();
+        Py_END_ALLOW_THREADS
+    }
+
+    // Redirect stdout/stderr to capture output
+    PyObject* sys = PyImport_ImportModule("sys");
+    if (!sys) {
+        PyErr_Clear();
+        return Err<std::string>("Failed to import sys module");
+    }
+
+    PyObject* io = PyImport_ImportModule("io");
+    if (!io) {
+        PyErr_Clear();
+        Py_DECREF(sys);
+        return Err<std::string>("Failed to import io module");
+    }
+
+    // Create StringIO for capturing output
+    PyObject* stringIoClass = PyObject_GetAttrString(io, "StringIO");
+    PyObject* stringIo = PyObject_CallObject(stringIoClass, nullptr);
+    Py_DECREF(stringIoClass);
+
+    // Save original stdout/stderr
+    PyObject* oldStdout = PyObject_GetAttrString(sys, "stdout");
+    PyObject* oldStderr = PyObject_GetAttrString(sys, "stderr");
+
+    // Redirect stdout/stderr to our StringIO
+    PyObject_SetAttrString(sys, "stdout", stringIo);
+    PyObject_SetAttrString(sys, "stderr", stringIo);
+
+    // Execute the code in the provided namespace
+    PyObject* result = PyRun_String(code.c_str(), Py_file_input, globals, globals);
+
+    // Park the exception while we talk to the StringIO
+    PyObject *excType = nullptr, *excValue = nullptr, *excTrace = nullptr;
+    PyErr_Fetch(&excType, &excValue, &excTrace);
+
+    // Get captured output
+    PyObject* getvalue = PyObject_GetAttrString(stringIo, "getvalue");
+    PyObject* outputObj = PyObject_CallObject(getvalue, nullptr);
+    Py_DECREF(getvalue);
+
+    std::string output;
+    if (outputObj && PyUnicode_Check(outputObj)) {
+        output = PyUnicode_AsUTF8(outputObj);
+    }
+    Py_XDECREF(outputObj);
+
+    // Restore stdout/stderr
+    PyObject_SetAttrString(sys, "stdout", oldStdout);
+    PyObject_SetAttrString(sys, "stderr", oldStderr);
+    Py_XDECREF(oldStdout);
+    Py_XDECREF(oldStderr);
+    Py_DECREF(stringIo);
+    Py_DECREF(io);
+    Py_DECREF(sys);
+
+    if (!result) {
+        PyErr_Restore(excType, excValue, excTrace);
+        PyErr_Print();
+        PyErr_Clear();
+        return Err<std::string>("Python execution error: " + output);
+    }
+
+    Py_DECREF(result);
+    return Ok(output);
+}
+
+} // namespace yetty
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <yetty/result.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declare Python types to avoid including Python.h in header
+struct _object;
+typedef _object PyObject;
+struct _ts;
+typedef _ts PyThreadState;
+
+namespace yetty {
+
+//-----------------------------------------------------------------------------
+// Interpreter - where a Python widget's thread runs its code
+//
+// Shared: the main interpreter; every widget in this mode takes turns on
+// the one GIL.
+// Isolated: a subinterpreter with its own GIL and its own modules, so
+// widgets run truly in parallel (CPython 3.12+). Extension modules must
+// support per-interpreter GIL to be importable there.
+//
+// An isolated interpreter belongs to the thread that created it; create,
+// lock and destroy it on that thread only, with no other GIL held.
+//-----------------------------------------------------------------------------
+class Interpreter {
+public:
+    using Ptr = std::unique_ptr<Interpreter>;
+
+    // Falls back to the shared interpreter when isolation is unsupported or
+    // the subinterpreter cannot be created. `sysPaths` are prepended to
+    // sys.path of a new subinterpreter, in order.
+    static Result<Ptr> create(bool isolated,
+                              const std::vector<std::string>& sysPaths = {}) noexcept;
+
+    ~Interpreter();
+
+    Interpreter(const Interpreter&) = delete;
+    Interpreter& operator=(const Interpreter&) = delete;
+
+    bool isolated() const { return subState_ != nullptr; }
+
+    // True when built against a Python with per-interpreter GIL
+    static bool isolationSupported();
+
+    // Holds the interpreter's GIL on the calling thread; nullptr or a
+    // shared interpreter means the main one. Not reentrant when isolated.
+    class Lock {
+    public:
+        explicit Lock(Interpreter* interp);
+        ~Lock();
+
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+
+    private:
+        PyThreadState* state_ = nullptr;
+        int gstate_ = 0;
+    };
+
+    // Run `code` with `globals` (a dict of this interpreter, or nullptr for
+    // its __main__), returning captured stdout/stderr. Takes the lock.
+    // Captured runs on the main interpreter are serialized across threads,
+    // so each gets only its own output.
+    Result<std::string> execute(const std::string& code, PyObject* globals);
+
+    // Same, for callers that already hold the GIL
+    static Result<std::string> runCaptured(const std::string& code, PyObject* globals);
+
+private:
+    Interpreter() = default;
+    Result<void> init(const std::vector<std::string>& sysPaths);
+
+    PyThreadState* subState_ = nullptr;
+};
+
+} // namespace yetty
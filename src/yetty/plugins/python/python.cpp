@@ -1,4 +1,5 @@
 #include "python.h"
+#include "interpreter.h"
 #include "yetty_wgpu.h"
 #include <yetty/yetty.h>
 #include <yetty/webgpu-context.h>
@@ -9,6 +10,7 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
@@ -195,6 +197,7 @@ Result<void> PythonPlugin::initPython() {
     if (fs::exists(pkgPath)) {
         std::string code = "import sys; sys.path.insert(0, '" + pkgPath + "')";
         PyRun_SimpleString(code.c_str());
+        sysPaths_.push_back(pkgPath);
         yinfo("Added Python packages to path: {}", pkgPath);
     } else {
         ywarn("Python packages path does not exist: {}", pkgPath);
@@ -206,6 +209,7 @@ Result<void> PythonPlugin::initPython() {
     if (fs::exists(pygfxPath)) {
         std::string code = "import sys; sys.path.insert(0, '" + pygfxPath + "')";
         PyRun_SimpleString(code.c_str());
+        sysPaths_.push_back(pygfxPath);
         yinfo("Added yetty_pygfx module to path: {}", pygfxPath);
     } else {
         ywarn("yetty_pygfx module path does not exist: {}", pygfxPath);
@@ -228,9 +232,10 @@ Result<void> PythonPlugin::loadInitCallbacks() {
     ydebug("Loading init.py from: {}", initPath);
 
     // Add the directory to sys.path
-    std::string addPath = "import sys; sys.path.insert(0, '" +
-        initPath.substr(0, initPath.find_last_of("/\\")) + "')";
+    std::string initDir = initPath.substr(0, initPath.find_last_of("/\\"));
+    std::string addPath = "import sys; sys.path.insert(0, '" + initDir + "')";
     PyRun_SimpleString(addPath.c_str());
+    sysPaths_.push_back(initDir);
 
     // Import init module
     initModule_ = PyImport_ImportModule("init");
@@ -310,70 +315,8 @@ Result<std::string> PythonPlugin::execute(const std::string& code) {
         return Err<std::string>("Python not initialized");
     }
 
-    // Acquire GIL
-    PyGILState_STATE gstate = PyGILState_Ensure();
-
-    // Redirect stdout/stderr to capture output
-    PyObject* sys = PyImport_ImportModule("sys");
-    if (!sys) {
-        PyGILState_Release(gstate);
-        return Err<std::string>("Failed to import sys module");
-    }
-
-    PyObject* io = PyImport_ImportModule("io");
-    if (!io) {
-        Py_DECREF(sys);
-        PyGILState_Release(gstate);
-        return Err<std::string>("Failed to import io module");
-    }
-
-    // Create StringIO for capturing output
-    PyObject* stringIoClass = PyObject_GetAttrString(io, "StringIO");
-    PyObject* stringIo = PyObject_CallObject(stringIoClass, nullptr);
-    Py_DECREF(stringIoClass);
-
-    // Save original stdout/stderr
-    PyObject* oldStdout = PyObject_GetAttrString(sys, "stdout");
-    PyObject* oldStderr = PyObject_GetAttrString(sys, "stderr");
-
-    // Redirect stdout/stderr to our StringIO
-    PyObject_SetAttrString(sys, "stdout", stringIo);
-    PyObject_SetAttrString(sys, "stderr", stringIo);
-
-    // Execute the code
-    PyObject* result = PyRun_String(code.c_str(), Py_file_input, mainDict_, mainDict_);
-
-    // Get captured output
-    PyObject* getvalue = PyObject_GetAttrString(stringIo, "getvalue");
-    PyObject* outputObj = PyObject_CallObject(getvalue, nullptr);
-    Py_DECREF(getvalue);
-
-    std::string output;
-    if (outputObj && PyUnicode_Check(outputObj)) {
-        output = PyUnicode_AsUTF8(outputObj);
-    }
-    Py_XDECREF(outputObj);
-
-    // Restore stdout/stderr
-    PyObject_SetAttrString(sys, "stdout", oldStdout);
-    PyObject_SetAttrString(sys, "stderr", oldStderr);
-    Py_DECREF(oldStdout);
-    Py_DECREF(oldStderr);
-    Py_DECREF(stringIo);
-    Py_DECREF(io);
-    Py_DECREF(sys);
-
-    if (!result) {
-        // Get error info
-        PyErr_Print();
-        PyErr_Clear();
-        PyGILState_Release(gstate);
-        return Err<std::string>("Python execution error: " + output);
-    }
-
-    Py_DECREF(result);
-    PyGILState_Release(gstate);
-    return Ok(output);
+    Interpreter::Lock lock(nullptr);
+    return Interpreter::runCaptured(code, mainDict_);
 }
 
 Result<void> PythonPlugin::runFile(const std::string& path) {
@@ -402,69 +345,8 @@ Result<std::string> PythonPlugin::executeInNamespace(const std::string& code, Py
         return execute(code);  // Fall back to main dict
     }
 
-    // Acquire GIL
-    PyGILState_STATE gstate = PyGILState_Ensure();
-
-    // Redirect stdout/stderr to capture output
-    PyObject* sys = PyImport_ImportModule("sys");
-    if (!sys) {
-        PyGILState_Release(gstate);
-        return Err<std::string>("Failed to import sys module");
-    }
-
-    PyObject* io = PyImport_ImportModule("io");
-    if (!io) {
-        Py_DECREF(sys);
-        PyGILState_Release(gstate);
-        return Err<std::string>("Failed to import io module");
-    }
-
-    // Create StringIO for capturing output
-    PyObject* stringIoClass = PyObject_GetAttrString(io, "StringIO");
-    PyObject* stringIo = PyObject_CallObject(stringIoClass, nullptr);
-    Py_DECREF(stringIoClass);
-
-    // Save original stdout/stderr
-    PyObject* oldStdout = PyObject_GetAttrString(sys, "stdout");
-    PyObject* oldStderr = PyObject_GetAttrString(sys, "stderr");
-
-    // Redirect stdout/stderr to our StringIO
-    PyObject_SetAttrString(sys, "stdout", stringIo);
-    PyObject_SetAttrString(sys, "stderr", stringIo);
-
-    // Execute the code in the provided namespace
-    PyObject* result = PyRun_String(code.c_str(), Py_file_input, namespaceDict, namespaceDict);
-
-    // Get captured output
-    PyObject* getvalue = PyObject_GetAttrString(stringIo, "getvalue");
-    PyObject* outputObj = PyObject_CallObject(getvalue, nullptr);
-    Py_DECREF(getvalue);
-
-    std::string output;
-    if (outputObj && PyUnicode_Check(outputObj)) {
-        output = PyUnicode_AsUTF8(outputObj);
-    }
-    Py_XDECREF(outputObj);
-
-    // Restore stdout/stderr
-    PyObject_SetAttrString(sys, "stdout", oldStdout);
-    PyObject_SetAttrString(sys, "stderr", oldStderr);
-    Py_DECREF(oldStdout);
-    Py_DECREF(oldStderr);
-    Py_DECREF(stringIo);
-    Py_DECREF(io);
-    Py_DECREF(sys);
-
-    if (!result) {
-        PyErr_Print();
-        PyErr_Clear();
-        PyGILState_Release(gstate);
-        return Err<std::string>("Python execution error: " + output);
-    }
-
-    Py_DECREF(result);
-    PyGILState_Release(gstate);
-    return Ok(output);
+    Interpreter::Lock lock(nullptr);
+    return Interpreter::runCaptured(code, namespaceDict);
 }
 
 Result<void> PythonPlugin::runFileInNamespace(const std::string& path, PyObject* namespaceDict) {
@@ -535,10 +417,7 @@ Result<void> Python::init() {
 void Python::releaseGPUResources() {
     // Release blit pipeline resources when widget goes off-screen
     // This saves GPU memory for widgets that are scrolled out of view
-    if (blitBindGroup_) {
-        wgpuBindGroupRelease(blitBindGroup_);
-        blitBindGroup_ = nullptr;
-    }
+    releaseBlitBindGroups();
     if (blitPipeline_) {
         wgpuRenderPipelineRelease(blitPipeline_);
         blitPipeline_ = nullptr;
@@ -551,15 +430,26 @@ void Python::releaseGPUResources() {
     yinfo("Python: GPU resources released");
 }
 
+void Python::releaseBlitBindGroups() {
+    for (auto& bindGroup : blitBindGroups_) {
+        if (bindGroup) {
+            wgpuBindGroupRelease(bindGroup);
+            bindGroup = nullptr;
+        }
+    }
+}
+
 Result<void> Python::dispose() {
-    // Call dispose_layer callback
-    callDisposeWidget();
+    // No more Python callbacks from the widget's thread past this point; it
+    // releases its Python state on the way out
+    stopRenderThread();
 
-    // Cleanup blit resources first (before Python cleanup)
-    if (blitBindGroup_) {
-        wgpuBindGroupRelease(blitBindGroup_);
-        blitBindGroup_ = nullptr;
-    }
+    // Anything set up from this thread (initPygfx)
+    releasePython();
+
+    // Cleanup blit resources
+    releaseBlitBindGroups();
+    releaseDisplayTextures();
     if (blitPipeline_) {
         wgpuRenderPipelineRelease(blitPipeline_);
         blitPipeline_ = nullptr;
@@ -570,43 +460,40 @@ Result<void> Python::dispose() {
     }
     blitInitialized_ = false;
 
+    return Ok();
+}
+
+void Python::releasePython() {
+    // Call dispose_widget callback
+    callDisposeWidget();
+
     // Cleanup Python references (only if Python is still initialized)
     // Note: yetty_pygfx.cleanup() is already called by dispose_widget() above
-    if (plugin_ && plugin_->isInitialized()) {
-        PyGILState_STATE gstate = PyGILState_Ensure();
-        if (userRenderFunc_) {
-            Py_DECREF(userRenderFunc_);
-            userRenderFunc_ = nullptr;
-        }
-        if (renderFrameFunc_) {
-            Py_DECREF(renderFrameFunc_);
-            renderFrameFunc_ = nullptr;
-        }
-        if (pygfxModule_) {
-            Py_DECREF(pygfxModule_);
-            pygfxModule_ = nullptr;
+    PyObject** refs[] = {&userRenderFunc_, &renderFrameFunc_, &pygfxModule_, &widgetDict_,
+                         &initWidgetFunc_, &disposeWidgetFunc_};
+    bool any = false;
+    for (PyObject** ref : refs) any = any || *ref;
+
+    if (any && plugin_ && plugin_->isInitialized()) {
+        Interpreter::Lock lock(interp_.get());
+        for (PyObject** ref : refs) {
+            Py_XDECREF(*ref);
+            *ref = nullptr;
         }
-        if (widgetDict_) {
-            Py_DECREF(widgetDict_);
-            widgetDict_ = nullptr;
-        }
-        PyGILState_Release(gstate);
     } else {
         // Python already finalized, just null out pointers
-        userRenderFunc_ = nullptr;
-        renderFrameFunc_ = nullptr;
-        pygfxModule_ = nullptr;
-        widgetDict_ = nullptr;
+        for (PyObject** ref : refs) *ref = nullptr;
     }
     pygfxInitialized_ = false;
     wgpuHandlesSet_ = false;
 
-    return Ok();
+    // Isolated interpreters end on the thread that created them
+    interp_.reset();
 }
 
 void Python::prepareFrame(WebGPUContext& ctx, bool on) {
-    // This is called BEFORE the shared render pass begins
-    // Here we initialize and render pygfx content to our texture
+    // This is called BEFORE the shared render pass begins. Python runs on
+    // its own thread; here we only start it and tell it what to do.
 
     // Handle on/off transitions for GPU resource management
     if (!on && wasOn_) {
@@ -614,118 +501,329 @@ void Python::prepareFrame(WebGPUContext& ctx, bool on) {
         yinfo("Python: Transitioning to off - releasing GPU resources");
         releaseGPUResources();
         wasOn_ = false;
-        return;
     }
 
     if (on && !wasOn_) {
-        // Transitioning to on - will reinitialize on next frame
+        // Transitioning to on - blit pipeline is recreated on next render()
         yinfo("Python: Transitioning to on - will reinitialize");
         wasOn_ = true;
-        // Reset initialization flags so we recreate resources
-        blitInitialized_ = false;
-        // Note: wgpuHandlesSet_ stays true, we just need to recreate blit pipeline
     }
 
-    if (!on || failed_ || !_visible) {
-        return;
-    }
+    bool active = on && !failed_ && _visible;
 
-    // First time: call init_layer, then execute user script
-    if (!wgpuHandlesSet_) {
-        uint32_t width = getPixelWidth();
-        uint32_t height = getPixelHeight();
+    uint32_t width = getPixelWidth();
+    uint32_t height = getPixelHeight();
 
+    if (active && !renderThread_.joinable()) {
         yinfo("Python: First prepareFrame - layer dimensions: {}x{}", width, height);
 
         // Use defaults if not set
         if (width == 0) width = 1024;
         if (height == 0) height = 768;
 
-        yinfo("Python: Initializing layer with dimensions: {}x{}", width, height);
+        startRenderThread(ctx, width, height);
+        return;
+    }
+
+    if (!renderThread_.joinable()) return;
+
+    // Off-screen widgets stop calling render() until they come back
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    if (width != 0) requestWidth_ = width;
+    if (height != 0) requestHeight_ = height;
+    if (renderPaused_ == active) {
+        renderPaused_ = !active;
+        renderCv_.notify_one();
+    }
+}
+
+Result<void> Python::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) {
+    // This is called INSIDE the shared render pass
+    // We only blit the last finished frame here - NO Python rendering!
+
+    if (!on) return Ok();  // Skip rendering when off
+    if (failed_) return Err<void>("Python: failed flag is set");
+    if (!_visible) return Ok();
+
+    // Never wait for the Python thread: composite whatever it published last
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    if (frontIndex_ < 0) return Ok();  // No frame finished yet
+
+    if (!blitToPass(pass, ctx, frontIndex_)) {
+        return Err<void>("Python: Failed to blit render texture");
+    }
+
+    return Ok();
+}
+
+//-----------------------------------------------------------------------------
+// Python thread
+//-----------------------------------------------------------------------------
+
+void Python::startRenderThread(WebGPUContext& ctx, uint32_t width, uint32_t height) {
+    {
+        std::lock_guard<std::mutex> lock(renderMutex_);
+        renderStop_ = false;
+        renderPaused_ = false;
+        requestWidth_ = width;
+        requestHeight_ = height;
+    }
+    renderThread_ = std::thread(&Python::renderLoop, this, &ctx, width, height);
+    yinfo("Python: started render thread at up to {} fps", maxFps_);
+}
+
+void Python::stopRenderThread() {
+    {
+        std::lock_guard<std::mutex> lock(renderMutex_);
+        renderStop_ = true;
+    }
+    renderCv_.notify_one();
+    if (renderThread_.joinable()) {
+        renderThread_.join();
+    }
+}
+
+void Python::renderLoop(WebGPUContext* ctx, uint32_t width, uint32_t height) {
+    auto interp = Interpreter::create(isolated_, plugin_->sysPaths());
+    if (!interp) {
+        yerror("Python: {}", error_msg(interp));
+        failed_ = true;
+        return;
+    }
+    interp_ = std::move(*interp);
 
-        // Call init_widget() callback with WebGPU context
-        if (!callInitWidget(ctx, width, height)) {
-            failed_ = true;
-            return;
+    if (!runScript(*ctx, width, height)) {
+        failed_ = true;
+        releasePython();
+        return;
+    }
+
+    const auto frameTime = std::chrono::nanoseconds(1'000'000'000LL / maxFps_);
+    auto nextFrame = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(renderMutex_);
+    while (true) {
+        renderCv_.wait_until(lock, nextFrame, [this] { return renderStop_; });
+        renderCv_.wait(lock, [this] { return renderStop_ || !renderPaused_; });
+        if (renderStop_) break;
+
+        std::vector<InputEvent> events;
+        events.swap(inputQueue_);
+        std::vector<std::string> repl;
+        repl.swap(replQueue_);
+        uint32_t w = requestWidth_ ? requestWidth_ : textureWidth_;
+        uint32_t h = requestHeight_ ? requestHeight_ : textureHeight_;
+        lock.unlock();
+
+        nextFrame = std::chrono::steady_clock::now() + frameTime;
+
+        dispatchInput(events);
+        runRepl(repl);
+
+        // A failing render() is not permanent, the user script might recover
+        if (callRender(*ctx, frameCount_, w, h)) {
+            publishFrame(*ctx);
         }
+        frameCount_++;
 
-        // Create per-widget namespace for isolated execution
-        if (!widgetDict_) {
-            PyGILState_STATE gstate = PyGILState_Ensure();
+        lock.lock();
+    }
+    lock.unlock();
 
-            // Create a new dict that inherits from __main__ but is isolated
-            widgetDict_ = PyDict_New();
+    releasePython();
+}
 
-            // Copy builtins so import etc. works
-            PyObject* mainModule = PyImport_AddModule("__main__");
-            PyObject* mainDict = PyModule_GetDict(mainModule);
-            PyObject* builtins = PyDict_GetItemString(mainDict, "__builtins__");
-            if (builtins) {
-                PyDict_SetItemString(widgetDict_, "__builtins__", builtins);
-            }
+bool Python::runScript(WebGPUContext& ctx, uint32_t width, uint32_t height) {
+    yinfo("Python: Initializing layer with dimensions: {}x{}", width, height);
 
-            // Set widget name
-            PyDict_SetItemString(widgetDict_, "__name__", PyUnicode_FromString("__widget__"));
-            PyDict_SetItemString(widgetDict_, "__widget_id__", PyLong_FromLong(widgetId_));
+    // Call init_widget() callback with WebGPU context
+    if (!callInitWidget(ctx, width, height)) {
+        return false;
+    }
+
+    // Create per-widget namespace for isolated execution
+    if (!widgetDict_) {
+        Interpreter::Lock lock(interp_.get());
 
-            PyGILState_Release(gstate);
-            yinfo("Python: Created per-widget namespace for widget {}", widgetId_);
+        // Create a new dict that inherits from __main__ but is isolated
+        widgetDict_ = PyDict_New();
+
+        // Copy builtins so import etc. works
+        PyObject* mainModule = PyImport_AddModule("__main__");
+        PyObject* mainDict = PyModule_GetDict(mainModule);
+        PyObject* builtins = PyDict_GetItemString(mainDict, "__builtins__");
+        if (builtins) {
+            PyDict_SetItemString(widgetDict_, "__builtins__", builtins);
         }
 
-        // Now execute the user script in the widget's namespace
-        if (!scriptPath_.empty()) {
-            yinfo("Python: Executing user script in widget namespace: {}", scriptPath_);
-            auto result = plugin_->runFileInNamespace(scriptPath_, widgetDict_);
-            if (!result) {
-                output_ = "Error: " + result.error().message();
-                yerror("Python: failed to run script: {}", scriptPath_);
-                failed_ = true;
-                return;
-            }
-            output_ = "Script executed: " + scriptPath_;
-            yinfo("Python: User script executed successfully in widget namespace");
-        } else if (!_payload.empty()) {
-            // Inline code
-            yinfo("Python: Executing inline code in widget namespace");
-            auto result = plugin_->executeInNamespace(_payload, widgetDict_);
-            if (!result) {
-                output_ = "Error: " + result.error().message();
-                failed_ = true;
-                return;
-            }
-            output_ = *result;
+        // Set widget name
+        PyDict_SetItemString(widgetDict_, "__name__", PyUnicode_FromString("__widget__"));
+        PyDict_SetItemString(widgetDict_, "__widget_id__", PyLong_FromLong(widgetId_));
+
+        yinfo("Python: Created per-widget namespace for widget {}", widgetId_);
+    }
+
+    // Now execute the user script in the widget's namespace
+    std::string output;
+    if (!scriptPath_.empty()) {
+        yinfo("Python: Executing user script in widget namespace: {}", scriptPath_);
+        auto result = interp_->execute(_payload, widgetDict_);  // Loaded by init()
+        if (!result) {
+            std::lock_guard<std::mutex> lock(renderMutex_);
+            output_ = "Error: " + result.error().message();
+            yerror("Python: failed to run script: {}", scriptPath_);
+            return false;
         }
+        output = "Script executed: " + scriptPath_;
+        yinfo("Python: User script executed successfully in widget namespace");
+    } else if (!_payload.empty()) {
+        // Inline code
+        yinfo("Python: Executing inline code in widget namespace");
+        auto result = interp_->execute(_payload, widgetDict_);
+        if (!result) {
+            std::lock_guard<std::mutex> lock(renderMutex_);
+            output_ = "Error: " + result.error().message();
+            return false;
+        }
+        output = *result;
     }
 
-    // Call user's render() callback every frame to render to texture
-    uint32_t width = getPixelWidth();
-    uint32_t height = getPixelHeight();
-    if (width == 0) width = textureWidth_;
-    if (height == 0) height = textureHeight_;
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    output_ = std::move(output);
+    return true;
+}
+
+void Python::dispatchInput(const std::vector<InputEvent>& events) {
+    if (events.empty() || !pygfxInitialized_) return;
 
-    if (!callRender(ctx, frameCount_, width, height)) {
-        // Render callback failed, but don't mark as failed permanently
-        // The user script might recover
+    // Forward to pygfx via Python callbacks
+    Interpreter::Lock lock(interp_.get());
+
+    PyObject* pygfx = PyImport_ImportModule("yetty_pygfx");
+    if (pygfx) {
+        for (const auto& ev : events) {
+            const char* name = ev.type == InputEvent::Move   ? "on_mouse_move"
+                             : ev.type == InputEvent::Button ? "on_mouse_button"
+                                                             : "on_mouse_scroll";
+            PyObject* func = PyObject_GetAttrString(pygfx, name);
+            if (func && PyCallable_Check(func)) {
+                PyObject* args = ev.type == InputEvent::Scroll
+                    ? Py_BuildValue("(ffffi)", ev.x, ev.y, ev.dx, ev.dy, ev.mods)
+                    : Py_BuildValue("(ffii)", ev.x, ev.y, ev.button, ev.pressed);
+                PyObject* result = PyObject_CallObject(func, args);
+                Py_XDECREF(result);
+                Py_DECREF(args);
+            }
+            Py_XDECREF(func);
+            PyErr_Clear();
+        }
+        Py_DECREF(pygfx);
     }
+    PyErr_Clear();
+}
 
-    frameCount_++;
+void Python::runRepl(const std::vector<std::string>& lines) {
+    for (const auto& line : lines) {
+        // The interpreter's __main__, which is the plugin's when shared
+        auto result = interp_ ? interp_->execute(line, nullptr) : plugin_->execute(line);
+        std::lock_guard<std::mutex> lock(renderMutex_);
+        if (result) {
+            output_ += ">>> " + line + "\n" + *result;
+        } else {
+            output_ += ">>> " + line + "\nError: " + result.error().message() + "\n";
+        }
+    }
 }
 
-Result<void> Python::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) {
-    // This is called INSIDE the shared render pass
-    // We only blit our pre-rendered texture here - NO Python rendering!
+bool Python::createDisplayTextures(WebGPUContext& ctx, uint32_t width, uint32_t height) {
+    std::lock_guard<std::mutex> lock(renderMutex_);
+
+    // The compositor's bind groups keep their own references to the old
+    // views and are rebuilt on the next flip
+    releaseDisplayTextures();
+
+    for (int i = 0; i < 2; i++) {
+        WGPUTextureDescriptor texDesc = {};
+        texDesc.size = {width, height, 1};
+        texDesc.mipLevelCount = 1;
+        texDesc.sampleCount = 1;
+        texDesc.dimension = WGPUTextureDimension_2D;
+        texDesc.format = WGPUTextureFormat_RGBA8Unorm;
+        texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
+
+        displayTextures_[i] = wgpuDeviceCreateTexture(ctx.getDevice(), &texDesc);
+        if (!displayTextures_[i]) {
+            yerror("Python: Failed to create display texture");
+            releaseDisplayTextures();
+            return false;
+        }
+        displayViews_[i] = wgpuTextureCreateView(displayTextures_[i], nullptr);
+        if (!displayViews_[i]) {
+            yerror("Python: Failed to create display texture view");
+            releaseDisplayTextures();
+            return false;
+        }
+    }
 
-    if (!on) return Ok();  // Skip rendering when off
-    if (failed_) return Err<void>("Python: failed flag is set");
-    if (!_visible) return Ok();
-    if (!wgpuHandlesSet_) return Ok();  // prepareFrame() hasn't run yet
+    displayWidth_ = width;
+    displayHeight_ = height;
+    displayGeneration_++;
+    return true;
+}
 
-    // Blit the rendered texture to the layer rectangle in the pass
-    if (!blitToPass(pass, ctx)) {
-        return Err<void>("Python: Failed to blit render texture");
+void Python::releaseDisplayTextures() {
+    for (int i = 0; i < 2; i++) {
+        if (displayViews_[i]) {
+            wgpuTextureViewRelease(displayViews_[i]);
+            displayViews_[i] = nullptr;
+        }
+        if (displayTextures_[i]) {
+            wgpuTextureRelease(displayTextures_[i]);
+            displayTextures_[i] = nullptr;
+        }
     }
+    displayWidth_ = 0;
+    displayHeight_ = 0;
+    frontIndex_ = -1;
+}
 
-    return Ok();
+bool Python::publishFrame(WebGPUContext& ctx) {
+    WGPUTexture source = yetty_wgpu_get_render_texture(widgetId_);
+    if (!source) return false;
+
+    // render() may have recreated the render texture at a new size
+    uint32_t width = wgpuTextureGetWidth(source);
+    uint32_t height = wgpuTextureGetHeight(source);
+    if (width != displayWidth_ || height != displayHeight_) {
+        if (!createDisplayTextures(ctx, width, height)) return false;
+    }
+
+    // Only this thread changes frontIndex_, reading it unlocked is fine
+    int back = frontIndex_ == 0 ? 1 : 0;
+
+    // Queue order puts the copy after whatever render() submitted
+    WGPUCommandEncoderDescriptor encDesc = {};
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(ctx.getDevice(), &encDesc);
+    if (!encoder) return false;
+
+    WGPUTexelCopyTextureInfo src = {};
+    src.texture = source;
+    src.aspect = WGPUTextureAspect_All;
+    WGPUTexelCopyTextureInfo dst = {};
+    dst.texture = displayTextures_[back];
+    dst.aspect = WGPUTextureAspect_All;
+    WGPUExtent3D extent = {width, height, 1};
+    wgpuCommandEncoderCopyTextureToTexture(encoder, &src, &dst, &extent);
+
+    WGPUCommandBufferDescriptor cmdDesc = {};
+    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, &cmdDesc);
+    wgpuQueueSubmit(ctx.getQueue(), 1, &cmd);
+    wgpuCommandBufferRelease(cmd);
+    wgpuCommandEncoderRelease(encoder);
+
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    frontIndex_ = back;
+    return true;
 }
 
 bool Python::callInitWidget(WebGPUContext& ctx, uint32_t width, uint32_t height) {
@@ -736,12 +834,31 @@ bool Python::callInitWidget(WebGPUContext& ctx, uint32_t width, uint32_t height)
     yinfo("Python: allocated widget_id={}", widgetId_);
 
     // Acquire GIL
-    PyGILState_STATE gstate = PyGILState_Ensure();
+    Interpreter::Lock lock(interp_.get());
+
+    // init.py callbacks; an isolated interpreter imports its own copy
+    if (!initWidgetFunc_) {
+        if (interp_ && interp_->isolated()) {
+            PyObject* initModule = PyImport_ImportModule("init");
+            if (initModule) {
+                initWidgetFunc_ = PyObject_GetAttrString(initModule, "init_widget");
+                disposeWidgetFunc_ = PyObject_GetAttrString(initModule, "dispose_widget");
+                Py_DECREF(initModule);
+            }
+            if (PyErr_Occurred()) {
+                PyErr_Print();
+            }
+        } else {
+            initWidgetFunc_ = plugin_->getInitWidgetFunc();
+            disposeWidgetFunc_ = plugin_->getDisposeWidgetFunc();
+            Py_XINCREF(initWidgetFunc_);
+            Py_XINCREF(disposeWidgetFunc_);
+        }
+    }
 
-    auto initFunc = plugin_->getInitWidgetFunc();
+    PyObject* initFunc = initWidgetFunc_;
     if (!initFunc) {
         yerror("Python: init_widget function not available");
-        PyGILState_Release(gstate);
         return false;
     }
 
@@ -749,7 +866,6 @@ bool Python::callInitWidget(WebGPUContext& ctx, uint32_t width, uint32_t height)
     PyObject* ctxDict = PyDict_New();
     if (!ctxDict) {
         yerror("Python: Failed to create ctx dict");
-        PyGILState_Release(gstate);
         return false;
     }
 
@@ -774,7 +890,6 @@ bool Python::callInitWidget(WebGPUContext& ctx, uint32_t width, uint32_t height)
         Py_DECREF(ctxDict);
         yerror("Python: Failed to build args");
         PyErr_Print();
-        PyGILState_Release(gstate);
         return false;
     }
 
@@ -787,12 +902,10 @@ bool Python::callInitWidget(WebGPUContext& ctx, uint32_t width, uint32_t height)
     if (!result) {
         yerror("Python: init_widget() raised exception");
         PyErr_Print();
-        PyGILState_Release(gstate);
         return false;
     }
 
     Py_DECREF(result);
-    PyGILState_Release(gstate);
 
     wgpuHandlesSet_ = true;
     textureWidth_ = width;
@@ -804,7 +917,7 @@ bool Python::callInitWidget(WebGPUContext& ctx, uint32_t width, uint32_t height)
 
 bool Python::callRender(WebGPUContext& ctx, uint32_t frameNum, uint32_t width, uint32_t height) {
     // Acquire GIL
-    PyGILState_STATE gstate = PyGILState_Ensure();
+    Interpreter::Lock lock(interp_.get());
 
     if (!userRenderFunc_) {
         // Try to get render function from widget's namespace (per-widget isolation)
@@ -821,7 +934,6 @@ bool Python::callRender(WebGPUContext& ctx, uint32_t frameNum, uint32_t width, u
 
         if (!userRenderFunc_) {
             ywarn("Python: No render() function found in user script for widget {}", widgetId_);
-            PyGILState_Release(gstate);
             return false;
         }
 
@@ -858,12 +970,10 @@ bool Python::callRender(WebGPUContext& ctx, uint32_t frameNum, uint32_t width, u
     if (!result) {
         PyErr_Print();
         yerror("Python: render() failed");
-        PyGILState_Release(gstate);
         return false;
     }
 
     Py_DECREF(result);
-    PyGILState_Release(gstate);
     return true;
 }
 
@@ -875,11 +985,13 @@ bool Python::callDisposeWidget() {
     yinfo("Python: calling dispose_widget({})", widgetId_);
 
     // Acquire GIL
-    PyGILState_STATE gstate = PyGILState_Ensure();
+    Interpreter::Lock lock(interp_.get());
 
-    auto disposeFunc = plugin_->getDisposeWidgetFunc();
+    PyObject* disposeFunc = disposeWidgetFunc_;
+    if (!disposeFunc && !(interp_ && interp_->isolated())) {
+        disposeFunc = plugin_->getDisposeWidgetFunc();
+    }
     if (!disposeFunc) {
-        PyGILState_Release(gstate);
         // Still cleanup C++ side
         yetty_wgpu_cleanup_widget(widgetId_);
         widgetId_ = -1;
@@ -894,7 +1006,6 @@ bool Python::callDisposeWidget() {
     if (!result) {
         PyErr_Print();
         ywarn("Python: dispose_widget() failed");
-        PyGILState_Release(gstate);
         // Still cleanup C++ side
         yetty_wgpu_cleanup_widget(widgetId_);
         widgetId_ = -1;
@@ -902,7 +1013,6 @@ bool Python::callDisposeWidget() {
     }
 
     Py_DECREF(result);
-    PyGILState_Release(gstate);
 
     widgetId_ = -1;
     return true;
@@ -1149,13 +1259,7 @@ bool Python::createBlitPipeline(WebGPUContext& ctx) {
     return true;
 }
 
-bool Python::blitToPass(WGPURenderPassEncoder pass, WebGPUContext& ctx) {
-    // Get the render texture view for this widget
-    WGPUTextureView texView = yetty_wgpu_get_render_texture_view(widgetId_);
-    if (!texView) {
-        return false;
-    }
-
+bool Python::blitToPass(WGPURenderPassEncoder pass, WebGPUContext& ctx, int index) {
     // Create blit pipeline if needed
     if (!blitInitialized_) {
         if (!createBlitPipeline(ctx)) {
@@ -1163,33 +1267,40 @@ bool Python::blitToPass(WGPURenderPassEncoder pass, WebGPUContext& ctx) {
         }
     }
 
-    // Create bind group (recreate each frame in case texture changed)
-    if (blitBindGroup_) {
-        wgpuBindGroupRelease(blitBindGroup_);
-        blitBindGroup_ = nullptr;
+    // One bind group per display texture, rebuilt only when the Python
+    // thread recreated them at a new size
+    if (boundGeneration_ != displayGeneration_) {
+        releaseBlitBindGroups();
+        boundGeneration_ = displayGeneration_;
     }
 
-    // Get bind group layout from pipeline
-    WGPUBindGroupLayout bgl = wgpuRenderPipelineGetBindGroupLayout(blitPipeline_, 0);
+    if (!blitBindGroups_[index]) {
+        if (!displayViews_[index]) {
+            return false;
+        }
+
+        // Get bind group layout from pipeline
+        WGPUBindGroupLayout bgl = wgpuRenderPipelineGetBindGroupLayout(blitPipeline_, 0);
 
-    WGPUBindGroupEntry bgEntries[2] = {};
-    bgEntries[0].binding = 0;
-    bgEntries[0].textureView = texView;
+        WGPUBindGroupEntry bgEntries[2] = {};
+        bgEntries[0].binding = 0;
+        bgEntries[0].textureView = displayViews_[index];
 
-    bgEntries[1].binding = 1;
-    bgEntries[1].sampler = blitSampler_;
+        bgEntries[1].binding = 1;
+        bgEntries[1].sampler = blitSampler_;
 
-    WGPUBindGroupDescriptor bgDesc = {};
-    bgDesc.layout = bgl;
-    bgDesc.entryCount = 2;
-    bgDesc.entries = bgEntries;
+        WGPUBindGroupDescriptor bgDesc = {};
+        bgDesc.layout = bgl;
+        bgDesc.entryCount = 2;
+        bgDesc.entries = bgEntries;
 
-    blitBindGroup_ = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
-    wgpuBindGroupLayoutRelease(bgl);
+        blitBindGroups_[index] = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
+        wgpuBindGroupLayoutRelease(bgl);
 
-    if (!blitBindGroup_) {
-        yerror("Python: Failed to create blit bind group");
-        return false;
+        if (!blitBindGroups_[index]) {
+            yerror("Python: Failed to create blit bind group");
+            return false;
+        }
     }
 
     // Set viewport to layer rectangle
@@ -1198,7 +1309,7 @@ bool Python::blitToPass(WGPURenderPassEncoder pass, WebGPUContext& ctx) {
     wgpuRenderPassEncoderSetScissorRect(pass, _pixelX, _pixelY, _pixelWidth, _pixelHeight);
 
     wgpuRenderPassEncoderSetPipeline(pass, blitPipeline_);
-    wgpuRenderPassEncoderSetBindGroup(pass, 0, blitBindGroup_, 0, nullptr);
+    wgpuRenderPassEncoderSetBindGroup(pass, 0, blitBindGroups_[index], 0, nullptr);
     wgpuRenderPassEncoderDraw(pass, 6, 1, 0, 0);
 
     // Reset viewport to full screen for next layer
@@ -1225,11 +1336,12 @@ bool Python::onKey(int key, int scancode, int action, int mods) {
     // Enter key - execute input buffer
     if (key == 257) { // GLFW_KEY_ENTER
         if (!inputBuffer_.empty()) {
-            auto result = plugin_->execute(inputBuffer_);
-            if (result) {
-                output_ += ">>> " + inputBuffer_ + "\n" + *result;
+            if (renderThread_.joinable()) {
+                // Runs between frames on the widget's Python thread
+                std::lock_guard<std::mutex> lock(renderMutex_);
+                replQueue_.push_back(std::move(inputBuffer_));
             } else {
-                output_ += ">>> " + inputBuffer_ + "\nError: " + result.error().message() + "\n";
+                runRepl({inputBuffer_});
             }
             inputBuffer_.clear();
             return true;
@@ -1261,25 +1373,10 @@ bool Python::onMouseMove(float localX, float localY) {
 
     if (!pygfxInitialized_) return false;
 
-    // Forward to pygfx via Python callback
-    PyGILState_STATE gstate = PyGILState_Ensure();
-
-    PyObject* pygfx = PyImport_ImportModule("yetty_pygfx");
-    if (pygfx) {
-        PyObject* func = PyObject_GetAttrString(pygfx, "on_mouse_move");
-        if (func && PyCallable_Check(func)) {
-            PyObject* args = Py_BuildValue("(ffii)", localX, localY,
-                                           mouseDown_ ? mouseButton_ : -1, 0);
-            PyObject* result = PyObject_CallObject(func, args);
-            Py_XDECREF(result);
-            Py_DECREF(args);
-        }
-        Py_XDECREF(func);
-        Py_DECREF(pygfx);
-    }
-    PyErr_Clear();
-
-    PyGILState_Release(gstate);
+    // Forwarded to pygfx on the widget's Python thread
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    inputQueue_.push_back({InputEvent::Move, localX, localY, 0.0f, 0.0f,
+                           mouseDown_ ? mouseButton_ : -1, 0, 0});
     return true;
 }
 
@@ -1289,48 +1386,18 @@ bool Python::onMouseButton(int button, bool pressed) {
 
     if (!pygfxInitialized_) return false;
 
-    // Forward to pygfx via Python callback
-    PyGILState_STATE gstate = PyGILState_Ensure();
-
-    PyObject* pygfx = PyImport_ImportModule("yetty_pygfx");
-    if (pygfx) {
-        PyObject* func = PyObject_GetAttrString(pygfx, "on_mouse_button");
-        if (func && PyCallable_Check(func)) {
-            PyObject* args = Py_BuildValue("(ffii)", mouseX_, mouseY_, button, pressed ? 1 : 0);
-            PyObject* result = PyObject_CallObject(func, args);
-            Py_XDECREF(result);
-            Py_DECREF(args);
-        }
-        Py_XDECREF(func);
-        Py_DECREF(pygfx);
-    }
-    PyErr_Clear();
-
-    PyGILState_Release(gstate);
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    inputQueue_.push_back({InputEvent::Button, mouseX_, mouseY_, 0.0f, 0.0f,
+                           button, pressed ? 1 : 0, 0});
     return true;
 }
 
 bool Python::onMouseScroll(float xoffset, float yoffset, int mods) {
     if (!pygfxInitialized_) return false;
 
-    // Forward to pygfx via Python callback
-    PyGILState_STATE gstate = PyGILState_Ensure();
-
-    PyObject* pygfx = PyImport_ImportModule("yetty_pygfx");
-    if (pygfx) {
-        PyObject* func = PyObject_GetAttrString(pygfx, "on_mouse_scroll");
-        if (func && PyCallable_Check(func)) {
-            PyObject* args = Py_BuildValue("(ffffi)", mouseX_, mouseY_, xoffset, yoffset, mods);
-            PyObject* result = PyObject_CallObject(func, args);
-            Py_XDECREF(result);
-            Py_DECREF(args);
-        }
-        Py_XDECREF(func);
-        Py_DECREF(pygfx);
-    }
-    PyErr_Clear();
-
-    PyGILState_Release(gstate);
+    std::lock_guard<std::mutex> lock(renderMutex_);
+    inputQueue_.push_back({InputEvent::Scroll, mouseX_, mouseY_, xoffset, yoffset,
+                           0, 0, mods});
     return true;
 }
 
@@ -1,15 +1,16 @@
 #pragma once
 
+#include "interpreter.h"
 #include <yetty/plugin.h>
 #include <webgpu/webgpu.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <string>
-
-// Forward declare Python types to avoid including Python.h in header
-struct _object;
-typedef _object PyObject;
-struct _ts;
-typedef _ts PyThreadState;
+#include <thread>
+#include <vector>
 
 namespace yetty {
 
@@ -63,6 +64,10 @@ public:
     PyObject* getInitWidgetFunc() const { return initWidgetFunc_; }
     PyObject* getDisposeWidgetFunc() const { return disposeWidgetFunc_; }
 
+    // Directories added to sys.path at runtime, oldest first, so isolated
+    // subinterpreters can see the same modules
+    const std::vector<std::string>& sysPaths() const { return sysPaths_; }
+
 private:
     PythonPlugin() noexcept = default;
     Result<void> pluginInit() noexcept;
@@ -73,6 +78,7 @@ private:
     PyObject* mainModule_ = nullptr;
     PyObject* mainDict_ = nullptr;
     PyThreadState* mainThreadState_ = nullptr;  // For GIL management
+    std::vector<std::string> sysPaths_;
 
     // Callback functions from init.py
     PyObject* initModule_ = nullptr;
@@ -84,6 +90,20 @@ private:
 
 //-----------------------------------------------------------------------------
 // Python - Displays Python output or runs Python scripts
+//
+// The script, init_widget() and every render() callback run on a dedicated
+// thread per widget, at most maxFps_ times a second (plugin args "--fps N").
+// After each frame that thread copies the Python render texture into the
+// back one of two display textures and flips them; the terminal render
+// thread only samples the front one, so a slow scene never holds up the
+// rest of the screen. Mouse events and REPL input are queued for the
+// Python thread instead of taking the GIL on the main thread.
+//
+// With "--isolated" the thread runs in its own subinterpreter with its own
+// GIL (Python 3.12+), so busy widgets do not serialize on one lock and
+// keep separate globals and modules. Extensions without subinterpreter
+// support (wgpu-py, so pygfx) cannot be imported there; such widgets
+// should stay shared, and older Pythons fall back to shared.
 //-----------------------------------------------------------------------------
 class Python : public Widget {
 public:
@@ -102,8 +122,15 @@ public:
         (void)factory;
         (void)fontManager;
         (void)loop;
-        (void)pluginArgs;
         auto w = std::shared_ptr<Python>(new Python(payload, plugin));
+        if (auto pos = pluginArgs.find("--fps"); pos != std::string::npos) {
+            auto num = pluginArgs.find_first_not_of(" =", pos + 5);
+            if (num != std::string::npos) {
+                long fps = std::strtol(pluginArgs.c_str() + num, nullptr, 10);
+                if (fps > 0) w->maxFps_ = static_cast<uint32_t>(fps);
+            }
+        }
+        w->isolated_ = pluginArgs.find("--isolated") != std::string::npos;
         w->_x = x;
         w->_y = y;
         w->_widthCells = widthCells;
@@ -143,7 +170,6 @@ public:
     bool initPygfx(WebGPUContext& ctx, uint32_t width, uint32_t height);
     bool renderPygfx();
     bool blitRenderTexture(WebGPUContext& ctx);
-    bool blitToPass(WGPURenderPassEncoder pass, WebGPUContext& ctx);
     bool isPygfxInitialized() const { return pygfxInitialized_; }
 
     // Callback management
@@ -160,18 +186,68 @@ private:
 
     Result<void> init() override;
     bool createBlitPipeline(WebGPUContext& ctx);
+    bool blitToPass(WGPURenderPassEncoder pass, WebGPUContext& ctx, int index);
+    void releaseBlitBindGroups();
+
+    static constexpr uint32_t DEFAULT_FPS = 30;
+
+    struct InputEvent {
+        enum Type { Move, Button, Scroll } type;
+        float x, y;
+        float dx, dy;
+        int button;
+        int pressed;
+        int mods;
+    };
+
+    // Python thread
+    void startRenderThread(WebGPUContext& ctx, uint32_t width, uint32_t height);
+    void stopRenderThread();
+    void renderLoop(WebGPUContext* ctx, uint32_t width, uint32_t height);
+    bool runScript(WebGPUContext& ctx, uint32_t width, uint32_t height);
+    void releasePython();
+    void dispatchInput(const std::vector<InputEvent>& events);
+    void runRepl(const std::vector<std::string>& lines);
+    bool publishFrame(WebGPUContext& ctx);
+    bool createDisplayTextures(WebGPUContext& ctx, uint32_t width, uint32_t height);
+    void releaseDisplayTextures();
 
     PythonPlugin* plugin_ = nullptr;
     std::string scriptPath_;
-    std::string output_;
+    std::string output_;       // Guarded by renderMutex_ once the thread runs
     std::string inputBuffer_;
-    bool failed_ = false;
+    std::atomic<bool> failed_{false};
+    uint32_t maxFps_ = DEFAULT_FPS;
+    bool isolated_ = false;
+
+    // Created, used and destroyed on the Python thread
+    Interpreter::Ptr interp_;
+
+    // Shared with the Python thread, guarded by renderMutex_
+    std::thread renderThread_;
+    std::mutex renderMutex_;
+    std::condition_variable renderCv_;
+    bool renderStop_ = false;
+    bool renderPaused_ = false;
+    uint32_t requestWidth_ = 0;
+    uint32_t requestHeight_ = 0;
+    std::vector<InputEvent> inputQueue_;
+    std::vector<std::string> replQueue_;
+    int frontIndex_ = -1;  // Display texture the compositor samples, -1 until the first frame
+    uint64_t displayGeneration_ = 0;  // Bumped whenever the display textures are recreated
+
+    // Double-buffered display textures, created and written by the Python
+    // thread. Views are only swapped under renderMutex_.
+    WGPUTexture displayTextures_[2] = {nullptr, nullptr};
+    WGPUTextureView displayViews_[2] = {nullptr, nullptr};
+    uint32_t displayWidth_ = 0;
+    uint32_t displayHeight_ = 0;
 
     // For rendering output
     float scrollOffset_ = 0.0f;
 
     // pygfx integration state
-    bool pygfxInitialized_ = false;
+    std::atomic<bool> pygfxInitialized_{false};
     bool wgpuHandlesSet_ = false;
     PyObject* pygfxModule_ = nullptr;
     PyObject* renderFrameFunc_ = nullptr;
@@ -183,6 +259,10 @@ private:
     // User render callback
     PyObject* userRenderFunc_ = nullptr;
 
+    // init.py callbacks in this widget's interpreter
+    PyObject* initWidgetFunc_ = nullptr;
+    PyObject* disposeWidgetFunc_ = nullptr;
+
     // Per-widget Python namespace (so each widget has isolated globals)
     PyObject* widgetDict_ = nullptr;
 
@@ -194,7 +274,8 @@ private:
 
     // Blit pipeline resources
     WGPURenderPipeline blitPipeline_ = nullptr;
-    WGPUBindGroup blitBindGroup_ = nullptr;
+    WGPUBindGroup blitBindGroups_[2] = {nullptr, nullptr};  // One per display texture
+    uint64_t boundGeneration_ = 0;
     WGPUSampler blitSampler_ = nullptr;
     bool blitInitialized_ = false;
 
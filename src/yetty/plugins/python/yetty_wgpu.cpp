@@ -12,6 +12,7 @@
 #include <webgpu/webgpu.h>
 #include <yetty/webgpu-context.h>
 #include <cstdint>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 
@@ -39,8 +40,10 @@ struct YettyWGPUState {
     // Reference to WebGPUContext (if available)
     yetty::WebGPUContext* ctx = nullptr;
 
-    // Per-widget texture states
+    // Per-widget texture states. Each widget renders on its own thread, so
+    // the map itself is guarded; an entry is only touched by its widget.
     std::unordered_map<int, WidgetTextureState> widgetTextures;
+    std::mutex widgetTexturesMutex;
 
     // Counter for generating unique widget IDs
     int nextWidgetId = 1;
@@ -52,6 +55,7 @@ static YettyWGPUState g_state;
 // Helper to get widget state
 //-----------------------------------------------------------------------------
 static WidgetTextureState* getWidgetState(int widgetId) {
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     auto it = g_state.widgetTextures.find(widgetId);
     if (it == g_state.widgetTextures.end()) {
         return nullptr;
@@ -244,6 +248,7 @@ static PyObject* set_handles(PyObject* self, PyObject* args, PyObject* kwargs) {
 // Allocate a new widget ID and return it
 static PyObject* allocate_widget_id(PyObject* self, PyObject* args) {
     (void)self; (void)args;
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     int widgetId = g_state.nextWidgetId++;
     g_state.widgetTextures[widgetId] = WidgetTextureState{};
     return PyLong_FromLong(widgetId);
@@ -339,6 +344,7 @@ static PyObject* cleanup_widget(PyObject* self, PyObject* args) {
         return nullptr;
     }
 
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     auto it = g_state.widgetTextures.find(widgetId);
     if (it == g_state.widgetTextures.end()) {
         // Widget not found, nothing to cleanup
@@ -366,6 +372,7 @@ static PyObject* cleanup_widget(PyObject* self, PyObject* args) {
 static PyObject* cleanup_all(PyObject* self, PyObject* args) {
     (void)self; (void)args;
 
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     for (auto& [id, ws] : g_state.widgetTextures) {
         if (ws.renderTextureView) {
             wgpuTextureViewRelease(ws.renderTextureView);
@@ -384,6 +391,7 @@ static PyObject* cleanup_all(PyObject* self, PyObject* args) {
 static PyObject* get_widget_ids(PyObject* self, PyObject* args) {
     (void)self; (void)args;
 
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     PyObject* list = PyList_New(g_state.widgetTextures.size());
     if (!list) return nullptr;
 
@@ -451,12 +459,27 @@ static PyMethodDef YettyWgpuMethods[] = {
     {nullptr, nullptr, 0, nullptr}
 };
 
+#if PY_VERSION_HEX >= 0x030C0000
+// All state lives in g_state, shared by every interpreter and guarded where
+// widget threads meet, so isolated subinterpreters may import the module
+static PyModuleDef_Slot YettyWgpuSlots[] = {
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    {0, nullptr}
+};
+#endif
+
 static struct PyModuleDef yetty_wgpu_module = {
     PyModuleDef_HEAD_INIT,
     "yetty_wgpu",
     "Yetty WebGPU handle exposure for Python graphics libraries (multi-widget)",
+#if PY_VERSION_HEX >= 0x030C0000
+    0,
+    YettyWgpuMethods,
+    YettyWgpuSlots,
+#else
     -1,
-    YettyWgpuMethods
+    YettyWgpuMethods,
+#endif
 };
 
 } // anonymous namespace
@@ -466,7 +489,11 @@ static struct PyModuleDef yetty_wgpu_module = {
 //-----------------------------------------------------------------------------
 
 PyMODINIT_FUNC PyInit_yetty_wgpu(void) {
+#if PY_VERSION_HEX >= 0x030C0000
+    return PyModuleDef_Init(&yetty_wgpu_module);
+#else
     return PyModule_Create(&yetty_wgpu_module);
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -499,6 +526,7 @@ void yetty_wgpu_set_handles(
 
 // Allocate a new widget ID (C++ API)
 int yetty_wgpu_allocate_widget_id() {
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     int widgetId = g_state.nextWidgetId++;
     g_state.widgetTextures[widgetId] = WidgetTextureState{};
     return widgetId;
@@ -577,6 +605,7 @@ WGPUTextureView yetty_wgpu_get_render_texture_view(int widgetId) {
 
 // Cleanup a specific widget (C++ API)
 void yetty_wgpu_cleanup_widget(int widgetId) {
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     auto it = g_state.widgetTextures.find(widgetId);
     if (it == g_state.widgetTextures.end()) return;
 
@@ -593,6 +622,7 @@ void yetty_wgpu_cleanup_widget(int widgetId) {
 
 // Cleanup all widgets (C++ API)
 void yetty_wgpu_cleanup() {
+    std::lock_guard<std::mutex> lock(g_state.widgetTexturesMutex);
     for (auto& [id, ws] : g_state.widgetTextures) {
         if (ws.renderTextureView) {
             wgpuTextureViewRelease(ws.renderTextureView);
@@ -603,7 +633,12 @@ void yetty_wgpu_cleanup() {
         }
     }
     g_state.widgetTextures.clear();
-    g_state = YettyWGPUState{};
+    g_state.instance = nullptr;
+    g_state.adapter = nullptr;
+    g_state.device = nullptr;
+    g_state.queue = nullptr;
+    g_state.ctx = nullptr;
+    g_state.nextWidgetId = 1;
 }
 
 } // extern "C"
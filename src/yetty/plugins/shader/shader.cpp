@@ -5,6 +5,7 @@
 #include <yetty/shader-manager.h>
 #include <yetty/wgpu-compat.h>
 #include <ytrace/ytrace.hpp>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <regex>
@@ -38,10 +39,116 @@ Result<void> ShaderPlugin::dispose() {
     if (auto res = Plugin::dispose(); !res) {
         return Err<void>("Failed to dispose ShaderPlugin", res);
     }
+    releaseGlobals();
     _initialized = false;
     return Ok();
 }
 
+Result<void> ShaderPlugin::ensureGlobals(WebGPUContext& ctx) {
+    if (globalBindGroup_) return Ok();
+
+    // Create global uniform buffer (matches ShaderManager::GlobalUniforms)
+    WGPUBufferDescriptor bufDesc = {};
+    bufDesc.size = 48;  // iTime, iTimeRelative, iTimeDelta, iFrame, iMouse, iScreenResolution, pad
+    bufDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
+    bufDesc.mappedAtCreation = false;
+
+    globalUniformBuffer_ = wgpuDeviceCreateBuffer(ctx.getDevice(), &bufDesc);
+    if (!globalUniformBuffer_) {
+        return Err<void>("Failed to create global uniform buffer");
+    }
+
+    WGPUBindGroupLayoutEntry entry = {};
+    entry.binding = 0;
+    entry.visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
+    entry.buffer.type = WGPUBufferBindingType_Uniform;
+
+    WGPUBindGroupLayoutDescriptor bglDesc = {};
+    bglDesc.entryCount = 1;
+    bglDesc.entries = &entry;
+
+    globalBindGroupLayout_ = ctx.shaderCache().createBindGroupLayout(&bglDesc);
+    if (!globalBindGroupLayout_) {
+        releaseGlobals();
+        return Err<void>("Failed to create global bind group layout");
+    }
+
+    WGPUBindGroupEntry bgEntry = {};
+    bgEntry.binding = 0;
+    bgEntry.buffer = globalUniformBuffer_;
+    bgEntry.size = 48;
+
+    WGPUBindGroupDescriptor bgDesc = {};
+    bgDesc.layout = globalBindGroupLayout_;
+    bgDesc.entryCount = 1;
+    bgDesc.entries = &bgEntry;
+
+    globalBindGroup_ = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
+    if (!globalBindGroup_) {
+        releaseGlobals();
+        return Err<void>("Failed to create global bind group");
+    }
+
+    startTime_ = std::chrono::steady_clock::now();
+    lastFrameTime_ = startTime_;
+    frame_ = 0;
+    return Ok();
+}
+
+void ShaderPlugin::releaseGlobals() {
+    if (globalBindGroup_) { wgpuBindGroupRelease(globalBindGroup_); globalBindGroup_ = nullptr; }
+    if (globalBindGroupLayout_) { wgpuBindGroupLayoutRelease(globalBindGroupLayout_); globalBindGroupLayout_ = nullptr; }
+    if (globalUniformBuffer_) { wgpuBufferRelease(globalUniformBuffer_); globalUniformBuffer_ = nullptr; }
+}
+
+void ShaderPlugin::beginFrame(WebGPUContext& ctx, uint64_t& layerFrame) {
+    if (!globalUniformBuffer_) return;
+
+    // A layer that already saw frame_ is back, so this is a new frame.
+    // A layer that is behind (new, or skipped frames) just catches up.
+    if (layerFrame != frame_) {
+        layerFrame = frame_;
+        return;
+    }
+
+    struct GlobalUniforms {
+        float iTime;
+        float iTimeRelative;
+        float iTimeDelta;
+        uint32_t iFrame;
+        float iMouse[4];
+        float iScreenResolution[2];
+        float _pad[2];
+    } globals = {};
+
+    auto now = std::chrono::steady_clock::now();
+    uint32_t screenW = ctx.getSurfaceWidth();
+    uint32_t screenH = ctx.getSurfaceHeight();
+
+    globals.iTime = std::chrono::duration<float>(now - startTime_).count();
+    globals.iTimeRelative = globals.iTime;
+    globals.iTimeDelta = frame_ == 0 ? 0.0f : std::chrono::duration<float>(now - lastFrameTime_).count();
+    globals.iFrame = static_cast<uint32_t>(frame_);
+    globals.iMouse[0] = mouse_[0];
+    globals.iMouse[1] = static_cast<float>(screenH) - mouse_[1];  // Y=0 at bottom
+    globals.iMouse[2] = mouse_[2];
+    globals.iMouse[3] = mouse_[3];
+    globals.iScreenResolution[0] = static_cast<float>(screenW);
+    globals.iScreenResolution[1] = static_cast<float>(screenH);
+
+    wgpuQueueWriteBuffer(ctx.getQueue(), globalUniformBuffer_, 0, &globals, sizeof(globals));
+
+    lastFrameTime_ = now;
+    layerFrame = ++frame_;
+}
+
+void ShaderPlugin::setMouse(float x, float y, bool down, bool grabbed) {
+    mouse_[0] = x;
+    mouse_[1] = y;
+    mouse_[2] = down ? 1.0f : 0.0f;
+    mouse_[3] = grabbed ? 1.0f : 0.0f;
+}
+
 Result<WidgetPtr> ShaderPlugin::createWidget(
     const std::string& widgetName,
     WidgetFactory* factory,
@@ -57,7 +164,7 @@ Result<WidgetPtr> ShaderPlugin::createWidget(
     (void)widgetName;
     yfunc();
     yinfo("payload size={} x={} y={} w={} h={} pluginArgs='{}'", payload.size(), x, y, widthCells, heightCells, pluginArgs);
-    return Shader::create(factory, fontManager, loop, x, y, widthCells, heightCells, pluginArgs, payload);
+    return Shader::create(factory, fontManager, loop, x, y, widthCells, heightCells, pluginArgs, payload, this);
 }
 
 //-----------------------------------------------------------------------------
@@ -171,20 +278,6 @@ Result<void> Shader::dispose() {
         wgpuTextureRelease(_placeholderTexture);
         _placeholderTexture = nullptr;
     }
-    
-    // Release standalone global resources
-    if (_globalBindGroup) {
-        wgpuBindGroupRelease(_globalBindGroup);
-        _globalBindGroup = nullptr;
-    }
-    if (_globalBindGroupLayout) {
-        wgpuBindGroupLayoutRelease(_globalBindGroupLayout);
-        _globalBindGroupLayout = nullptr;
-    }
-    if (_globalUniformBuffer) {
-        wgpuBufferRelease(_globalUniformBuffer);
-        _globalUniformBuffer = nullptr;
-    }
 
     _compiled = false;
     return Ok();
@@ -226,11 +319,6 @@ void Shader::releaseGPUResources() {
     if (_placeholderTextureView) { wgpuTextureViewRelease(_placeholderTextureView); _placeholderTextureView = nullptr; }
     if (_placeholderTexture) { wgpuTextureRelease(_placeholderTexture); _placeholderTexture = nullptr; }
 
-    // Release standalone global resources
-    if (_globalBindGroup) { wgpuBindGroupRelease(_globalBindGroup); _globalBindGroup = nullptr; }
-    if (_globalBindGroupLayout) { wgpuBindGroupLayoutRelease(_globalBindGroupLayout); _globalBindGroupLayout = nullptr; }
-    if (_globalUniformBuffer) { wgpuBufferRelease(_globalUniformBuffer); _globalUniformBuffer = nullptr; }
-
     _compiled = false;
     yinfo("Shader: GPU resources released");
 }
@@ -255,71 +343,11 @@ void Shader::prepareFrame(WebGPUContext& ctx, bool on) {
     if (!on || _failed || !_visible) return;
 
     if (!_compiled) {
-        // Load channel textures if specified
-        for (int i = 0; i < kMaxChannels; ++i) {
-            if (!_channels[i].path.empty() && !_channels[i].loaded) {
-                (void)createChannelSampler(ctx);
-                (void)loadChannelTexture(ctx, i, _channels[i].path);
-            }
-        }
-
-        // Parse multipass sections first
-        _isMultipass = parseMultipassShader(_payload);
-
-        // Use parsed _mainImageCode or original payload
-        std::string shaderToCompile = _mainImageCode.empty() ? _payload : _mainImageCode;
-        auto result = compileShader(ctx, ctx.getSurfaceFormat(), shaderToCompile);
-        if (!result) {
+        if (auto res = compile(ctx); !res) {
+            yerror("Shader prepareFrame: {}", error_msg(res));
             _failed = true;
             return;
         }
-
-        // Setup multipass if detected
-        if (_isMultipass) {
-            uint32_t w = _pixelWidth;
-            uint32_t h = _pixelHeight;
-            if (w > 0 && h > 0) {
-                if (auto res = createBufferTextures(ctx, w, h); !res) {
-                    ywarn("Shader: Failed to create buffer textures: {}", res.error().message());
-                    _isMultipass = false;
-                } else {
-                    for (int i = 0; i < kMaxBufferPasses; ++i) {
-                        if (_bufferPasses[i].enabled) {
-                            if (auto res2 = compileBufferPass(ctx, i); !res2) {
-                                ywarn("Shader: Failed to compile buffer pass {}: {}", i, res2.error().message());
-                            }
-                        }
-                    }
-                    // Create bind group for Image pass with texture bindings
-                    if (_bufferBindGroupLayout && _bufferSampler) {
-                        std::array<WGPUBindGroupEntry, 6> bgEntries = {};
-                        bgEntries[0].binding = 0;
-                        bgEntries[0].buffer = _uniformBuffer;
-                        bgEntries[0].size = 48;
-                        
-                        bgEntries[1].binding = 1;
-                        bgEntries[1].sampler = _bufferSampler;
-                        
-                        // Bind buffer textures as iChannel inputs
-                        for (int i = 0; i < 4; ++i) {
-                            bgEntries[2 + i].binding = 2 + i;
-                            if (i < kMaxBufferPasses && _bufferPasses[i].texturePrevView) {
-                                bgEntries[2 + i].textureView = _bufferPasses[i].texturePrevView;
-                            } else if (_bufferPasses[0].texturePrevView) {
-                                bgEntries[2 + i].textureView = _bufferPasses[0].texturePrevView;
-                            }
-                        }
-                        
-                        WGPUBindGroupDescriptor bgDesc = {};
-                        bgDesc.layout = _bufferBindGroupLayout;
-                        bgDesc.entryCount = bgEntries.size();
-                        bgDesc.entries = bgEntries.data();
-                        _bindGroup = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
-                    }
-                }
-            }
-        }
-        _compiled = true;
     }
 
     if (!_pipeline || !_uniformBuffer || !_bindGroup) {
@@ -328,252 +356,121 @@ void Shader::prepareFrame(WebGPUContext& ctx, bool on) {
         return;
     }
 
-    // Get global bind group - standalone mode (plugin tester or standalone)
-    WGPUBindGroup globalBindGroup = nullptr;
-    if (!_globalBindGroup) {
-        if (auto res = createStandaloneGlobalBindGroup(ctx); !res) {
-            yerror("Shader prepareFrame: failed to create standalone global bind group: {}", res.error().message());
-            return;
-        }
-    }
-    globalBindGroup = _globalBindGroup;
-    
-    // Update global uniforms
-    struct GlobalUniforms {
-        float iTime;
-        float iTimeRelative;
-        float iTimeDelta;
-        uint32_t iFrame;
-        float iMouse[4];
-        float iScreenResolution[2];
-        float _pad[2];
-    } globals;
-    
-    static auto startTime = std::chrono::steady_clock::now();
-    static uint32_t frameCount = 0;
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration<float>(now - startTime).count();
-    
-    uint32_t screenW = ctx.getSurfaceWidth();
-    uint32_t screenH = ctx.getSurfaceHeight();
-
-    globals.iTime = elapsed;
-    globals.iTimeRelative = elapsed;
-    globals.iTimeDelta = 0.016f;  // ~60fps default
-    globals.iFrame = frameCount++;
-    globals.iMouse[0] = _mouseX * screenW;
-    globals.iMouse[1] = _mouseY * screenH;
-    globals.iMouse[2] = _mouseDown ? 1.0f : 0.0f;
-    globals.iMouse[3] = _mouseGrabbed ? 1.0f : 0.0f;
-    globals.iScreenResolution[0] = static_cast<float>(screenW);
-    globals.iScreenResolution[1] = static_cast<float>(screenH);
-
-    wgpuQueueWriteBuffer(ctx.getQueue(), _globalUniformBuffer, 0, &globals, sizeof(globals));
+    _plugin->beginFrame(ctx, _frame);
+    writePluginUniforms(ctx);
 
     // Render buffer passes first (if any)
-    if (_isMultipass) {
+    if (_isMultipass && needsBufferPasses()) {
         renderBufferPasses(ctx);
     }
+}
 
-    // Use pixel position/size set by Terminal
-    float ndcX = (_pixelX / screenW) * 2.0f - 1.0f;
-    float ndcY = 1.0f - (_pixelY / screenH) * 2.0f;
-    float ndcW = (static_cast<float>(_pixelWidth) / screenW) * 2.0f;
-    float ndcH = (static_cast<float>(_pixelHeight) / screenH) * 2.0f;
-
-    struct PluginUniforms {
-        float resolution[2];
-        float param;
-        float zoom;
-        float rect[4];
-        float mouse[4];
-    } uniforms;
-
-    uniforms.resolution[0] = static_cast<float>(_pixelWidth);
-    uniforms.resolution[1] = static_cast<float>(_pixelHeight);
-    uniforms.param = _param;
-    uniforms.zoom = _zoom;
-    uniforms.rect[0] = ndcX;
-    uniforms.rect[1] = ndcY;
-    uniforms.rect[2] = ndcW;
-    uniforms.rect[3] = ndcH;
-    uniforms.mouse[0] = _mouseX;
-    uniforms.mouse[1] = _mouseY;
-    uniforms.mouse[2] = _mouseGrabbed ? 1.0f : 0.0f;
-    uniforms.mouse[3] = _mouseDown ? 1.0f : 0.0f;
-
-    wgpuQueueWriteBuffer(ctx.getQueue(), _uniformBuffer, 0, &uniforms, sizeof(uniforms));
-
-    WGPUCommandEncoderDescriptor encoderDesc = {};
-    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(ctx.getDevice(), &encoderDesc);
-    if (!encoder) {
-        yerror("Shader prepareFrame: Failed to create command encoder");
-        return;
-    }
-
-    auto viewResult = ctx.getCurrentTextureView();
-    if (!viewResult) return;
-    WGPURenderPassColorAttachment colorAttachment = {};
-    colorAttachment.view = *viewResult;
-    colorAttachment.loadOp = WGPULoadOp_Load;
-    colorAttachment.storeOp = WGPUStoreOp_Store;
-    colorAttachment.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
-
-    WGPURenderPassDescriptor passDesc = {};
-    passDesc.colorAttachmentCount = 1;
-    passDesc.colorAttachments = &colorAttachment;
+Result<void> Shader::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) {
+    (void)ctx;
+    if (!on) return Ok();
+    if (_failed) return Err<void>("Shader already failed");
+    if (!_visible || !_compiled) return Ok();
 
-    WGPURenderPassEncoder pass = wgpuCommandEncoderBeginRenderPass(encoder, &passDesc);
-    if (!pass) {
-        wgpuCommandEncoderRelease(encoder);
-        yerror("Shader prepareFrame: Failed to begin render pass");
-        return;
+    WGPUBindGroup globalBindGroup = getGlobalBindGroup();
+    if (!_pipeline || !_bindGroup || !globalBindGroup) {
+        _failed = true;
+        return Err<void>("Shader: pipeline not initialized");
     }
 
     wgpuRenderPassEncoderSetPipeline(pass, _pipeline);
     wgpuRenderPassEncoderSetBindGroup(pass, 0, globalBindGroup, 0, nullptr);
     wgpuRenderPassEncoderSetBindGroup(pass, 1, _bindGroup, 0, nullptr);
     wgpuRenderPassEncoderDraw(pass, 6, 1, 0, 0);
-    wgpuRenderPassEncoderEnd(pass);
-    wgpuRenderPassEncoderRelease(pass);
 
-    WGPUCommandBufferDescriptor cmdDesc = {};
-    WGPUCommandBuffer cmdBuffer = wgpuCommandEncoderFinish(encoder, &cmdDesc);
-    if (!cmdBuffer) {
-        wgpuCommandEncoderRelease(encoder);
-        yerror("Shader prepareFrame: Failed to finish command encoder");
-        return;
-    }
-    wgpuQueueSubmit(ctx.getQueue(), 1, &cmdBuffer);
-    wgpuCommandBufferRelease(cmdBuffer);
-    wgpuCommandEncoderRelease(encoder);
+    return Ok();
 }
 
-Result<void> Shader::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) {
-    (void)pass;  // Shader renders in prepareFrame
-    if (!on) return Ok();
-    if (_failed) return Err<void>("Shader already failed");
-    if (!_visible) return Ok();
+Result<void> Shader::compile(WebGPUContext& ctx) {
+    if (auto res = _plugin->ensureGlobals(ctx); !res) {
+        return Err<void>("Shader: failed to create global bind group", res);
+    }
 
-    if (!_compiled) {
-        // Load channel textures if specified
-        for (int i = 0; i < kMaxChannels; ++i) {
-            if (!_channels[i].path.empty() && !_channels[i].loaded) {
-                (void)createChannelSampler(ctx);
-                (void)loadChannelTexture(ctx, i, _channels[i].path);
-            }
+    // Load channel textures if specified
+    for (int i = 0; i < kMaxChannels; ++i) {
+        if (!_channels[i].path.empty() && !_channels[i].loaded) {
+            (void)createChannelSampler(ctx);
+            (void)loadChannelTexture(ctx, i, _channels[i].path);
         }
+    }
 
-        // Parse multipass sections first
-        _isMultipass = parseMultipassShader(_payload);
+    // Parse multipass sections first
+    _isMultipass = parseMultipassShader(_payload);
+    _static = !usesFrameInputs(_payload);
+    _settleFrames = kMaxBufferPasses;
 
-        // Use parsed _mainImageCode or original payload
-        std::string shaderToCompile = _mainImageCode.empty() ? _payload : _mainImageCode;
-        auto result = compileShader(ctx, ctx.getSurfaceFormat(), shaderToCompile);
-        if (!result) {
-            _failed = true;
-            return Err<void>("Shader: Failed to compile shader", result);
-        }
+    // Use parsed _mainImageCode or original payload
+    std::string shaderToCompile = _mainImageCode.empty() ? _payload : _mainImageCode;
+    if (auto res = compileShader(ctx, ctx.getSurfaceFormat(), shaderToCompile); !res) {
+        return Err<void>("Shader: Failed to compile shader", res);
+    }
 
-        // Setup multipass if detected
-        if (_isMultipass) {
-            uint32_t w = _pixelWidth;
-            uint32_t h = _pixelHeight;
-            if (w > 0 && h > 0) {
-                if (auto res = createBufferTextures(ctx, w, h); res) {
-                    for (int i = 0; i < kMaxBufferPasses; ++i) {
-                        if (_bufferPasses[i].enabled) {
-                            (void)compileBufferPass(ctx, i);
+    // Setup multipass if detected
+    if (_isMultipass) {
+        uint32_t w = _pixelWidth;
+        uint32_t h = _pixelHeight;
+        if (w > 0 && h > 0) {
+            if (auto res = createBufferTextures(ctx, w, h); !res) {
+                ywarn("Shader: Failed to create buffer textures: {}", res.error().message());
+                _isMultipass = false;
+            } else {
+                for (int i = 0; i < kMaxBufferPasses; ++i) {
+                    if (_bufferPasses[i].enabled) {
+                        if (auto res2 = compileBufferPass(ctx, i); !res2) {
+                            ywarn("Shader: Failed to compile buffer pass {}: {}", i, res2.error().message());
                         }
                     }
-                    // Create bind group for Image pass with texture bindings
-                    if (_bufferBindGroupLayout && _bufferSampler) {
-                        std::array<WGPUBindGroupEntry, 6> bgEntries = {};
-                        bgEntries[0].binding = 0;
-                        bgEntries[0].buffer = _uniformBuffer;
-                        bgEntries[0].size = 48;
-
-                        bgEntries[1].binding = 1;
-                        bgEntries[1].sampler = _bufferSampler;
-
-                        for (int i = 0; i < 4; ++i) {
-                            bgEntries[2 + i].binding = 2 + i;
-                            if (i < kMaxBufferPasses && _bufferPasses[i].texturePrevView) {
-                                bgEntries[2 + i].textureView = _bufferPasses[i].texturePrevView;
-                            } else if (_bufferPasses[0].texturePrevView) {
-                                bgEntries[2 + i].textureView = _bufferPasses[0].texturePrevView;
-                            }
+                }
+                // Create bind group for Image pass with texture bindings
+                if (_bufferBindGroupLayout && _bufferSampler) {
+                    std::array<WGPUBindGroupEntry, 6> bgEntries = {};
+                    bgEntries[0].binding = 0;
+                    bgEntries[0].buffer = _uniformBuffer;
+                    bgEntries[0].size = 48;
+
+                    bgEntries[1].binding = 1;
+                    bgEntries[1].sampler = _bufferSampler;
+
+                    // Bind buffer textures as iChannel inputs
+                    for (int i = 0; i < 4; ++i) {
+                        bgEntries[2 + i].binding = 2 + i;
+                        if (i < kMaxBufferPasses && _bufferPasses[i].texturePrevView) {
+                            bgEntries[2 + i].textureView = _bufferPasses[i].texturePrevView;
+                        } else if (_bufferPasses[0].texturePrevView) {
+                            bgEntries[2 + i].textureView = _bufferPasses[0].texturePrevView;
                         }
-
-                        WGPUBindGroupDescriptor bgDesc = {};
-                        bgDesc.layout = _bufferBindGroupLayout;
-                        bgDesc.entryCount = bgEntries.size();
-                        bgDesc.entries = bgEntries.data();
-                        _bindGroup = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
                     }
-                } else {
-                    _isMultipass = false;
+
+                    WGPUBindGroupDescriptor bgDesc = {};
+                    bgDesc.layout = _bufferBindGroupLayout;
+                    bgDesc.entryCount = bgEntries.size();
+                    bgDesc.entries = bgEntries.data();
+                    _bindGroup = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
                 }
             }
         }
-        _compiled = true;
-    }
-
-    if (!_pipeline || !_uniformBuffer || !_bindGroup) {
-        _failed = true;
-        return Err<void>("Shader: pipeline not initialized");
     }
 
-    // Get global bind group - standalone mode
-    WGPUBindGroup globalBindGroup = nullptr;
-    if (!_globalBindGroup) {
-        // Create standalone bind group
-        if (auto res = createStandaloneGlobalBindGroup(ctx); !res) {
-            return Err<void>("Shader: failed to create standalone global bind group", res);
-        }
+    if (_isMultipass && _static) {
+        yinfo("Shader: static shader, buffer passes run on input changes only");
     }
-    globalBindGroup = _globalBindGroup;
-
-    // Update global uniforms
-    struct GlobalUniforms {
-        float iTime;
-        float iTimeRelative;
-        float iTimeDelta;
-        uint32_t iFrame;
-        float iMouse[4];
-        float iScreenResolution[2];
-        float _pad[2];
-    } globals;
-
-    static auto startTime = std::chrono::steady_clock::now();
-    static uint32_t frameCount = 0;
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration<float>(now - startTime).count();
-
-    globals.iTime = elapsed;
-    globals.iTimeRelative = elapsed;
-    globals.iTimeDelta = 0.016f;  // ~60fps
-    globals.iFrame = frameCount++;
-    globals.iMouse[0] = _mouseX * ctx.getSurfaceWidth();
-    globals.iMouse[1] = _mouseY * ctx.getSurfaceHeight();
-    globals.iMouse[2] = _mouseDown ? 1.0f : 0.0f;
-    globals.iMouse[3] = _mouseGrabbed ? 1.0f : 0.0f;
-    globals.iScreenResolution[0] = static_cast<float>(ctx.getSurfaceWidth());
-    globals.iScreenResolution[1] = static_cast<float>(ctx.getSurfaceHeight());
-
-    wgpuQueueWriteBuffer(ctx.getQueue(), _globalUniformBuffer, 0, &globals, sizeof(globals));
-
-    if (!globalBindGroup) return Err<void>("Shader: no global bind group");
+    _compiled = true;
+    return Ok();
+}
 
-    // Render buffer passes first (if any) - these create their own command buffers
-    if (_isMultipass) {
-        renderBufferPasses(ctx);
-    }
+void Shader::writePluginUniforms(WebGPUContext& ctx) {
+    uint32_t screenW = ctx.getSurfaceWidth();
+    uint32_t screenH = ctx.getSurfaceHeight();
 
-    float ndcX = (static_cast<float>(_pixelX) / ctx.getSurfaceWidth()) * 2.0f - 1.0f;
-    float ndcY = 1.0f - (static_cast<float>(_pixelY) / ctx.getSurfaceHeight()) * 2.0f;
-    float ndcW = (static_cast<float>(_pixelWidth) / ctx.getSurfaceWidth()) * 2.0f;
-    float ndcH = (static_cast<float>(_pixelHeight) / ctx.getSurfaceHeight()) * 2.0f;
+    // Use pixel position/size set by Terminal
+    float ndcX = (_pixelX / screenW) * 2.0f - 1.0f;
+    float ndcY = 1.0f - (_pixelY / screenH) * 2.0f;
+    float ndcW = (static_cast<float>(_pixelWidth) / screenW) * 2.0f;
+    float ndcH = (static_cast<float>(_pixelHeight) / screenH) * 2.0f;
 
     struct PluginUniforms {
         float resolution[2];
@@ -597,19 +494,32 @@ Result<void> Shader::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool
     uniforms.mouse[3] = _mouseDown ? 1.0f : 0.0f;
 
     wgpuQueueWriteBuffer(ctx.getQueue(), _uniformBuffer, 0, &uniforms, sizeof(uniforms));
+}
 
-    wgpuRenderPassEncoderSetPipeline(pass, _pipeline);
-    wgpuRenderPassEncoderSetBindGroup(pass, 0, globalBindGroup, 0, nullptr);
-    wgpuRenderPassEncoderSetBindGroup(pass, 1, _bindGroup, 0, nullptr);
-    wgpuRenderPassEncoderDraw(pass, 6, 1, 0, 0);
+bool Shader::usesFrameInputs(const std::string& code) {
+    static const std::regex frameInputs(
+        R"(\b(iTime|iTimeRelative|iTimeDelta|iFrame|iMouse|iMouseGlobal|iMouseDown|iGrabbed)\b)");
+    return std::regex_search(code, frameInputs);
+}
 
-    return Ok();
+bool Shader::needsBufferPasses() {
+    if (!_static) return true;
+
+    float inputs[4] = {static_cast<float>(_pixelWidth), static_cast<float>(_pixelHeight), _param, _zoom};
+    if (!std::equal(std::begin(inputs), std::end(inputs), std::begin(_lastInputs))) {
+        std::copy(std::begin(inputs), std::end(inputs), std::begin(_lastInputs));
+        _settleFrames = kMaxBufferPasses;
+    }
+    if (_settleFrames == 0) return false;
+    _settleFrames--;
+    return true;
 }
 
 bool Shader::onMouseMove(float localX, float localY) {
     _mouseX = localX / static_cast<float>(_pixelWidth);
     // Invert Y to match Shadertoy/GLSL convention (Y=0 at bottom)
     _mouseY = 1.0f - (localY / static_cast<float>(_pixelHeight));
+    _plugin->setMouse(_pixelX + localX, _pixelY + localY, _mouseDown, _mouseGrabbed);
     ydebug("Shader::onMouseMove: local=({},{}) normalized=({},{})",
                   localX, localY, _mouseX, _mouseY);
     return true;
@@ -619,6 +529,8 @@ bool Shader::onMouseButton(int button, bool pressed) {
     if (button == 0) {
         _mouseDown = pressed;
         _mouseGrabbed = pressed;
+        _plugin->setMouse(_pixelX + _mouseX * _pixelWidth,
+                          _pixelY + (1.0f - _mouseY) * _pixelHeight, _mouseDown, _mouseGrabbed);
         ydebug("Shader::onMouseButton: button={} pressed={} grabbed={}",
                       button, pressed, _mouseGrabbed);
         return true;
@@ -764,17 +676,8 @@ fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
 Result<void> Shader::compileShader(WebGPUContext& ctx,
                                         WGPUTextureFormat targetFormat,
                                         const std::string& fragmentCode) {
-    // Get global bind group layout - standalone mode
-    WGPUBindGroupLayout globalBGL = _globalBindGroupLayout;
-    
-    // Create standalone if needed
-    if (!globalBGL) {
-        if (auto res = createStandaloneGlobalBindGroup(ctx); !res) {
-            return Err<void>("Failed to create standalone global bind group", res);
-        }
-        globalBGL = _globalBindGroupLayout;
-    }
-    
+    // Global bind group layout, shared by all layers through the plugin
+    WGPUBindGroupLayout globalBGL = getGlobalBindGroupLayout();
     if (!globalBGL) {
         return Err<void>("Shader: no global bind group layout");
     }
@@ -794,7 +697,7 @@ Result<void> Shader::compileShader(WebGPUContext& ctx,
 
     WGPUShaderModuleDescriptor shaderDescVert = {};
     shaderDescVert.nextInChain = &wgslDescVert.chain;
-    WGPUShaderModule vertModule = wgpuDeviceCreateShaderModule(ctx.getDevice(), &shaderDescVert);
+    WGPUShaderModule vertModule = ctx.shaderCache().createShaderModule(&shaderDescVert);
 
     // Use different wrapper based on multipass mode or channel textures
     std::string fragCode;
@@ -811,7 +714,7 @@ Result<void> Shader::compileShader(WebGPUContext& ctx,
 
     WGPUShaderModuleDescriptor shaderDescFrag = {};
     shaderDescFrag.nextInChain = &wgslDescFrag.chain;
-    WGPUShaderModule fragModule = wgpuDeviceCreateShaderModule(ctx.getDevice(), &shaderDescFrag);
+    WGPUShaderModule fragModule = ctx.shaderCache().createShaderModule(&shaderDescFrag);
 
     if (!vertModule || !fragModule) {
         if (vertModule) wgpuShaderModuleRelease(vertModule);
@@ -846,7 +749,7 @@ Result<void> Shader::compileShader(WebGPUContext& ctx,
             WGPUBindGroupLayoutDescriptor bglDesc = {};
             bglDesc.entryCount = entries.size();
             bglDesc.entries = entries.data();
-            _bufferBindGroupLayout = wgpuDeviceCreateBindGroupLayout(ctx.getDevice(), &bglDesc);
+            _bufferBindGroupLayout = ctx.shaderCache().createBindGroupLayout(&bglDesc);
         }
         _bindGroupLayout = _bufferBindGroupLayout;
         // Add reference since we'll use it
@@ -862,7 +765,7 @@ Result<void> Shader::compileShader(WebGPUContext& ctx,
         WGPUBindGroupLayoutDescriptor bglDesc = {};
         bglDesc.entryCount = 1;
         bglDesc.entries = &bindingEntry;
-        _bindGroupLayout = wgpuDeviceCreateBindGroupLayout(ctx.getDevice(), &bglDesc);
+        _bindGroupLayout = ctx.shaderCache().createBindGroupLayout(&bglDesc);
     }
     
     if (!_bindGroupLayout) {
@@ -875,7 +778,7 @@ Result<void> Shader::compileShader(WebGPUContext& ctx,
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 2;
     plDesc.bindGroupLayouts = layouts;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(ctx.getDevice(), &plDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
     if (!pipelineLayout) {
         wgpuShaderModuleRelease(vertModule);
         wgpuShaderModuleRelease(fragModule);
@@ -990,7 +893,7 @@ Result<void> Shader::compileShader(WebGPUContext& ctx,
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = ~0u;
 
-    _pipeline = wgpuDeviceCreateRenderPipeline(ctx.getDevice(), &pipelineDesc);
+    _pipeline = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(vertModule);
     wgpuShaderModuleRelease(fragModule);
@@ -1301,8 +1204,7 @@ Result<void> Shader::compileBufferPass(WebGPUContext& ctx, int passIndex) {
         return Ok();
     }
     
-    // Get global bind group layout - standalone mode
-    WGPUBindGroupLayout globalBGL = _globalBindGroupLayout;
+    WGPUBindGroupLayout globalBGL = getGlobalBindGroupLayout();
     if (!globalBGL) {
         return Err<void>("Shader: no global bind group layout for buffer pass");
     }
@@ -1332,7 +1234,7 @@ Result<void> Shader::compileBufferPass(WebGPUContext& ctx, int passIndex) {
         WGPUBindGroupLayoutDescriptor bglDesc = {};
         bglDesc.entryCount = entries.size();
         bglDesc.entries = entries.data();
-        _bufferBindGroupLayout = wgpuDeviceCreateBindGroupLayout(ctx.getDevice(), &bglDesc);
+        _bufferBindGroupLayout = ctx.shaderCache().createBindGroupLayout(&bglDesc);
         if (!_bufferBindGroupLayout) {
             return Err<void>("Failed to create buffer bind group layout");
         }
@@ -1346,7 +1248,7 @@ Result<void> Shader::compileBufferPass(WebGPUContext& ctx, int passIndex) {
     
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(ctx.getDevice(), &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     
     if (!shaderModule) {
         return Err<void>("Failed to create buffer pass shader module");
@@ -1357,7 +1259,7 @@ Result<void> Shader::compileBufferPass(WebGPUContext& ctx, int passIndex) {
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 2;
     plDesc.bindGroupLayouts = layouts;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(ctx.getDevice(), &plDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
     
     // Create bind group
     std::array<WGPUBindGroupEntry, 6> bgEntries = {};
@@ -1414,7 +1316,7 @@ Result<void> Shader::compileBufferPass(WebGPUContext& ctx, int passIndex) {
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = ~0u;
     
-    pass.pipeline = wgpuDeviceCreateRenderPipeline(ctx.getDevice(), &pipelineDesc);
+    pass.pipeline = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
     
     wgpuShaderModuleRelease(shaderModule);
     wgpuPipelineLayoutRelease(pipelineLayout);
@@ -1436,8 +1338,7 @@ void Shader::swapBufferTextures() {
 }
 
 void Shader::renderBufferPasses(WebGPUContext& ctx) {
-    // Get global bind group - standalone mode
-    WGPUBindGroup globalBindGroup = _globalBindGroup;
+    WGPUBindGroup globalBindGroup = getGlobalBindGroup();
     if (!globalBindGroup) return;
     if (!_bufferBindGroupLayout || !_bufferSampler) return;
     
@@ -1725,70 +1626,12 @@ Result<void> Shader::createPlaceholderTexture(WebGPUContext& ctx) {
     return Ok();
 }
 
-Result<void> Shader::createStandaloneGlobalBindGroup(WebGPUContext& ctx) {
-    if (_globalBindGroup) return Ok();
-    
-    // Create global uniform buffer (matches ShaderManager::GlobalUniforms)
-    WGPUBufferDescriptor bufDesc = {};
-    bufDesc.size = 48;  // iTime, iTimeRelative, iTimeDelta, iFrame, iMouse, iScreenResolution, pad
-    bufDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
-    bufDesc.mappedAtCreation = false;
-    
-    _globalUniformBuffer = wgpuDeviceCreateBuffer(ctx.getDevice(), &bufDesc);
-    if (!_globalUniformBuffer) {
-        return Err<void>("Failed to create global uniform buffer");
-    }
-    
-    // Create bind group layout
-    WGPUBindGroupLayoutEntry entry = {};
-    entry.binding = 0;
-    entry.visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
-    entry.buffer.type = WGPUBufferBindingType_Uniform;
-    
-    WGPUBindGroupLayoutDescriptor bglDesc = {};
-    bglDesc.entryCount = 1;
-    bglDesc.entries = &entry;
-    
-    _globalBindGroupLayout = wgpuDeviceCreateBindGroupLayout(ctx.getDevice(), &bglDesc);
-    if (!_globalBindGroupLayout) {
-        wgpuBufferRelease(_globalUniformBuffer);
-        _globalUniformBuffer = nullptr;
-        return Err<void>("Failed to create global bind group layout");
-    }
-    
-    // Create bind group
-    WGPUBindGroupEntry bgEntry = {};
-    bgEntry.binding = 0;
-    bgEntry.buffer = _globalUniformBuffer;
-    bgEntry.size = 48;
-    
-    WGPUBindGroupDescriptor bgDesc = {};
-    bgDesc.layout = _globalBindGroupLayout;
-    bgDesc.entryCount = 1;
-    bgDesc.entries = &bgEntry;
-    
-    _globalBindGroup = wgpuDeviceCreateBindGroup(ctx.getDevice(), &bgDesc);
-    if (!_globalBindGroup) {
-        wgpuBindGroupLayoutRelease(_globalBindGroupLayout);
-        _globalBindGroupLayout = nullptr;
-        wgpuBufferRelease(_globalUniformBuffer);
-        _globalUniformBuffer = nullptr;
-        return Err<void>("Failed to create global bind group");
-    }
-    
-    return Ok();
-}
-
 WGPUBindGroup Shader::getGlobalBindGroup() {
-    if (_globalBindGroup) return _globalBindGroup;
-    // Factory mode - defer to ShaderManager (but don't call getShaderManager to avoid symbol dep)
-    // In standalone mode, _globalBindGroup should already be created
-    return nullptr;
+    return _plugin ? _plugin->globalBindGroup() : nullptr;
 }
 
 WGPUBindGroupLayout Shader::getGlobalBindGroupLayout() {
-    if (_globalBindGroupLayout) return _globalBindGroupLayout;
-    return nullptr;
+    return _plugin ? _plugin->globalBindGroupLayout() : nullptr;
 }
 
 } // namespace yetty
@@ -3,6 +3,7 @@
 #include <yetty/plugin.h>
 #include <webgpu/webgpu.h>
 #include <array>
+#include <chrono>
 #include <string>
 
 namespace yetty {
@@ -16,7 +17,9 @@ class Shader;
 
 //-----------------------------------------------------------------------------
 // ShaderPlugin - manages all shader layers
-// Each layer has its own compiled pipeline and state
+// Each layer has its own compiled pipeline and state. The frame-global
+// uniforms (iTime, iTimeDelta, iFrame, iMouseGlobal) live here in one buffer
+// that every layer binds at group 0.
 //-----------------------------------------------------------------------------
 class ShaderPlugin : public Plugin {
 public:
@@ -41,9 +44,32 @@ public:
         const std::string& payload
     ) override;
 
+    // Frame-global uniforms, created on first use
+    Result<void> ensureGlobals(WebGPUContext& ctx);
+    WGPUBindGroupLayout globalBindGroupLayout() const { return globalBindGroupLayout_; }
+    WGPUBindGroup globalBindGroup() const { return globalBindGroup_; }
+
+    // Called by each layer once per frame with its own frame counter. The
+    // first layer to arrive in a new frame advances the clock and writes the
+    // buffer; the others find it current.
+    void beginFrame(WebGPUContext& ctx, uint64_t& layerFrame);
+
+    // Last pointer position over any layer, in screen pixels
+    void setMouse(float x, float y, bool down, bool grabbed);
+
 private:
     ShaderPlugin() noexcept = default;
     Result<void> pluginInit() noexcept;
+    void releaseGlobals();
+
+    WGPUBuffer globalUniformBuffer_ = nullptr;
+    WGPUBindGroupLayout globalBindGroupLayout_ = nullptr;
+    WGPUBindGroup globalBindGroup_ = nullptr;
+
+    uint64_t frame_ = 0;
+    std::chrono::steady_clock::time_point startTime_;
+    std::chrono::steady_clock::time_point lastFrameTime_;
+    float mouse_[4] = {0, 0, 0, 0};
 };
 
 //-----------------------------------------------------------------------------
@@ -53,6 +79,11 @@ private:
 //   1. Constructor (private) - stores payload
 //   2. init() (private) - no args, compiles shader
 //   3. create() (public) - factory
+//
+// prepareFrame() compiles, updates uniforms and runs the BufferA-D passes;
+// render() only draws the Image pass into the shared render pass. A shader
+// that never reads iTime, iFrame or the mouse is static: its buffer passes
+// run only after its size, parameters or textures change.
 //-----------------------------------------------------------------------------
 class WidgetFactory;
 
@@ -67,11 +98,13 @@ public:
         uint32_t widthCells,
         uint32_t heightCells,
         const std::string& pluginArgs,
-        const std::string& payload
+        const std::string& payload,
+        ShaderPlugin* plugin
     ) {
         (void)fontManager;
         (void)loop;
         auto w = std::shared_ptr<Shader>(new Shader(payload, pluginArgs, factory));
+        w->_plugin = plugin;
         w->_x = x;
         w->_y = y;
         w->_widthCells = widthCells;
@@ -95,6 +128,10 @@ public:
     bool onMouseScroll(float xoffset, float yoffset, int mods) override;
     bool wantsMouse() const override { return true; }
 
+    // True when `code` reads time, frame count or mouse state, i.e. its
+    // output can change without any input changing
+    static bool usesFrameInputs(const std::string& code);
+
 private:
     explicit Shader(const std::string& payload, const std::string& pluginArgs, WidgetFactory* factory)
         : _factory(factory), _pluginArgs(pluginArgs) {
@@ -104,6 +141,7 @@ private:
     Result<void> init() override;
 
     WidgetFactory* _factory = nullptr;
+    ShaderPlugin* _plugin = nullptr;
     std::string _pluginArgs;
 
     // Parse plugin args for channel textures (--channel0=path, --channel1=path, etc.)
@@ -115,6 +153,10 @@ private:
     // Create sampler for channel textures
     Result<void> createChannelSampler(WebGPUContext& ctx);
 
+    // Parse, load channels and compile all passes
+    Result<void> compile(WebGPUContext& ctx);
+    void writePluginUniforms(WebGPUContext& ctx);
+
     Result<void> compileShader(WebGPUContext& ctx,
                                WGPUTextureFormat targetFormat,
                                const std::string& fragmentCode);
@@ -161,6 +203,14 @@ private:
     void renderBufferPasses(WebGPUContext& ctx);
     void swapBufferTextures();
 
+    // Static shaders rerun their buffer passes only when these change.
+    // Buffers read each other's previous frame, so a change is followed by
+    // kMaxBufferPasses runs to let a BufferA -> BufferD chain settle.
+    bool _static = false;
+    int _settleFrames = 0;
+    float _lastInputs[4] = {0, 0, 0, 0};  // width, height, param, zoom
+    bool needsBufferPasses();
+
     // Main image shader code (after parsing)
     std::string _mainImageCode;
 
@@ -183,13 +233,8 @@ private:
     WGPUTextureView _placeholderTextureView = nullptr;
     Result<void> createPlaceholderTexture(WebGPUContext& ctx);
 
-    // Standalone mode (when factory is null) - own global bind group
-    WGPUBuffer _globalUniformBuffer = nullptr;
-    WGPUBindGroup _globalBindGroup = nullptr;
-    WGPUBindGroupLayout _globalBindGroupLayout = nullptr;
-    Result<void> createStandaloneGlobalBindGroup(WebGPUContext& ctx);
-    
-    // Helper to get global bind group (from factory or standalone)
+    // Frame-global bind group, owned by the plugin
+    uint64_t _frame = 0;
     WGPUBindGroup getGlobalBindGroup();
     WGPUBindGroupLayout getGlobalBindGroupLayout();
 
@@ -5,6 +5,7 @@
 #include <ytrace/ytrace.hpp>
 #include <ytrace/ytrace.hpp>
 #include <yaml-cpp/yaml.h>
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 #include <sstream>
@@ -69,7 +70,183 @@ Result<WidgetPtr> ThorvgPlugin::createWidget(
     (void)widgetName;
     yfunc();
     yinfo("payload size={} x={} y={} w={} h={}", payload.size(), x, y, widthCells, heightCells);
-    return Lottie::create(factory, fontManager, loop, x, y, widthCells, heightCells, pluginArgs, payload);
+    return Lottie::create(factory, fontManager, loop, x, y, widthCells, heightCells, pluginArgs, payload, this);
+}
+
+LottieFrameCache::Ptr ThorvgPlugin::acquireFrameCache(WebGPUContext& ctx, const std::string& data,
+                                                      uint32_t width, uint32_t height, uint32_t frameCount) {
+    if (frameCount == 0 || frameCount > MAX_CACHED_FRAMES) {
+        return nullptr;
+    }
+    size_t bytes = LottieFrameCache::bytesFor(width, height, frameCount);
+    if (bytes > ANIMATION_CACHE_BUDGET) {
+        return nullptr;
+    }
+
+    std::string key = std::to_string(std::hash<std::string>()(data)) + ":" +
+                      std::to_string(data.size()) + ":" +
+                      std::to_string(width) + "x" + std::to_string(height);
+
+    size_t used = 0;
+    for (auto it = frameCaches_.begin(); it != frameCaches_.end();) {
+        auto cache = it->second.lock();
+        if (!cache) {
+            it = frameCaches_.erase(it);
+            continue;
+        }
+        if (it->first == key) {
+            return cache;
+        }
+        used += cache->bytes();
+        ++it;
+    }
+
+    if (used + bytes > FRAME_CACHE_BUDGET) {
+        ydebug("ThorvgPlugin: frame cache budget used ({} bytes), rendering live", used);
+        return nullptr;
+    }
+
+    auto result = LottieFrameCache::create(ctx, data, width, height, frameCount);
+    if (!result) {
+        ywarn("ThorvgPlugin: {}", result.error().message());
+        return nullptr;
+    }
+    frameCaches_[key] = *result;
+    ydebug("ThorvgPlugin: frame cache {}x{} x {} frames ({} bytes)", width, height, frameCount, bytes);
+    return *result;
+}
+
+//-----------------------------------------------------------------------------
+// LottieFrameCache
+//-----------------------------------------------------------------------------
+
+Result<LottieFrameCache::Ptr> LottieFrameCache::create(WebGPUContext& ctx, const std::string& data,
+                                                       uint32_t width, uint32_t height,
+                                                       uint32_t frameCount) noexcept {
+    auto cache = Ptr(new LottieFrameCache());
+    if (auto res = cache->init(ctx, data, width, height, frameCount); !res) {
+        return Err<Ptr>("Failed to init LottieFrameCache", res);
+    }
+    return Ok(cache);
+}
+
+LottieFrameCache::~LottieFrameCache() {
+    releaseRenderer();
+    if (framesView_) { wgpuTextureViewRelease(framesView_); framesView_ = nullptr; }
+    if (frames_) { wgpuTextureRelease(frames_); frames_ = nullptr; }
+}
+
+Result<void> LottieFrameCache::init(WebGPUContext& ctx, const std::string& data,
+                                    uint32_t width, uint32_t height, uint32_t frameCount) {
+    WGPUDevice device = ctx.getDevice();
+    width_ = width;
+    height_ = height;
+    ready_.assign(frameCount, false);
+
+    animation_.reset(tvg::Animation::gen());
+    if (!animation_) {
+        return Err<void>("Failed to create ThorVG Animation");
+    }
+    tvg::Picture* picture = animation_->picture();
+    if (!picture || picture->load(data.c_str(), static_cast<uint32_t>(data.size()),
+                                  "lottie", nullptr, true) != tvg::Result::Success) {
+        return Err<void>("Failed to load Lottie animation for frame cache");
+    }
+    // Rasterize at the size the frames are shown at
+    picture->size(static_cast<float>(width), static_cast<float>(height));
+
+    // Same format and usage as the live render target, plus CopySrc for the layers
+    WGPUTextureDescriptor texDesc = {};
+    texDesc.size.width = width;
+    texDesc.size.height = height;
+    texDesc.size.depthOrArrayLayers = 1;
+    texDesc.mipLevelCount = 1;
+    texDesc.sampleCount = 1;
+    texDesc.dimension = WGPUTextureDimension_2D;
+    texDesc.format = WGPUTextureFormat_BGRA8Unorm;
+    texDesc.usage = WGPUTextureUsage_RenderAttachment | WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopySrc;
+    target_ = wgpuDeviceCreateTexture(device, &texDesc);
+    if (!target_) return Err<void>("Failed to create frame cache render target");
+
+    texDesc.size.depthOrArrayLayers = frameCount;
+    texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
+    frames_ = wgpuDeviceCreateTexture(device, &texDesc);
+    if (!frames_) return Err<void>("Failed to create frame cache texture array");
+
+    WGPUTextureViewDescriptor viewDesc = {};
+    viewDesc.format = WGPUTextureFormat_BGRA8Unorm;
+    viewDesc.dimension = WGPUTextureViewDimension_2DArray;
+    viewDesc.mipLevelCount = 1;
+    viewDesc.arrayLayerCount = frameCount;
+    framesView_ = wgpuTextureCreateView(frames_, &viewDesc);
+    if (!framesView_) return Err<void>("Failed to create frame cache view");
+
+    canvas_.reset(tvg::WgCanvas::gen());
+    if (!canvas_) {
+        return Err<void>("Failed to create ThorVG WgCanvas");
+    }
+    if (canvas_->target(device, ctx.getInstance(), target_, width, height,
+                        tvg::ColorSpace::ABGR8888S, 1) != tvg::Result::Success) {
+        return Err<void>("Failed to set ThorVG WgCanvas target");
+    }
+    if (canvas_->push(picture) != tvg::Result::Success) {
+        return Err<void>("Failed to push picture to ThorVG canvas");
+    }
+    return Ok();
+}
+
+Result<void> LottieFrameCache::ensureFrame(WebGPUContext& ctx, uint32_t frame) {
+    if (frame >= ready_.size() || ready_[frame]) {
+        return Ok();
+    }
+    if (!canvas_ || !animation_) {
+        return Err<void>("LottieFrameCache: renderer already released");
+    }
+
+    animation_->frame(static_cast<float>(frame));
+    if (canvas_->update() != tvg::Result::Success ||
+        canvas_->draw(true) != tvg::Result::Success ||
+        canvas_->sync() != tvg::Result::Success) {
+        return Err<void>("LottieFrameCache: ThorVG failed to render frame " + std::to_string(frame));
+    }
+
+    // sync() submitted the ThorVG pass, the copy is queued after it
+    WGPUCommandEncoderDescriptor encDesc = {};
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(ctx.getDevice(), &encDesc);
+    if (!encoder) {
+        return Err<void>("LottieFrameCache: failed to create command encoder");
+    }
+
+    WGPUTexelCopyTextureInfo src = {};
+    src.texture = target_;
+    src.aspect = WGPUTextureAspect_All;
+    WGPUTexelCopyTextureInfo dst = {};
+    dst.texture = frames_;
+    dst.origin = {0, 0, frame};
+    dst.aspect = WGPUTextureAspect_All;
+    WGPUExtent3D extent = {width_, height_, 1};
+    wgpuCommandEncoderCopyTextureToTexture(encoder, &src, &dst, &extent);
+
+    WGPUCommandBufferDescriptor cmdDesc = {};
+    WGPUCommandBuffer cmd = wgpuCommandEncoderFinish(encoder, &cmdDesc);
+    wgpuQueueSubmit(ctx.getQueue(), 1, &cmd);
+    wgpuCommandBufferRelease(cmd);
+    wgpuCommandEncoderRelease(encoder);
+
+    ready_[frame] = true;
+    if (++readyCount_ == ready_.size()) {
+        // Every frame is in the array, the rasterizer is no longer needed
+        releaseRenderer();
+        ydebug("LottieFrameCache: all {} frames cached", readyCount_);
+    }
+    return Ok();
+}
+
+void LottieFrameCache::releaseRenderer() {
+    // Release ThorVG canvas before destroying the texture it targets
+    canvas_.reset();
+    animation_.reset();
+    if (target_) { wgpuTextureRelease(target_); target_ = nullptr; }
 }
 
 //-----------------------------------------------------------------------------
@@ -129,6 +306,9 @@ Result<void> Lottie::init() {
         yerror("Lottie::init: loadContent failed: {}", result.error().message());
         return result;
     }
+    if (cacheFrames_ && isAnimated_) {
+        lottieData_ = std::move(content);
+    }
 
     yinfo("Lottie: loaded {}x{} content (animated: {})",
                  contentWidth_, contentHeight_, isAnimated_);
@@ -240,10 +420,11 @@ Result<void> Lottie::initWebGPU(WebGPUContext& ctx) {
     renderTexture_ = wgpuDeviceCreateTexture(device, &texDesc);
     if (!renderTexture_) return Err<void>("Failed to create ThorVG render texture");
 
-    // Create texture view for our composite shader
+    // Create texture view for our composite shader (one layer array, the
+    // shader also samples frame caches)
     WGPUTextureViewDescriptor viewDesc = {};
     viewDesc.format = WGPUTextureFormat_BGRA8Unorm;
-    viewDesc.dimension = WGPUTextureViewDimension_2D;
+    viewDesc.dimension = WGPUTextureViewDimension_2DArray;
     viewDesc.mipLevelCount = 1;
     viewDesc.arrayLayerCount = 1;
     renderTextureView_ = wgpuTextureCreateView(renderTexture_, &viewDesc);
@@ -290,9 +471,9 @@ Result<void> Lottie::createCompositePipeline(WebGPUContext& ctx, WGPUTextureForm
     sampler_ = wgpuDeviceCreateSampler(device, &samplerDesc);
     if (!sampler_) return Err<void>("Failed to create sampler");
 
-    // Create uniform buffer for rect transform
+    // Create uniform buffer for rect transform and frame layer
     WGPUBufferDescriptor bufDesc = {};
-    bufDesc.size = 16;
+    bufDesc.size = 32;
     bufDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
     uniformBuffer_ = wgpuDeviceCreateBuffer(device, &bufDesc);
     if (!uniformBuffer_) return Err<void>("Failed to create uniform buffer");
@@ -300,10 +481,10 @@ Result<void> Lottie::createCompositePipeline(WebGPUContext& ctx, WGPUTextureForm
     // Composite shader - renders ThorVG output texture as a quad
     // ThorVG WebGPU outputs ABGR into a BGRA texture, so swizzle to RGBA
     const char* shaderCode = R"(
-struct Uniforms { rect: vec4<f32>, }
+struct Uniforms { rect: vec4<f32>, layer: u32, }
 @group(0) @binding(0) var<uniform> u: Uniforms;
 @group(0) @binding(1) var texSampler: sampler;
-@group(0) @binding(2) var tex: texture_2d<f32>;
+@group(0) @binding(2) var tex: texture_2d_array<f32>;
 struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: vec2<f32>, }
 @vertex fn vs_main(@builtin(vertex_index) vi: u32) -> VertexOutput {
     var p = array<vec2<f32>,6>(vec2(0.,0.),vec2(1.,0.),vec2(1.,1.),vec2(0.,0.),vec2(1.,1.),vec2(0.,1.));
@@ -314,7 +495,7 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
     return o;
 }
 @fragment fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
-    let c = textureSample(tex, texSampler, uv);
+    let c = textureSample(tex, texSampler, uv, u.layer);
     // ThorVG writes ABGR; BGRA view yields c = (B=A, G=B, R=G, A=R). Swizzle back to RGBA.
     return vec4(c.a, c.r, c.g, c.b);
 }
@@ -325,33 +506,33 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
     wgslDesc.code = WGPU_STR(shaderCode);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
     // Bind group layout
     WGPUBindGroupLayoutEntry entries[3] = {};
-    entries[0].binding = 0; entries[0].visibility = WGPUShaderStage_Vertex;
+    entries[0].binding = 0; entries[0].visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
     entries[0].buffer.type = WGPUBufferBindingType_Uniform;
     entries[1].binding = 1; entries[1].visibility = WGPUShaderStage_Fragment;
     entries[1].sampler.type = WGPUSamplerBindingType_Filtering;
     entries[2].binding = 2; entries[2].visibility = WGPUShaderStage_Fragment;
     entries[2].texture.sampleType = WGPUTextureSampleType_Float;
-    entries[2].texture.viewDimension = WGPUTextureViewDimension_2D;
+    entries[2].texture.viewDimension = WGPUTextureViewDimension_2DArray;
 
     WGPUBindGroupLayoutDescriptor bglDesc = {};
     bglDesc.entryCount = 3; bglDesc.entries = entries;
-    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
+    WGPUBindGroupLayout bgl = ctx.shaderCache().createBindGroupLayout(&bglDesc);
     if (!bgl) { wgpuShaderModuleRelease(shaderModule); return Err<void>("Failed to create bgl"); }
 
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 1; plDesc.bindGroupLayouts = &bgl;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
 
     // Bind group
     WGPUBindGroupEntry bgE[3] = {};
-    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = 16;
+    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = 32;
     bgE[1].binding = 1; bgE[1].sampler = sampler_;
-    bgE[2].binding = 2; bgE[2].textureView = renderTextureView_;
+    bgE[2].binding = 2; bgE[2].textureView = frameCache_ ? frameCache_->view() : renderTextureView_;
     WGPUBindGroupDescriptor bgDesc = {};
     bgDesc.layout = bgl; bgDesc.entryCount = 3; bgDesc.entries = bgE;
     bindGroup_ = wgpuDeviceCreateBindGroup(device, &bgDesc);
@@ -386,7 +567,7 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = ~0u;
 
-    compositePipeline_ = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    compositePipeline_ = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(shaderModule);
     wgpuBindGroupLayoutRelease(bgl);
@@ -416,77 +597,52 @@ static void thorvgErrorCallback(WGPUPopErrorScopeStatus status, WGPUErrorType ty
 }
 
 Result<void> Lottie::renderThorvgFrame(WGPUDevice device) {
+    (void)device;
     if (!canvas_ || !picture_) {
         ywarn("Lottie::renderThorvgFrame: no canvas or picture");
         return Ok();  // Nothing to render is not an error
     }
 
-    yinfo("Lottie::renderThorvgFrame: rendering frame {}, animated={}",
-                 currentFrame_, isAnimated_);
+    // Static content, paused or finished animations: the texture already
+    // holds this frame, keep compositing it
+    if (!contentDirty_ && renderedFrame_ == currentFrame_) {
+        return Ok();
+    }
 
     // Update animation frame if animated
     if (isAnimated_ && animation_) {
-        auto frameResult = animation_->frame(currentFrame_);
-        yinfo("Lottie::renderThorvgFrame: animation->frame({}) result={}",
-                     currentFrame_, static_cast<int>(frameResult));
+        animation_->frame(currentFrame_);
     }
 
     // Render using ThorVG's WebGPU canvas
     auto updateResult = canvas_->update();
-    yinfo("Lottie::renderThorvgFrame: canvas->update result={}", static_cast<int>(updateResult));
     if (updateResult != tvg::Result::Success) {
         return Err<void>("ThorVG canvas update failed (result=" + std::to_string(static_cast<int>(updateResult)) + ")");
     }
 
     // draw(true) clears the buffer before rendering
     auto drawResult = canvas_->draw(true);
-    yinfo("Lottie::renderThorvgFrame: canvas->draw result={}", static_cast<int>(drawResult));
     if (drawResult != tvg::Result::Success) {
         return Err<void>("ThorVG canvas draw failed (result=" + std::to_string(static_cast<int>(drawResult)) + ")");
     }
 
     // sync() submits WebGPU commands
     auto syncResult = canvas_->sync();
-    yinfo("Lottie::renderThorvgFrame: canvas->sync result={}", static_cast<int>(syncResult));
     if (syncResult != tvg::Result::Success) {
         return Err<void>("ThorVG canvas sync failed (result=" + std::to_string(static_cast<int>(syncResult)) + ")");
     }
 
+    // The render texture, its view and the bind group stay the same,
+    // only the texels changed
     contentDirty_ = false;
-
-    // Recreate texture view to ensure fresh GPU state after ThorVG render
-    if (renderTextureView_) {
-        wgpuTextureViewRelease(renderTextureView_);
-    }
-    WGPUTextureViewDescriptor viewDesc = {};
-    viewDesc.format = WGPUTextureFormat_BGRA8Unorm;
-    viewDesc.dimension = WGPUTextureViewDimension_2D;
-    viewDesc.mipLevelCount = 1;
-    viewDesc.arrayLayerCount = 1;
-    renderTextureView_ = wgpuTextureCreateView(renderTexture_, &viewDesc);
-
-    // Recreate bind group with fresh texture view
-    if (bindGroup_) {
-        wgpuBindGroupRelease(bindGroup_);
-    }
-    WGPUBindGroupEntry bgE[3] = {};
-    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = 16;
-    bgE[1].binding = 1; bgE[1].sampler = sampler_;
-    bgE[2].binding = 2; bgE[2].textureView = renderTextureView_;
-    WGPUBindGroupDescriptor bgDesc = {};
-    bgDesc.layout = wgpuRenderPipelineGetBindGroupLayout(compositePipeline_, 0);
-    bgDesc.entryCount = 3;
-    bgDesc.entries = bgE;
-    bindGroup_ = wgpuDeviceCreateBindGroup(device, &bgDesc);
-
-    yinfo("Lottie::renderThorvgFrame: completed successfully, recreated view/bindgroup");
+    renderedFrame_ = currentFrame_;
     return Ok();
 }
 
 void Lottie::setFrame(float frame) {
     if (!isAnimated_) return;
 
-    currentFrame_ = frame;
+    currentFrame_ = std::floor(frame);
     if (currentFrame_ >= totalFrames_) {
         currentFrame_ = loop_ ? 0.0f : totalFrames_ - 1;
     }
@@ -494,7 +650,9 @@ void Lottie::setFrame(float frame) {
         currentFrame_ = 0;
     }
 
-    contentDirty_ = true;
+    if (currentFrame_ != renderedFrame_) {
+        contentDirty_ = true;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -708,12 +866,16 @@ Result<void> Lottie::dispose() {
     canvas_.reset();
 
     if (renderTexture_) { wgpuTextureRelease(renderTexture_); renderTexture_ = nullptr; }
+    frameCache_.reset();
 
     animation_.reset();
     picture_ = nullptr;
 
     gpuInitialized_ = false;
     contentDirty_ = true;
+    renderedFrame_ = -1.0f;
+    lastLayer_ = UINT32_MAX;
+    std::fill(std::begin(lastRect_), std::end(lastRect_), 0.0f);
     return Ok();
 }
 
@@ -729,9 +891,13 @@ void Lottie::releaseGPUResources() {
     canvas_.reset();
 
     if (renderTexture_) { wgpuTextureRelease(renderTexture_); renderTexture_ = nullptr; }
+    frameCache_.reset();
 
     gpuInitialized_ = false;
     contentDirty_ = true;
+    renderedFrame_ = -1.0f;
+    lastLayer_ = UINT32_MAX;
+    std::fill(std::begin(lastRect_), std::end(lastRect_), 0.0f);
     yinfo("Lottie: GPU resources released");
 }
 
@@ -756,9 +922,6 @@ void Lottie::prepareFrame(WebGPUContext& ctx, bool on) {
         contentDirty_ = true;
     }
 
-    yinfo("Lottie::prepareFrame CALLED! on={} failed={} visible={} animation={} gpu_init={} dirty={}",
-                 on, failed_, _visible, (void*)animation_.get(), gpuInitialized_, contentDirty_);
-
     if (!on || failed_ || !_visible || !animation_) {
         return;
     }
@@ -781,25 +944,40 @@ void Lottie::prepareFrame(WebGPUContext& ctx, bool on) {
             }
         }
 
-        if (std::abs(targetFrame - currentFrame_) >= 0.5f) {
+        // Only whole frames are rendered; between them the texture is reused
+        targetFrame = std::floor(targetFrame);
+        if (targetFrame != currentFrame_) {
             currentFrame_ = targetFrame;
             contentDirty_ = true;
         }
     }
 
+    // A frame cache holds frames at one size, follow the widget
+    if (frameCache_ && (frameCache_->width() != _pixelWidth || frameCache_->height() != _pixelHeight)) {
+        releaseGPUResources();
+    }
+
     // Initialize GPU resources on first use
     if (!gpuInitialized_) {
-        yinfo("Lottie::prepareFrame: initializing WebGPU resources");
-        auto result = initWebGPU(ctx);
-        if (!result) {
-            yerror("Lottie::prepareFrame: initWebGPU failed: {}", result.error().message());
-            failed_ = true;
-            return;
+        if (cacheFrames_ && isAnimated_ && _pixelWidth > 0 && _pixelHeight > 0 && plugin_) {
+            uint32_t frameCount = static_cast<uint32_t>(std::ceil(totalFrames_));
+            frameCache_ = plugin_->acquireFrameCache(ctx, lottieData_, _pixelWidth, _pixelHeight, frameCount);
+        }
+
+        // Without a frame cache (disabled, too long, over budget) render live
+        if (!frameCache_) {
+            yinfo("Lottie::prepareFrame: initializing WebGPU resources");
+            auto result = initWebGPU(ctx);
+            if (!result) {
+                yerror("Lottie::prepareFrame: initWebGPU failed: {}", result.error().message());
+                failed_ = true;
+                return;
+            }
         }
 
         yinfo("Lottie::prepareFrame: creating composite pipeline, targetFormat={}",
                      static_cast<int>(ctx.getSurfaceFormat()));
-        result = createCompositePipeline(ctx, ctx.getSurfaceFormat());
+        auto result = createCompositePipeline(ctx, ctx.getSurfaceFormat());
         if (!result) {
             yerror("Lottie::prepareFrame: createCompositePipeline failed: {}", result.error().message());
             failed_ = true;
@@ -810,16 +988,28 @@ void Lottie::prepareFrame(WebGPUContext& ctx, bool on) {
         yinfo("Lottie::prepareFrame: GPU resources initialized");
     }
 
+    // Cached playback: the frame only has to be in the shared array
+    if (frameCache_) {
+        if (contentDirty_) {
+            if (auto res = frameCache_->ensureFrame(ctx, static_cast<uint32_t>(currentFrame_)); !res) {
+                yerror("Lottie::prepareFrame: {}", res.error().message());
+                failed_ = true;
+                return;
+            }
+            contentDirty_ = false;
+            renderedFrame_ = currentFrame_;
+        }
+        return;
+    }
+
     // Render ThorVG content to texture if dirty
     if (contentDirty_) {
-        yinfo("Lottie::prepareFrame: rendering ThorVG frame to texture");
         auto renderResult = renderThorvgFrame(ctx.getDevice());
         if (!renderResult) {
             yerror("Lottie::prepareFrame: {}", renderResult.error().message());
             failed_ = true;
             return;
         }
-        yinfo("Lottie::prepareFrame: ThorVG frame rendered successfully");
     }
 }
 
@@ -844,43 +1034,37 @@ Result<void> Lottie::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool
         return Ok();
     }
 
-    yinfo("Lottie::render: cell pos ({},{}) size ({},{}) cells", _x, _y, _widthCells, _heightCells);
-    yinfo("Lottie::render: pixel pos ({},{}) size ({},{})", _pixelX, _pixelY, _pixelWidth, _pixelHeight);
-
     float ndcX = (static_cast<float>(_pixelX) / ctx.getSurfaceWidth()) * 2.0f - 1.0f;
     float ndcY = 1.0f - (static_cast<float>(_pixelY) / ctx.getSurfaceHeight()) * 2.0f;
     float ndcW = (static_cast<float>(_pixelWidth) / ctx.getSurfaceWidth()) * 2.0f;
     float ndcH = (static_cast<float>(_pixelHeight) / ctx.getSurfaceHeight()) * 2.0f;
 
-    // Update uniform buffer if rect changed
+    // Live rendering always shows layer 0, cached playback the current frame
+    uint32_t layer = frameCache_ ? static_cast<uint32_t>(std::max(renderedFrame_, 0.0f)) : 0;
+
+    // Update uniform buffer if rect or layer changed
     bool rectChanged = (ndcX != lastRect_[0] || ndcY != lastRect_[1] ||
                         ndcW != lastRect_[2] || ndcH != lastRect_[3]);
-    if (rectChanged) {
-        struct Uniforms { float rect[4]; } uniforms;
+    if (rectChanged || layer != lastLayer_) {
+        struct Uniforms { float rect[4]; uint32_t layer; uint32_t _pad[3]; } uniforms = {};
         uniforms.rect[0] = ndcX;
         uniforms.rect[1] = ndcY;
         uniforms.rect[2] = ndcW;
         uniforms.rect[3] = ndcH;
+        uniforms.layer = layer;
         wgpuQueueWriteBuffer(ctx.getQueue(), uniformBuffer_, 0, &uniforms, sizeof(uniforms));
         lastRect_[0] = ndcX;
         lastRect_[1] = ndcY;
         lastRect_[2] = ndcW;
         lastRect_[3] = ndcH;
+        lastLayer_ = layer;
     }
 
     // Draw ThorVG rendered content into existing pass
-    yinfo("Lottie::render: drawing composite - NDC rect ({}, {}, {}, {})",
-                 ndcX, ndcY, ndcW, ndcH);
-    yinfo("Lottie::render: pixel position ({}, {}) size ({}, {})",
-                 _pixelX, _pixelY, _pixelWidth, _pixelHeight);
-    yinfo("Lottie::render: screen size ({}, {})",
-                 ctx.getSurfaceWidth(), ctx.getSurfaceHeight());
-
     wgpuRenderPassEncoderSetPipeline(pass, compositePipeline_);
     wgpuRenderPassEncoderSetBindGroup(pass, 0, bindGroup_, 0, nullptr);
     wgpuRenderPassEncoderDraw(pass, 6, 1, 0, 0);
 
-    yinfo("Lottie::render: composite draw issued");
     return Ok();
 }
 
@@ -3,13 +3,65 @@
 #include <yetty/plugin.h>
 #include <webgpu/webgpu.h>
 #include <thorvg.h>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace yetty {
 
 class Lottie;
 
+//-----------------------------------------------------------------------------
+// LottieFrameCache - one animation at one size, each frame rendered once by
+// ThorVG into a layer of a texture array. Shared by every Lottie widget that
+// plays the same content at the same size, so fifty identical spinners cost
+// one rasterization pass; playback is a layer index.
+//-----------------------------------------------------------------------------
+class LottieFrameCache {
+public:
+    using Ptr = std::shared_ptr<LottieFrameCache>;
+
+    static Result<Ptr> create(WebGPUContext& ctx, const std::string& data,
+                              uint32_t width, uint32_t height, uint32_t frameCount) noexcept;
+
+    ~LottieFrameCache();
+
+    LottieFrameCache(const LottieFrameCache&) = delete;
+    LottieFrameCache& operator=(const LottieFrameCache&) = delete;
+
+    // Renders the frame into its layer unless an earlier caller did
+    Result<void> ensureFrame(WebGPUContext& ctx, uint32_t frame);
+
+    WGPUTextureView view() const { return framesView_; }
+    uint32_t width() const { return width_; }
+    uint32_t height() const { return height_; }
+    size_t bytes() const { return static_cast<size_t>(width_) * height_ * 4 * ready_.size(); }
+
+    static size_t bytesFor(uint32_t width, uint32_t height, uint32_t frameCount) {
+        return static_cast<size_t>(width) * height * 4 * frameCount;
+    }
+
+private:
+    LottieFrameCache() = default;
+    Result<void> init(WebGPUContext& ctx, const std::string& data,
+                      uint32_t width, uint32_t height, uint32_t frameCount);
+    void releaseRenderer();
+
+    // Rasterizer, dropped once every frame is in the array
+    std::unique_ptr<tvg::Animation> animation_;
+    std::unique_ptr<tvg::WgCanvas> canvas_;
+    WGPUTexture target_ = nullptr;
+
+    WGPUTexture frames_ = nullptr;
+    WGPUTextureView framesView_ = nullptr;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    std::vector<bool> ready_;
+    uint32_t readyCount_ = 0;
+};
+
 //-----------------------------------------------------------------------------
 // ThorvgPlugin - Vector graphics plugin using ThorVG library
 // Supports SVG, Lottie animations, and other vector formats
@@ -38,15 +90,28 @@ public:
         const std::string& payload
     ) override;
 
+    // Frame cache for (content, size), shared while any widget holds it.
+    // nullptr when the animation is too long or the budget is used up -
+    // the widget then renders live.
+    LottieFrameCache::Ptr acquireFrameCache(WebGPUContext& ctx, const std::string& data,
+                                            uint32_t width, uint32_t height, uint32_t frameCount);
+
+    static constexpr uint32_t MAX_CACHED_FRAMES = 256;                     // Texture array layer limit
+    static constexpr size_t ANIMATION_CACHE_BUDGET = 32 * 1024 * 1024;    // Per cached animation
+    static constexpr size_t FRAME_CACHE_BUDGET = 128 * 1024 * 1024;       // All cached animations
+
 private:
     ThorvgPlugin() noexcept = default;
     Result<void> pluginInit() noexcept;
+
+    std::unordered_map<std::string, std::weak_ptr<LottieFrameCache>> frameCaches_;
 };
 
 //-----------------------------------------------------------------------------
 // Lottie - A single vector graphics widget instance
 // Can display static SVG or animated Lottie content
 // Renders directly using WebGPU via ThorVG's WgCanvas
+// With --cache-frames, animations play back from a shared LottieFrameCache
 //-----------------------------------------------------------------------------
 class Lottie : public Widget {
 public:
@@ -59,13 +124,15 @@ public:
         uint32_t widthCells,
         uint32_t heightCells,
         const std::string& pluginArgs,
-        const std::string& payload
+        const std::string& payload,
+        ThorvgPlugin* plugin
     ) {
         (void)factory;
         (void)fontManager;
         (void)loop;
-        (void)pluginArgs;
         auto w = std::shared_ptr<Lottie>(new Lottie(payload));
+        w->plugin_ = plugin;
+        w->cacheFrames_ = pluginArgs.find("--cache-frames") != std::string::npos;
         w->_x = x;
         w->_y = y;
         w->_widthCells = widthCells;
@@ -107,6 +174,13 @@ private:
     Result<void> renderThorvgFrame(WGPUDevice device);
     Result<std::string> yamlToSvg(const std::string& yamlContent);
 
+    ThorvgPlugin* plugin_ = nullptr;
+
+    // --cache-frames: play back from a shared LottieFrameCache
+    bool cacheFrames_ = false;
+    std::string lottieData_;  // Source for the cache's own rasterizer
+    LottieFrameCache::Ptr frameCache_;
+
     // ThorVG objects - using WebGPU canvas
     std::unique_ptr<tvg::WgCanvas> canvas_;
     tvg::Picture* picture_ = nullptr;  // Owned by canvas or animation
@@ -120,6 +194,7 @@ private:
     bool isAnimated_ = false;
     float totalFrames_ = 0.0f;
     float currentFrame_ = 0.0f;
+    float renderedFrame_ = -1.0f;  // Frame held by renderTexture_, -1 when none
     float duration_ = 0.0f;
     bool playing_ = true;
     bool loop_ = true;
@@ -137,8 +212,9 @@ private:
     bool contentDirty_ = true;
     bool failed_ = false;
 
-    // Cached rect for dirty optimization
+    // Cached rect and layer for dirty optimization
     float lastRect_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    uint32_t lastLayer_ = UINT32_MAX;
 
     // On/off state tracking for GPU resource management
     bool wasOn_ = true;
@@ -6,6 +6,8 @@
 #include <ytrace/ytrace.hpp>
 #include <iostream>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -123,7 +125,8 @@ Result<WidgetPtr> VideoPlugin::createWidget(
 Video::~Video() { (void)dispose(); }
 
 Result<void> Video::init() {
-    if (_payload.empty()) {
+    // Payload is a file path, or the container bytes when sent via shared memory
+    if (_payload.empty() && !_shmPayload) {
         return Err<void>("Video: empty payload");
     }
 
@@ -133,26 +136,99 @@ Result<void> Video::init() {
     if (!result) {
         return result;
     }
+    if (auto res = allocateFramePool(); !res) {
+        return res;
+    }
+    startDecoder();
 
     std::cout << "Video: loaded " << videoWidth_ << "x" << videoHeight_
               << " @ " << frameRate_ << " fps, duration=" << duration_ << "s" << std::endl;
     return Ok();
 }
 
-Result<void> Video::initFFmpeg(const std::string& filepath) {
-    // Store file path
-    filePath_ = filepath;
+int Video::avioRead(void* opaque, uint8_t* buf, int bufSize) {
+    auto* self = static_cast<Video*>(opaque);
+    std::string_view data = self->payloadView();
+    int64_t remaining = static_cast<int64_t>(data.size()) - self->avioPos_;
+    if (remaining <= 0) {
+        return AVERROR_EOF;
+    }
+    int n = static_cast<int>(std::min<int64_t>(bufSize, remaining));
+    std::memcpy(buf, data.data() + self->avioPos_, n);
+    self->avioPos_ += n;
+    return n;
+}
+
+int64_t Video::avioSeek(void* opaque, int64_t offset, int whence) {
+    auto* self = static_cast<Video*>(opaque);
+    int64_t size = static_cast<int64_t>(self->payloadView().size());
+    int64_t pos;
+    switch (whence & ~AVSEEK_FORCE) {
+        case AVSEEK_SIZE: return size;
+        case SEEK_SET: pos = offset; break;
+        case SEEK_CUR: pos = self->avioPos_ + offset; break;
+        case SEEK_END: pos = size + offset; break;
+        default: return -1;
+    }
+    if (pos < 0 || pos > size) {
+        return -1;
+    }
+    self->avioPos_ = pos;
+    return pos;
+}
+
+Result<void> Video::openInput() {
+    if (!_shmPayload) {
+        // Open input file directly
+        int ret = avformat_open_input(&formatCtx_, filePath_.c_str(), nullptr, nullptr);
+        if (ret < 0) {
+            char errbuf[256];
+            av_strerror(ret, errbuf, sizeof(errbuf));
+            return Err<void>(std::string("Failed to open video file: ") + errbuf);
+        }
+        return Ok();
+    }
+
+    // Shared memory payload: demux straight from the mapping
+    constexpr int AVIO_BUFFER_SIZE = 64 * 1024;
+    auto* ioBuffer = static_cast<uint8_t*>(av_malloc(AVIO_BUFFER_SIZE));
+    if (!ioBuffer) {
+        return Err<void>("Failed to allocate AVIO buffer");
+    }
+    avioPos_ = 0;
+    avioCtx_ = avio_alloc_context(ioBuffer, AVIO_BUFFER_SIZE, 0, this,
+                                  &Video::avioRead, nullptr, &Video::avioSeek);
+    if (!avioCtx_) {
+        av_free(ioBuffer);
+        return Err<void>("Failed to allocate AVIO context");
+    }
 
-    // Open input file directly
-    int ret = avformat_open_input(&formatCtx_, filepath.c_str(), nullptr, nullptr);
+    formatCtx_ = avformat_alloc_context();
+    if (!formatCtx_) {
+        return Err<void>("Failed to allocate format context");
+    }
+    formatCtx_->pb = avioCtx_;
+    formatCtx_->flags |= AVFMT_FLAG_CUSTOM_IO;
+
+    int ret = avformat_open_input(&formatCtx_, nullptr, nullptr, nullptr);
     if (ret < 0) {
         char errbuf[256];
         av_strerror(ret, errbuf, sizeof(errbuf));
-        return Err<void>(std::string("Failed to open video file: ") + errbuf);
+        return Err<void>(std::string("Failed to open video from shared memory: ") + errbuf);
+    }
+    return Ok();
+}
+
+Result<void> Video::initFFmpeg(const std::string& filepath) {
+    // Store file path (empty for shared memory payloads)
+    filePath_ = filepath;
+
+    if (auto res = openInput(); !res) {
+        return res;
     }
 
     // Find stream info
-    ret = avformat_find_stream_info(formatCtx_, nullptr);
+    int ret = avformat_find_stream_info(formatCtx_, nullptr);
     if (ret < 0) {
         return Err<void>("Failed to find stream info");
     }
@@ -184,6 +260,11 @@ Result<void> Video::initFFmpeg(const std::string& filepath) {
         return Err<void>("Failed to copy codec parameters");
     }
 
+    // Let FFmpeg decode several frames in parallel (we are already off the
+    // render thread, this keeps 1080p+ decoding ahead of the playback clock)
+    codecCtx_->thread_count = 0;  // auto
+    codecCtx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
     // Open codec
     ret = avcodec_open2(codecCtx_, codec, nullptr);
     if (ret < 0) {
@@ -218,95 +299,289 @@ Result<void> Video::initFFmpeg(const std::string& filepath) {
 
     // Allocate frames
     frame_ = av_frame_alloc();
-    frameRgba_ = av_frame_alloc();
     packet_ = av_packet_alloc();
 
-    if (!frame_ || !frameRgba_ || !packet_) {
+    if (!frame_ || !packet_) {
         return Err<void>("Failed to allocate frame/packet");
     }
 
-    // Allocate RGBA frame buffer
-    int num_bytes = av_image_get_buffer_size(AV_PIX_FMT_RGBA, videoWidth_, videoHeight_, 1);
-    frameBuffer_.resize(num_bytes);
+    // 4:2:0 planar is what nearly every codec produces: the shader converts
+    // it. Anything else is converted to RGBA by swscale.
+    planar_ = codecCtx_->pix_fmt == AV_PIX_FMT_YUV420P ||
+              codecCtx_->pix_fmt == AV_PIX_FMT_YUVJ420P;
+    if (!planar_) {
+        swsCtx_ = sws_getContext(
+            videoWidth_, videoHeight_, codecCtx_->pix_fmt,
+            videoWidth_, videoHeight_, AV_PIX_FMT_RGBA,
+            SWS_BILINEAR, nullptr, nullptr, nullptr
+        );
+
+        if (!swsCtx_) {
+            return Err<void>("Failed to create swscale context");
+        }
+    }
+    ydebug("Video: {}x{} {} path", videoWidth_, videoHeight_, planar_ ? "YUV420" : "RGBA");
 
-    av_image_fill_arrays(frameRgba_->data, frameRgba_->linesize,
-                         frameBuffer_.data(), AV_PIX_FMT_RGBA,
-                         videoWidth_, videoHeight_, 1);
+    return Ok();
+}
 
-    // Create swscale context for format conversion
-    swsCtx_ = sws_getContext(
-        videoWidth_, videoHeight_, codecCtx_->pix_fmt,
-        videoWidth_, videoHeight_, AV_PIX_FMT_RGBA,
-        SWS_BILINEAR, nullptr, nullptr, nullptr
-    );
+Result<void> Video::allocateFramePool() {
+    readyFrames_ = std::make_unique<SpscQueue<DecodedFrame>>(FRAME_POOL_SIZE);
+    freeFrames_ = std::make_unique<SpscQueue<AVFrame*>>(FRAME_POOL_SIZE);
 
-    if (!swsCtx_) {
-        return Err<void>("Failed to create swscale context");
+    for (size_t i = 0; i < FRAME_POOL_SIZE; i++) {
+        AVFrame* f = av_frame_alloc();
+        if (!f) {
+            return Err<void>("Failed to allocate frame pool");
+        }
+        framePool_.push_back(f);
+        if (planar_) {
+            // Filled by reference from the decoder, no buffer of our own
+            freeFrames_->tryPush(f);
+            continue;
+        }
+        f->format = AV_PIX_FMT_RGBA;
+        f->width = videoWidth_;
+        f->height = videoHeight_;
+        if (av_frame_get_buffer(f, 0) < 0) {
+            return Err<void>("Failed to allocate frame pool buffer");
+        }
+        freeFrames_->tryPush(f);
     }
+    return Ok();
+}
 
-    // Decode first frame
-    auto decRes = decodeNextFrame();
-    if (!decRes) {
-        std::cerr << "Warning: Failed to decode first frame: " << error_msg(decRes) << std::endl;
-    }
+//-----------------------------------------------------------------------------
+// Decoder thread
+//-----------------------------------------------------------------------------
 
-    return Ok();
+void Video::startDecoder() {
+    decoderStop_ = false;
+    decoderEnded_ = false;
+    loopBase_ = 0.0;
+    firstPts_ = -1.0;
+    lastPts_ = 0.0;
+    decoderThread_ = std::thread([this] { decoderLoop(); });
 }
 
-Result<void> Video::decodeNextFrame() {
-    if (!formatCtx_ || !codecCtx_ || !frame_ || !packet_) {
-        return Err<void>("FFmpeg not initialized");
-    }
+void Video::stopDecoder() {
+    if (!decoderThread_.joinable()) return;
+    decoderStop_ = true;
+    wakeDecoder();
+    decoderThread_.join();
+}
 
-    while (true) {
-        int ret = av_read_frame(formatCtx_, packet_);
-        if (ret < 0) {
-            if (ret == AVERROR_EOF) {
-                if (loop_) {
-                    // Seek to beginning
-                    av_seek_frame(formatCtx_, videoStreamIdx_, 0, AVSEEK_FLAG_BACKWARD);
-                    avcodec_flush_buffers(codecCtx_);
-                    currentTime_ = 0.0;
-                    continue;
-                }
-                return Err<void>("End of stream");
+void Video::wakeDecoder() {
+    decoderWake_.fetch_add(1, std::memory_order_release);
+    decoderWake_.notify_one();
+}
+
+void Video::recycleFrame(AVFrame* frame) {
+    if (!frame) return;
+    freeFrames_->tryPush(frame);
+    wakeDecoder();
+}
+
+void Video::decoderLoop() {
+    ydebug("Video: decoder thread started");
+
+    // Frame being filled. Only the render thread pushes to freeFrames_, so a
+    // frame that didn't get decoded into is kept here for the next attempt.
+    AVFrame* out = nullptr;
+
+    // Generation decoded frames are tagged with; only changes when a seek
+    // is consumed, so frames from before the seek position never carry it
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+
+    while (!decoderStop_.load(std::memory_order_acquire)) {
+        // Sample the wake counter first so a recycle/seek that happens while
+        // we look at the queues still wakes us up
+        uint32_t wake = decoderWake_.load(std::memory_order_acquire);
+
+        double target = -1.0;
+        {
+            std::lock_guard<std::mutex> lock(seekMutex_);
+            if (seekTarget_ >= 0.0) {
+                target = seekTarget_;
+                seekTarget_ = -1.0;
+                generation = generation_.load(std::memory_order_relaxed);
             }
-            return Err<void>("Error reading frame");
+        }
+        if (target >= 0.0) {
+            int64_t timestamp = static_cast<int64_t>(target / timeBase_);
+            av_seek_frame(formatCtx_, videoStreamIdx_, timestamp, AVSEEK_FLAG_BACKWARD);
+            avcodec_flush_buffers(codecCtx_);
+            decoderEnded_ = false;
+            loopBase_ = 0.0;
         }
 
-        if (packet_->stream_index != videoStreamIdx_) {
-            av_packet_unref(packet_);
+        if (decoderEnded_.load(std::memory_order_relaxed)) {
+            decoderWake_.wait(wake);
             continue;
         }
 
-        ret = avcodec_send_packet(codecCtx_, packet_);
-        av_packet_unref(packet_);
+        if (!out && !freeFrames_->tryPop(out)) {
+            // All frames queued or on screen - wait for the render thread
+            decoderWake_.wait(wake);
+            continue;
+        }
 
-        if (ret < 0) {
-            continue;  // Try next packet
+        double pts = 0.0;
+        auto res = decodeNextFrame(out, pts);
+        if (res && *res) {
+            // Pool size == queue capacity, this cannot fail
+            readyFrames_->tryPush(DecodedFrame{out, pts, generation});
+            out = nullptr;
+            continue;
         }
 
-        ret = avcodec_receive_frame(codecCtx_, frame_);
-        if (ret == AVERROR(EAGAIN)) {
-            continue;  // Need more packets
+        if (!res) {
+            yerror("Video: {}", error_msg(res));
+            decoderEnded_ = true;
+        } else if (loop_) {
+            // Continue the PTS timeline one frame after the last one
+            av_seek_frame(formatCtx_, videoStreamIdx_, 0, AVSEEK_FLAG_BACKWARD);
+            avcodec_flush_buffers(codecCtx_);
+            loopBase_ = lastPts_ + frameTime_ - std::max(firstPts_, 0.0);
+        } else {
+            decoderEnded_ = true;
+        }
+    }
+
+    ydebug("Video: decoder thread stopped");
+}
+
+// Decode the next video frame into 'out' (YUV420 planes or RGBA). Returns
+// false at the end of the stream, after the frames still buffered in the
+// decoder were drained.
+Result<bool> Video::decodeNextFrame(AVFrame* out, double& pts) {
+    if (!formatCtx_ || !codecCtx_ || !frame_ || !packet_) {
+        return Err<bool>("FFmpeg not initialized");
+    }
+
+    while (true) {
+        int ret = avcodec_receive_frame(codecCtx_, frame_);
+        if (ret == 0) {
+            break;
+        }
+        if (ret == AVERROR_EOF) {
+            return Ok(false);
+        }
+        if (ret != AVERROR(EAGAIN)) {
+            return Err<bool>("Error decoding frame");
         }
+
+        // Decoder needs more input
+        ret = av_read_frame(formatCtx_, packet_);
         if (ret < 0) {
-            return Err<void>("Error decoding frame");
+            if (ret != AVERROR_EOF) {
+                return Err<bool>("Error reading frame");
+            }
+            // Enter draining mode, frame threading holds several frames
+            avcodec_send_packet(codecCtx_, nullptr);
+            continue;
         }
 
-        // Convert to RGBA
+        if (packet_->stream_index == videoStreamIdx_) {
+            avcodec_send_packet(codecCtx_, packet_);  // Bad packets are skipped
+        }
+        av_packet_unref(packet_);
+    }
+
+    // Presentation time from PTS (or the best effort guess)
+    int64_t ts = frame_->best_effort_timestamp != AV_NOPTS_VALUE
+                     ? frame_->best_effort_timestamp : frame_->pts;
+
+    bool passthrough = planar_ &&
+                       (frame_->format == AV_PIX_FMT_YUV420P ||
+                        frame_->format == AV_PIX_FMT_YUVJ420P) &&
+                       frame_->width == videoWidth_ && frame_->height == videoHeight_ &&
+                       frame_->linesize[0] > 0;
+    if (passthrough) {
+        // Hand the decoder's planes over by reference, no copy
+        av_frame_unref(out);
+        av_frame_move_ref(out, frame_);
+    } else {
+        // RGBA path, or a planar stream that changed format/size mid-way
+        AVPixelFormat dstFormat = planar_ ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA;
+        swsCtx_ = sws_getCachedContext(swsCtx_,
+            frame_->width, frame_->height, static_cast<AVPixelFormat>(frame_->format),
+            videoWidth_, videoHeight_, dstFormat,
+            SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!swsCtx_) {
+            av_frame_unref(frame_);
+            return Err<bool>("Failed to create swscale context");
+        }
+        if (planar_) {
+            // 'out' may still reference decoder-owned planes
+            av_frame_unref(out);
+            out->format = dstFormat;
+            out->width = videoWidth_;
+            out->height = videoHeight_;
+            out->colorspace = frame_->colorspace;
+            out->color_range = frame_->color_range;
+            if (av_frame_get_buffer(out, 0) < 0) {
+                av_frame_unref(frame_);
+                return Err<bool>("Failed to allocate frame buffer");
+            }
+        }
         sws_scale(swsCtx_,
                   frame_->data, frame_->linesize,
-                  0, videoHeight_,
-                  frameRgba_->data, frameRgba_->linesize);
+                  0, frame_->height,
+                  out->data, out->linesize);
+    }
+
+    double raw = ts != AV_NOPTS_VALUE ? ts * timeBase_ : lastPts_ + frameTime_ - loopBase_;
+    if (firstPts_ < 0.0) {
+        firstPts_ = raw;
+    }
+    pts = raw + loopBase_;
+    lastPts_ = pts;
+    av_frame_unref(frame_);
+    return Ok(true);
+}
+
+//-----------------------------------------------------------------------------
+// Playback
+//-----------------------------------------------------------------------------
+
+void Video::selectFrame() {
+    if (!readyFrames_) return;
 
-        // Update current time from PTS
-        if (frame_->pts != AV_NOPTS_VALUE) {
-            currentTime_ = frame_->pts * timeBase_;
+    auto now = std::chrono::steady_clock::now();
+    if (playing_ && clockStarted_) {
+        clock_ += std::chrono::duration<double>(now - lastTick_).count();
+    }
+    lastTick_ = now;
+
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    while (DecodedFrame* next = readyFrames_->front()) {
+        if (next->generation != generation) {
+            // Decoded before a seek
+            DecodedFrame stale;
+            readyFrames_->tryPop(stale);
+            recycleFrame(stale.frame);
+            continue;
+        }
+        if (!clockStarted_) {
+            clock_ = next->pts;
+            clockStarted_ = true;
+        } else if (current_.frame && next->pts > clock_) {
+            break;  // Not due yet
         }
 
+        // Due: replaces the frame on screen. Several due frames in a row
+        // means we fell behind, only the newest one gets uploaded.
+        DecodedFrame due;
+        readyFrames_->tryPop(due);
+        recycleFrame(current_.frame);
+        current_ = due;
         frameUpdated_ = true;
-        return Ok();
+        currentTime_ = duration_ > 0.0 ? std::fmod(due.pts, duration_) : due.pts;
+    }
+
+    if (!loop_ && decoderEnded_ && readyFrames_->empty()) {
+        playing_ = false;
     }
 }
 
@@ -320,14 +595,17 @@ void Video::stop() {
 void Video::seek(double seconds) {
     if (!formatCtx_ || videoStreamIdx_ < 0) return;
 
-    int64_t timestamp = static_cast<int64_t>(seconds / timeBase_);
-    av_seek_frame(formatCtx_, videoStreamIdx_, timestamp, AVSEEK_FLAG_BACKWARD);
-    avcodec_flush_buffers(codecCtx_);
+    // The decoder thread owns the FFmpeg contexts: post the request and
+    // invalidate frames already queued. The clock restarts at the first
+    // frame of the new generation.
+    {
+        std::lock_guard<std::mutex> lock(seekMutex_);
+        seekTarget_ = std::max(seconds, 0.0);
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    clockStarted_ = false;
     currentTime_ = seconds;
-    accumulatedTime_ = 0.0;
-
-    // Decode frame at new position
-    (void)decodeNextFrame();
+    wakeDecoder();
 }
 
 bool Video::onMouseButton(int button, bool pressed) {
@@ -346,33 +624,48 @@ void Video::releaseGPUResources() {
     if (pipeline_) { wgpuRenderPipelineRelease(pipeline_); pipeline_ = nullptr; }
     if (uniformBuffer_) { wgpuBufferRelease(uniformBuffer_); uniformBuffer_ = nullptr; }
     if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
-    if (textureView_) { wgpuTextureViewRelease(textureView_); textureView_ = nullptr; }
-    if (texture_) { wgpuTextureRelease(texture_); texture_ = nullptr; }
+    for (int i = 0; i < MAX_PLANES; i++) {
+        if (textureViews_[i]) { wgpuTextureViewRelease(textureViews_[i]); textureViews_[i] = nullptr; }
+        if (textures_[i]) { wgpuTextureRelease(textures_[i]); textures_[i] = nullptr; }
+    }
     gpuInitialized_ = false;
     yinfo("Video: GPU resources released");
 }
 
 Result<void> Video::dispose() {
+    // Decoder thread uses the FFmpeg state below
+    stopDecoder();
+
     // Release WebGPU resources
     if (bindGroup_) { wgpuBindGroupRelease(bindGroup_); bindGroup_ = nullptr; }
     if (pipeline_) { wgpuRenderPipelineRelease(pipeline_); pipeline_ = nullptr; }
     if (uniformBuffer_) { wgpuBufferRelease(uniformBuffer_); uniformBuffer_ = nullptr; }
     if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
-    if (textureView_) { wgpuTextureViewRelease(textureView_); textureView_ = nullptr; }
-    if (texture_) { wgpuTextureRelease(texture_); texture_ = nullptr; }
+    for (int i = 0; i < MAX_PLANES; i++) {
+        if (textureViews_[i]) { wgpuTextureViewRelease(textureViews_[i]); textureViews_[i] = nullptr; }
+        if (textures_[i]) { wgpuTextureRelease(textures_[i]); textures_[i] = nullptr; }
+    }
 
     // Release FFmpeg resources
     if (swsCtx_) { sws_freeContext(swsCtx_); swsCtx_ = nullptr; }
     if (frame_) { av_frame_free(&frame_); }
-    if (frameRgba_) { av_frame_free(&frameRgba_); }
     if (packet_) { av_packet_free(&packet_); }
+    for (AVFrame*& f : framePool_) { av_frame_free(&f); }
+    framePool_.clear();
+    readyFrames_.reset();
+    freeFrames_.reset();
+    current_ = DecodedFrame{};
+    clockStarted_ = false;
     if (codecCtx_) { avcodec_free_context(&codecCtx_); }
 
     if (formatCtx_) {
         avformat_close_input(&formatCtx_);
     }
+    if (avioCtx_) {
+        av_freep(&avioCtx_->buffer);
+        avio_context_free(&avioCtx_);
+    }
 
-    frameBuffer_.clear();
     filePath_.clear();
     gpuInitialized_ = false;
 
@@ -380,25 +673,85 @@ Result<void> Video::dispose() {
 }
 
 void Video::updateTexture(WebGPUContext& ctx) {
-    if (!texture_ || !frameUpdated_ || frameBuffer_.empty()) return;
+    AVFrame* f = current_.frame;
+    if (!textures_[0] || !frameUpdated_ || !f) return;
+
+    for (int i = 0; i < planeCount(); i++) {
+        // Chroma planes of 4:2:0 are half size, rounded up
+        uint32_t w = static_cast<uint32_t>(videoWidth_);
+        uint32_t h = static_cast<uint32_t>(videoHeight_);
+        if (i > 0) {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+        }
 
-    WGPUTexelCopyTextureInfo dst = {};
-    dst.texture = texture_;
-    WGPUTexelCopyBufferLayout layout = {};
-    layout.bytesPerRow = videoWidth_ * 4;
-    layout.rowsPerImage = videoHeight_;
-    WGPUExtent3D extent = {static_cast<uint32_t>(videoWidth_),
-                           static_cast<uint32_t>(videoHeight_), 1};
+        WGPUTexelCopyTextureInfo dst = {};
+        dst.texture = textures_[i];
+        WGPUTexelCopyBufferLayout layout = {};
+        layout.bytesPerRow = static_cast<uint32_t>(f->linesize[i]);
+        layout.rowsPerImage = h;
+        WGPUExtent3D extent = {w, h, 1};
 
-    wgpuQueueWriteTexture(ctx.getQueue(), &dst, frameBuffer_.data(),
-                          frameBuffer_.size(), &layout, &extent);
+        wgpuQueueWriteTexture(ctx.getQueue(), &dst, f->data[i],
+                              static_cast<size_t>(f->linesize[i]) * h, &layout, &extent);
+    }
 
+    if (planar_) {
+        updateColorMatrix(f);
+    }
     frameUpdated_ = false;
 }
 
+// Build the YUV -> RGB transform from the frame's color metadata. Untagged
+// video follows the usual convention: BT.709 for HD, BT.601 below 720 lines.
+void Video::updateColorMatrix(const AVFrame* frame) {
+    float kr = 0.299f, kb = 0.114f;  // BT.601
+    switch (frame->colorspace) {
+        case AVCOL_SPC_BT709:
+            kr = 0.2126f; kb = 0.0722f;
+            break;
+        case AVCOL_SPC_BT2020_NCL:
+            kr = 0.2627f; kb = 0.0593f;
+            break;
+        case AVCOL_SPC_BT470BG:
+        case AVCOL_SPC_SMPTE170M:
+            break;
+        default:
+            if (videoHeight_ >= 720) { kr = 0.2126f; kb = 0.0722f; }
+            break;
+    }
+    float kg = 1.0f - kr - kb;
+
+    bool fullRange = frame->color_range == AVCOL_RANGE_JPEG ||
+                     (frame->color_range != AVCOL_RANGE_MPEG &&
+                      frame->format == AV_PIX_FMT_YUVJ420P);
+    float yScale = fullRange ? 1.0f : 255.0f / 219.0f;
+    float yOffset = fullRange ? 0.0f : 16.0f / 255.0f;
+    float cScale = fullRange ? 1.0f : 255.0f / 224.0f;
+    float cOffset = 128.0f / 255.0f;
+
+    // Coefficients applied to normalized Y, Cb, Cr
+    const float m[3][3] = {
+        {1.0f, 0.0f, 2.0f * (1.0f - kr)},
+        {1.0f, -2.0f * kb * (1.0f - kb) / kg, -2.0f * kr * (1.0f - kr) / kg},
+        {1.0f, 2.0f * (1.0f - kb), 0.0f},
+    };
+    for (int i = 0; i < 3; i++) {
+        colorRows_[i][0] = m[i][0] * yScale;
+        colorRows_[i][1] = m[i][1] * cScale;
+        colorRows_[i][2] = m[i][2] * cScale;
+        colorRows_[i][3] = -(colorRows_[i][0] * yOffset +
+                             (colorRows_[i][1] + colorRows_[i][2]) * cOffset);
+    }
+}
+
 void Video::prepareFrame(WebGPUContext& ctx, bool on) {
     // Video uses its own command encoder/pass, so render during prepareFrame
 
+    // Playback advances whether or not we are visible: consuming due frames
+    // keeps the decoder running while scrolled off
+    selectFrame();
+
     // Handle on/off transitions for GPU resource management
     if (!on && wasOn_) {
         // Transitioning to off - release GPU resources
@@ -416,21 +769,8 @@ void Video::prepareFrame(WebGPUContext& ctx, bool on) {
     }
 
     if (!on || failed_ || !_visible) return;
-    if (frameBuffer_.empty()) {
-        yerror("Video has no frame data");
-        return;
-    }
-
-    // Update playback
-    if (playing_) {
-        accumulatedTime_ += 0.016;  // ~60fps
-        if (accumulatedTime_ >= frameTime_) {
-            accumulatedTime_ -= frameTime_;
-            auto res = decodeNextFrame();
-            if (!res && !loop_) {
-                playing_ = false;
-            }
-        }
+    if (!current_.frame) {
+        return;  // First frame not decoded yet
     }
 
     if (!gpuInitialized_) {
@@ -441,6 +781,7 @@ void Video::prepareFrame(WebGPUContext& ctx, bool on) {
             return;
         }
         gpuInitialized_ = true;
+        frameUpdated_ = true;  // New texture needs the current frame
     }
 
     if (!pipeline_ || !uniformBuffer_ || !bindGroup_) {
@@ -458,11 +799,12 @@ void Video::prepareFrame(WebGPUContext& ctx, bool on) {
     float ndcW = (static_cast<float>(_pixelWidth) / ctx.getSurfaceWidth()) * 2.0f;
     float ndcH = (static_cast<float>(_pixelHeight) / ctx.getSurfaceHeight()) * 2.0f;
 
-    struct Uniforms { float rect[4]; } uniforms;
+    struct Uniforms { float rect[4]; float color[3][4]; } uniforms;
     uniforms.rect[0] = ndcX;
     uniforms.rect[1] = ndcY;
     uniforms.rect[2] = ndcW;
     uniforms.rect[3] = ndcH;
+    std::memcpy(uniforms.color, colorRows_, sizeof(colorRows_));
 
     wgpuQueueWriteBuffer(ctx.getQueue(), uniformBuffer_, 0, &uniforms, sizeof(uniforms));
 
@@ -518,39 +860,37 @@ Result<void> Video::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool
 Result<void> Video::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat) {
     WGPUDevice device = ctx.getDevice();
 
-    // Create texture
-    WGPUTextureDescriptor texDesc = {};
-    texDesc.size.width = videoWidth_;
-    texDesc.size.height = videoHeight_;
-    texDesc.size.depthOrArrayLayers = 1;
-    texDesc.mipLevelCount = 1;
-    texDesc.sampleCount = 1;
-    texDesc.dimension = WGPUTextureDimension_2D;
-    texDesc.format = WGPUTextureFormat_RGBA8Unorm;
-    texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
-
-    texture_ = wgpuDeviceCreateTexture(device, &texDesc);
-    if (!texture_) return Err<void>("Failed to create texture");
-
-    // Upload initial frame
-    WGPUTexelCopyTextureInfo dst = {};
-    dst.texture = texture_;
-    WGPUTexelCopyBufferLayout layout = {};
-    layout.bytesPerRow = videoWidth_ * 4;
-    layout.rowsPerImage = videoHeight_;
-    WGPUExtent3D extent = {static_cast<uint32_t>(videoWidth_),
-                           static_cast<uint32_t>(videoHeight_), 1};
-    wgpuQueueWriteTexture(ctx.getQueue(), &dst, frameBuffer_.data(),
-                          frameBuffer_.size(), &layout, &extent);
-
-    // Create texture view
-    WGPUTextureViewDescriptor viewDesc = {};
-    viewDesc.format = WGPUTextureFormat_RGBA8Unorm;
-    viewDesc.dimension = WGPUTextureViewDimension_2D;
-    viewDesc.mipLevelCount = 1;
-    viewDesc.arrayLayerCount = 1;
-    textureView_ = wgpuTextureCreateView(texture_, &viewDesc);
-    if (!textureView_) return Err<void>("Failed to create texture view");
+    // Create textures: one RGBA texture, or Y + half size U and V planes
+    for (int i = 0; i < planeCount(); i++) {
+        WGPUTextureFormat format = planar_ ? WGPUTextureFormat_R8Unorm : WGPUTextureFormat_RGBA8Unorm;
+        uint32_t w = static_cast<uint32_t>(videoWidth_);
+        uint32_t h = static_cast<uint32_t>(videoHeight_);
+        if (i > 0) {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+        }
+
+        WGPUTextureDescriptor texDesc = {};
+        texDesc.size.width = w;
+        texDesc.size.height = h;
+        texDesc.size.depthOrArrayLayers = 1;
+        texDesc.mipLevelCount = 1;
+        texDesc.sampleCount = 1;
+        texDesc.dimension = WGPUTextureDimension_2D;
+        texDesc.format = format;
+        texDesc.usage = WGPUTextureUsage_TextureBinding | WGPUTextureUsage_CopyDst;
+
+        textures_[i] = wgpuDeviceCreateTexture(device, &texDesc);
+        if (!textures_[i]) return Err<void>("Failed to create texture");
+
+        WGPUTextureViewDescriptor viewDesc = {};
+        viewDesc.format = format;
+        viewDesc.dimension = WGPUTextureViewDimension_2D;
+        viewDesc.mipLevelCount = 1;
+        viewDesc.arrayLayerCount = 1;
+        textureViews_[i] = wgpuTextureCreateView(textures_[i], &viewDesc);
+        if (!textureViews_[i]) return Err<void>("Failed to create texture view");
+    }
 
     // Create sampler
     WGPUSamplerDescriptor samplerDesc = {};
@@ -565,14 +905,14 @@ Result<void> Video::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetF
 
     // Create uniform buffer
     WGPUBufferDescriptor bufDesc = {};
-    bufDesc.size = 16;
+    bufDesc.size = UNIFORM_SIZE;
     bufDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
     uniformBuffer_ = wgpuDeviceCreateBuffer(device, &bufDesc);
     if (!uniformBuffer_) return Err<void>("Failed to create uniform buffer");
 
-    // Shader (same as image plugin)
-    const char* shaderCode = R"(
-struct Uniforms { rect: vec4<f32>, }
+    // Shader (same as image plugin, plus the YUV variant)
+    const char* rgbaShader = R"(
+struct Uniforms { rect: vec4<f32>, color: array<vec4<f32>, 3>, }
 @group(0) @binding(0) var<uniform> u: Uniforms;
 @group(0) @binding(1) var texSampler: sampler;
 @group(0) @binding(2) var tex: texture_2d<f32>;
@@ -590,41 +930,72 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
 }
 )";
 
+    const char* yuvShader = R"(
+struct Uniforms { rect: vec4<f32>, color: array<vec4<f32>, 3>, }
+@group(0) @binding(0) var<uniform> u: Uniforms;
+@group(0) @binding(1) var texSampler: sampler;
+@group(0) @binding(2) var texY: texture_2d<f32>;
+@group(0) @binding(3) var texU: texture_2d<f32>;
+@group(0) @binding(4) var texV: texture_2d<f32>;
+struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: vec2<f32>, }
+@vertex fn vs_main(@builtin(vertex_index) vi: u32) -> VertexOutput {
+    var p = array<vec2<f32>,6>(vec2(0.,0.),vec2(1.,0.),vec2(1.,1.),vec2(0.,0.),vec2(1.,1.),vec2(0.,1.));
+    let pos = p[vi];
+    var o: VertexOutput;
+    o.position = vec4(u.rect.x + pos.x * u.rect.z, u.rect.y - pos.y * u.rect.w, 0., 1.);
+    o.uv = pos;
+    return o;
+}
+@fragment fn fs_main(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
+    let yuv = vec4(textureSample(texY, texSampler, uv).r,
+                   textureSample(texU, texSampler, uv).r,
+                   textureSample(texV, texSampler, uv).r, 1.);
+    let rgb = vec3(dot(u.color[0], yuv), dot(u.color[1], yuv), dot(u.color[2], yuv));
+    return vec4(clamp(rgb, vec3(0.), vec3(1.)), 1.);
+}
+)";
+    const char* shaderCode = planar_ ? yuvShader : rgbaShader;
+
     WGPUShaderSourceWGSL wgslDesc = {};
     wgslDesc.chain.sType = WGPUSType_ShaderSourceWGSL;
     wgslDesc.code = WGPU_STR(shaderCode);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
-    // Bind group layout
-    WGPUBindGroupLayoutEntry entries[3] = {};
-    entries[0].binding = 0; entries[0].visibility = WGPUShaderStage_Vertex;
+    // Bind group layout: uniforms, sampler, one texture per plane
+    uint32_t entryCount = 2 + static_cast<uint32_t>(planeCount());
+    WGPUBindGroupLayoutEntry entries[2 + MAX_PLANES] = {};
+    entries[0].binding = 0; entries[0].visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
     entries[0].buffer.type = WGPUBufferBindingType_Uniform;
     entries[1].binding = 1; entries[1].visibility = WGPUShaderStage_Fragment;
     entries[1].sampler.type = WGPUSamplerBindingType_Filtering;
-    entries[2].binding = 2; entries[2].visibility = WGPUShaderStage_Fragment;
-    entries[2].texture.sampleType = WGPUTextureSampleType_Float;
-    entries[2].texture.viewDimension = WGPUTextureViewDimension_2D;
+    for (uint32_t i = 2; i < entryCount; i++) {
+        entries[i].binding = i; entries[i].visibility = WGPUShaderStage_Fragment;
+        entries[i].texture.sampleType = WGPUTextureSampleType_Float;
+        entries[i].texture.viewDimension = WGPUTextureViewDimension_2D;
+    }
 
     WGPUBindGroupLayoutDescriptor bglDesc = {};
-    bglDesc.entryCount = 3; bglDesc.entries = entries;
-    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
+    bglDesc.entryCount = entryCount; bglDesc.entries = entries;
+    WGPUBindGroupLayout bgl = ctx.shaderCache().createBindGroupLayout(&bglDesc);
     if (!bgl) { wgpuShaderModuleRelease(shaderModule); return Err<void>("Failed to create bgl"); }
 
     // Pipeline layout
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 1; plDesc.bindGroupLayouts = &bgl;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
 
     // Bind group
-    WGPUBindGroupEntry bgE[3] = {};
-    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = 16;
+    WGPUBindGroupEntry bgE[2 + MAX_PLANES] = {};
+    bgE[0].binding = 0; bgE[0].buffer = uniformBuffer_; bgE[0].size = UNIFORM_SIZE;
     bgE[1].binding = 1; bgE[1].sampler = sampler_;
-    bgE[2].binding = 2; bgE[2].textureView = textureView_;
+    for (uint32_t i = 2; i < entryCount; i++) {
+        bgE[i].binding = i; bgE[i].textureView = textureViews_[i - 2];
+    }
     WGPUBindGroupDescriptor bgDesc = {};
-    bgDesc.layout = bgl; bgDesc.entryCount = 3; bgDesc.entries = bgE;
+    bgDesc.layout = bgl; bgDesc.entryCount = entryCount; bgDesc.entries = bgE;
     bindGroup_ = wgpuDeviceCreateBindGroup(device, &bgDesc);
 
     // Render pipeline
@@ -649,7 +1020,7 @@ struct VertexOutput { @builtin(position) position: vec4<f32>, @location(0) uv: v
     pipelineDesc.primitive.topology = WGPUPrimitiveTopology_TriangleList;
     pipelineDesc.multisample.count = 1; pipelineDesc.multisample.mask = ~0u;
 
-    pipeline_ = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    pipeline_ = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(shaderModule);
     wgpuBindGroupLayoutRelease(bgl);
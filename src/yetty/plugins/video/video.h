@@ -1,6 +1,7 @@
 #pragma once
 
 #include <yetty/plugin.h>
+#include <yetty/spsc-queue.h>
 #include <webgpu/webgpu.h>
 #include <memory>
 #include <vector>
@@ -14,6 +15,7 @@ struct AVFormatContext;
 struct AVCodecContext;
 struct AVFrame;
 struct AVPacket;
+struct AVIOContext;
 struct SwsContext;
 
 namespace yetty {
@@ -57,6 +59,17 @@ private:
 //-----------------------------------------------------------------------------
 // Video - displays video files using FFmpeg
 //
+// Decoding runs on a dedicated thread (with FFmpeg frame threading) that
+// fills a small pool of frames. 4:2:0 planar video is passed through as is:
+// the Y, U and V planes are uploaded to three R8 textures and converted to
+// RGB in the fragment shader (BT.601/709/2020, limited or full range). Other
+// pixel formats fall back to a swscale conversion to RGBA on the decoder
+// thread. Frames reach the render thread through
+// a bounded lock-free queue and are picked by presentation time against a
+// wall-clock playback clock, so a slow decode never stalls the terminal and
+// late frames are dropped. The clock keeps running and the queue keeps being
+// drained while the widget is scrolled off, so playback resumes in sync.
+//
 // Two-phase construction:
 //   1. Constructor (private) - stores payload
 //   2. init() (private) - no args, loads video
@@ -118,17 +131,43 @@ private:
     Result<void> init() override;
 
     Result<void> initFFmpeg(const std::string& data);
-    Result<void> decodeNextFrame();
+    Result<void> openInput();
+
+    // Custom AVIO over a shared memory payload (no temp file, no copy)
+    static int avioRead(void* opaque, uint8_t* buf, int bufSize);
+    static int64_t avioSeek(void* opaque, int64_t offset, int whence);
+    // Decoder thread
+    struct DecodedFrame {
+        AVFrame* frame = nullptr;
+        double pts = 0.0;         // Seconds, keeps increasing across loops
+        uint64_t generation = 0;  // Seek generation the frame was decoded in
+    };
+    static constexpr size_t FRAME_QUEUE_DEPTH = 4;
+    // Queued frames + the one on screen + the one being decoded
+    static constexpr size_t FRAME_POOL_SIZE = FRAME_QUEUE_DEPTH + 2;
+
+    Result<void> allocateFramePool();
+    void startDecoder();
+    void stopDecoder();
+    void decoderLoop();
+    Result<bool> decodeNextFrame(AVFrame* out, double& pts);
+    void recycleFrame(AVFrame* frame);
+    void wakeDecoder();
+
+    // Render thread: advance the playback clock and take the due frame
+    void selectFrame();
     void updateTexture(WebGPUContext& ctx);
+    void updateColorMatrix(const AVFrame* frame);
     Result<void> createPipeline(WebGPUContext& ctx, WGPUTextureFormat targetFormat);
 
     // FFmpeg state
     AVFormatContext* formatCtx_ = nullptr;
     AVCodecContext* codecCtx_ = nullptr;
     AVFrame* frame_ = nullptr;
-    AVFrame* frameRgba_ = nullptr;
     AVPacket* packet_ = nullptr;
     SwsContext* swsCtx_ = nullptr;
+    AVIOContext* avioCtx_ = nullptr;
+    int64_t avioPos_ = 0;
     int videoStreamIdx_ = -1;
 
     // Video properties
@@ -138,17 +177,45 @@ private:
     double duration_ = 0.0;
     double timeBase_ = 0.0;
 
-    // Playback state
+    // Planar 4:2:0 frames go to the GPU untouched, everything else is
+    // converted to RGBA by swscale
+    bool planar_ = false;
+    int planeCount() const { return planar_ ? 3 : 1; }
+
+    // Playback state (render thread)
     bool playing_ = true;
     bool loop_ = true;
     double currentTime_ = 0.0;
     double frameTime_ = 0.0;
-    double accumulatedTime_ = 0.0;
+    double clock_ = 0.0;          // Playback position on the frame PTS timeline
+    bool clockStarted_ = false;
+    std::chrono::steady_clock::time_point lastTick_;
 
-    // Frame buffer (RGBA)
-    std::vector<uint8_t> frameBuffer_;
+    // Frame on screen (render thread owns it until it is recycled)
+    DecodedFrame current_;
     bool frameUpdated_ = false;
 
+    // Decoder thread and frame handoff. readyFrames_ carries decoded frames
+    // to the render thread, freeFrames_ returns them for reuse.
+    std::vector<AVFrame*> framePool_;
+    std::unique_ptr<SpscQueue<DecodedFrame>> readyFrames_;
+    std::unique_ptr<SpscQueue<AVFrame*>> freeFrames_;
+    std::thread decoderThread_;
+    std::atomic<bool> decoderStop_{false};
+    std::atomic<bool> decoderEnded_{false};
+    std::atomic<uint32_t> decoderWake_{0};
+    std::atomic<uint64_t> generation_{0};   // Bumped by seek()
+
+    // Pending seek and the generation it starts; taken together by the
+    // decoder so the seek keyframe is never tagged with an older generation
+    std::mutex seekMutex_;
+    double seekTarget_ = -1.0;              // < 0 when none
+
+    // Decoder thread only
+    double loopBase_ = 0.0;       // Added to PTS after each loop
+    double firstPts_ = -1.0;
+    double lastPts_ = 0.0;
+
     // File path for video
     std::string filePath_;
 
@@ -156,10 +223,16 @@ private:
     WGPURenderPipeline pipeline_ = nullptr;
     WGPUBindGroup bindGroup_ = nullptr;
     WGPUBuffer uniformBuffer_ = nullptr;
-    WGPUTexture texture_ = nullptr;
-    WGPUTextureView textureView_ = nullptr;
+    static constexpr int MAX_PLANES = 3;
+    WGPUTexture textures_[MAX_PLANES] = {};          // RGBA, or Y/U/V (R8)
+    WGPUTextureView textureViews_[MAX_PLANES] = {};
     WGPUSampler sampler_ = nullptr;
 
+    // YUV -> RGB affine transform, one row per output channel:
+    // rgb[i] = dot(rows[i].xyz, yuv) + rows[i].w
+    float colorRows_[3][4] = {};
+    static constexpr uint64_t UNIFORM_SIZE = 64;  // rect + 3 color rows
+
     bool gpuInitialized_ = false;
     bool failed_ = false;
 
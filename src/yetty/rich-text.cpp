@@ -1,4 +1,5 @@
 #include <yetty/rich-text.h>
+#include <yetty/text-layout-cache.h>
 #include <yetty/webgpu-context.h>
 #include <yetty/wgpu-compat.h>
 #include <ytrace/ytrace.hpp>
@@ -163,10 +164,13 @@ void RichText::dispose() noexcept {
     if (sampler_) { wgpuSamplerRelease(sampler_); sampler_ = nullptr; }
 
     fontBatches_.clear();
+    instances_.clear();
+    uploaded_.clear();
     chars_.clear();
     spans_.clear();
     glyphCount_ = 0;
     glyphBufferCapacity_ = 0;
+    uniformsValid_ = false;
     initialized_ = false;
     gpuResourcesDirty_ = true;
 }
@@ -239,6 +243,7 @@ void RichText::clear() {
     spans_.clear();
     chars_.clear();
     fontBatches_.clear();
+    instances_.clear();
     contentHeight_ = 0;
     contentWidth_ = 0;
     glyphCount_ = 0;
@@ -345,53 +350,66 @@ void RichText::layoutSpans(float viewWidth, float viewHeight) {
         float cursorX = span.x;
         float cursorY = span.y;
 
+        // Decode once, then measure word by word through the shared cache
+        std::u32string text;
+        text.reserve(span.text.size());
         const uint8_t* ptr = reinterpret_cast<const uint8_t*>(span.text.data());
         const uint8_t* end = ptr + span.text.size();
-
         while (ptr < end) {
             uint32_t codepoint = decodeUTF8(ptr, end);
-            if (codepoint == 0) continue;
+            if (codepoint != 0 && codepoint != '\r') text.push_back(codepoint);
+        }
 
+        size_t pos = 0;
+        while (pos < text.size()) {
             // Handle newlines
-            if (codepoint == '\n') {
+            if (text[pos] == '\n') {
                 cursorX = startX;
                 cursorY += lineHeight;
+                pos++;
                 continue;
             }
-            if (codepoint == '\r') continue;
-
-            // Get glyph metrics with style
-            const auto* metrics = font->getGlyph(codepoint, span.style);
-            if (!metrics) continue;
 
-            float advance = metrics->_advance * scale;
-
-            // Word wrap check
-            if (span.wrap && cursorX + advance > startX + maxWidth && cursorX > startX) {
-                cursorX = startX;
-                cursorY += lineHeight;
+            // A word and the spaces after it
+            size_t wordEnd = pos;
+            while (wordEnd < text.size() && text[wordEnd] != ' ' && text[wordEnd] != '\n') wordEnd++;
+            while (wordEnd < text.size() && text[wordEnd] == ' ') wordEnd++;
+            std::u32string_view word(text.data() + pos, wordEnd - pos);
+            auto run = TextLayoutCache::shared().shape(font, span.style, span.size, word);
+
+            for (size_t i = 0; i < word.size(); ++i) {
+                float advance = run->advances[i];
+                if (advance < 0.0f) continue;
+
+                // Word wrap check
+                if (span.wrap && cursorX + advance > startX + maxWidth && cursorX > startX) {
+                    cursorX = startX;
+                    cursorY += lineHeight;
+                }
+
+                // Add character with font family for later rendering
+                TextChar ch;
+                ch.codepoint = word[i];
+                ch.x = cursorX;
+                ch.y = cursorY;
+                ch.size = span.size;
+                ch.color = span.color;
+                ch.style = span.style;
+                ch.fontFamily = span.fontFamily;
+                chars_.push_back(ch);
+
+                cursorX += advance;
+                contentWidth_ = std::max(contentWidth_, cursorX);
             }
-
-            // Add character with font family for later rendering
-            TextChar ch;
-            ch.codepoint = codepoint;
-            ch.x = cursorX;
-            ch.y = cursorY;
-            ch.size = span.size;
-            ch.color = span.color;
-            ch.style = span.style;
-            ch.fontFamily = span.fontFamily;
-            chars_.push_back(ch);
-
-            cursorX += advance;
-            contentWidth_ = std::max(contentWidth_, cursorX);
+            pos = wordEnd;
         }
 
         contentHeight_ = std::max(contentHeight_, cursorY + lineHeight);
     }
 
-    ydebug("RichText::layoutSpans: produced {} chars, content {}x{}",
-                  chars_.size(), contentWidth_, contentHeight_);
+    ydebug("RichText::layoutSpans: produced {} chars, content {}x{}, run cache hit rate {:.2f}",
+                  chars_.size(), contentWidth_, contentHeight_,
+                  TextLayoutCache::shared().hitRate());
 }
 
 //-----------------------------------------------------------------------------
@@ -429,10 +447,12 @@ void RichText::buildGlyphInstances() {
     ydebug("RichText::buildGlyphInstances: processing {} chars", chars_.size());
 
     fontBatches_.clear();
+    instances_.clear();
     glyphCount_ = 0;
 
     // Map from Font* to batch index for grouping
     std::map<Font*, size_t> fontToBatch;
+    std::vector<std::vector<std::pair<float, GlyphInstance>>> batchGlyphs;  // (line y, glyph)
     int skippedNoFont = 0;
     int skippedNoGlyph = 0;
 
@@ -515,19 +535,38 @@ void RichText::buildGlyphInstances() {
             FontGlyphBatch batch;
             batch.font = font;
             fontBatches_.push_back(batch);
+            batchGlyphs.emplace_back();
             it = fontToBatch.find(font);
         }
 
-        fontBatches_[it->second].glyphs.push_back(inst);
+        batchGlyphs[it->second].emplace_back(ch.y, inst);
         glyphCount_++;
     }
 
+    // Lay the batches out back to back in one instance array, each sorted
+    // by line (chars carry their line's baseline, or top when prepositioned)
+    instances_.reserve(glyphCount_);
+    for (size_t i = 0; i < fontBatches_.size(); ++i) {
+        auto& glyphs = batchGlyphs[i];
+        std::stable_sort(glyphs.begin(), glyphs.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        auto& batch = fontBatches_[i];
+        batch.firstInstance = static_cast<uint32_t>(instances_.size());
+        batch.instanceCount = static_cast<uint32_t>(glyphs.size());
+        batch.lines.clear();
+        for (const auto& [lineY, inst] : glyphs) {
+            batch.lines.add(lineY, inst.posY, inst.posY + inst.sizeY);
+            instances_.push_back(inst);
+        }
+    }
+
     yinfo("RichText::buildGlyphInstances: {} glyphs in {} batches (skipped: {} no font, {} no glyph)",
                   glyphCount_, fontBatches_.size(), skippedNoFont, skippedNoGlyph);
 
     // Debug: print first few glyphs
-    if (!fontBatches_.empty() && !fontBatches_[0].glyphs.empty()) {
-        const auto& g = fontBatches_[0].glyphs[0];
+    if (!instances_.empty()) {
+        const auto& g = instances_[0];
         yinfo("First glyph: pos=({:.1f},{:.1f}) uv=({:.4f},{:.4f})-({:.4f},{:.4f}) size=({:.1f},{:.1f}) color=({:.1f},{:.1f},{:.1f},{:.1f})",
               g.posX, g.posY, g.uvMinX, g.uvMinY, g.uvMaxX, g.uvMaxY, g.sizeX, g.sizeY, g.colorR, g.colorG, g.colorB, g.colorA);
     }
@@ -590,7 +629,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
     wgslDesc.code = WGPU_STR(RICH_TEXT_SHADER);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
     // Create bind group layout
@@ -616,7 +655,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
     WGPUBindGroupLayoutDescriptor layoutDesc = {};
     layoutDesc.entryCount = 4;
     layoutDesc.entries = entries;
-    bindGroupLayout_ = wgpuDeviceCreateBindGroupLayout(device, &layoutDesc);
+    bindGroupLayout_ = ctx.shaderCache().createBindGroupLayout(&layoutDesc);
     if (!bindGroupLayout_) {
         wgpuShaderModuleRelease(shaderModule);
         return Err<void>("Failed to create bind group layout");
@@ -626,7 +665,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
     WGPUPipelineLayoutDescriptor pipelineLayoutDesc = {};
     pipelineLayoutDesc.bindGroupLayoutCount = 1;
     pipelineLayoutDesc.bindGroupLayouts = &bindGroupLayout_;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &pipelineLayoutDesc);
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&pipelineLayoutDesc);
 
     // Create render pipeline
     WGPUBlendState blend = {};
@@ -657,7 +696,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = 0xFFFFFFFF;
 
-    pipeline_ = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    pipeline_ = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuPipelineLayoutRelease(pipelineLayout);
     wgpuShaderModuleRelease(shaderModule);
@@ -679,7 +718,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
         bgWgslDesc.code = WGPU_STR(BG_SHADER);
         WGPUShaderModuleDescriptor bgShaderDesc = {};
         bgShaderDesc.nextInChain = &bgWgslDesc.chain;
-        WGPUShaderModule bgShaderModule = wgpuDeviceCreateShaderModule(device, &bgShaderDesc);
+        WGPUShaderModule bgShaderModule = ctx.shaderCache().createShaderModule(&bgShaderDesc);
         if (!bgShaderModule) return Err<void>("Failed to create bg shader module");
 
         // Background bind group layout
@@ -691,7 +730,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
         WGPUBindGroupLayoutDescriptor bgLayoutDesc = {};
         bgLayoutDesc.entryCount = 1;
         bgLayoutDesc.entries = &bgEntry;
-        WGPUBindGroupLayout bgBindGroupLayout = wgpuDeviceCreateBindGroupLayout(device, &bgLayoutDesc);
+        WGPUBindGroupLayout bgBindGroupLayout = ctx.shaderCache().createBindGroupLayout(&bgLayoutDesc);
 
         // Background bind group
         WGPUBindGroupEntry bgBindEntry = {};
@@ -709,7 +748,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
         WGPUPipelineLayoutDescriptor bgPipelineLayoutDesc = {};
         bgPipelineLayoutDesc.bindGroupLayoutCount = 1;
         bgPipelineLayoutDesc.bindGroupLayouts = &bgBindGroupLayout;
-        WGPUPipelineLayout bgPipelineLayout = wgpuDeviceCreatePipelineLayout(device, &bgPipelineLayoutDesc);
+        WGPUPipelineLayout bgPipelineLayout = ctx.shaderCache().createPipelineLayout(&bgPipelineLayoutDesc);
 
         // Background render pipeline (no blending, just overwrite)
         WGPUColorTargetState bgColorTarget = {};
@@ -731,7 +770,7 @@ Result<void> RichText::createPipeline(WebGPUContext& ctx, WGPUTextureFormat targ
         bgPipelineDesc.multisample.count = 1;
         bgPipelineDesc.multisample.mask = 0xFFFFFFFF;
 
-        bgPipeline_ = wgpuDeviceCreateRenderPipeline(device, &bgPipelineDesc);
+        bgPipeline_ = ctx.shaderCache().createRenderPipeline(&bgPipelineDesc);
 
         wgpuBindGroupLayoutRelease(bgBindGroupLayout);
         wgpuPipelineLayoutRelease(bgPipelineLayout);
@@ -804,8 +843,62 @@ Result<void> RichText::createBindGroup(WebGPUContext& ctx, Font* font) {
 }
 
 Result<void> RichText::uploadGlyphBuffer(WebGPUContext& ctx) {
-    (void)ctx;
-    // This function is no longer used - glyph data is uploaded per-batch in render()
+    WGPUDevice device = ctx.getDevice();
+    size_t count = instances_.size();
+
+    // Grow: new buffer, everything is uploaded
+    if (count > glyphBufferCapacity_ || !glyphBuffer_) {
+        if (glyphBuffer_) {
+            wgpuBufferRelease(glyphBuffer_);
+        }
+        glyphBufferCapacity_ = std::max(static_cast<uint32_t>(count), glyphBufferCapacity_ * 2);
+        if (glyphBufferCapacity_ < 256) glyphBufferCapacity_ = 256;
+
+        WGPUBufferDescriptor bufDesc = {};
+        bufDesc.size = glyphBufferCapacity_ * sizeof(GlyphInstance);
+        bufDesc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+        glyphBuffer_ = device ? wgpuDeviceCreateBuffer(device, &bufDesc) : nullptr;
+        if (!glyphBuffer_) return Err<void>("RichText: failed to create glyph buffer");
+
+        // Invalidate cached bind groups since buffer changed
+        for (auto& [font, bindGroup] : fontBindGroups_) {
+            if (bindGroup) wgpuBindGroupRelease(bindGroup);
+        }
+        fontBindGroups_.clear();
+        fontResourceVersions_.clear();
+        uploaded_.clear();
+    }
+
+    // Write only the runs that differ from what the buffer already holds
+    auto same = [&](size_t i) {
+        return i < uploaded_.size() &&
+               std::memcmp(&instances_[i], &uploaded_[i], sizeof(GlyphInstance)) == 0;
+    };
+
+    size_t writes = 0;
+    size_t i = 0;
+    while (i < count) {
+        if (same(i)) {
+            ++i;
+            continue;
+        }
+        size_t end = i + 1;
+        for (size_t j = i + 1; j < count && j - end < UPLOAD_MERGE_GAP; ++j) {
+            if (!same(j)) end = j + 1;
+        }
+        size_t bytes = (end - i) * sizeof(GlyphInstance);
+        wgpuQueueWriteBuffer(ctx.getQueue(), glyphBuffer_, i * sizeof(GlyphInstance),
+                             instances_.data() + i, bytes);
+        uploadedBytes_ += bytes;
+        writes++;
+        i = end;
+    }
+
+    ydebug("RichText::uploadGlyphBuffer: {} instances, {} writes", count, writes);
+
+    // instances_ now mirrors the buffer; the next layout rebuilds it
+    std::swap(instances_, uploaded_);
+    instances_.clear();
     return Ok();
 }
 
@@ -828,34 +921,12 @@ Result<void> RichText::render(WGPURenderPassEncoder pass, WebGPUContext& ctx,
         return Ok();  // Nothing to render
     }
 
-    WGPUDevice device = ctx.getDevice();
-
-    // Find max batch size for glyph buffer allocation
-    size_t maxBatchSize = 0;
-    for (const auto& batch : fontBatches_) {
-        maxBatchSize = std::max(maxBatchSize, batch.glyphs.size());
-    }
-
-    // Ensure glyph buffer is large enough for any batch
-    if (maxBatchSize > glyphBufferCapacity_) {
-        if (glyphBuffer_) {
-            wgpuBufferRelease(glyphBuffer_);
+    // Only after a layout: write the instances that changed
+    if (gpuResourcesDirty_) {
+        if (auto res = uploadGlyphBuffer(ctx); !res) {
+            return res;
         }
-        glyphBufferCapacity_ = std::max(static_cast<uint32_t>(maxBatchSize), glyphBufferCapacity_ * 2);
-        if (glyphBufferCapacity_ < 256) glyphBufferCapacity_ = 256;
-
-        WGPUBufferDescriptor bufDesc = {};
-        bufDesc.size = glyphBufferCapacity_ * sizeof(GlyphInstance);
-        bufDesc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
-        glyphBuffer_ = device ? wgpuDeviceCreateBuffer(device, &bufDesc) : nullptr;
-        if (!glyphBuffer_) return Err<void>("RichText: failed to create glyph buffer");
-
-        // Invalidate cached bind groups since buffer changed
-        for (auto& [font, bindGroup] : fontBindGroups_) {
-            if (bindGroup) wgpuBindGroupRelease(bindGroup);
-        }
-        fontBindGroups_.clear();
-        fontResourceVersions_.clear();
+        gpuResourcesDirty_ = false;
     }
 
     // Update uniforms
@@ -868,7 +939,8 @@ Result<void> RichText::render(WGPURenderPassEncoder pass, WebGPUContext& ctx,
         float scrollOffset;
         float pixelRange;
         float _pad[4];
-    } uniforms;
+    } uniforms = {};
+    static_assert(sizeof(Uniforms) == sizeof(lastUniforms_));
 
     uniforms.rect[0] = ndcX;
     uniforms.rect[1] = ndcY;
@@ -879,10 +951,14 @@ Result<void> RichText::render(WGPURenderPassEncoder pass, WebGPUContext& ctx,
     uniforms.scrollOffset = scrollOffset_;
     uniforms.pixelRange = pixelRange_;
 
-    yinfo("RichText::render uniforms: ndc=({:.3f},{:.3f}) size=({:.0f},{:.0f}) screen={}x{} scroll={:.1f} pixelRange={:.1f}",
-          ndcX, ndcY, pixelW, pixelH, screenWidth, screenHeight, scrollOffset_, pixelRange_);
-
-    wgpuQueueWriteBuffer(ctx.getQueue(), uniformBuffer_, 0, &uniforms, sizeof(uniforms));
+    // Scrolling and moving change only this
+    if (!uniformsValid_ || std::memcmp(lastUniforms_.data(), &uniforms, sizeof(uniforms)) != 0) {
+        ydebug("RichText::render uniforms: ndc=({:.3f},{:.3f}) size=({:.0f},{:.0f}) screen={}x{} scroll={:.1f}",
+               ndcX, ndcY, pixelW, pixelH, screenWidth, screenHeight, scrollOffset_);
+        wgpuQueueWriteBuffer(ctx.getQueue(), uniformBuffer_, 0, &uniforms, sizeof(uniforms));
+        std::memcpy(lastUniforms_.data(), &uniforms, sizeof(uniforms));
+        uniformsValid_ = true;
+    }
 
     // Set scissor rect to clip content to bounds (clamped to screen)
     float sx = std::max(0.0f, pixelX);
@@ -926,18 +1002,13 @@ Result<void> RichText::render(WGPURenderPassEncoder pass, WebGPUContext& ctx,
 
     wgpuRenderPassEncoderSetPipeline(pass, pipeline_);
 
-    yinfo("RichText::render: rendering {} batches, {} total glyphs, glyphBuffer={}, uniformBuffer={}",
-          fontBatches_.size(), glyphCount_, glyphBuffer_ != nullptr, uniformBuffer_ != nullptr);
-
-    // Render each font batch
+    // Each font batch draws the lines of its range that intersect the view
+    drawnGlyphCount_ = 0;
     for (const auto& batch : fontBatches_) {
-        if (batch.glyphs.empty() || !batch.font) {
-            ywarn("RichText::render: skipping batch - empty={}, font={}", batch.glyphs.empty(), batch.font != nullptr);
-            continue;
-        }
+        if (batch.instanceCount == 0 || !batch.font) continue;
 
-        yinfo("RichText::render: batch has {} glyphs, font textureView={}",
-              batch.glyphs.size(), batch.font->getTextureView() != nullptr);
+        auto [first, last] = batch.lines.visible(scrollOffset_, scrollOffset_ + pixelH);
+        if (first >= last) continue;
 
         // Ensure bind group exists for this font
         auto result = createBindGroup(ctx, batch.font);
@@ -952,18 +1023,11 @@ Result<void> RichText::render(WGPURenderPassEncoder pass, WebGPUContext& ctx,
             continue;
         }
 
-        // Upload this batch's glyphs
-        wgpuQueueWriteBuffer(ctx.getQueue(), glyphBuffer_, 0,
-                             batch.glyphs.data(), batch.glyphs.size() * sizeof(GlyphInstance));
-
-        yinfo("RichText::render: drawing {} instances", batch.glyphs.size());
-
-        // Draw with this font's bind group
         wgpuRenderPassEncoderSetBindGroup(pass, 0, it->second, 0, nullptr);
-        wgpuRenderPassEncoderDraw(pass, 6, static_cast<uint32_t>(batch.glyphs.size()), 0, 0);
+        wgpuRenderPassEncoderDraw(pass, 6, last - first, 0, batch.firstInstance + first);
+        drawnGlyphCount_ += last - first;
     }
 
-    gpuResourcesDirty_ = false;
     return Ok();
 }
 
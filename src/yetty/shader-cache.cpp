@@ -0,0 +1,325 @@
+#include <yetty/shader-cache.h>
+#include <yetty/wgpu-compat.h>
+#include <ytrace/ytrace.hpp>
+#include <string_view>
+
+namespace yetty {
+
+namespace {
+
+// Key helpers, only the new API descriptors are cached
+#if !WGPU_USE_OLD_API
+template <typename T>
+void put(std::string& key, const T& v) {
+    key.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+void putU32(std::string& key, uint32_t v) { put(key, v); }
+
+std::string_view viewOf(WGPUStringView s) {
+    if (!s.data) return {};
+    return s.length == WGPU_STRLEN ? std::string_view(s.data) : std::string_view(s.data, s.length);
+}
+
+void putStr(std::string& key, WGPUStringView s) {
+    std::string_view v = viewOf(s);
+    put(key, v.size());
+    key.append(v);
+}
+
+// WGSL source of a module descriptor, false for anything else in the chain
+bool wgslOf(const WGPUShaderModuleDescriptor* desc, std::string_view& code) {
+    const WGPUChainedStruct* chain = desc->nextInChain;
+    if (!chain || chain->next || chain->sType != WGPUSType_ShaderSourceWGSL) return false;
+    code = viewOf(reinterpret_cast<const WGPUShaderSourceWGSL*>(chain)->code);
+    return !code.empty();
+}
+
+template <typename Map, typename T>
+bool idOf(const Map& ids, T handle, uint64_t& id) {
+    auto it = ids.find(handle);
+    if (it == ids.end()) return false;
+    id = it->second;
+    return true;
+}
+#endif
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// Lifetime
+//-----------------------------------------------------------------------------
+
+ShaderCache::ShaderCache(WGPUDevice device)
+    : _device(device) {}
+
+ShaderCache::~ShaderCache() {
+    clear();
+}
+
+void ShaderCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Pipelines first, they hold on to their layouts and modules
+    _pipelines.cache.clear();
+    _pipelineLayouts.cache.clear();
+    _bindGroupLayouts.cache.clear();
+    _modules.cache.clear();
+    _pipelineIds.clear();
+    _pipelineLayoutIds.clear();
+    _bindGroupLayoutIds.clear();
+    _moduleIds.clear();
+}
+
+ShaderCache::Stats ShaderCache::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats s;
+    s.hits = _hits;
+    s.misses = _misses;
+    s.uncached = _uncached;
+    s.shaderModules = _modules.cache.size();
+    s.pipelines = _pipelines.cache.size();
+    return s;
+}
+
+#if WGPU_USE_OLD_API
+
+// The Emscripten API spells the descriptors differently; no caching there
+WGPUShaderModule ShaderCache::createShaderModule(const WGPUShaderModuleDescriptor* desc) {
+    return wgpuDeviceCreateShaderModule(_device, desc);
+}
+
+WGPUBindGroupLayout ShaderCache::createBindGroupLayout(const WGPUBindGroupLayoutDescriptor* desc) {
+    return wgpuDeviceCreateBindGroupLayout(_device, desc);
+}
+
+WGPUPipelineLayout ShaderCache::createPipelineLayout(const WGPUPipelineLayoutDescriptor* desc) {
+    return wgpuDeviceCreatePipelineLayout(_device, desc);
+}
+
+WGPURenderPipeline ShaderCache::createRenderPipeline(const WGPURenderPipelineDescriptor* desc) {
+    return wgpuDeviceCreateRenderPipeline(_device, desc);
+}
+
+bool ShaderCache::renderPipelineKey(const WGPURenderPipelineDescriptor*, std::string&) const {
+    return false;
+}
+
+#else
+
+//-----------------------------------------------------------------------------
+// Shader modules
+//-----------------------------------------------------------------------------
+
+WGPUShaderModule ShaderCache::createShaderModule(const WGPUShaderModuleDescriptor* desc) {
+    std::string_view code;
+    if (!wgslOf(desc, code)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _uncached++;
+        return wgpuDeviceCreateShaderModule(_device, desc);
+    }
+
+    std::string key(code);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto* e = _modules.cache.get(key)) {
+        _hits++;
+        wgpuShaderModuleAddRef(e->handle.get());
+        return e->handle.get();
+    }
+
+    _misses++;
+    WGPUShaderModule module = wgpuDeviceCreateShaderModule(_device, desc);
+    if (!module) return nullptr;
+
+    uint64_t id = _nextId++;
+    _moduleIds[module] = id;
+    _modules.cache.put(key, {Ref<WGPUShaderModule, wgpuShaderModuleRelease>(module), id}, 1);
+    ydebug("ShaderCache: compiled module #{} ({} bytes)", id, code.size());
+
+    wgpuShaderModuleAddRef(module);
+    return module;
+}
+
+//-----------------------------------------------------------------------------
+// Layouts
+//-----------------------------------------------------------------------------
+
+WGPUBindGroupLayout ShaderCache::createBindGroupLayout(const WGPUBindGroupLayoutDescriptor* desc) {
+    bool cacheable = !desc->nextInChain;
+    std::string key;
+    for (size_t i = 0; cacheable && i < desc->entryCount; i++) {
+        const WGPUBindGroupLayoutEntry& e = desc->entries[i];
+        if (e.nextInChain) {
+            cacheable = false;
+            break;
+        }
+        putU32(key, e.binding);
+        put(key, static_cast<uint64_t>(e.visibility));
+        putU32(key, static_cast<uint32_t>(e.buffer.type));
+        putU32(key, static_cast<uint32_t>(e.buffer.hasDynamicOffset));
+        put(key, static_cast<uint64_t>(e.buffer.minBindingSize));
+        putU32(key, static_cast<uint32_t>(e.sampler.type));
+        putU32(key, static_cast<uint32_t>(e.texture.sampleType));
+        putU32(key, static_cast<uint32_t>(e.texture.viewDimension));
+        putU32(key, static_cast<uint32_t>(e.texture.multisampled));
+        putU32(key, static_cast<uint32_t>(e.storageTexture.access));
+        putU32(key, static_cast<uint32_t>(e.storageTexture.format));
+        putU32(key, static_cast<uint32_t>(e.storageTexture.viewDimension));
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!cacheable) {
+        _uncached++;
+        return wgpuDeviceCreateBindGroupLayout(_device, desc);
+    }
+    if (auto* e = _bindGroupLayouts.cache.get(key)) {
+        _hits++;
+        wgpuBindGroupLayoutAddRef(e->handle.get());
+        return e->handle.get();
+    }
+
+    _misses++;
+    WGPUBindGroupLayout layout = wgpuDeviceCreateBindGroupLayout(_device, desc);
+    if (!layout) return nullptr;
+
+    uint64_t id = _nextId++;
+    _bindGroupLayoutIds[layout] = id;
+    _bindGroupLayouts.cache.put(key, {Ref<WGPUBindGroupLayout, wgpuBindGroupLayoutRelease>(layout), id}, 1);
+    wgpuBindGroupLayoutAddRef(layout);
+    return layout;
+}
+
+WGPUPipelineLayout ShaderCache::createPipelineLayout(const WGPUPipelineLayoutDescriptor* desc) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    bool cacheable = !desc->nextInChain;
+    std::string key;
+    for (size_t i = 0; cacheable && i < desc->bindGroupLayoutCount; i++) {
+        uint64_t id = 0;
+        cacheable = idOf(_bindGroupLayoutIds, desc->bindGroupLayouts[i], id);
+        put(key, id);
+    }
+
+    if (!cacheable) {
+        _uncached++;
+        return wgpuDeviceCreatePipelineLayout(_device, desc);
+    }
+    if (auto* e = _pipelineLayouts.cache.get(key)) {
+        _hits++;
+        wgpuPipelineLayoutAddRef(e->handle.get());
+        return e->handle.get();
+    }
+
+    _misses++;
+    WGPUPipelineLayout layout = wgpuDeviceCreatePipelineLayout(_device, desc);
+    if (!layout) return nullptr;
+
+    uint64_t id = _nextId++;
+    _pipelineLayoutIds[layout] = id;
+    _pipelineLayouts.cache.put(key, {Ref<WGPUPipelineLayout, wgpuPipelineLayoutRelease>(layout), id}, 1);
+    wgpuPipelineLayoutAddRef(layout);
+    return layout;
+}
+
+//-----------------------------------------------------------------------------
+// Render pipelines
+//-----------------------------------------------------------------------------
+
+// Caller holds _mutex
+bool ShaderCache::renderPipelineKey(const WGPURenderPipelineDescriptor* desc, std::string& key) const {
+    if (desc->nextInChain || desc->depthStencil) return false;
+
+    uint64_t id = 0;
+    // Auto layout (nullptr) is derived from the shaders, which are keyed below
+    if (desc->layout && !idOf(_pipelineLayoutIds, desc->layout, id)) return false;
+    put(key, id);
+
+    const WGPUVertexState& vs = desc->vertex;
+    if (vs.nextInChain || vs.constantCount || !idOf(_moduleIds, vs.module, id)) return false;
+    put(key, id);
+    putStr(key, vs.entryPoint);
+    put(key, vs.bufferCount);
+    for (size_t i = 0; i < vs.bufferCount; i++) {
+        const WGPUVertexBufferLayout& b = vs.buffers[i];
+        if (b.nextInChain) return false;
+        putU32(key, static_cast<uint32_t>(b.stepMode));
+        put(key, static_cast<uint64_t>(b.arrayStride));
+        put(key, b.attributeCount);
+        for (size_t a = 0; a < b.attributeCount; a++) {
+            const WGPUVertexAttribute& attr = b.attributes[a];
+            if (attr.nextInChain) return false;
+            putU32(key, static_cast<uint32_t>(attr.format));
+            put(key, static_cast<uint64_t>(attr.offset));
+            putU32(key, attr.shaderLocation);
+        }
+    }
+
+    const WGPUPrimitiveState& prim = desc->primitive;
+    if (prim.nextInChain) return false;
+    putU32(key, static_cast<uint32_t>(prim.topology));
+    putU32(key, static_cast<uint32_t>(prim.stripIndexFormat));
+    putU32(key, static_cast<uint32_t>(prim.frontFace));
+    putU32(key, static_cast<uint32_t>(prim.cullMode));
+    putU32(key, static_cast<uint32_t>(prim.unclippedDepth));
+
+    const WGPUMultisampleState& ms = desc->multisample;
+    if (ms.nextInChain) return false;
+    putU32(key, ms.count);
+    putU32(key, ms.mask);
+    putU32(key, static_cast<uint32_t>(ms.alphaToCoverageEnabled));
+
+    const WGPUFragmentState* fs = desc->fragment;
+    putU32(key, fs ? 1 : 0);
+    if (!fs) return true;
+    if (fs->nextInChain || fs->constantCount || !idOf(_moduleIds, fs->module, id)) return false;
+    put(key, id);
+    putStr(key, fs->entryPoint);
+    put(key, fs->targetCount);
+    for (size_t i = 0; i < fs->targetCount; i++) {
+        const WGPUColorTargetState& t = fs->targets[i];
+        if (t.nextInChain) return false;
+        putU32(key, static_cast<uint32_t>(t.format));
+        put(key, static_cast<uint64_t>(t.writeMask));
+        putU32(key, t.blend ? 1 : 0);
+        if (t.blend) {
+            for (const WGPUBlendComponent* c : {&t.blend->color, &t.blend->alpha}) {
+                putU32(key, static_cast<uint32_t>(c->operation));
+                putU32(key, static_cast<uint32_t>(c->srcFactor));
+                putU32(key, static_cast<uint32_t>(c->dstFactor));
+            }
+        }
+    }
+    return true;
+}
+
+WGPURenderPipeline ShaderCache::createRenderPipeline(const WGPURenderPipelineDescriptor* desc) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::string key;
+    if (!renderPipelineKey(desc, key)) {
+        _uncached++;
+        return wgpuDeviceCreateRenderPipeline(_device, desc);
+    }
+    if (auto* e = _pipelines.cache.get(key)) {
+        _hits++;
+        wgpuRenderPipelineAddRef(e->handle.get());
+        return e->handle.get();
+    }
+
+    // Creation can take a while on some drivers, but doing it under the lock
+    // keeps two widgets from building the same pipeline at once
+    _misses++;
+    WGPURenderPipeline pipeline = wgpuDeviceCreateRenderPipeline(_device, desc);
+    if (!pipeline) return nullptr;
+
+    uint64_t id = _nextId++;
+    _pipelineIds[pipeline] = id;
+    _pipelines.cache.put(key, {Ref<WGPURenderPipeline, wgpuRenderPipelineRelease>(pipeline), id}, 1);
+    ydebug("ShaderCache: built pipeline #{} ({} cached)", id, _pipelines.cache.size());
+
+    wgpuRenderPipelineAddRef(pipeline);
+    return pipeline;
+}
+
+#endif // WGPU_USE_OLD_API
+
+} // namespace yetty
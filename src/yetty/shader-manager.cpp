@@ -1,4 +1,5 @@
 #include <yetty/shader-manager.h>
+#include <yetty/shader-cache.h>
 #include <yetty/wgpu-compat.h>
 #include <ytrace/ytrace.hpp>
 #include <fstream>
@@ -12,12 +13,14 @@ ShaderManager::~ShaderManager() {
     dispose();
 }
 
-Result<void> ShaderManager::init(WGPUDevice device, const std::string& shaderPath) {
+Result<void> ShaderManager::init(WGPUDevice device, const std::string& shaderPath,
+                                 ShaderCache* cache) {
     if (!device) {
         return Err<void>("ShaderManager::init: null device");
     }
 
     _device = device;
+    _cache = cache;
     _shaderPath = shaderPath;
 
     // Ensure path ends with separator
@@ -72,6 +75,7 @@ void ShaderManager::dispose() {
     }
 
     _device = nullptr;
+    _cache = nullptr;
 }
 
 Result<void> ShaderManager::createGlobalUniformBuffer() {
@@ -93,7 +97,8 @@ Result<void> ShaderManager::createGlobalUniformBuffer() {
     WGPUBindGroupLayoutDescriptor bglDesc = {};
     bglDesc.entryCount = 1;
     bglDesc.entries = &entry;
-    _globalBindGroupLayout = wgpuDeviceCreateBindGroupLayout(_device, &bglDesc);
+    _globalBindGroupLayout = _cache ? _cache->createBindGroupLayout(&bglDesc)
+                                    : wgpuDeviceCreateBindGroupLayout(_device, &bglDesc);
     if (!_globalBindGroupLayout) {
         return Err<void>("Failed to create global bind group layout");
     }
@@ -196,7 +201,7 @@ fn vs_main(@builtin(vertex_index) vertexIndex: u32) -> VertexOutput {
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
 
-    _quadVertexShader = wgpuDeviceCreateShaderModule(_device, &shaderDesc);
+    _quadVertexShader = compile(&shaderDesc);
     if (!_quadVertexShader) {
         return Err<void>("Failed to compile quad vertex shader");
     }
@@ -297,7 +302,7 @@ fn fs_entry(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
 
-    WGPUShaderModule module = wgpuDeviceCreateShaderModule(_device, &shaderDesc);
+    WGPUShaderModule module = compile(&shaderDesc);
     if (!module) {
         return Err<WGPUShaderModule>("Failed to compile shader: " + filename);
     }
@@ -306,4 +311,8 @@ fn fs_entry(@location(0) uv: vec2<f32>) -> @location(0) vec4<f32> {
     return Ok(module);
 }
 
+WGPUShaderModule ShaderManager::compile(const WGPUShaderModuleDescriptor* desc) {
+    return _cache ? _cache->createShaderModule(desc) : wgpuDeviceCreateShaderModule(_device, desc);
+}
+
 } // namespace yetty
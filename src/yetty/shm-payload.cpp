@@ -0,0 +1,187 @@
+#include <yetty/shm-payload.h>
+#include <ytrace/ytrace.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#define YETTY_HAS_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define YETTY_HAS_SHM 0
+#endif
+
+namespace yetty {
+
+namespace {
+thread_local ShmPayload::Ptr tlsCurrent;
+} // namespace
+
+uint32_t ShmPayload::crc32(const void* data, size_t size) noexcept {
+    static const auto table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool ShmPayload::isValidToken(const std::string& token) noexcept {
+    if (token.empty() || token.size() > 64) return false;
+    for (char c : token) {
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                  (c >= '0' && c <= '9') || c == '-' || c == '_';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+ShmPayload::~ShmPayload() {
+#if YETTY_HAS_SHM
+    if (_mapped && _addr) {
+        munmap(_addr, _size);
+        _addr = nullptr;
+    }
+#endif
+}
+
+Result<ShmPayload::Ptr> ShmPayload::open(const ShmPayloadRef& ref) noexcept {
+#if YETTY_HAS_SHM
+    if (!isValidToken(ref.token)) {
+        return Err<Ptr>("shm: invalid token");
+    }
+    if (ref.size == 0) {
+        return Err<Ptr>("shm: zero payload size");
+    }
+
+    const std::string objName = "yetty-" + ref.token;
+    int fd = -1;
+
+    if (ref.isMemfd()) {
+#ifdef __linux__
+        // The client keeps the memfd open; reach it through procfs and make
+        // sure it really is the memfd this token was issued for
+        std::string procPath = "/proc/" + std::to_string(ref.pid) + "/fd/" + std::to_string(ref.fd);
+        char target[256] = {};
+        ssize_t n = readlink(procPath.c_str(), target, sizeof(target) - 1);
+        if (n <= 0) {
+            return Err<Ptr>("shm: cannot resolve memfd " + procPath + ": " + strerror(errno));
+        }
+        std::string_view link(target, static_cast<size_t>(n));
+        std::string expected = "/memfd:" + objName;
+        if (link != expected && link != expected + " (deleted)") {
+            return Err<Ptr>("shm: memfd name does not match token");
+        }
+        fd = ::open(procPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return Err<Ptr>("shm: cannot open memfd: " + std::string(strerror(errno)));
+        }
+        // Mapped in place, so the client must not be able to resize it
+        // (SIGBUS) or rewrite it after the CRC check
+        constexpr int requiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+        int seals = fcntl(fd, F_GET_SEALS);
+        if (seals < 0 || (seals & requiredSeals) != requiredSeals) {
+            ::close(fd);
+            return Err<Ptr>("shm: memfd must be sealed against shrink, grow and write");
+        }
+#else
+        return Err<Ptr>("shm: memfd payloads are only supported on Linux");
+#endif
+    } else {
+        std::string shmName = "/" + objName;
+        fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return Err<Ptr>("shm: cannot open " + shmName + ": " + strerror(errno));
+        }
+        // One-shot: the name is gone as soon as we hold the descriptor
+        shm_unlink(shmName.c_str());
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return Err<Ptr>("shm: fstat failed: " + std::string(strerror(errno)));
+    }
+    if (st.st_uid != geteuid()) {
+        ::close(fd);
+        return Err<Ptr>("shm: object is owned by a different user");
+    }
+    if (static_cast<uint64_t>(st.st_size) < ref.size) {
+        ::close(fd);
+        return Err<Ptr>("shm: object smaller than advertised size");
+    }
+
+    size_t size = static_cast<size_t>(ref.size);
+    Ptr payload;
+    if (ref.isMemfd()) {
+        void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return Err<Ptr>("shm: mmap failed: " + std::string(strerror(errno)));
+        }
+        payload = Ptr(new ShmPayload(addr, size));
+    } else {
+        // The client may still hold a writable descriptor: take a private
+        // copy with pread, which reports a shrunk object as a short read
+        std::unique_ptr<uint8_t[]> copy(new (std::nothrow) uint8_t[size]);
+        if (!copy) {
+            ::close(fd);
+            return Err<Ptr>("shm: cannot allocate " + std::to_string(size) + " bytes");
+        }
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = pread(fd, copy.get() + done, size - done, static_cast<off_t>(done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                ::close(fd);
+                return Err<Ptr>("shm: short read of payload");
+            }
+            done += static_cast<size_t>(n);
+        }
+        ::close(fd);
+        payload = Ptr(new ShmPayload(std::move(copy), size));
+    }
+
+    if (crc32(payload->data(), payload->size()) != ref.crc) {
+        return Err<Ptr>("shm: payload checksum mismatch");
+    }
+
+    ydebug("ShmPayload: {} {} ({} bytes)", ref.isMemfd() ? "mapped" : "copied", objName, size);
+    return Ok(payload);
+#else
+    (void)ref;
+    return Err<Ptr>("shm: shared memory payloads are not supported on this platform");
+#endif
+}
+
+ShmPayload::Scope::Scope(Ptr payload) noexcept
+    : _prev(std::move(tlsCurrent)) {
+    tlsCurrent = std::move(payload);
+}
+
+ShmPayload::Scope::~Scope() {
+    tlsCurrent = std::move(_prev);
+}
+
+ShmPayload::Ptr ShmPayload::current() noexcept {
+    return tlsCurrent;
+}
+
+} // namespace yetty
@@ -315,64 +315,14 @@ void Terminal::stop() {
 
 void Terminal::prepareFrame(WebGPUContext& ctx, bool on) {
     (void)on;  // Terminal is always on when called
+    if (!_gpuScreen) return;
 
-    // Scan for widget markers when terminal has damage - markers scroll with content
-    if (_gpuScreen && !_childWidgets.empty()) {
-        bool hasDamage = _gpuScreen->hasDamage();
-        ydebug("prepareFrame: hasDamage={} childWidgets={}", hasDamage, _childWidgets.size());
-
-        if (hasDamage) {
-            auto positions = _gpuScreen->scanWidgetPositions();
-            ydebug("prepareFrame: scanWidgetPositions found {} positions", positions.size());
-
-            for (const auto& pos : positions) {
-                for (const auto& widget : _childWidgets) {
-                    if (static_cast<uint16_t>(widget->id()) == pos.widgetId) {
-                        if (widget->getX() != pos.col || widget->getY() != pos.row) {
-                            ydebug("prepareFrame: widget {} position updated ({},{}) -> ({},{})",
-                                   pos.widgetId, widget->getX(), widget->getY(), pos.col, pos.row);
-                            widget->setPosition(pos.col, pos.row);
-                        }
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    // Get current screen type for filtering
+    // Widgets scrolled out of view get on=false so they pause
     ScreenType currentScreen = _isAltScreen ? ScreenType::Alternate : ScreenType::Main;
-
-    // Compute and set pixel positions for child widgets
-    for (const auto& widget : _childWidgets) {
-        if (!widget->isVisible()) continue;
-        if (widget->getScreenType() != currentScreen) continue;
-
-        // Terminal computes pixel position from grid position
-        float pixelX = static_cast<float>(widget->getX()) * _cellWidth;
-        float pixelY = static_cast<float>(widget->getY()) * _cellHeight;
-
-        // Adjust for scroll offset if widget is relative
-        int scrollOff = getScrollOffset();
-        if (widget->getPositionMode() == PositionMode::Relative && scrollOff > 0) {
-            pixelY += scrollOff * _cellHeight;
-        }
-
-        // Compute pixel size from cell size
-        uint32_t pixelW = widget->getWidthCells() * _cellWidth;
-        uint32_t pixelH = widget->getHeightCells() * _cellHeight;
-
-        yinfo("Terminal::prepareFrame widget '{}' grid=({},{}) cellSize=({},{}) -> pixel=({},{}) size={}x{}",
-              widget->name(), widget->getX(), widget->getY(), _cellWidth, _cellHeight,
-              pixelX, pixelY, pixelW, pixelH);
-
-        // Set pixel position and size on widget
-        widget->setPixelPosition(pixelX, pixelY);
-        widget->setPixelSize(pixelW, pixelH);
-
-        // TODO: Calculate if widget is visible based on scroll position
-        bool widgetOn = true;
-
+    const auto& placed = _childLayout.place(*_gpuScreen, _childWidgets, currentScreen,
+                                            static_cast<float>(_cellWidth),
+                                            static_cast<float>(_cellHeight));
+    for (const auto& [widget, widgetOn] : placed) {
         // Call prepareFrame on child (for texture-based widgets)
         widget->prepareFrame(ctx, widgetOn);
     }
@@ -411,15 +361,9 @@ Result<void> Terminal::render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bo
     _gpuScreen->clearDamage();
     _fullDamage = false;
 
-    // Child widgets decide themselves if they need to render
-    ScreenType currentScreen = _isAltScreen ? ScreenType::Alternate : ScreenType::Main;
-    for (const auto& widget : _childWidgets) {
-        if (!widget->isVisible()) continue;
-        if (widget->getScreenType() != currentScreen) continue;
-
-        // TODO: Calculate if widget is visible based on scroll position
-        bool widgetOn = true;
-
+    // Child widgets decide themselves if they need to render; same rects
+    // and on flags as placed in prepareFrame
+    for (const auto& [widget, widgetOn] : _childLayout.placed()) {
         if (auto res = widget->render(pass, ctx, widgetOn); !res) {
             yerror("Terminal: widget '{}' render failed: {}", widget->name(), res.error().message());
         }
@@ -773,10 +717,9 @@ void Terminal::colorToRGB(const VTermColor& color, uint8_t& r, uint8_t& g, uint8
 
 void Terminal::updateWidgetPositionsOnScroll(int lines) {
     (void)lines;
-    // Widget marker tracking is handled by GPUScreen::pushLineToScrollback
-    // (scans row 0 for markers before pushing to scrollback)
-    // Widget positions are updated by prepareFrame via scanWidgetPositions
-    // which includes both visible buffer markers AND scrolledOutWidgets_
+    // Widget marker tracking is handled by GPUScreen: markers move with the
+    // moverect callbacks and pushLineToScrollback tracks the ones scrolled
+    // out. prepareFrame applies GPUScreen::widgetPositions() when they change.
 }
 
 //=============================================================================
@@ -912,6 +855,7 @@ int Terminal::onOSC(int command, VTermStringFragment frag, void* user) {
 void Terminal::addChildWidget(WidgetPtr widget) {
     if (!widget) return;
     _childWidgets.push_back(widget);
+    _childLayout.invalidate();  // Apply marker positions to it next frame
     // Sort by zOrder for correct render order
     std::sort(_childWidgets.begin(), _childWidgets.end(),
               [](const WidgetPtr& a, const WidgetPtr& b) {
@@ -955,6 +899,7 @@ Result<void> Terminal::removeChildWidget(uint32_t id) {
             if (auto res = (*it)->dispose(); !res) {
                 return Err<void>("Failed to dispose widget " + std::to_string(id), res);
             }
+            _childLayout.remove(id);
             _childWidgets.erase(it);
             return Ok();
         }
@@ -990,6 +935,7 @@ Result<void> Terminal::removeChildWidgetByHashId(const std::string& hashId) {
             if (auto res = (*vit)->dispose(); !res) {
                 return Err<void>("Failed to dispose widget", res);
             }
+            _childLayout.remove(widget->id());
             _childWidgets.erase(vit);
             break;
         }
@@ -1001,6 +947,19 @@ Result<void> Terminal::removeChildWidgetByHashId(const std::string& hashId) {
 // OSC Sequence Handling
 //=============================================================================
 
+Result<ShmPayload::Ptr> Terminal::openShmPayload(const ShmPayloadRef& ref) {
+    // Tokens are one-shot: a replayed OSC must not map the object again
+    if (!_usedShmTokens.claim(ref.token)) {
+        return Err<ShmPayload::Ptr>("shm token already used: " + ref.token);
+    }
+    auto res = ShmPayload::open(ref);
+    if (!res) {
+        return Err<ShmPayload::Ptr>("Failed to map shm payload", res);
+    }
+    yinfo("Terminal: mapped shm payload token={} size={}", ref.token, (*res)->size());
+    return res;
+}
+
 bool Terminal::handleOSCSequence(const std::string& sequence,
                                   std::string* response,
                                   uint32_t* linesToAdvance) {
@@ -1050,14 +1009,29 @@ bool Terminal::handleOSCSequence(const std::string& sequence,
                 pluginArgs += "--relative";
             }
 
-            auto result = _widgetFactory->createWidget(
-                widgetName,
-                x, y,
-                static_cast<uint32_t>(cmd.create.width),
-                static_cast<uint32_t>(cmd.create.height),
-                pluginArgs,
-                cmd.payload
-            );
+            // Large payloads may arrive through shared memory instead of the OSC
+            ShmPayload::Ptr shmPayload;
+            if (!cmd.create.shm.empty()) {
+                auto shmRes = openShmPayload(cmd.create.shm);
+                if (!shmRes) {
+                    yerror("Terminal: shm payload rejected: {}", error_msg(shmRes));
+                    if (response) *response = OscResponse::error(error_msg(shmRes));
+                    return false;
+                }
+                shmPayload = *shmRes;
+            }
+
+            Result<WidgetPtr> result = [&]() {
+                ShmPayload::Scope shmScope(shmPayload);
+                return _widgetFactory->createWidget(
+                    widgetName,
+                    x, y,
+                    static_cast<uint32_t>(cmd.create.width),
+                    static_cast<uint32_t>(cmd.create.height),
+                    pluginArgs,
+                    cmd.payload
+                );
+            }();
             if (!result) {
                 yerror("Terminal: createWidget failed: {}", error_msg(result));
                 if (response) *response = OscResponse::error(error_msg(result));
@@ -1172,11 +1146,24 @@ bool Terminal::handleOSCSequence(const std::string& sequence,
                 if (response) *response = OscResponse::error("Widget not found: " + cmd.target.id);
                 return false;
             }
+            ShmPayload::Ptr shmPayload;
+            if (!cmd.target.shm.empty()) {
+                auto shmRes = openShmPayload(cmd.target.shm);
+                if (!shmRes) {
+                    if (response) *response = OscResponse::error(error_msg(shmRes));
+                    return false;
+                }
+                shmPayload = *shmRes;
+            }
             if (auto res = widget->dispose(); !res) {
                 if (response) *response = OscResponse::error("Failed to dispose widget");
                 return false;
             }
-            widget->setPayload(cmd.payload);
+            if (shmPayload) {
+                widget->setShmPayload(shmPayload);
+            } else {
+                widget->setPayload(cmd.payload);
+            }
             if (auto res = widget->reinit(); !res) {
                 if (response) *response = OscResponse::error("Widget re-init failed");
                 return false;
@@ -1184,6 +1171,35 @@ bool Terminal::handleOSCSequence(const std::string& sequence,
             return true;
         }
 
+        case OscCommandType::Append: {
+            if (cmd.target.id.empty()) {
+                if (response) *response = OscResponse::error("append: --id required");
+                return false;
+            }
+            auto widget = getChildWidgetByHashId(cmd.target.id);
+            if (!widget) {
+                if (response) *response = OscResponse::error("Widget not found: " + cmd.target.id);
+                return false;
+            }
+            ShmPayload::Ptr shmPayload;
+            if (!cmd.target.shm.empty()) {
+                auto shmRes = openShmPayload(cmd.target.shm);
+                if (!shmRes) {
+                    if (response) *response = OscResponse::error(error_msg(shmRes));
+                    return false;
+                }
+                shmPayload = *shmRes;
+            }
+            // Streaming updates go straight to the widget: no dispose/reinit,
+            // the widget batches them until its next frame
+            auto data = shmPayload ? shmPayload->view() : std::string_view(cmd.payload);
+            if (auto res = widget->append(data); !res) {
+                if (response) *response = OscResponse::error(error_msg(res));
+                return false;
+            }
+            return true;
+        }
+
         case OscCommandType::Plugins: {
             if (response) {
                 *response = OscResponse::pluginList(_widgetFactory->getAvailableWidgets());
@@ -7,6 +7,7 @@
 #include <yetty/osc-command.h>
 #include "grid.h"
 #include "gpu-screen.h"
+#include "child-widget-layout.h"
 #include "terminal-backend.h"  // For SelectionMode, ScrollbackStyle, ScrollbackLine
 
 extern "C" {
@@ -201,6 +202,9 @@ private:
     void syncDamageToGrid();
     void colorToRGB(const VTermColor& color, uint8_t& r, uint8_t& g, uint8_t& b);
 
+    // Map an out-of-band payload, enforcing one-shot tokens
+    Result<ShmPayload::Ptr> openShmPayload(const ShmPayloadRef& ref);
+
     // Widget position update on scroll (called when lines are pushed/popped from scrollback)
     void updateWidgetPositionsOnScroll(int lines);
 
@@ -257,9 +261,11 @@ private:
 
     // Child widgets (Terminal owns its child widgets)
     std::vector<WidgetPtr> _childWidgets;
+    ChildWidgetLayout _childLayout;  // Per-frame placement and on/off state
     std::unordered_map<std::string, WidgetPtr> _childWidgetsByHashId;
     OscCommandParser _oscParser;
     uint32_t _nextChildWidgetId = 1;
+    ShmTokenSet _usedShmTokens;  // One-shot shm payload tokens
 
     uint32_t _cellWidth = 10;
     uint32_t _cellHeight = 20;
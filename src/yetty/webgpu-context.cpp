@@ -58,6 +58,8 @@ WebGPUContext::WebGPUContext(GLFWwindow* window, uint32_t width, uint32_t height
 #endif
 
 WebGPUContext::~WebGPUContext() {
+    // Cached pipelines and modules go before the device
+    shaderCache_.reset();
     if (device_) wgpuDeviceRelease(device_);
     if (adapter_) wgpuAdapterRelease(adapter_);
 #if YETTY_WEB
@@ -313,6 +315,8 @@ Result<void> WebGPUContext::init() noexcept {
 #endif
     // (Web already configured swapchain above)
 
+    shaderCache_ = std::make_unique<ShaderCache>(device_);
+
     std::cout << "WebGPU initialized successfully" << std::endl;
     return Ok();
 }
@@ -0,0 +1,67 @@
+#include <yetty/ydraw-scene-cache.h>
+
+namespace yetty {
+
+YDrawSceneCache& YDrawSceneCache::instance() {
+    static YDrawSceneCache cache;
+    return cache;
+}
+
+YDrawSceneCache::YDrawSceneCache(size_t budget)
+    : _cache(budget) {}
+
+YDrawSceneCache::Key YDrawSceneCache::keyFor(std::string_view content) {
+    // FNV-1a, same as the font cache
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return {hash, content.size()};
+}
+
+YDrawSceneCache::ScenePtr YDrawSceneCache::find(std::string_view content) {
+    Key key = keyFor(content);
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry* entry = _cache.get(key);
+    if (!entry || entry->content != content) {
+        _misses++;
+        return nullptr;
+    }
+    _hits++;
+    return entry->scene;
+}
+
+void YDrawSceneCache::insert(std::string_view content, ScenePtr scene) {
+    if (!scene) return;
+
+    size_t cost = content.size() + scene->primitives.size() * sizeof(YDrawPrimitiveGPU);
+    for (const auto& [name, s] : scene->structs) cost += name.size() + s.body_yaml.size();
+    for (const auto& [name, w] : scene->widgets) cost += name.size() + w.body_yaml.size();
+
+    Key key = keyFor(content);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache.put(key, Entry{std::string(content), std::move(scene)}, cost);
+}
+
+void YDrawSceneCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache.clear();
+}
+
+uint64_t YDrawSceneCache::hits() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
+
+uint64_t YDrawSceneCache::misses() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _misses;
+}
+
+size_t YDrawSceneCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cache.size();
+}
+
+} // namespace yetty
@@ -0,0 +1,793 @@
+#include <yetty/ydraw-svg.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace yetty::ydraw {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+// Curves of filled outlines are flattened to within this distance
+constexpr float FLATTEN_TOLERANCE = 0.25f;
+constexpr int MAX_FLATTEN_STEPS = 64;
+
+// Triangles of a fill are grown by the shader's antialias band so that
+// neighbours overlap instead of leaving half-covered seams between them
+constexpr float FILL_OVERLAP = 1.0f;
+
+// Ear clipping is quadratic, longer contours are drawn as outlines only
+constexpr size_t MAX_FILL_POINTS = 1024;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back())) s.remove_suffix(1);
+    return s;
+}
+
+// Leading number of s, 0 when there is none ("12px" -> 12)
+float toFloat(std::string_view s) {
+    s = trim(s);
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+    float v = 0.0f;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Tag scanner
+//-----------------------------------------------------------------------------
+
+struct Attr {
+    std::string_view name;
+    std::string_view value;
+};
+
+struct Tag {
+    std::string_view name;
+    std::vector<Attr> attrs;
+
+    std::string_view get(std::string_view key) const {
+        for (const auto& a : attrs) {
+            if (a.name == key) return a.value;
+        }
+        return {};
+    }
+};
+
+// Walks opening tags in document order. Attribute values are views into the
+// source text, so a Tag is only valid until the next call.
+class TagScanner {
+public:
+    explicit TagScanner(std::string_view text) : _s(text) {}
+
+    bool next(Tag& tag) {
+        while (true) {
+            size_t lt = _s.find('<', _pos);
+            if (lt == std::string_view::npos) {
+                _pos = _s.size();
+                return false;
+            }
+            _pos = lt + 1;
+
+            if (startsWith("!--")) { skipPast("-->"); continue; }
+            if (startsWith("![CDATA[")) { skipPast("]]>"); continue; }
+            if (_pos < _s.size() && (_s[_pos] == '?' || _s[_pos] == '!' || _s[_pos] == '/')) {
+                skipPast(">");
+                continue;
+            }
+
+            tag.name = readName();
+            tag.attrs.clear();
+            if (tag.name.empty()) continue;
+            readAttrs(tag);
+            return true;
+        }
+    }
+
+private:
+    bool startsWith(std::string_view prefix) const {
+        return _s.compare(_pos, prefix.size(), prefix) == 0;
+    }
+
+    void skipPast(std::string_view terminator) {
+        size_t end = _s.find(terminator, _pos);
+        _pos = end == std::string_view::npos ? _s.size() : end + terminator.size();
+    }
+
+    void skipSpace() {
+        while (_pos < _s.size() && isSpace(_s[_pos])) _pos++;
+    }
+
+    std::string_view readName() {
+        size_t start = _pos;
+        while (_pos < _s.size()) {
+            char c = _s[_pos];
+            if (isSpace(c) || c == '=' || c == '>' || c == '/') break;
+            _pos++;
+        }
+        return _s.substr(start, _pos - start);
+    }
+
+    void readAttrs(Tag& tag) {
+        while (true) {
+            skipSpace();
+            if (_pos >= _s.size()) return;
+            char c = _s[_pos];
+            if (c == '>') { _pos++; return; }
+            if (c == '/') { _pos++; continue; }
+
+            std::string_view name = readName();
+            if (name.empty()) { _pos++; continue; }
+
+            skipSpace();
+            if (_pos >= _s.size() || _s[_pos] != '=') {
+                tag.attrs.push_back({name, {}});
+                continue;
+            }
+            _pos++;
+            skipSpace();
+            if (_pos >= _s.size()) return;
+
+            std::string_view value;
+            char quote = _s[_pos];
+            if (quote == '"' || quote == '\'') {
+                size_t start = ++_pos;
+                size_t end = _s.find(quote, start);
+                if (end == std::string_view::npos) end = _s.size();
+                value = _s.substr(start, end - start);
+                _pos = std::min(end + 1, _s.size());
+            } else {
+                size_t start = _pos;
+                while (_pos < _s.size() && !isSpace(_s[_pos]) && _s[_pos] != '>') _pos++;
+                value = _s.substr(start, _pos - start);
+            }
+            tag.attrs.push_back({name, value});
+        }
+    }
+
+    std::string_view _s;
+    size_t _pos = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Styles
+//-----------------------------------------------------------------------------
+
+YDrawStyle readStyle(const Tag& tag) {
+    std::string_view fill = tag.get("fill");
+    std::string_view stroke = tag.get("stroke");
+    std::string_view strokeWidth = tag.get("stroke-width");
+
+    // Inline style="fill:..;stroke:.." wins over presentation attributes
+    std::string_view css = tag.get("style");
+    while (!css.empty()) {
+        size_t semi = css.find(';');
+        std::string_view decl = css.substr(0, semi);
+        css = semi == std::string_view::npos ? std::string_view{} : css.substr(semi + 1);
+
+        size_t colon = decl.find(':');
+        if (colon == std::string_view::npos) continue;
+        std::string_view key = trim(decl.substr(0, colon));
+        std::string_view value = trim(decl.substr(colon + 1));
+        if (key == "fill") fill = value;
+        else if (key == "stroke") stroke = value;
+        else if (key == "stroke-width") strokeWidth = value;
+    }
+
+    YDrawStyle style = {};
+    if (!fill.empty()) {
+        parseSvgColor(fill, style.fill);
+    }
+    if (!stroke.empty() && trim(stroke) != "none" && parseSvgColor(stroke, style.stroke)) {
+        style.stroke_width = strokeWidth.empty() ? 1.0f : toFloat(strokeWidth);
+    }
+    return style;
+}
+
+// Open shapes only have an outline; draw it with the stroke, or with the
+// fill color when there is no stroke
+YDrawStyle outlineStyle(YDrawStyle style) {
+    if (style.stroke[3] <= 0.0f || style.stroke_width <= 0.0f) {
+        std::copy(style.fill, style.fill + 4, style.stroke);
+        style.stroke_width = 1.0f;
+    }
+    style.fill[3] = 0.0f;
+    return style;
+}
+
+// Triangles filling the inside of a closed outline
+YDrawStyle fillStyle(YDrawStyle style) {
+    style.stroke[3] = 0.0f;
+    style.stroke_width = 0.0f;
+    style.round = FILL_OVERLAP;
+    return style;
+}
+
+//-----------------------------------------------------------------------------
+// Fills
+//-----------------------------------------------------------------------------
+
+struct Point {
+    float x, y;
+    bool operator==(const Point&) const = default;
+};
+
+float cross(const Point& a, const Point& b, const Point& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+void addTriangle(std::vector<YDrawPrimitiveGPU>& out, const YDrawStyle& style,
+                 const Point& a, const Point& b, const Point& c) {
+    YDrawPrimitiveGPU& p = out.emplace_back();
+    p = {};
+    p.type = static_cast<uint32_t>(YDrawPrimitiveType::Triangle2D);
+    p.params[2] = a.x; p.params[3] = a.y;
+    p.params[4] = b.x; p.params[5] = b.y;
+    p.params[6] = c.x; p.params[7] = c.y;
+    p.style = style;
+}
+
+// Ear clipping of one closed contour. Each subpath is filled on its own, so
+// holes drawn as inner subpaths are filled over rather than cut out.
+// Self-intersecting contours still terminate, with an approximate fill.
+void fillContour(const std::vector<Point>& contour, std::vector<YDrawPrimitiveGPU>& out,
+                 const YDrawStyle& style) {
+    std::vector<Point> ring;
+    ring.reserve(contour.size());
+    for (const Point& p : contour) {
+        if (ring.empty() || !(p == ring.back())) ring.push_back(p);
+    }
+    while (ring.size() > 1 && ring.front() == ring.back()) ring.pop_back();
+    if (ring.size() < 3 || ring.size() > MAX_FILL_POINTS) return;
+
+    double area = 0.0;
+    for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        area += double(ring[j].x) * ring[i].y - double(ring[i].x) * ring[j].y;
+    }
+    if (area == 0.0) return;
+    const float orient = area > 0.0 ? 1.0f : -1.0f;
+
+    std::vector<uint32_t> idx(ring.size());
+    for (uint32_t i = 0; i < idx.size(); ++i) idx[i] = i;
+
+    size_t i = 0;
+    size_t stalled = 0;
+    while (idx.size() > 3) {
+        size_t n = idx.size();
+        i %= n;
+        const Point& a = ring[idx[(i + n - 1) % n]];
+        const Point& b = ring[idx[i]];
+        const Point& c = ring[idx[(i + 1) % n]];
+        float turn = cross(a, b, c) * orient;
+
+        if (turn == 0.0f) {
+            // Collinear corner, nothing to fill
+            idx.erase(idx.begin() + i);
+            stalled = 0;
+            continue;
+        }
+
+        bool ear = turn > 0.0f;
+        for (size_t k = 0; ear && k < n; ++k) {
+            const Point& q = ring[idx[k]];
+            if (q == a || q == b || q == c) continue;
+            ear = !(cross(a, b, q) * orient >= 0.0f && cross(b, c, q) * orient >= 0.0f &&
+                    cross(c, a, q) * orient >= 0.0f);
+        }
+
+        // A full round without an ear only happens on self-intersections
+        if (ear || ++stalled > n) {
+            addTriangle(out, style, a, b, c);
+            idx.erase(idx.begin() + i);
+            stalled = 0;
+        } else {
+            i++;
+        }
+    }
+    if (cross(ring[idx[0]], ring[idx[1]], ring[idx[2]]) != 0.0f) {
+        addTriangle(out, style, ring[idx[0]], ring[idx[1]], ring[idx[2]]);
+    }
+}
+
+// Wang's bound on the segments that keep a bezier within the tolerance
+int flattenSteps(float degreeTerm, float dx, float dy) {
+    float n = std::ceil(std::sqrt(degreeTerm * std::sqrt(dx * dx + dy * dy) / FLATTEN_TOLERANCE));
+    return std::clamp(static_cast<int>(n), 1, MAX_FLATTEN_STEPS);
+}
+
+//-----------------------------------------------------------------------------
+// Primitive emitters
+//-----------------------------------------------------------------------------
+
+class Emitter {
+public:
+    Emitter(std::vector<YDrawPrimitiveGPU>& out, const YDrawStyle& style)
+        : _out(out), _style(style) {}
+
+    // Also fill subpaths that get closed: their outline is recorded as a
+    // polygon, curves flattened, and triangulated into `fills` on close
+    void fillClosed(std::vector<YDrawPrimitiveGPU>& fills, const YDrawStyle& style) {
+        _fills = &fills;
+        _fillStyle = style;
+    }
+
+    // An open subpath is never filled, drop what was recorded of it
+    void beginSubpath() { _contour.clear(); }
+
+    void closeSubpath() {
+        if (_fills) fillContour(_contour, *_fills, _fillStyle);
+        _contour.clear();
+    }
+
+    void segment(float x1, float y1, float x2, float y2) {
+        auto& p = add(YDrawPrimitiveType::Segment2D);
+        p.params[2] = x1; p.params[3] = y1;
+        p.params[4] = x2; p.params[5] = y2;
+        record(x1, y1, x2, y2);
+    }
+
+    void quad(float x0, float y0, float x1, float y1, float x2, float y2) {
+        auto& p = add(YDrawPrimitiveType::Bezier2D);
+        p.params[2] = x0; p.params[3] = y0;
+        p.params[4] = x1; p.params[5] = y1;
+        p.params[6] = x2; p.params[7] = y2;
+        if (!_fills) return;
+
+        int n = flattenSteps(0.25f, x0 - 2 * x1 + x2, y0 - 2 * y1 + y2);
+        for (int i = 1; i <= n; ++i) {
+            float t = static_cast<float>(i) / n;
+            float u = 1.0f - t;
+            record(x0, y0, u * u * x0 + 2 * u * t * x1 + t * t * x2,
+                   u * u * y0 + 2 * u * t * y1 + t * t * y2);
+        }
+    }
+
+    void cubic(float x0, float y0, float x1, float y1,
+               float x2, float y2, float x3, float y3) {
+        auto& p = add(YDrawPrimitiveType::CubicBezier2D);
+        p.params[2] = x0; p.params[3] = y0;
+        p.params[4] = x1; p.params[5] = y1;
+        p.params[6] = x2; p.params[7] = y2;
+        p.params[8] = x3; p.params[9] = y3;
+        if (!_fills) return;
+
+        float ddx = std::max(std::abs(x0 - 2 * x1 + x2), std::abs(x1 - 2 * x2 + x3));
+        float ddy = std::max(std::abs(y0 - 2 * y1 + y2), std::abs(y1 - 2 * y2 + y3));
+        int n = flattenSteps(0.75f, ddx, ddy);
+        for (int i = 1; i <= n; ++i) {
+            float t = static_cast<float>(i) / n;
+            float u = 1.0f - t;
+            record(x0, y0,
+                   u * u * u * x0 + 3 * u * u * t * x1 + 3 * u * t * t * x2 + t * t * t * x3,
+                   u * u * u * y0 + 3 * u * u * t * y1 + 3 * u * t * t * y2 + t * t * t * y3);
+        }
+    }
+
+    // SVG endpoint arc, converted to the center parameterization of
+    // EllipseArc2D (SVG 1.1 implementation notes F.6.5)
+    void arc(float x1, float y1, float rx, float ry, float angleDeg,
+             bool largeArc, bool sweep, float x2, float y2) {
+        if (x1 == x2 && y1 == y2) return;
+        rx = std::abs(rx);
+        ry = std::abs(ry);
+        if (rx == 0.0f || ry == 0.0f) {
+            segment(x1, y1, x2, y2);
+            return;
+        }
+
+        float phi = angleDeg * PI / 180.0f;
+        float c = std::cos(phi);
+        float s = std::sin(phi);
+        float dx = (x1 - x2) * 0.5f;
+        float dy = (y1 - y2) * 0.5f;
+        float x1p = c * dx + s * dy;
+        float y1p = -s * dx + c * dy;
+
+        // Radii too small for the endpoints are scaled up
+        float lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+        if (lambda > 1.0f) {
+            float k = std::sqrt(lambda);
+            rx *= k;
+            ry *= k;
+        }
+
+        float rx2 = rx * rx, ry2 = ry * ry;
+        float num = rx2 * ry2 - rx2 * y1p * y1p - ry2 * x1p * x1p;
+        float den = rx2 * y1p * y1p + ry2 * x1p * x1p;
+        float coef = std::sqrt(std::max(0.0f, num / den));
+        if (largeArc == sweep) coef = -coef;
+        float cxp = coef * rx * y1p / ry;
+        float cyp = -coef * ry * x1p / rx;
+
+        float cx = c * cxp - s * cyp + (x1 + x2) * 0.5f;
+        float cy = s * cxp + c * cyp + (y1 + y2) * 0.5f;
+
+        float ux = (x1p - cxp) / rx, uy = (y1p - cyp) / ry;
+        float vx = (-x1p - cxp) / rx, vy = (-y1p - cyp) / ry;
+        float theta1 = std::atan2(uy, ux);
+        float delta = std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+        if (!sweep && delta > 0.0f) delta -= 2.0f * PI;
+        if (sweep && delta < 0.0f) delta += 2.0f * PI;
+
+        // The shader always sweeps from params[5] up to params[6]
+        auto& p = add(YDrawPrimitiveType::EllipseArc2D);
+        p.params[0] = cx; p.params[1] = cy;
+        p.params[2] = rx; p.params[3] = ry;
+        p.params[4] = phi;
+        p.params[5] = delta >= 0.0f ? theta1 : theta1 + delta;
+        p.params[6] = delta >= 0.0f ? theta1 + delta : theta1;
+        if (!_fills) return;
+
+        // Chords of angle a deviate r * (1 - cos(a / 2)) from the arc
+        float r = std::max(rx, ry);
+        float step = r > FLATTEN_TOLERANCE ? 2.0f * std::acos(1.0f - FLATTEN_TOLERANCE / r) : PI;
+        int n = std::clamp(static_cast<int>(std::ceil(std::abs(delta) / step)), 1, MAX_FLATTEN_STEPS);
+        for (int i = 1; i < n; ++i) {
+            float t = theta1 + delta * i / n;
+            float ex = rx * std::cos(t);
+            float ey = ry * std::sin(t);
+            record(x1, y1, cx + c * ex - s * ey, cy + s * ex + c * ey);
+        }
+        record(x1, y1, x2, y2);
+    }
+
+    YDrawPrimitiveGPU& add(YDrawPrimitiveType type) {
+        YDrawPrimitiveGPU& p = _out.emplace_back();
+        p = {};
+        p.type = static_cast<uint32_t>(type);
+        p.style = _style;
+        return p;
+    }
+
+private:
+    // Extend the contour of the current subpath, which starts at (x0, y0)
+    void record(float x0, float y0, float x, float y) {
+        if (!_fills) return;
+        if (_contour.empty()) _contour.push_back({x0, y0});
+        _contour.push_back({x, y});
+    }
+
+    std::vector<YDrawPrimitiveGPU>& _out;
+    YDrawStyle _style;
+    std::vector<YDrawPrimitiveGPU>* _fills = nullptr;
+    YDrawStyle _fillStyle = {};
+    std::vector<Point> _contour;
+};
+
+//-----------------------------------------------------------------------------
+// Path data
+//-----------------------------------------------------------------------------
+
+class PathLexer {
+public:
+    explicit PathLexer(std::string_view d) : _s(d) {}
+
+    bool atEnd() {
+        skipSeparators();
+        return _pos >= _s.size();
+    }
+
+    // Command letter, when that is the next token
+    bool command(char& cmd) {
+        skipSeparators();
+        if (_pos >= _s.size()) return false;
+        char c = _s[_pos];
+        bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        if (!letter || c == 'e' || c == 'E') return false;
+        cmd = c;
+        _pos++;
+        return true;
+    }
+
+    bool number(float& v) {
+        skipSeparators();
+        if (_pos >= _s.size()) return false;
+        const char* begin = _s.data() + _pos;
+        const char* end = _s.data() + _s.size();
+        if (*begin == '+') begin++;
+        auto [ptr, ec] = std::from_chars(begin, end, v);
+        if (ec != std::errc()) return false;
+        _pos = static_cast<size_t>(ptr - _s.data());
+        return true;
+    }
+
+    // Arc flags may be written without separators ("a5 5 0 1010 10")
+    bool flag(bool& f) {
+        skipSeparators();
+        if (_pos >= _s.size() || (_s[_pos] != '0' && _s[_pos] != '1')) return false;
+        f = _s[_pos++] == '1';
+        return true;
+    }
+
+private:
+    void skipSeparators() {
+        while (_pos < _s.size() && (isSpace(_s[_pos]) || _s[_pos] == ',')) _pos++;
+    }
+
+    std::string_view _s;
+    size_t _pos = 0;
+};
+
+void parsePath(std::string_view d, Emitter& emit) {
+    PathLexer lex(d);
+    float cx = 0, cy = 0;   // Current point
+    float sx = 0, sy = 0;   // Start of the subpath
+    float qx = 0, qy = 0;   // Last quadratic control point, for T
+    float kx = 0, ky = 0;   // Last cubic control point, for S
+    char cmd = 0;
+    char last = 0;          // Previous command, upper case
+
+    while (!lex.atEnd()) {
+        char c;
+        if (lex.command(c)) {
+            cmd = c;
+        } else if (cmd == 0) {
+            return;  // Numbers without a command
+        }
+
+        bool rel = cmd >= 'a' && cmd <= 'z';
+        char op = static_cast<char>(rel ? cmd - 'a' + 'A' : cmd);
+        float ox = rel ? cx : 0.0f;
+        float oy = rel ? cy : 0.0f;
+
+        switch (op) {
+            case 'M': {
+                float x, y;
+                if (!lex.number(x) || !lex.number(y)) return;
+                emit.beginSubpath();
+                cx = sx = x + ox;
+                cy = sy = y + oy;
+                // Further pairs are implicit line-tos
+                cmd = rel ? 'l' : 'L';
+                break;
+            }
+            case 'L': {
+                float x, y;
+                if (!lex.number(x) || !lex.number(y)) return;
+                emit.segment(cx, cy, x + ox, y + oy);
+                cx = x + ox;
+                cy = y + oy;
+                break;
+            }
+            case 'H': {
+                float x;
+                if (!lex.number(x)) return;
+                emit.segment(cx, cy, x + ox, cy);
+                cx = x + ox;
+                break;
+            }
+            case 'V': {
+                float y;
+                if (!lex.number(y)) return;
+                emit.segment(cx, cy, cx, y + oy);
+                cy = y + oy;
+                break;
+            }
+            case 'Q':
+            case 'T': {
+                float x1, y1;
+                if (op == 'Q') {
+                    if (!lex.number(x1) || !lex.number(y1)) return;
+                    x1 += ox;
+                    y1 += oy;
+                } else {
+                    bool smooth = last == 'Q' || last == 'T';
+                    x1 = smooth ? 2 * cx - qx : cx;
+                    y1 = smooth ? 2 * cy - qy : cy;
+                }
+                float x, y;
+                if (!lex.number(x) || !lex.number(y)) return;
+                emit.quad(cx, cy, x1, y1, x + ox, y + oy);
+                qx = x1;
+                qy = y1;
+                cx = x + ox;
+                cy = y + oy;
+                break;
+            }
+            case 'C':
+            case 'S': {
+                float x1, y1;
+                if (op == 'C') {
+                    if (!lex.number(x1) || !lex.number(y1)) return;
+                    x1 += ox;
+                    y1 += oy;
+                } else {
+                    bool smooth = last == 'C' || last == 'S';
+                    x1 = smooth ? 2 * cx - kx : cx;
+                    y1 = smooth ? 2 * cy - ky : cy;
+                }
+                float x2, y2, x, y;
+                if (!lex.number(x2) || !lex.number(y2) || !lex.number(x) || !lex.number(y)) return;
+                emit.cubic(cx, cy, x1, y1, x2 + ox, y2 + oy, x + ox, y + oy);
+                kx = x2 + ox;
+                ky = y2 + oy;
+                cx = x + ox;
+                cy = y + oy;
+                break;
+            }
+            case 'A': {
+                float rx, ry, angle, x, y;
+                bool largeArc, sweep;
+                if (!lex.number(rx) || !lex.number(ry) || !lex.number(angle) ||
+                    !lex.flag(largeArc) || !lex.flag(sweep) ||
+                    !lex.number(x) || !lex.number(y)) {
+                    return;
+                }
+                emit.arc(cx, cy, rx, ry, angle, largeArc, sweep, x + ox, y + oy);
+                cx = x + ox;
+                cy = y + oy;
+                break;
+            }
+            case 'Z':
+                if (cx != sx || cy != sy) {
+                    emit.segment(cx, cy, sx, sy);
+                }
+                emit.closeSubpath();
+                cx = sx;
+                cy = sy;
+                // A command letter has to follow
+                cmd = 0;
+                break;
+            default:
+                return;  // Unsupported command, drop the rest of the path
+        }
+        last = op;
+    }
+}
+
+void parsePoints(std::string_view points, bool close, Emitter& emit) {
+    PathLexer lex(points);
+    float x0, y0;
+    if (!lex.number(x0) || !lex.number(y0)) return;
+    float px = x0, py = y0;
+    float x, y;
+    while (lex.number(x) && lex.number(y)) {
+        emit.segment(px, py, x, y);
+        px = x;
+        py = y;
+    }
+    if (close) {
+        if (px != x0 || py != y0) {
+            emit.segment(px, py, x0, y0);
+        }
+        emit.closeSubpath();
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// Colors
+//-----------------------------------------------------------------------------
+
+bool parseSvgColor(std::string_view color, float out[4]) {
+    color = trim(color);
+    if (color.empty()) return false;
+
+    if (color.front() == '#') {
+        std::string_view hex = color.substr(1);
+        int v[8];
+        for (size_t i = 0; i < hex.size() && i < 8; ++i) {
+            v[i] = hexValue(hex[i]);
+            if (v[i] < 0) return false;
+        }
+        if (hex.size() == 3) {
+            for (int i = 0; i < 3; ++i) out[i] = v[i] * 17 / 255.0f;
+            out[3] = 1.0f;
+            return true;
+        }
+        if (hex.size() == 6 || hex.size() == 8) {
+            for (int i = 0; i < 3; ++i) out[i] = (v[2 * i] * 16 + v[2 * i + 1]) / 255.0f;
+            out[3] = hex.size() == 8 ? (v[6] * 16 + v[7]) / 255.0f : 1.0f;
+            return true;
+        }
+        return false;
+    }
+
+    struct Named { std::string_view name; uint8_t r, g, b, a; };
+    static constexpr Named NAMED[] = {
+        {"none", 0, 0, 0, 0},        {"transparent", 0, 0, 0, 0},
+        {"black", 0, 0, 0, 255},     {"white", 255, 255, 255, 255},
+        {"red", 255, 0, 0, 255},     {"green", 0, 128, 0, 255},
+        {"lime", 0, 255, 0, 255},    {"blue", 0, 0, 255, 255},
+        {"yellow", 255, 255, 0, 255}, {"cyan", 0, 255, 255, 255},
+        {"magenta", 255, 0, 255, 255}, {"gray", 128, 128, 128, 255},
+        {"grey", 128, 128, 128, 255}, {"orange", 255, 165, 0, 255},
+        {"purple", 128, 0, 128, 255}, {"navy", 0, 0, 128, 255},
+    };
+    for (const auto& n : NAMED) {
+        if (n.name == color) {
+            out[0] = n.r / 255.0f;
+            out[1] = n.g / 255.0f;
+            out[2] = n.b / 255.0f;
+            out[3] = n.a / 255.0f;
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Document
+//-----------------------------------------------------------------------------
+
+size_t parseSvg(std::string_view svg, std::vector<YDrawPrimitiveGPU>& out) {
+    size_t first = out.size();
+    TagScanner scanner(svg);
+    Tag tag;
+    tag.attrs.reserve(16);
+
+    // Polygons and paths: fill triangles go below their outline
+    std::vector<YDrawPrimitiveGPU> fills;
+    std::vector<YDrawPrimitiveGPU> outline;
+
+    while (scanner.next(tag)) {
+        const std::string_view name = tag.name;
+        if (name != "circle" && name != "ellipse" && name != "rect" && name != "line" &&
+            name != "polyline" && name != "polygon" && name != "path") {
+            continue;
+        }
+
+        YDrawStyle style = readStyle(tag);
+        auto num = [&](std::string_view attr) { return toFloat(tag.get(attr)); };
+
+        if (name == "circle") {
+            auto& p = Emitter(out, style).add(YDrawPrimitiveType::Circle2D);
+            p.params[0] = num("cx");
+            p.params[1] = num("cy");
+            p.params[2] = num("r");
+        } else if (name == "ellipse") {
+            auto& p = Emitter(out, style).add(YDrawPrimitiveType::Ellipse2D);
+            p.params[0] = num("cx");
+            p.params[1] = num("cy");
+            p.params[2] = num("rx");
+            p.params[3] = num("ry");
+        } else if (name == "rect") {
+            float w = num("width");
+            float h = num("height");
+            float rx = tag.get("rx").empty() ? num("ry") : num("rx");
+            auto& p = Emitter(out, style).add(YDrawPrimitiveType::Box2D);
+            p.params[0] = num("x") + w / 2;
+            p.params[1] = num("y") + h / 2;
+            p.params[2] = w / 2;
+            p.params[3] = h / 2;
+            p.style.round = std::min(rx, std::min(w, h) / 2);
+        } else if (name == "line") {
+            Emitter(out, style).segment(num("x1"), num("y1"), num("x2"), num("y2"));
+        } else if (name == "polyline") {
+            Emitter emit(out, outlineStyle(style));
+            parsePoints(tag.get("points"), false, emit);
+        } else {
+            fills.clear();
+            outline.clear();
+            Emitter emit(outline, outlineStyle(style));
+            if (style.fill[3] > 0.0f) {
+                emit.fillClosed(fills, fillStyle(style));
+            }
+            if (name == "polygon") {
+                parsePoints(tag.get("points"), true, emit);
+            } else {
+                parsePath(tag.get("d"), emit);
+            }
+            out.insert(out.end(), fills.begin(), fills.end());
+            out.insert(out.end(), outline.begin(), outline.end());
+        }
+    }
+
+    return out.size() - first;
+}
+
+} // namespace yetty::ydraw
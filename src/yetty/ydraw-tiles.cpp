@@ -0,0 +1,205 @@
+#include <yetty/ydraw-tiles.h>
+#include <algorithm>
+#include <cmath>
+
+namespace yetty {
+
+namespace {
+
+// Slack on top of the antialias band, covers float error of the SDFs
+constexpr float BOUNDS_SLACK = 0.5f;
+
+void extend(float box[4], float x, float y) {
+    box[0] = std::min(box[0], x);
+    box[1] = std::min(box[1], y);
+    box[2] = std::max(box[2], x);
+    box[3] = std::max(box[3], y);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// Bounds
+//-----------------------------------------------------------------------------
+
+bool YDrawTileBins::bounds(const YDrawPrimitiveGPU& prim, float out[4]) {
+    if (prim.type >= static_cast<uint32_t>(YDrawPrimitiveType::Sphere3D)) {
+        return false;
+    }
+
+    const YDrawStyle& style = prim.style;
+    bool filled = style.fill[3] > 0.0f;
+    bool stroked = style.stroke[3] > 0.0f && style.stroke_width > 0.0f;
+    if (!filled && !stroked) {
+        return false;
+    }
+
+    // The shader fades fill over d in [-1, 1] and the stroke over
+    // |d| - width/2 in [-1, 1], so nothing is drawn beyond this distance
+    float margin = 1.0f + BOUNDS_SLACK + (stroked ? style.stroke_width * 0.5f : 0.0f);
+
+    // Local box, relative to the primitive origin params[0..1] (the shader
+    // evaluates every 2D SDF in that space)
+    const float* p = prim.params;
+    float cx = p[0];
+    float cy = p[1];
+    float box[4] = {INFINITY, INFINITY, -INFINITY, -INFINITY};
+
+    switch (static_cast<YDrawPrimitiveType>(prim.type)) {
+        case YDrawPrimitiveType::Circle2D: {
+            float r = std::abs(p[2]);
+            extend(box, -r, -r);
+            extend(box, r, r);
+            break;
+        }
+        case YDrawPrimitiveType::Box2D:
+        case YDrawPrimitiveType::Ellipse2D: {
+            float hx = std::abs(p[2]);
+            float hy = std::abs(p[3]);
+            extend(box, -hx, -hy);
+            extend(box, hx, hy);
+            break;
+        }
+        case YDrawPrimitiveType::Segment2D:
+            extend(box, p[2] - cx, p[3] - cy);
+            extend(box, p[4] - cx, p[5] - cy);
+            break;
+        case YDrawPrimitiveType::Triangle2D:
+            // Rounding grows the triangle outwards
+            for (int i = 2; i < 8; i += 2) {
+                extend(box, p[i] - cx, p[i + 1] - cy);
+            }
+            margin += std::max(style.round, 0.0f);
+            break;
+        case YDrawPrimitiveType::Bezier2D:
+            // Beziers stay inside the hull of their control points
+            for (int i = 2; i < 8; i += 2) {
+                extend(box, p[i] - cx, p[i + 1] - cy);
+            }
+            break;
+        case YDrawPrimitiveType::CubicBezier2D:
+            for (int i = 2; i < 10; i += 2) {
+                extend(box, p[i] - cx, p[i + 1] - cy);
+            }
+            break;
+        case YDrawPrimitiveType::Arc2D: {
+            float r = std::abs(p[4]) + std::abs(p[5]);
+            extend(box, -r, -r);
+            extend(box, r, r);
+            break;
+        }
+        case YDrawPrimitiveType::EllipseArc2D: {
+            float r = std::max(std::abs(p[2]), std::abs(p[3]));
+            extend(box, -r, -r);
+            extend(box, r, r);
+            break;
+        }
+        default:
+            // Unknown to the binner: let it cover the whole widget
+            out[0] = out[1] = -INFINITY;
+            out[2] = out[3] = INFINITY;
+            return true;
+    }
+
+    if (style.rotate != 0.0f) {
+        // The shader rotates the sample point by +angle around the origin,
+        // so the shape itself is rotated by -angle
+        float a = -style.rotate * 3.14159265f / 180.0f;
+        float c = std::cos(a);
+        float s = std::sin(a);
+        float corners[4][2] = {
+            {box[0], box[1]}, {box[2], box[1]}, {box[0], box[3]}, {box[2], box[3]}};
+        box[0] = box[1] = INFINITY;
+        box[2] = box[3] = -INFINITY;
+        for (auto& q : corners) {
+            extend(box, c * q[0] - s * q[1], s * q[0] + c * q[1]);
+        }
+    }
+
+    out[0] = cx + box[0] - margin;
+    out[1] = cy + box[1] - margin;
+    out[2] = cx + box[2] + margin;
+    out[3] = cy + box[3] + margin;
+
+    if (!std::isfinite(out[0] + out[1] + out[2] + out[3])) {
+        out[0] = out[1] = -INFINITY;
+        out[2] = out[3] = INFINITY;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Binning
+//-----------------------------------------------------------------------------
+
+void YDrawTileBins::build(const std::vector<YDrawPrimitiveGPU>& prims, float width, float height) {
+    _tilesX = std::max(1u, static_cast<uint32_t>(std::ceil(std::max(width, 0.0f) / TILE_SIZE)));
+    _tilesY = std::max(1u, static_cast<uint32_t>(std::ceil(std::max(height, 0.0f) / TILE_SIZE)));
+    _has3D = false;
+
+    const uint32_t tileCount = _tilesX * _tilesY;
+
+    // Tile rectangle [x0, y0, x1, y1] per primitive, x0 > x1 when culled
+    struct TileRect { uint32_t x0, y0, x1, y1; };
+    std::vector<TileRect> rects(prims.size(), TileRect{1, 1, 0, 0});
+
+    auto toTile = [](float v, uint32_t count) -> int64_t {
+        float t = std::floor(v / TILE_SIZE);
+        return static_cast<int64_t>(std::clamp(t, -1.0f, static_cast<float>(count)));
+    };
+
+    _counts.assign(tileCount, 0);
+    for (size_t i = 0; i < prims.size(); ++i) {
+        float b[4];
+        if (!bounds(prims[i], b)) {
+            if (prims[i].type >= static_cast<uint32_t>(YDrawPrimitiveType::Sphere3D)) {
+                _has3D = true;
+            }
+            continue;
+        }
+        int64_t x0 = toTile(b[0], _tilesX);
+        int64_t y0 = toTile(b[1], _tilesY);
+        int64_t x1 = toTile(b[2], _tilesX);
+        int64_t y1 = toTile(b[3], _tilesY);
+        // Fragments past the last tile are clamped into it by the shader
+        if (x1 < 0 || y1 < 0 || x0 >= _tilesX || y0 >= _tilesY) {
+            continue;
+        }
+        TileRect r{static_cast<uint32_t>(std::max<int64_t>(x0, 0)),
+                   static_cast<uint32_t>(std::max<int64_t>(y0, 0)),
+                   static_cast<uint32_t>(std::min<int64_t>(x1, _tilesX - 1)),
+                   static_cast<uint32_t>(std::min<int64_t>(y1, _tilesY - 1))};
+        rects[i] = r;
+        for (uint32_t ty = r.y0; ty <= r.y1; ++ty) {
+            for (uint32_t tx = r.x0; tx <= r.x1; ++tx) {
+                _counts[ty * _tilesX + tx]++;
+            }
+        }
+    }
+
+    // Offsets are absolute positions in _data, lists follow the header
+    _data.resize(tileCount + 1);
+    uint32_t offset = tileCount + 1;
+    for (uint32_t t = 0; t < tileCount; ++t) {
+        _data[t] = offset;
+        offset += _counts[t];
+        _counts[t] = _data[t];  // Reused as write cursor
+    }
+    _data[tileCount] = offset;
+    _data.resize(offset);
+
+    // Walking primitives in order keeps each list sorted
+    for (size_t i = 0; i < prims.size(); ++i) {
+        const TileRect& r = rects[i];
+        if (r.x0 > r.x1) {
+            continue;
+        }
+        for (uint32_t ty = r.y0; ty <= r.y1; ++ty) {
+            for (uint32_t tx = r.x0; tx <= r.x1; ++tx) {
+                _data[_counts[ty * _tilesX + tx]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+} // namespace yetty
@@ -1,10 +1,12 @@
 #include <yetty/ydraw.h>
 #include <yetty/wgpu-compat.h>
+#include <yetty/ydraw-scene-cache.h>
+#include <yetty/ydraw-svg.h>
 #include <yaml-cpp/yaml.h>
 #include <ytrace/ytrace.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cmath>
-#include <regex>
 
 namespace yetty {
 
@@ -18,6 +20,10 @@ struct Uniforms {
     resolution: vec2<f32>,
     time: f32,
     num_primitives: f32,
+    tile_size: f32,
+    tiles_x: f32,
+    tiles_y: f32,
+    has_3d: f32,
 }
 
 struct YDrawStyle {
@@ -37,6 +43,8 @@ struct Primitive {
 
 @group(0) @binding(0) var<uniform> u: Uniforms;
 @group(0) @binding(1) var<storage, read> primitives: array<Primitive>;
+// Per-tile primitive lists, see YDrawTileBins
+@group(0) @binding(2) var<storage, read> tiles: array<u32>;
 
 struct VertexOutput {
     @builtin(position) position: vec4<f32>,
@@ -441,7 +449,7 @@ fn evalPrimitive2D(p: vec2<f32>, prim: Primitive) -> f32 {
             let p2 = vec2(prim.params[6], prim.params[7]);
             d = sdTriangle(q, p0 - vec2(prim.params[0], prim.params[1]),
                               p1 - vec2(prim.params[0], prim.params[1]),
-                              p2 - vec2(prim.params[0], prim.params[1]));
+                              p2 - vec2(prim.params[0], prim.params[1])) - prim.style.round;
         }
         case 4u: {
             let A = vec2(prim.params[2], prim.params[3]);
@@ -565,15 +573,7 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
     let fragCoord = uv * u.resolution;
     var color = vec4<f32>(0.95, 0.95, 0.95, 1.0);
 
-    let numPrims = i32(u.num_primitives);
-
-    // Check if we have 3D primitives
-    var has3D = false;
-    for (var i = 0; i < numPrims; i = i + 1) {
-        if (primitives[i].ptype >= 100u) { has3D = true; break; }
-    }
-
-    if (has3D) {
+    if (u.has_3d > 0.0) {
         // Raymarching for 3D
         let aspect = u.resolution.x / u.resolution.y;
         let uv2 = (uv - 0.5) * vec2(aspect, 1.0);
@@ -605,22 +605,25 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
         }
     }
 
-    // 2D primitives (rendered on top or standalone)
-    for (var i = 0; i < numPrims; i = i + 1) {
-        let prim = primitives[i];
-        if (prim.ptype < 100u) {
-            let d = evalPrimitive2D(fragCoord, prim);
-
-            if (prim.style.fill.a > 0.0) {
-                let fillAlpha = 1.0 - smoothstep(-1.0, 1.0, d);
-                color = mix(color, prim.style.fill, fillAlpha * prim.style.fill.a);
-            }
+    // 2D primitives (rendered on top or standalone), only those binned
+    // into this fragment's tile
+    let tileMax = vec2(u.tiles_x, u.tiles_y) - 1.0;
+    let tile = vec2<u32>(clamp(floor(fragCoord / u.tile_size), vec2(0.0), tileMax));
+    let tileIndex = tile.y * u32(u.tiles_x) + tile.x;
+    let listEnd = tiles[tileIndex + 1u];
+    for (var k = tiles[tileIndex]; k < listEnd; k = k + 1u) {
+        let prim = primitives[tiles[k]];
+        let d = evalPrimitive2D(fragCoord, prim);
+
+        if (prim.style.fill.a > 0.0) {
+            let fillAlpha = 1.0 - smoothstep(-1.0, 1.0, d);
+            color = mix(color, prim.style.fill, fillAlpha * prim.style.fill.a);
+        }
 
-            if (prim.style.stroke.a > 0.0 && prim.style.stroke_width > 0.0) {
-                let strokeDist = abs(d) - prim.style.stroke_width * 0.5;
-                let strokeAlpha = 1.0 - smoothstep(-1.0, 1.0, strokeDist);
-                color = mix(color, prim.style.stroke, strokeAlpha * prim.style.stroke.a);
-            }
+        if (prim.style.stroke.a > 0.0 && prim.style.stroke_width > 0.0) {
+            let strokeDist = abs(d) - prim.style.stroke_width * 0.5;
+            let strokeAlpha = 1.0 - smoothstep(-1.0, 1.0, strokeDist);
+            color = mix(color, prim.style.stroke, strokeAlpha * prim.style.stroke.a);
         }
     }
 
@@ -632,6 +635,10 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
 // YDrawRenderer
 //-----------------------------------------------------------------------------
 
+static constexpr uint64_t UNIFORM_SIZE = 48;
+static constexpr size_t MIN_TILE_BUFFER_SIZE = 16 * 1024;
+static constexpr size_t MIN_PRIMITIVE_CAPACITY = 256;
+
 YDrawRenderer::YDrawRenderer() = default;
 
 YDrawRenderer::~YDrawRenderer() {
@@ -650,6 +657,14 @@ Result<void> YDrawRenderer::dispose() {
     if (_pipeline) { wgpuRenderPipelineRelease(_pipeline); _pipeline = nullptr; }
     if (_uniform_buffer) { wgpuBufferRelease(_uniform_buffer); _uniform_buffer = nullptr; }
     if (_primitive_buffer) { wgpuBufferRelease(_primitive_buffer); _primitive_buffer = nullptr; }
+    if (_tile_buffer) { wgpuBufferRelease(_tile_buffer); _tile_buffer = nullptr; }
+    if (_bind_group_layout) { wgpuBindGroupLayoutRelease(_bind_group_layout); _bind_group_layout = nullptr; }
+    _tile_buffer_size = 0;
+    _primitive_capacity = 0;
+    _binned_width = -1.0f;
+    _binned_height = -1.0f;
+    // Buffers are gone, everything has to be uploaded again
+    markDirty(0, _primitives.size());
     _gpu_initialized = false;
     _current_format = WGPUTextureFormat_Undefined;
     return Ok();
@@ -657,30 +672,77 @@ Result<void> YDrawRenderer::dispose() {
 
 void YDrawRenderer::clear() {
     _primitives.clear();
-    _primitives_dirty = true;
+    _dirty_begin = _dirty_end = 0;
+    _bins_dirty = true;
 }
 
 void YDrawRenderer::addPrimitive(const YDrawPrimitiveGPU& prim) {
-    if (_primitives.size() < MAX_PRIMITIVES) {
-        _primitives.push_back(prim);
-        _primitives_dirty = true;
+    _primitives.push_back(prim);
+    markDirty(_primitives.size() - 1, _primitives.size());
+}
+
+void YDrawRenderer::setPrimitive(size_t index, const YDrawPrimitiveGPU& prim) {
+    if (index >= _primitives.size()) return;
+    _primitives[index] = prim;
+    markDirty(index, index + 1);
+}
+
+void YDrawRenderer::markDirty(size_t begin, size_t end) {
+    if (begin >= end) return;
+    if (_dirty_begin == _dirty_end) {
+        _dirty_begin = begin;
+        _dirty_end = end;
+    } else {
+        _dirty_begin = std::min(_dirty_begin, begin);
+        _dirty_end = std::max(_dirty_end, end);
     }
+    _bins_dirty = true;
 }
 
 Result<void> YDrawRenderer::parse(const std::string& content) {
     if (content.empty()) return Ok();
 
+    // The outcome only depends on the content while no definitions from an
+    // earlier parse() are around, only then can the compiled scene be shared
+    bool cacheable = _structs.empty() && _widgets.empty();
+    auto& cache = YDrawSceneCache::instance();
+
+    if (cacheable) {
+        if (auto scene = cache.find(content)) {
+            size_t first = _primitives.size();
+            _primitives.insert(_primitives.end(), scene->primitives.begin(), scene->primitives.end());
+            _structs = scene->structs;
+            _widgets = scene->widgets;
+            markDirty(first, _primitives.size());
+            ydebug("YDraw: scene cache hit, {} primitives", scene->primitives.size());
+            return Ok();
+        }
+    }
+
+    // Parsers append, so only the new tail needs uploading - also after a
+    // failure part way through
+    size_t first = _primitives.size();
+
     // Check if SVG
+    bool svg = false;
     size_t i = 0;
     while (i < content.size() && std::isspace(content[i])) i++;
     if (i < content.size()) {
-        if (content.substr(i, 5) == "<?xml" || content.substr(i, 4) == "<svg" ||
-            content.find("<svg") != std::string::npos) {
-            return parseSVG(content);
-        }
+        svg = content.substr(i, 5) == "<?xml" || content.substr(i, 4) == "<svg" ||
+              content.find("<svg") != std::string::npos;
     }
 
-    return parseYAML(content);
+    auto result = svg ? parseSVG(content) : parseYAML(content);
+    markDirty(first, _primitives.size());
+
+    if (result && cacheable) {
+        auto scene = std::make_shared<YDrawCompiledScene>();
+        scene->primitives.assign(_primitives.begin() + first, _primitives.end());
+        scene->structs = _structs;
+        scene->widgets = _widgets;
+        cache.insert(content, std::move(scene));
+    }
+    return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1038,8 +1100,6 @@ Result<void> YDrawRenderer::parseYAML(const std::string& yaml) {
                 }
             }
         }
-
-        _primitives_dirty = true;
     } catch (const YAML::Exception& e) {
         return Err<void>(std::string("YAML parse error: ") + e.what());
     } catch (const std::exception& e) {
@@ -1050,128 +1110,12 @@ Result<void> YDrawRenderer::parseYAML(const std::string& yaml) {
 }
 
 //-----------------------------------------------------------------------------
-// SVG parsing (simplified)
+// SVG parsing
 //-----------------------------------------------------------------------------
 
-static std::string getAttr(const std::string& tag, const std::string& attr) {
-    std::string search = attr + "=\"";
-    size_t pos = tag.find(search);
-    if (pos == std::string::npos) {
-        search = attr + "='";
-        pos = tag.find(search);
-    }
-    if (pos == std::string::npos) return "";
-    pos += search.length();
-    char quote = tag[pos - 1];
-    size_t end = tag.find(quote, pos);
-    if (end == std::string::npos) return "";
-    return tag.substr(pos, end - pos);
-}
-
-static float parseNumber(const std::string& s) {
-    if (s.empty()) return 0.0f;
-    try { return std::stof(s); } catch (...) { return 0.0f; }
-}
-
 Result<void> YDrawRenderer::parseSVG(const std::string& svg) {
-    try {
-        size_t pos = 0;
-
-        while ((pos = svg.find("<", pos)) != std::string::npos) {
-            if (svg.substr(pos, 4) == "<!--" || svg.substr(pos, 2) == "<?") {
-                pos++;
-                continue;
-            }
-
-            size_t tagEnd = svg.find(">", pos);
-            if (tagEnd == std::string::npos) break;
-
-            std::string tag = svg.substr(pos, tagEnd - pos + 1);
-            pos = tagEnd + 1;
-
-            if (tag.size() > 1 && tag[1] == '/') continue;
-
-            size_t nameStart = 1;
-            size_t nameEnd = nameStart;
-            while (nameEnd < tag.size() && !std::isspace(tag[nameEnd]) && tag[nameEnd] != '>' && tag[nameEnd] != '/') {
-                nameEnd++;
-            }
-            std::string elemName = tag.substr(nameStart, nameEnd - nameStart);
-
-            YDrawStyle style = {};
-            std::string fillStr = getAttr(tag, "fill");
-            std::string strokeStr = getAttr(tag, "stroke");
-            std::string strokeWidthStr = getAttr(tag, "stroke-width");
-
-            if (!fillStr.empty() && fillStr != "none") {
-                parseColor(fillStr, style.fill);
-            }
-            if (!strokeStr.empty() && strokeStr != "none") {
-                parseColor(strokeStr, style.stroke);
-                style.stroke_width = strokeWidthStr.empty() ? 1.0f : parseNumber(strokeWidthStr);
-            }
-
-            if (elemName == "circle") {
-                float cx = parseNumber(getAttr(tag, "cx"));
-                float cy = parseNumber(getAttr(tag, "cy"));
-                float r = parseNumber(getAttr(tag, "r"));
-
-                YDrawPrimitiveGPU prim = {};
-                prim.type = static_cast<uint32_t>(YDrawPrimitiveType::Circle2D);
-                prim.params[0] = cx; prim.params[1] = cy;
-                prim.params[2] = r;
-                prim.style = style;
-                _primitives.push_back(prim);
-            }
-            else if (elemName == "ellipse") {
-                float cx = parseNumber(getAttr(tag, "cx"));
-                float cy = parseNumber(getAttr(tag, "cy"));
-                float rx = parseNumber(getAttr(tag, "rx"));
-                float ry = parseNumber(getAttr(tag, "ry"));
-
-                YDrawPrimitiveGPU prim = {};
-                prim.type = static_cast<uint32_t>(YDrawPrimitiveType::Ellipse2D);
-                prim.params[0] = cx; prim.params[1] = cy;
-                prim.params[2] = rx; prim.params[3] = ry;
-                prim.style = style;
-                _primitives.push_back(prim);
-            }
-            else if (elemName == "rect") {
-                float x = parseNumber(getAttr(tag, "x"));
-                float y = parseNumber(getAttr(tag, "y"));
-                float w = parseNumber(getAttr(tag, "width"));
-                float h = parseNumber(getAttr(tag, "height"));
-                float rx = parseNumber(getAttr(tag, "rx"));
-
-                YDrawPrimitiveGPU prim = {};
-                prim.type = static_cast<uint32_t>(YDrawPrimitiveType::Box2D);
-                prim.params[0] = x + w / 2; prim.params[1] = y + h / 2;
-                prim.params[2] = w / 2; prim.params[3] = h / 2;
-                prim.style = style;
-                prim.style.round = rx;
-                _primitives.push_back(prim);
-            }
-            else if (elemName == "line") {
-                float x1 = parseNumber(getAttr(tag, "x1"));
-                float y1 = parseNumber(getAttr(tag, "y1"));
-                float x2 = parseNumber(getAttr(tag, "x2"));
-                float y2 = parseNumber(getAttr(tag, "y2"));
-
-                YDrawPrimitiveGPU prim = {};
-                prim.type = static_cast<uint32_t>(YDrawPrimitiveType::Segment2D);
-                prim.params[2] = x1; prim.params[3] = y1;
-                prim.params[4] = x2; prim.params[5] = y2;
-                prim.style = style;
-                _primitives.push_back(prim);
-            }
-        }
-
-        _primitives_dirty = true;
-        yinfo("YDraw SVG parsed: {} primitives", _primitives.size());
-    } catch (const std::exception& e) {
-        return Err<void>(std::string("SVG parse error: ") + e.what());
-    }
-
+    size_t added = ydraw::parseSvg(svg, _primitives);
+    yinfo("YDraw SVG parsed: {} primitives", added);
     return Ok();
 }
 
@@ -1216,6 +1160,10 @@ Result<void> YDrawRenderer::render(WebGPUContext& ctx,
         float resolution[2];
         float time;
         float num_primitives;
+        float tile_size;
+        float tiles_x;
+        float tiles_y;
+        float has_3d;
     } uniforms;
 
     uniforms.rect[0] = ndcX;
@@ -1227,12 +1175,36 @@ Result<void> YDrawRenderer::render(WebGPUContext& ctx,
     uniforms.time = _time;
     uniforms.num_primitives = static_cast<float>(_primitives.size());
 
+    if (auto res = ensurePrimitiveCapacity(ctx.getDevice(), _primitives.size()); !res) {
+        _failed = true;
+        return Err<void>("YDrawRenderer: failed to grow primitive buffer", res);
+    }
+
+    // Bins depend on the primitives and the widget size
+    if (_bins_dirty || width != _binned_width || height != _binned_height) {
+        if (auto res = uploadTiles(ctx, width, height); !res) {
+            _failed = true;
+            return Err<void>("YDrawRenderer: failed to upload tile bins", res);
+        }
+    }
+
+    uniforms.tile_size = static_cast<float>(YDrawTileBins::TILE_SIZE);
+    uniforms.tiles_x = static_cast<float>(_tile_bins.tilesX());
+    uniforms.tiles_y = static_cast<float>(_tile_bins.tilesY());
+    uniforms.has_3d = _tile_bins.has3D() ? 1.0f : 0.0f;
+
     wgpuQueueWriteBuffer(ctx.getQueue(), _uniform_buffer, 0, &uniforms, sizeof(uniforms));
 
-    if (_primitives_dirty && !_primitives.empty()) {
-        wgpuQueueWriteBuffer(ctx.getQueue(), _primitive_buffer, 0,
-                             _primitives.data(), _primitives.size() * sizeof(YDrawPrimitiveGPU));
-        _primitives_dirty = false;
+    // Only the changed range goes over the bus
+    if (_dirty_begin < _dirty_end) {
+        size_t end = std::min(_dirty_end, _primitives.size());
+        if (_dirty_begin < end) {
+            wgpuQueueWriteBuffer(ctx.getQueue(), _primitive_buffer,
+                                 _dirty_begin * sizeof(YDrawPrimitiveGPU),
+                                 _primitives.data() + _dirty_begin,
+                                 (end - _dirty_begin) * sizeof(YDrawPrimitiveGPU));
+        }
+        _dirty_begin = _dirty_end = 0;
     }
 
     wgpuRenderPassEncoderSetPipeline(pass, _pipeline);
@@ -1247,17 +1219,19 @@ Result<void> YDrawRenderer::createPipeline(WebGPUContext& ctx, WGPUTextureFormat
 
     // Uniform buffer
     WGPUBufferDescriptor bufDesc = {};
-    bufDesc.size = 32;
+    bufDesc.size = UNIFORM_SIZE;
     bufDesc.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
     _uniform_buffer = wgpuDeviceCreateBuffer(device, &bufDesc);
     if (!_uniform_buffer) return Err<void>("Failed to create uniform buffer");
 
-    // Primitive storage buffer
+    // Primitive storage buffer, grown by ensurePrimitiveCapacity()
+    size_t capacity = std::max(MIN_PRIMITIVE_CAPACITY, _primitives.size());
     WGPUBufferDescriptor primBufDesc = {};
-    primBufDesc.size = MAX_PRIMITIVES * sizeof(YDrawPrimitiveGPU);
+    primBufDesc.size = capacity * sizeof(YDrawPrimitiveGPU);
     primBufDesc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
     _primitive_buffer = wgpuDeviceCreateBuffer(device, &primBufDesc);
     if (!_primitive_buffer) return Err<void>("Failed to create primitive buffer");
+    _primitive_capacity = capacity;
 
     // Shader
     WGPUShaderSourceWGSL wgslDesc = {};
@@ -1265,23 +1239,37 @@ Result<void> YDrawRenderer::createPipeline(WebGPUContext& ctx, WGPUTextureFormat
     wgslDesc.code = WGPU_STR(YDRAW_SHADER);
     WGPUShaderModuleDescriptor shaderDesc = {};
     shaderDesc.nextInChain = &wgslDesc.chain;
-    WGPUShaderModule shaderModule = wgpuDeviceCreateShaderModule(device, &shaderDesc);
+    WGPUShaderModule shaderModule = ctx.shaderCache().createShaderModule(&shaderDesc);
     if (!shaderModule) return Err<void>("Failed to create shader module");
 
+    // Tile list buffer, grown by uploadTiles() when a layout needs more
+    WGPUBufferDescriptor tileBufDesc = {};
+    tileBufDesc.size = MIN_TILE_BUFFER_SIZE;
+    tileBufDesc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+    _tile_buffer = wgpuDeviceCreateBuffer(device, &tileBufDesc);
+    if (!_tile_buffer) {
+        wgpuShaderModuleRelease(shaderModule);
+        return Err<void>("Failed to create tile buffer");
+    }
+    _tile_buffer_size = MIN_TILE_BUFFER_SIZE;
+
     // Bind group layout
-    WGPUBindGroupLayoutEntry entries[2] = {};
+    WGPUBindGroupLayoutEntry entries[3] = {};
     entries[0].binding = 0;
     entries[0].visibility = WGPUShaderStage_Vertex | WGPUShaderStage_Fragment;
     entries[0].buffer.type = WGPUBufferBindingType_Uniform;
     entries[1].binding = 1;
     entries[1].visibility = WGPUShaderStage_Fragment;
     entries[1].buffer.type = WGPUBufferBindingType_ReadOnlyStorage;
+    entries[2].binding = 2;
+    entries[2].visibility = WGPUShaderStage_Fragment;
+    entries[2].buffer.type = WGPUBufferBindingType_ReadOnlyStorage;
 
     WGPUBindGroupLayoutDescriptor bglDesc = {};
-    bglDesc.entryCount = 2;
+    bglDesc.entryCount = 3;
     bglDesc.entries = entries;
-    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDesc);
-    if (!bgl) {
+    _bind_group_layout = ctx.shaderCache().createBindGroupLayout(&bglDesc);
+    if (!_bind_group_layout) {
         wgpuShaderModuleRelease(shaderModule);
         return Err<void>("Failed to create bind group layout");
     }
@@ -1289,23 +1277,14 @@ Result<void> YDrawRenderer::createPipeline(WebGPUContext& ctx, WGPUTextureFormat
     // Pipeline layout
     WGPUPipelineLayoutDescriptor plDesc = {};
     plDesc.bindGroupLayoutCount = 1;
-    plDesc.bindGroupLayouts = &bgl;
-    WGPUPipelineLayout pipelineLayout = wgpuDeviceCreatePipelineLayout(device, &plDesc);
+    plDesc.bindGroupLayouts = &_bind_group_layout;
+    WGPUPipelineLayout pipelineLayout = ctx.shaderCache().createPipelineLayout(&plDesc);
 
-    // Bind group
-    WGPUBindGroupEntry bgE[2] = {};
-    bgE[0].binding = 0;
-    bgE[0].buffer = _uniform_buffer;
-    bgE[0].size = 32;
-    bgE[1].binding = 1;
-    bgE[1].buffer = _primitive_buffer;
-    bgE[1].size = MAX_PRIMITIVES * sizeof(YDrawPrimitiveGPU);
-
-    WGPUBindGroupDescriptor bgDesc = {};
-    bgDesc.layout = bgl;
-    bgDesc.entryCount = 2;
-    bgDesc.entries = bgE;
-    _bind_group = wgpuDeviceCreateBindGroup(device, &bgDesc);
+    if (auto res = createBindGroup(device); !res) {
+        wgpuShaderModuleRelease(shaderModule);
+        wgpuPipelineLayoutRelease(pipelineLayout);
+        return res;
+    }
 
     // Render pipeline
     WGPURenderPipelineDescriptor pipelineDesc = {};
@@ -1338,10 +1317,9 @@ Result<void> YDrawRenderer::createPipeline(WebGPUContext& ctx, WGPUTextureFormat
     pipelineDesc.multisample.count = 1;
     pipelineDesc.multisample.mask = ~0u;
 
-    _pipeline = wgpuDeviceCreateRenderPipeline(device, &pipelineDesc);
+    _pipeline = ctx.shaderCache().createRenderPipeline(&pipelineDesc);
 
     wgpuShaderModuleRelease(shaderModule);
-    wgpuBindGroupLayoutRelease(bgl);
     wgpuPipelineLayoutRelease(pipelineLayout);
 
     if (!_pipeline) return Err<void>("Failed to create render pipeline");
@@ -1350,6 +1328,89 @@ Result<void> YDrawRenderer::createPipeline(WebGPUContext& ctx, WGPUTextureFormat
     return Ok();
 }
 
+Result<void> YDrawRenderer::createBindGroup(WGPUDevice device) {
+    if (_bind_group) {
+        wgpuBindGroupRelease(_bind_group);
+        _bind_group = nullptr;
+    }
+
+    WGPUBindGroupEntry bgE[3] = {};
+    bgE[0].binding = 0;
+    bgE[0].buffer = _uniform_buffer;
+    bgE[0].size = UNIFORM_SIZE;
+    bgE[1].binding = 1;
+    bgE[1].buffer = _primitive_buffer;
+    bgE[1].size = _primitive_capacity * sizeof(YDrawPrimitiveGPU);
+    bgE[2].binding = 2;
+    bgE[2].buffer = _tile_buffer;
+    bgE[2].size = _tile_buffer_size;
+
+    WGPUBindGroupDescriptor bgDesc = {};
+    bgDesc.layout = _bind_group_layout;
+    bgDesc.entryCount = 3;
+    bgDesc.entries = bgE;
+    _bind_group = wgpuDeviceCreateBindGroup(device, &bgDesc);
+    if (!_bind_group) return Err<void>("Failed to create bind group");
+    return Ok();
+}
+
+Result<void> YDrawRenderer::ensurePrimitiveCapacity(WGPUDevice device, size_t count) {
+    if (count <= _primitive_capacity) return Ok();
+
+    // Geometric growth keeps bind group churn logarithmic in scene size
+    size_t capacity = std::max(_primitive_capacity, MIN_PRIMITIVE_CAPACITY);
+    while (capacity < count) capacity *= 2;
+
+    WGPUBufferDescriptor desc = {};
+    desc.size = capacity * sizeof(YDrawPrimitiveGPU);
+    desc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &desc);
+    if (!buffer) return Err<void>("Failed to grow primitive buffer");
+
+    wgpuBufferRelease(_primitive_buffer);
+    _primitive_buffer = buffer;
+    _primitive_capacity = capacity;
+    ydebug("YDrawRenderer: primitive buffer grown to {} primitives", capacity);
+
+    // The new buffer starts empty
+    markDirty(0, _primitives.size());
+    return createBindGroup(device);
+}
+
+Result<void> YDrawRenderer::uploadTiles(WebGPUContext& ctx, float width, float height) {
+    _tile_bins.build(_primitives, width, height);
+    _bins_dirty = false;
+    _binned_width = width;
+    _binned_height = height;
+
+    const auto& data = _tile_bins.data();
+    size_t bytes = data.size() * sizeof(uint32_t);
+
+    if (bytes > _tile_buffer_size) {
+        // Grow geometrically so a slowly growing scene does not recreate
+        // the buffer and bind group every frame
+        size_t newSize = _tile_buffer_size;
+        while (newSize < bytes) newSize *= 2;
+
+        WGPUBufferDescriptor desc = {};
+        desc.size = newSize;
+        desc.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(ctx.getDevice(), &desc);
+        if (!buffer) return Err<void>("Failed to grow tile buffer");
+
+        wgpuBufferRelease(_tile_buffer);
+        _tile_buffer = buffer;
+        _tile_buffer_size = newSize;
+        if (auto res = createBindGroup(ctx.getDevice()); !res) {
+            return res;
+        }
+        ydebug("YDrawRenderer: tile buffer grown to {} bytes", newSize);
+    }
+
+    wgpuQueueWriteBuffer(ctx.getQueue(), _tile_buffer, 0, data.data(), bytes);
+    return Ok();
+}
+
 //-----------------------------------------------------------------------------
 // Helper functions for building primitives
 //-----------------------------------------------------------------------------
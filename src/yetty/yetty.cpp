@@ -617,7 +617,9 @@ setup_shader_manager:
   _shaderManager = std::make_shared<ShaderManager>();
   std::string shaderPath =
       std::string(CMAKE_SOURCE_DIR) + "/src/yetty/shaders/";
-  if (auto res = _shaderManager->init(_ctx->getDevice(), shaderPath); !res) {
+  if (auto res = _shaderManager->init(_ctx->getDevice(), shaderPath,
+                                      &_ctx->shaderCache());
+      !res) {
     ywarn("Failed to init ShaderManager: {} - cursor shader disabled",
                  error_msg(res));
     _shaderManager.reset();
@@ -0,0 +1,127 @@
+//=============================================================================
+// Glyph Line Index Unit Tests
+//
+// Tests for the line index RichText uses to cull glyphs outside the viewport
+// Covers: empty index, viewports above/below/inside the content, boundary
+// lines, tall glyphs widening the margin, randomized intersection check
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/glyph-line-index.h"
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+constexpr float LINE = 20.0f;     // Line pitch
+constexpr float ASCENT = 14.0f;   // Glyph extent above the baseline
+constexpr float DESCENT = 4.0f;   // Glyph extent below the baseline
+
+// `lines` lines of `perLine` glyphs, baselines at LINE * (i + 1)
+GlyphLineIndex makeIndex(int lines, int perLine) {
+    GlyphLineIndex index;
+    for (int i = 0; i < lines; i++) {
+        float baseline = LINE * (i + 1);
+        for (int g = 0; g < perLine; g++) {
+            index.add(baseline, baseline - ASCENT, baseline + DESCENT);
+        }
+    }
+    return index;
+}
+
+} // namespace
+
+suite glyph_line_index_tests = [] {
+    "empty index has nothing visible"_test = [] {
+        GlyphLineIndex index;
+        auto [first, last] = index.visible(0.0f, 1000.0f);
+        expect(first == last);
+        expect(index.lineCount() == 0_u);
+    };
+
+    "glyphs on one baseline share a line"_test = [] {
+        auto index = makeIndex(10, 5);
+        expect(index.lineCount() == 10_u);
+        expect(index.instanceCount() == 50_u);
+        expect(index.lines()[3].first == 15_u && index.lines()[3].count == 5_u);
+    };
+
+    "viewports outside the content draw nothing"_test = [] {
+        auto index = makeIndex(10, 5);
+        auto [aFirst, aLast] = index.visible(-100.0f, 0.0f);
+        expect(aFirst == aLast);
+        auto [bFirst, bLast] = index.visible(500.0f, 600.0f);
+        expect(bFirst == bLast);
+    };
+
+    "viewport selects only the lines it intersects"_test = [] {
+        auto index = makeIndex(100, 3);
+        // Lines 10..14 have baselines 220..300 and span [b - 14, b + 4]
+        auto [first, last] = index.visible(210.0f, 290.0f);
+        expect(first == 30_u) << "line 10 starts at 206";
+        expect(last == 45_u) << "line 15 starts at 306";
+    };
+
+    "lines touching the edges are kept, lines just past them are not"_test = [] {
+        auto index = makeIndex(10, 1);
+        // Line 0 spans [6, 24], line 1 spans [26, 44]
+        auto [first, last] = index.visible(24.5f, 25.5f);
+        expect(first == last) << "gap between lines";
+        auto [tFirst, tLast] = index.visible(23.9f, 25.5f);
+        expect(tFirst == 0_u && tLast == 1_u);
+        auto [bFirst, bLast] = index.visible(24.5f, 26.1f);
+        expect(bFirst == 1_u && bLast == 2_u);
+    };
+
+    "a tall glyph widens the margin so it is never culled"_test = [] {
+        GlyphLineIndex index;
+        for (int i = 0; i < 10; i++) {
+            float baseline = LINE * (i + 1);
+            float top = i == 5 ? baseline - 100.0f : baseline - ASCENT;
+            index.add(baseline, top, baseline + DESCENT);
+        }
+        // Line 5 (baseline 120) reaches up to 20
+        auto [first, last] = index.visible(0.0f, 30.0f);
+        expect(first == 0_u);
+        expect(last >= 6_u);
+    };
+
+    "every glyph intersecting the viewport is in the range"_test = [] {
+        std::mt19937 rng(47);
+        std::uniform_real_distribution<float> height(8.0f, 40.0f);
+        std::uniform_int_distribution<int> count(0, 6);
+        std::uniform_real_distribution<float> scroll(-200.0f, 6000.0f);
+
+        struct Glyph { float top, bottom; };
+        std::vector<Glyph> glyphs;
+        GlyphLineIndex index;
+        float baseline = 0.0f;
+        for (int line = 0; line < 300; line++) {
+            baseline += height(rng) * 0.75f;
+            for (int n = count(rng); n > 0; n--) {
+                float h = height(rng);
+                Glyph g{baseline - h * 0.8f, baseline + h * 0.2f};
+                glyphs.push_back(g);
+                index.add(baseline, g.top, g.bottom);
+            }
+        }
+
+        bool covered = true;
+        uint64_t drawn = 0;
+        for (int trial = 0; trial < 200; trial++) {
+            float top = scroll(rng);
+            float bottom = top + 400.0f;
+            auto [first, last] = index.visible(top, bottom);
+            for (uint32_t i = 0; i < glyphs.size(); i++) {
+                bool intersects = glyphs[i].bottom > top && glyphs[i].top < bottom;
+                if (intersects && (i < first || i >= last)) covered = false;
+            }
+            drawn += last - first;
+        }
+        expect(covered);
+        expect(drawn < 200 * glyphs.size() / 2) << "culling keeps a fraction of the glyphs";
+    };
+};
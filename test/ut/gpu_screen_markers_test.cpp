@@ -0,0 +1,163 @@
+//=============================================================================
+// GPUScreen Widget Marker Tests
+//
+// Tests for the incremental widget marker tracking in GPUScreen
+// Covers: markers set/overwritten/erased, moves with scrolling, insert and
+// delete of lines and chars, resize, and a fuzz cross-check against the
+// full-screen scan
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/gpu-screen.h"
+#include <map>
+#include <random>
+#include <string>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+constexpr int ROWS = 12;
+constexpr int COLS = 30;
+
+// GPUScreen attached to a real vterm, without a font
+struct Screen {
+    VTerm* vt;
+    GPUScreen screen;
+
+    Screen(int rows = ROWS, int cols = COLS) : vt(vterm_new(rows, cols)), screen(rows, cols, nullptr, 50) {
+        vterm_set_utf8(vt, 1);
+        screen.attach(vt);
+    }
+    ~Screen() { vterm_free(vt); }
+
+    void feed(const std::string& data) { vterm_input_write(vt, data.data(), data.size()); }
+};
+
+// What Terminal got from applying scanWidgetPositions() in order
+std::map<uint16_t, std::pair<int, int>> fromScan(const GPUScreen& screen) {
+    std::map<uint16_t, std::pair<int, int>> out;
+    for (const auto& pos : screen.scanWidgetPositions()) {
+        out[pos.widgetId] = {pos.row, pos.col};
+    }
+    return out;
+}
+
+std::map<uint16_t, std::pair<int, int>> tracked(GPUScreen& screen) {
+    std::map<uint16_t, std::pair<int, int>> out;
+    for (const auto& [id, pos] : screen.widgetPositions()) {
+        out[id] = {pos.row, pos.col};
+    }
+    return out;
+}
+
+std::string cup(int row, int col) {
+    return "\033[" + std::to_string(row + 1) + ";" + std::to_string(col + 1) + "H";
+}
+
+} // namespace
+
+suite gpu_screen_markers_tests = [] {
+    "set and overwritten markers are tracked"_test = [] {
+        Screen s;
+        s.screen.setWidgetMarker(3, 4, 7);
+        expect(s.screen.widgetPositions().at(7).row == 3_i);
+        expect(s.screen.widgetPositions().at(7).col == 4_i);
+
+        s.feed(cup(3, 4) + "x");
+        expect(s.screen.widgetPositions().empty()) << "printing over the marker removes it";
+    };
+
+    "typing next to a marker does not touch the positions"_test = [] {
+        Screen s;
+        s.screen.setWidgetMarker(2, 0, 1);
+        (void)s.screen.widgetPositions();
+        uint64_t generation = s.screen.widgetPositionsGeneration();
+        s.feed(cup(2, 5) + "hello");
+        s.feed(cup(5, 0) + "\033[K");
+        expect(s.screen.widgetPositionsGeneration() == generation);
+    };
+
+    "markers move with scrolling and leave into scrollback"_test = [] {
+        Screen s;
+        s.screen.setWidgetMarker(1, 2, 9);
+        s.feed(cup(ROWS - 1, 0) + "\n");
+        expect(s.screen.widgetPositions().at(9).row == 0_i);
+
+        s.feed("\n\n");
+        expect(s.screen.widgetPositions().at(9).row == -2_i) << "negative once in scrollback";
+        expect(tracked(s.screen) == fromScan(s.screen));
+    };
+
+    "insert and delete lines and chars move markers"_test = [] {
+        Screen s;
+        s.screen.setWidgetMarker(4, 10, 3);
+        s.feed(cup(2, 0) + "\033[2L");   // Insert 2 lines above
+        expect(s.screen.widgetPositions().at(3).row == 6_i);
+        s.feed(cup(6, 0) + "\033[3@");   // Insert 3 chars before it
+        expect(s.screen.widgetPositions().at(3).col == 13_i);
+        s.feed(cup(6, 0) + "\033[P");    // Delete 1 char
+        expect(s.screen.widgetPositions().at(3).col == 12_i);
+        s.feed(cup(6, 0) + "\033[M");    // Delete its line
+        expect(s.screen.widgetPositions().empty());
+        expect(tracked(s.screen) == fromScan(s.screen));
+    };
+
+    "resize keeps markers that still fit"_test = [] {
+        Screen s;
+        s.screen.setWidgetMarker(2, 3, 1);
+        s.screen.setWidgetMarker(10, 25, 2);
+        s.screen.resize(8, 20);
+        expect(tracked(s.screen) == fromScan(s.screen));
+        expect(s.screen.widgetPositions().count(1) == 1_u);
+        expect(s.screen.widgetPositions().count(2) == 0_u);
+    };
+
+    "fuzz: incremental positions match the full scan"_test = [] {
+        std::mt19937 rng(50);
+        auto pick = [&](int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); };
+
+        int mismatches = 0;
+        int staleGenerations = 0;
+        for (int round = 0; round < 20; round++) {
+            Screen s;
+            auto last = tracked(s.screen);
+            uint64_t lastGeneration = s.screen.widgetPositionsGeneration();
+
+            for (int step = 0; step < 400; step++) {
+                int row = pick(ROWS), col = pick(COLS), n = 1 + pick(4);
+                switch (pick(12)) {
+                case 0: case 1:
+                    s.screen.setWidgetMarker(row, col, static_cast<uint16_t>(1 + pick(6)));
+                    break;
+                case 2: s.feed(cup(row, col) + std::string(n, 'a' + pick(26))); break;
+                case 3: s.feed(cup(row, col) + "\n\n"); break;
+                case 4: s.feed(cup(row, col) + "\033[" + std::to_string(n) + "L"); break;
+                case 5: s.feed(cup(row, col) + "\033[" + std::to_string(n) + "M"); break;
+                case 6: s.feed(cup(row, col) + "\033[" + std::to_string(n) + "@"); break;
+                case 7: s.feed(cup(row, col) + "\033[" + std::to_string(n) + "P"); break;
+                case 8: s.feed(cup(row, col) + "\033[" + std::to_string(pick(3)) + "K"); break;
+                case 9: s.feed(cup(row, col) + "\033[" + std::to_string(pick(3)) + "J"); break;
+                case 10: {
+                    int top = pick(ROWS - 2);
+                    int bottom = top + 2 + pick(ROWS - top - 2);
+                    s.feed("\033[" + std::to_string(top + 1) + ";" + std::to_string(bottom) + "r" +
+                           cup(bottom - 1, 0) + "\n\033[r");
+                    break;
+                }
+                default: s.feed(cup(row, col) + "\033[" + std::to_string(n) + "S"); break;
+                }
+
+                auto now = tracked(s.screen);
+                if (now != fromScan(s.screen)) mismatches++;
+                uint64_t generation = s.screen.widgetPositionsGeneration();
+                if (now != last && generation == lastGeneration) staleGenerations++;
+                last = std::move(now);
+                lastGeneration = generation;
+            }
+        }
+        expect(mismatches == 0_i);
+        expect(staleGenerations == 0_i) << "every change bumps the generation";
+    };
+};
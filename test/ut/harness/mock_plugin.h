@@ -36,11 +36,17 @@ public:
     Result<void> render(WGPURenderPassEncoder pass, WebGPUContext& ctx, bool on) override {
         (void)pass;
         (void)ctx;
-        (void)on;
-        _renderCount++;
+        noteFrame(on);
         return Ok();
     }
 
+    // What render() records, callable without a GPU context
+    void noteFrame(bool on) {
+        if (on != _lastOn) _onTransitions++;
+        _lastOn = on;
+        if (on) _renderCount++;
+    }
+
     bool onMouseMove(float localX, float localY) override {
         _lastMouseX = localX;
         _lastMouseY = localY;
@@ -61,7 +67,9 @@ public:
     // Test inspection
     bool initCalled() const { return _initCalled; }
     bool disposeCalled() const { return _disposeCalled; }
-    int renderCount() const { return _renderCount; }
+    int renderCount() const { return _renderCount; }  // Renders with on=true
+    bool lastOn() const { return _lastOn; }
+    int onTransitions() const { return _onTransitions; }
     float lastMouseX() const { return _lastMouseX; }
     float lastMouseY() const { return _lastMouseY; }
     int mouseMoveCount() const { return _mouseMoveCount; }
@@ -84,6 +92,8 @@ private:
     bool _initCalled = false;
     bool _disposeCalled = false;
     int _renderCount = 0;
+    bool _lastOn = true;
+    int _onTransitions = 0;
     float _lastMouseX = 0;
     float _lastMouseY = 0;
     int _lastButton = 0;
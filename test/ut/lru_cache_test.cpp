@@ -0,0 +1,129 @@
+//=============================================================================
+// LruCache Unit Tests
+//
+// Tests for the cost-bounded least-recently-used cache
+// Covers: lookup, recency, budget eviction, replacement, evict callback,
+// pinned entries
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/lru-cache.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+suite lru_cache_tests = [] {
+    "LruCache get returns inserted values"_test = [] {
+        LruCache<int, std::string> cache(100);
+        cache.put(1, "one", 10);
+        cache.put(2, "two", 10);
+
+        expect(cache.size() == 2_u);
+        expect(cache.cost() == 20_u);
+        expect(cache.get(1) != nullptr && *cache.get(1) == "one");
+        expect(cache.get(3) == nullptr);
+    };
+
+    "LruCache evicts least recently used over budget"_test = [] {
+        LruCache<int, int> cache(30);
+        cache.put(1, 1, 10);
+        cache.put(2, 2, 10);
+        cache.put(3, 3, 10);
+
+        // Touch 1, so 2 is now the coldest
+        expect(cache.get(1) != nullptr);
+        cache.put(4, 4, 10);
+
+        expect(cache.contains(1));
+        expect(!cache.contains(2)) << "Coldest entry should be evicted";
+        expect(cache.contains(3));
+        expect(cache.contains(4));
+        expect(cache.cost() == 30_u);
+    };
+
+    "LruCache peek does not change recency"_test = [] {
+        LruCache<int, int> cache(20);
+        cache.put(1, 1, 10);
+        cache.put(2, 2, 10);
+
+        expect(cache.peek(1) != nullptr);
+        cache.put(3, 3, 10);
+        expect(!cache.contains(1)) << "peek must not promote the entry";
+    };
+
+    "LruCache replace updates value and cost"_test = [] {
+        LruCache<int, int> cache(100);
+        cache.put(1, 1, 10);
+        cache.put(1, 5, 40);
+
+        expect(cache.size() == 1_u);
+        expect(cache.cost() == 40_u);
+        expect(*cache.get(1) == 5_i);
+    };
+
+    "LruCache keeps a single oversized entry"_test = [] {
+        LruCache<int, int> cache(10);
+        cache.put(1, 1, 5);
+        cache.put(2, 2, 50);
+
+        expect(!cache.contains(1));
+        expect(cache.contains(2)) << "Newest entry is never evicted";
+        expect(cache.size() == 1_u);
+    };
+
+    "LruCache calls evict callback"_test = [] {
+        std::vector<int> evicted;
+        LruCache<int, int> cache(20, [&](const int& key, int&) { evicted.push_back(key); });
+        cache.put(1, 1, 10);
+        cache.put(2, 2, 10);
+        cache.put(3, 3, 10);
+        cache.setBudget(10);
+
+        expect(evicted.size() == 2_u);
+        expect(evicted[0] == 1_i);
+        expect(evicted[1] == 2_i);
+    };
+
+    "LruCache skips pinned entries when evicting"_test = [] {
+        std::vector<int> inUse = {1};
+        LruCache<int, int> cache(20);
+        cache.setPinned([&](const int& key, const int&) {
+            return std::find(inUse.begin(), inUse.end(), key) != inUse.end();
+        });
+        cache.put(1, 1, 10);
+        cache.put(2, 2, 10);
+        cache.put(3, 3, 10);
+
+        expect(cache.contains(1)) << "Pinned, although least recently used";
+        expect(!cache.contains(2));
+        expect(cache.cost() == 20_u);
+
+        // Nothing left to evict: pinned entries may exceed the budget
+        inUse = {1, 3};
+        cache.put(4, 4, 10);
+        expect(cache.size() == 3_u && cache.cost() == 30_u);
+
+        // Unpinned again, trimmed on request
+        inUse.clear();
+        cache.trim();
+        expect(cache.size() == 2_u);
+        expect(cache.contains(4) && !cache.contains(1));
+    };
+
+    "LruCache erase and clear"_test = [] {
+        LruCache<int, int> cache(100);
+        cache.put(1, 1, 10);
+        cache.put(2, 2, 10);
+
+        expect(cache.erase(1));
+        expect(!cache.erase(1));
+        expect(cache.cost() == 10_u);
+
+        cache.clear();
+        expect(cache.empty());
+        expect(cache.cost() == 0_u);
+    };
+};
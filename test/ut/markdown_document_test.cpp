@@ -0,0 +1,192 @@
+//=============================================================================
+// Markdown Document Unit Tests
+//
+// Tests for the markdown widget's parser and incremental block layout
+// Covers: parsing, tail-only append, wrapping, resize reuse, shared cache
+// entries, lazy viewport layout, and 10k-line resize/append counts
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/plugins/markdown/markdown-document.h"
+#include <limits>
+#include <string>
+
+using namespace boost::ut;
+using namespace yetty;
+using namespace yetty::plugins;
+
+namespace {
+
+constexpr float FONT_SIZE = 16.0f;
+constexpr float ADVANCE = 10.0f;  // Per glyph at FONT_SIZE
+constexpr float ALL = std::numeric_limits<float>::max();
+
+// Monospace stand-in for font metrics, through the shared run cache
+void setupDocument(MarkdownDocument& doc, float width) {
+    static const int FAKE_FONT = 0;
+    doc.setFontSize(FONT_SIZE);
+    doc.setMeasure([](std::u32string_view word, Font::Style style, float size) {
+        return TextLayoutCache::shared().shape(&FAKE_FONT, 0, style, size, word,
+                                               [size](uint32_t) { return ADVANCE * size / FONT_SIZE; });
+    });
+    doc.setWidth(width);
+}
+
+// Changelog-like text: headers, bullets, inline code and long paragraphs
+std::string changelog(int lines) {
+    std::string out;
+    for (int i = 0; i < lines; i++) {
+        switch (i % 8) {
+        case 0: out += "## Release 1." + std::to_string(i / 8) + "\n"; break;
+        case 1: out += "\n"; break;
+        case 2: out += "- Fixed `parser` crash on **empty** input (#" + std::to_string(i) + ")\n"; break;
+        case 3: out += "- Faster *startup*\n"; break;
+        case 4:
+            out += "This release reworks the renderer so that long documents scroll smoothly, "
+                   "and it also brings a number of smaller fixes listed below. Item " +
+                   std::to_string(i) + "\n";
+            break;
+        case 5: out += "* Updated dependencies\n"; break;
+        case 6: out += "---\n"; break;
+        default: out += "Plain line " + std::to_string(i) + "\n"; break;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+suite markdown_document_tests = [] {
+    "parse recognises headers, bullets and inline styles"_test = [] {
+        auto header = MarkdownDocument::parseLine("# Title");
+        expect(header.scale > 1.0f);
+        expect(header.spans.size() == 1_u && header.spans[0].style == Font::Bold);
+
+        auto bullet = MarkdownDocument::parseLine("- a `b` **c** *d*");
+        expect(bullet.indent == 20.0f);
+        expect(bullet.spans.size() == 7_u);
+        expect(bullet.spans[0].isBullet);
+        expect(bullet.spans[2].isCode && bullet.spans[2].text == "b");
+        expect(bullet.spans[4].style == Font::Bold);
+        expect(bullet.spans[6].style == Font::Italic);
+
+        auto empty = MarkdownDocument::parseLine("");
+        expect(empty.spans.size() == 1_u);
+    };
+
+    "append parses only the new tail"_test = [] {
+        MarkdownDocument doc;
+        setupDocument(doc, 400.0f);
+        doc.setContent("a\nb");
+        expect(doc.blockCount() == 2_u);
+        expect(doc.linesParsed() == 2_u);
+
+        // "b" was unterminated, so it joins the appended text
+        doc.append("c\nd\n");
+        expect(doc.blockCount() == 3_u);
+        expect(doc.linesParsed() == 4_u) << "Only the open line and the new lines";
+
+        MarkdownDocument whole;
+        setupDocument(whole, 400.0f);
+        whole.setContent("a\nbc\nd\n");
+        expect(whole.blockCount() == doc.blockCount());
+        for (size_t i = 0; i < whole.blockCount(); i++) {
+            expect(whole.block(i).hash == doc.block(i).hash);
+            expect(whole.block(i).y == doc.block(i).y);
+        }
+    };
+
+    "long lines wrap at the width"_test = [] {
+        MarkdownDocument doc;
+        setupDocument(doc, 205.0f);
+        doc.setContent(std::string(100, 'x') + "\n");
+        doc.layoutRange(0.0f, ALL);
+
+        const auto& block = doc.block(0);
+        expect(block.layout != nullptr);
+        expect(block.layout->wrapped);
+        expect(block.layout->glyphs.size() == 100_u);
+        // 20 glyphs per row -> 5 rows
+        expect(block.height == 5.0f * FONT_SIZE * 1.4f);
+        bool inside = true;
+        for (const auto& g : block.layout->glyphs) {
+            inside = inside && g.x + ADVANCE <= 205.0f;
+        }
+        expect(inside);
+    };
+
+    "resizing re-lays out only lines that wrap"_test = [] {
+        MarkdownDocument doc;
+        setupDocument(doc, 400.0f);
+        doc.setContent("short\n" + std::string(60, 'y') + "\nalso short\n");
+        doc.layoutRange(0.0f, ALL);
+        expect(doc.blocksLaidOut() == 3_u);
+
+        doc.setWidth(300.0f);
+        doc.layoutRange(0.0f, ALL);
+        expect(doc.blocksLaidOut() == 4_u) << "Only the 600px line is redone";
+
+        // Back to the first width: the wrapped layout is still cached
+        doc.setWidth(400.0f);
+        doc.layoutRange(0.0f, ALL);
+        expect(doc.blocksLaidOut() == 4_u);
+        expect(doc.cacheHits() >= 1_u);
+    };
+
+    "identical lines share a cached layout"_test = [] {
+        MarkdownDocument doc;
+        setupDocument(doc, 400.0f);
+        std::string text;
+        for (int i = 0; i < 50; i++) text += "---\n";
+        doc.setContent(text);
+        doc.layoutRange(0.0f, ALL);
+        expect(doc.blocksLaidOut() == 1_u);
+        expect(doc.cacheHits() == 49_u);
+    };
+
+    "only blocks in the requested range are laid out"_test = [] {
+        MarkdownDocument doc;
+        setupDocument(doc, 800.0f);
+        doc.setContent(changelog(10000));
+        doc.layoutRange(0.0f, 600.0f);
+
+        expect(doc.blocksLaidOut() < 100_u);
+        expect(doc.contentHeight() > 10000.0f * FONT_SIZE) << "Estimates cover the rest";
+
+        // A block deep in the document is found and laid out on demand
+        size_t deep = doc.blockAt(doc.contentHeight() / 2.0f);
+        expect(doc.block(deep).layout == nullptr);
+        doc.layoutRange(doc.block(deep).y, doc.block(deep).y + 600.0f);
+        expect(doc.block(deep).layout != nullptr);
+    };
+
+    "10k-line document: resize and append stay incremental"_test = [] {
+        const std::string text = changelog(10000);
+        constexpr float VIEW = 900.0f;  // Viewport plus a screen of margin each way
+
+        // What a full relayout costs: every block at the new width
+        MarkdownDocument full;
+        setupDocument(full, 800.0f);
+        full.setContent(text);
+        full.layoutRange(0.0f, ALL);
+
+        // Widget path: parse once, lay out the window, then resize twice
+        MarkdownDocument doc;
+        setupDocument(doc, 800.0f);
+        doc.setContent(text);
+        doc.layoutRange(0.0f, VIEW);
+        uint64_t before = doc.blocksLaidOut();
+        doc.setWidth(640.0f);
+        doc.layoutRange(0.0f, VIEW);
+        doc.setWidth(800.0f);
+        doc.layoutRange(0.0f, VIEW);
+        uint64_t relaid = doc.blocksLaidOut() - before;
+
+        uint64_t parsedBefore = doc.linesParsed();
+        doc.append("- one more entry\n");
+
+        expect(full.blocksLaidOut() > 1000_u);
+        expect(relaid < 100_u) << "A resize lays out the window, not the document";
+        expect(doc.linesParsed() - parsedBefore == 1_u);
+    };
+};
@@ -0,0 +1,88 @@
+//=============================================================================
+// Mip Chain Unit Tests
+//
+// Tests for the CPU box filter used before uploading images
+// Covers: sizes, averaging, non-integer ratios, alpha, chain length
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/mip-chain.h"
+#include <cstdint>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+std::vector<uint8_t> solid(uint32_t w, uint32_t h, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    for (size_t i = 0; i < px.size(); i += 4) {
+        px[i] = r; px[i + 1] = g; px[i + 2] = b; px[i + 3] = a;
+    }
+    return px;
+}
+
+} // namespace
+
+suite mip_chain_tests = [] {
+    "downsample averages a 2x2 block"_test = [] {
+        // Black, white, black, white -> mid grey
+        std::vector<uint8_t> px = {
+            0, 0, 0, 255,       255, 255, 255, 255,
+            0, 0, 0, 255,       255, 255, 255, 255,
+        };
+        MipLevel l = downsampleRGBA8(px.data(), 2, 2, 1, 1);
+        expect(l.width == 1_u && l.height == 1_u);
+        expect(l.pixels[0] == 128_i || l.pixels[0] == 127_i);
+        expect(l.pixels[3] == 255_i);
+    };
+
+    "downsample keeps solid colors exact at odd ratios"_test = [] {
+        auto px = solid(97, 61, 10, 200, 30, 255);
+        MipLevel l = downsampleRGBA8(px.data(), 97, 61, 13, 7);
+        expect(l.width == 13_u && l.height == 7_u);
+        bool exact = true;
+        for (size_t i = 0; i < l.pixels.size(); i += 4) {
+            exact = exact && l.pixels[i] == 10 && l.pixels[i + 1] == 200 &&
+                    l.pixels[i + 2] == 30 && l.pixels[i + 3] == 255;
+        }
+        expect(exact) << "Area weights must sum to one";
+    };
+
+    "downsample never enlarges"_test = [] {
+        auto px = solid(8, 4, 1, 2, 3, 4);
+        MipLevel l = downsampleRGBA8(px.data(), 8, 4, 100, 2);
+        expect(l.width == 8_u && l.height == 2_u);
+    };
+
+    "transparent pixels do not darken the average"_test = [] {
+        // Opaque red next to fully transparent black
+        std::vector<uint8_t> px = {
+            255, 0, 0, 255,     0, 0, 0, 0,
+        };
+        MipLevel l = downsampleRGBA8(px.data(), 2, 1, 1, 1);
+        expect(l.pixels[0] == 255_i) << "Color is averaged premultiplied";
+        expect(l.pixels[3] == 128_i || l.pixels[3] == 127_i);
+    };
+
+    "chain halves down to 1x1"_test = [] {
+        auto px = solid(1000, 600, 50, 50, 50, 255);
+        auto chain = buildMipChainRGBA8(px.data(), 1000, 600, 300, 100);
+        expect(chain.size() == 9_u);
+        expect(chain[0].width == 300_u && chain[0].height == 100_u);
+        expect(chain[1].width == 150_u && chain[1].height == 50_u);
+        expect(chain.back().width == 1_u && chain.back().height == 1_u);
+        for (const auto& l : chain) {
+            expect(l.pixels.size() == size_t(l.width) * l.height * 4);
+        }
+    };
+
+    "chain of an image smaller than the cap keeps full resolution"_test = [] {
+        auto px = solid(16, 8, 9, 9, 9, 255);
+        auto chain = buildMipChainRGBA8(px.data(), 16, 8, 64, 64);
+        expect(chain.size() == 5_u);
+        expect(chain[0].width == 16_u && chain[0].height == 8_u);
+        expect(chain[0].pixels == px);
+    };
+};
@@ -0,0 +1,206 @@
+//=============================================================================
+// Plot Pyramid Unit Tests
+//
+// Tests for the min/max level-of-detail pyramid behind streaming plots
+// Covers: level layout, full builds (serial and threaded, on the worker
+// pool) and partial updates of a wrapping ring, all against a brute-force
+// min/max per bucket over the samples in arrival order
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/plugins/plot/plot-pyramid.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+// Plot rings the way Plot::appendSamples fills them, plus every sample
+// ever appended for the brute force
+struct Rings {
+    uint32_t plots, capacity;
+    uint32_t count = 0;
+    uint64_t total = 0;
+    std::vector<float> data;
+    std::vector<std::vector<float>> history;
+
+    Rings(uint32_t plots, uint32_t capacity)
+        : plots(plots), capacity(capacity), data(static_cast<size_t>(plots) * capacity, 0.0f),
+          history(plots) {}
+
+    uint64_t first() const { return total - count; }
+
+    // Append n samples per plot and, with a pyramid, refresh it over them
+    // like Plot::updateDataTexture
+    template <typename Value>
+    void append(PlotPyramid* pyramid, uint32_t n, Value value) {
+        uint64_t start = total;
+        for (uint32_t p = 0; p < plots; ++p) {
+            for (uint64_t s = start; s < start + n; ++s) {
+                float v = value(p, s);
+                data[static_cast<size_t>(p) * capacity + s % capacity] = v;
+                history[p].push_back(v);
+            }
+        }
+        total += n;
+        count = static_cast<uint32_t>(std::min<uint64_t>(capacity, uint64_t(count) + n));
+        if (pyramid) {
+            pyramid->update(data.data(), first(), count, start);
+        }
+    }
+
+    void appendRandom(PlotPyramid* pyramid, uint32_t n, std::mt19937& rng) {
+        std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+        append(pyramid, n, [&](uint32_t, uint64_t) { return value(rng); });
+    }
+};
+
+// Buckets of the window that differ from the min/max of their samples.
+// Buckets at the old end may also hold samples that left the window, but
+// only their own: never newer ones from the other end of the ring.
+int mismatches(const PlotPyramid& pyramid, const Rings& rings) {
+    if (rings.count == 0) return 0;
+    uint64_t first = rings.first();
+    uint64_t end = rings.total;
+    int bad = 0;
+    for (uint32_t p = 0; p < rings.plots; ++p) {
+        const std::vector<float>& samples = rings.history[p];
+        const float* lod = pyramid.plot(p);
+        for (uint32_t level = 1; level <= pyramid.levels(); ++level) {
+            for (uint64_t k = first >> level; k <= (end - 1) >> level; ++k) {
+                uint64_t s0 = k << level;
+                uint64_t s1 = std::min<uint64_t>((k + 1) << level, end);
+                float mn = INF, mx = -INF, allMn = INF, allMx = -INF;
+                for (uint64_t s = s0; s < s1; ++s) {
+                    allMn = std::min(allMn, samples[s]);
+                    allMx = std::max(allMx, samples[s]);
+                    if (s >= first) {
+                        mn = std::min(mn, samples[s]);
+                        mx = std::max(mx, samples[s]);
+                    }
+                }
+                uint32_t at = pyramid.levelOffset(level) +
+                              static_cast<uint32_t>(k % pyramid.levelSize(level));
+                float lodMn = lod[at * 2], lodMx = lod[at * 2 + 1];
+                if (s0 >= first) {
+                    if (lodMn != mn || lodMx != mx) bad++;
+                } else if (lodMn > mn || lodMx < mx || lodMn < allMn || lodMx > allMx) {
+                    bad++;
+                }
+            }
+        }
+    }
+    return bad;
+}
+
+} // namespace
+
+suite plot_pyramid_tests = [] {
+    "levels halve down to one bucket, each a ring of slots"_test = [] {
+        PlotPyramid pyramid;
+        pyramid.layout(2, 5);
+        expect(pyramid.levels() == 3_u);
+        expect(pyramid.levelSize(1) == 4_u && pyramid.levelSize(2) == 4_u && pyramid.levelSize(3) == 2_u);
+        expect(pyramid.levelOffset(3) == 8_u);
+        expect(pyramid.buckets() == 10_u);
+        expect(pyramid.period() == 16_u);
+        expect(PlotPyramid::bucketsFor(5) == 10_u);
+        expect(PlotPyramid::bucketsFor(4096) == 8190_u);
+        expect(PlotPyramid::bucketsFor(1) == 0_u);
+    };
+
+    "full build matches brute force"_test = [] {
+        std::mt19937 rng(28);
+        for (uint32_t capacity : {1u, 2u, 3u, 7u, 64u, 1000u, 4097u}) {
+            for (uint32_t wrapped : {0u, capacity / 3 + 1}) {
+                Rings rings(3, capacity);
+                PlotPyramid pyramid;
+                pyramid.layout(rings.plots, capacity);
+                rings.appendRandom(nullptr, capacity + wrapped, rng);
+                pyramid.build(rings.data.data(), rings.first(), rings.count);
+                expect(mismatches(pyramid, rings) == 0_i) << "capacity" << capacity << "wrapped" << wrapped;
+            }
+        }
+    };
+
+    "threaded build over several chunks matches brute force"_test = [] {
+        std::mt19937 rng(280);
+        Rings rings(3, 150001);  // Above the parallel threshold, 3-4 chunks per plot
+        PlotPyramid pyramid;
+        pyramid.layout(rings.plots, rings.capacity);
+        rings.appendRandom(nullptr, rings.capacity + 100003, rng);  // Window off the chunk grid
+
+        // The workers stay up between builds
+        for (int i = 0; i < 3; ++i) {
+            pyramid.build(rings.data.data(), rings.first(), rings.count);
+            expect(mismatches(pyramid, rings) == 0_i) << "build" << i;
+            rings.appendRandom(nullptr, 77777, rng);
+        }
+    };
+
+    "a partly filled ring leaves empty buckets empty"_test = [] {
+        std::mt19937 rng(2);
+        Rings rings(1, 100);
+        PlotPyramid pyramid;
+        pyramid.layout(1, 100);
+        pyramid.build(rings.data.data(), 0, 0);
+        rings.appendRandom(&pyramid, 37, rng);
+        expect(mismatches(pyramid, rings) == 0_i);
+
+        const float* lod = pyramid.plot(0);
+        uint32_t last = pyramid.levelOffset(1) + 49;  // Samples 98, 99
+        expect(lod[last * 2] > lod[last * 2 + 1]) << "min > max";
+    };
+
+    "a wrapped ring keeps the newest and the oldest samples in separate buckets"_test = [] {
+        // Samples 0..8 through a ring of 6: the window is 3..8, and ring
+        // index 2 (sample 8) sits right before index 3 (sample 3)
+        Rings rings(1, 6);
+        PlotPyramid pyramid;
+        pyramid.layout(1, 6);
+        pyramid.build(rings.data.data(), 0, 0);
+        auto sequence = [](uint32_t, uint64_t s) { return static_cast<float>(s); };
+        rings.append(&pyramid, 6, sequence);
+        rings.append(&pyramid, 3, sequence);
+        expect(rings.first() == 3_u && rings.count == 6_u);
+        expect(mismatches(pyramid, rings) == 0_i);
+
+        const float* lod = pyramid.plot(0);
+        for (uint32_t level = 1; level <= pyramid.levels(); ++level) {
+            // The bucket of the newest sample holds it alone
+            uint32_t at = pyramid.levelOffset(level) + ((8u >> level) % pyramid.levelSize(level));
+            expect(lod[at * 2] == 8.0f && lod[at * 2 + 1] == 8.0f) << "level" << level;
+
+            // The shader's lookup: slot from the window phase and the sample index
+            uint32_t phase = static_cast<uint32_t>(rings.first() % pyramid.period());
+            for (uint32_t i = 0; i < rings.count; ++i) {
+                uint32_t slot = ((phase + i) >> level) & (pyramid.levelSize(level) - 1);
+                expect(slot == ((rings.first() + i) >> level) % pyramid.levelSize(level));
+            }
+        }
+    };
+
+    "partial updates with wrap-around match brute force"_test = [] {
+        std::mt19937 rng(2028);
+        std::uniform_int_distribution<uint32_t> size(1, 700);
+        for (uint32_t capacity : {5u, 513u, 1024u, 3001u}) {
+            Rings rings(4, capacity);
+            PlotPyramid pyramid;
+            pyramid.layout(rings.plots, capacity);
+            pyramid.build(rings.data.data(), 0, 0);
+
+            int bad = 0;
+            for (int step = 0; step < 60; ++step) {
+                rings.appendRandom(&pyramid, size(rng), rng);
+                bad += mismatches(pyramid, rings);
+            }
+            expect(bad == 0_i) << "capacity" << capacity;
+        }
+    };
+};
@@ -0,0 +1,146 @@
+//=============================================================================
+// Python Interpreter Unit Tests
+//
+// Tests for the interpreter a Python widget's thread runs in
+// Covers: shared execution, error reporting, output capture from several
+// threads, isolated globals, isolated subinterpreters holding their GILs
+// at the same time
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/plugins/python/interpreter.h"
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <latch>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+// One Python runtime for the whole binary, GIL released afterwards so
+// test threads can take it
+void ensurePython() {
+    static bool ready = [] {
+        PyConfig config;
+        PyConfig_InitIsolatedConfig(&config);
+#ifdef YETTY_PYTHON_HOME
+        std::string home = YETTY_PYTHON_HOME;
+        std::wstring homeW(home.begin(), home.end());
+        PyConfig_SetString(&config, &config.home, homeW.c_str());
+#endif
+        Py_InitializeFromConfig(&config);
+        PyConfig_Clear(&config);
+        PyEval_SaveThread();
+        return true;
+    }();
+    (void)ready;
+}
+
+// Two threads, each in its own interpreter with its GIL held, meet at a
+// rendezvous. With one GIL between them the second cannot get there; the
+// wait is bounded only so that case fails instead of hanging.
+bool bothHoldTheirGil(bool isolated) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int inside = 0;
+    bool met[2] = {false, false};
+
+    std::latch created(2);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 2; t++) {
+        workers.emplace_back([&, t] {
+            auto interp = Interpreter::create(isolated);
+            created.arrive_and_wait();
+            Interpreter::Lock lock((*interp).get());
+            std::unique_lock<std::mutex> guard(mutex);
+            inside++;
+            cv.notify_all();
+            met[t] = cv.wait_for(guard, std::chrono::seconds(10), [&] { return inside == 2; });
+        });
+    }
+    for (auto& w : workers) w.join();
+    return met[0] && met[1];
+}
+
+} // namespace
+
+suite python_interpreter_tests = [] {
+    ensurePython();
+
+    "shared interpreter runs code and captures output"_test = [] {
+        auto interp = Interpreter::create(false);
+        expect(bool(interp));
+        expect(!(*interp)->isolated());
+        auto out = (*interp)->execute("print(6 * 7)", nullptr);
+        expect(bool(out));
+        expect(*out == std::string("42\n"));
+    };
+
+    "errors are returned, not raised"_test = [] {
+        auto interp = Interpreter::create(false);
+        auto out = (*interp)->execute("raise ValueError('boom')", nullptr);
+        expect(!out);
+    };
+
+    "shared-mode threads capture only their own output"_test = [] {
+        // Each run hands the GIL over on every line it prints
+        auto script = [](const std::string& tag) {
+            return "import time\nfor i in range(200):\n    print('" + tag +
+                   "')\n    time.sleep(0)\n";
+        };
+
+        std::vector<std::string> outputs(2);
+        std::latch ready(2);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 2; t++) {
+            workers.emplace_back([&, t] {
+                auto interp = Interpreter::create(false);
+                ready.arrive_and_wait();
+                auto out = (*interp)->execute(script(t ? "b" : "a"), nullptr);
+                if (out) outputs[t] = *out;
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        std::string a, b;
+        for (int i = 0; i < 200; i++) {
+            a += "a\n";
+            b += "b\n";
+        }
+        expect(outputs[0] == a) << "thread a got" << outputs[0].size() << "bytes";
+        expect(outputs[1] == b) << "thread b got" << outputs[1].size() << "bytes";
+
+        Interpreter::Lock lock(nullptr);
+        expect(PySys_GetObject("stdout") == PySys_GetObject("__stdout__"))
+            << "sys.stdout restored";
+    };
+
+    "isolated interpreters keep separate globals"_test = [] {
+        std::thread([] {
+            auto a = Interpreter::create(true);
+            auto b = Interpreter::create(true);
+            expect((*a)->isolated() == Interpreter::isolationSupported());
+            if (!(*a)->isolated()) return;  // Shared fallback on older Pythons
+
+            (void)(*a)->execute("marker = 1", nullptr);
+            auto inA = (*a)->execute("print('marker' in globals())", nullptr);
+            auto inB = (*b)->execute("print('marker' in globals())", nullptr);
+            expect(*inA == std::string("True\n"));
+            expect(*inB == std::string("False\n"));
+        }).join();
+    };
+
+    "isolated interpreters hold their own GIL at the same time"_test = [] {
+        if (!Interpreter::isolationSupported()) return;
+        expect(bothHoldTheirGil(true)) << "both threads inside with their GIL held";
+    };
+};
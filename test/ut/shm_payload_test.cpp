@@ -0,0 +1,191 @@
+//=============================================================================
+// Shared Memory Payload Tests
+//
+// Tests for OSC payloads passed out of band through memfd/POSIX shm
+// Covers: --shm option parsing and validation, token validation, CRC-32,
+// size and checksum checks, private copies of POSIX objects, memfd names
+// and seals, one-shot tokens
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/osc-command.h"
+#include "yetty/shm-payload.h"
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+const std::string PAYLOAD = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+uint32_t payloadCrc() { return ShmPayload::crc32(PAYLOAD.data(), PAYLOAD.size()); }
+
+// Unique per test process so parallel runs don't collide
+std::string makeToken(const std::string& name) {
+    return "ut-" + std::to_string(getpid()) + "-" + name;
+}
+
+// POSIX shm object "/yetty-TOKEN" holding PAYLOAD; returns a writable fd
+int createShm(const std::string& token) {
+    std::string name = "/yetty-" + token;
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0 && write(fd, PAYLOAD.data(), PAYLOAD.size()) != ssize_t(PAYLOAD.size())) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+ShmPayloadRef makeRef(const std::string& token) {
+    ShmPayloadRef ref;
+    ref.token = token;
+    ref.size = PAYLOAD.size();
+    ref.crc = payloadCrc();
+    ref.hasCrc = true;
+    return ref;
+}
+
+OscCommand parse(const std::string& genericArgs) {
+    OscCommandParser parser;
+    return *parser.parse(std::to_string(YETTY_OSC_VENDOR_ID) + ";" + genericArgs);
+}
+
+} // namespace
+
+suite shm_payload_tests = [] {
+    "shm options are parsed into the reference"_test = [] {
+        auto cmd = parse("create -p image --shm abc_1 --shm-size 4096 --shm-crc CBF43926");
+        expect(cmd.isValid()) << cmd.error;
+        expect(cmd.create.shm.token == "abc_1");
+        expect(cmd.create.shm.size == 4096_ul);
+        expect(cmd.create.shm.hasCrc && cmd.create.shm.crc == 0xCBF43926u);
+        expect(!cmd.create.shm.isMemfd());
+
+        auto update = parse("update --id w1 --shm t --memfd 123:7 --shm-size 1 --shm-crc 0");
+        expect(update.isValid()) << update.error;
+        expect(update.target.shm.pid == 123_i && update.target.shm.fd == 7_i);
+        expect(update.target.shm.isMemfd());
+
+        expect(parse("create -p image").create.shm.empty()) << "shm is optional";
+    };
+
+    "incomplete or malformed shm options are rejected"_test = [] {
+        expect(!parse("create -p image --shm t --shm-size 10").isValid()) << "no crc";
+        expect(!parse("create -p image --shm t --shm-crc 0").isValid()) << "no size";
+        expect(!parse("create -p image --shm-size 10 --shm-crc 0").isValid()) << "no token";
+        expect(!parse("create -p image --shm ../x --shm-size 1 --shm-crc 0").isValid());
+        expect(!parse("create -p image --shm t --shm-size lots --shm-crc 0").isValid());
+        expect(!parse("create -p image --shm t --memfd 12 --shm-size 1 --shm-crc 0").isValid());
+        expect(!parse("create -p image --shm t --memfd 0:3 --shm-size 1 --shm-crc 0").isValid());
+        expect(!parse("update --id w1 --shm").isValid()) << "missing value";
+    };
+
+    "tokens stay inside the yetty- namespace"_test = [] {
+        expect(ShmPayload::isValidToken("abc-DEF_123"));
+        expect(!ShmPayload::isValidToken(""));
+        expect(!ShmPayload::isValidToken("a/b"));
+        expect(!ShmPayload::isValidToken(".."));
+        expect(!ShmPayload::isValidToken("a b"));
+        expect(ShmPayload::isValidToken(std::string(64, 'a')));
+        expect(!ShmPayload::isValidToken(std::string(65, 'a')));
+    };
+
+    "crc32 matches zlib"_test = [] {
+        expect(ShmPayload::crc32("123456789", 9) == 0xCBF43926u);
+        expect(ShmPayload::crc32("", 0) == 0u);
+    };
+
+    "posix object is copied, verified and unlinked"_test = [] {
+        auto token = makeToken("posix");
+        int fd = createShm(token);
+        if (fd < 0) { expect(false) << "shm_open failed"; return; }
+
+        auto res = ShmPayload::open(makeRef(token));
+        if (!res) { expect(false) << error_msg(res); return; }
+        auto payload = *res;
+        expect(payload->view() == PAYLOAD);
+
+        std::string name = "/yetty-" + token;
+        int again = shm_open(name.c_str(), O_RDONLY, 0);
+        expect(again < 0) << "one-shot: name removed on open";
+        if (again >= 0) close(again);
+
+        // The client rewriting or truncating its object can't reach us
+        expect(pwrite(fd, "XXXX", 4, 0) == 4);
+        expect(ftruncate(fd, 0) == 0);
+        expect(payload->view() == PAYLOAD);
+        close(fd);
+    };
+
+    "size and checksum must match"_test = [] {
+        auto bigToken = makeToken("big");
+        int fd = createShm(bigToken);
+        if (fd < 0) { expect(false) << "shm_open failed"; return; }
+        auto ref = makeRef(bigToken);
+        ref.size = PAYLOAD.size() + 1;
+        expect(!ShmPayload::open(ref)) << "object smaller than advertised";
+        close(fd);
+
+        auto crcToken = makeToken("crc");
+        fd = createShm(crcToken);
+        if (fd < 0) { expect(false) << "shm_open failed"; return; }
+        ref = makeRef(crcToken);
+        ref.crc ^= 1;
+        expect(!ShmPayload::open(ref)) << "checksum mismatch";
+        close(fd);
+
+        ref = makeRef(makeToken("missing"));
+        expect(!ShmPayload::open(ref));
+        ref.size = 0;
+        expect(!ShmPayload::open(ref));
+    };
+
+#ifdef __linux__
+    "memfd must be named for the token and sealed"_test = [] {
+        auto token = makeToken("memfd");
+        std::string name = "yetty-" + token;
+        int fd = memfd_create(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (fd < 0) { expect(false) << "memfd_create failed"; return; }
+        expect(write(fd, PAYLOAD.data(), PAYLOAD.size()) == ssize_t(PAYLOAD.size()));
+
+        auto ref = makeRef(token);
+        ref.pid = getpid();
+        ref.fd = fd;
+        expect(!ShmPayload::open(ref)) << "unsealed memfd";
+
+        expect(fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) == 0);
+        expect(!ShmPayload::open(ref)) << "still writable";
+
+        expect(fcntl(fd, F_ADD_SEALS, F_SEAL_WRITE) == 0);
+        auto res = ShmPayload::open(ref);
+        if (!res) { expect(false) << error_msg(res); return; }
+        expect((*res)->view() == PAYLOAD);
+
+        // A token that is only a prefix of the memfd name is not enough
+        auto prefix = ref;
+        prefix.token = token.substr(0, token.size() - 1);
+        expect(!ShmPayload::open(prefix));
+        close(fd);
+    };
+#endif
+
+    "tokens are one-shot and the set stays bounded"_test = [] {
+        ShmTokenSet tokens(3);
+        expect(tokens.claim("a"));
+        expect(!tokens.claim("a")) << "replay rejected";
+        expect(tokens.claim("b") && tokens.claim("c") && tokens.claim("d"));
+        expect(tokens.size() == 3_u);
+        expect(!tokens.claim("d"));
+        expect(tokens.claim("a")) << "oldest token forgotten";
+
+        ShmTokenSet many;
+        for (int i = 0; i < 20000; i++) many.claim("t" + std::to_string(i));
+        expect(many.size() == ShmTokenSet::DEFAULT_CAPACITY);
+    };
+};
@@ -0,0 +1,109 @@
+//=============================================================================
+// SpscQueue Unit Tests
+//
+// Tests for the bounded lock-free single-producer/single-consumer queue
+// Covers: ordering, full/empty behavior, peek, cross-thread handoff
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/spsc-queue.h"
+#include <memory>
+#include <thread>
+
+using namespace boost::ut;
+using namespace yetty;
+
+suite spsc_queue_tests = [] {
+    "SpscQueue starts empty"_test = [] {
+        SpscQueue<int> q(4);
+        expect(q.empty());
+        expect(q.capacity() == 4_u);
+        expect(q.front() == nullptr);
+
+        int v = 0;
+        expect(!q.tryPop(v));
+    };
+
+    "SpscQueue pops in push order"_test = [] {
+        SpscQueue<int> q(4);
+        expect(q.tryPush(1));
+        expect(q.tryPush(2));
+        expect(q.tryPush(3));
+        expect(q.size() == 3_u);
+
+        int v = 0;
+        expect(q.tryPop(v) && v == 1);
+        expect(q.tryPop(v) && v == 2);
+        expect(q.tryPop(v) && v == 3);
+        expect(q.empty());
+    };
+
+    "SpscQueue rejects push when full"_test = [] {
+        SpscQueue<int> q(2);
+        expect(q.tryPush(1));
+        expect(q.tryPush(2));
+        expect(!q.tryPush(3)) << "Queue of capacity 2 should be full";
+
+        int v = 0;
+        expect(q.tryPop(v) && v == 1);
+        expect(q.tryPush(3)) << "Pop should free a slot";
+        expect(q.tryPop(v) && v == 2);
+        expect(q.tryPop(v) && v == 3);
+    };
+
+    "SpscQueue front peeks without removing"_test = [] {
+        SpscQueue<int> q(2);
+        q.tryPush(7);
+        expect(q.front() != nullptr && *q.front() == 7);
+        expect(q.size() == 1_u);
+    };
+
+    "SpscQueue wraps around many times"_test = [] {
+        SpscQueue<int> q(3);
+        int v = 0;
+        for (int i = 0; i < 100; ++i) {
+            expect(q.tryPush(std::move(i)));
+            expect(q.tryPop(v) && v == i);
+        }
+        expect(q.empty());
+    };
+
+    "SpscQueue moves move-only values"_test = [] {
+        SpscQueue<std::unique_ptr<int>> q(2);
+        expect(q.tryPush(std::make_unique<int>(42)));
+
+        std::unique_ptr<int> out;
+        expect(q.tryPop(out));
+        expect(out != nullptr && *out == 42);
+    };
+
+    "SpscQueue hands off items between threads in order"_test = [] {
+        constexpr int COUNT = 100000;
+        SpscQueue<int> q(8);
+
+        std::thread producer([&] {
+            for (int i = 0; i < COUNT; ++i) {
+                int v = i;
+                while (!q.tryPush(std::move(v))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int expected = 0;
+        bool ordered = true;
+        while (expected < COUNT) {
+            int v = -1;
+            if (!q.tryPop(v)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (v != expected) ordered = false;
+            ++expected;
+        }
+        producer.join();
+
+        expect(ordered) << "Items should arrive in push order";
+        expect(q.empty());
+    };
+};
@@ -0,0 +1,111 @@
+//=============================================================================
+// Text Layout Cache Unit Tests
+//
+// Tests for the shared cache of shaped runs used by rich-text widgets
+// Covers: hits and misses, key separation (font, version, style, size,
+// text), missing glyphs, budget eviction, runs outliving eviction, threads
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/text-layout-cache.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+const int FONT_A = 0;
+const int FONT_B = 0;
+
+// Counts how often glyphs are actually measured
+struct Measure {
+    int calls = 0;
+    float operator()(uint32_t codepoint) {
+        calls++;
+        return codepoint == U'?' ? -1.0f : 10.0f;
+    }
+};
+
+} // namespace
+
+suite text_layout_cache_tests = [] {
+    "repeated words are measured once"_test = [] {
+        TextLayoutCache cache;
+        Measure measure;
+        auto a = cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"hello ", measure);
+        auto b = cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"hello ", measure);
+        expect(a == b) << "same run handed out";
+        expect(measure.calls == 6_i);
+        expect(a->advances.size() == 6_u);
+        expect(a->width == 60.0f);
+        expect(cache.hits() == 1_u && cache.misses() == 1_u);
+        expect(cache.hitRate() == 0.5);
+    };
+
+    "font, version, style, size and text all separate entries"_test = [] {
+        TextLayoutCache cache;
+        Measure measure;
+        cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"word", measure);
+        cache.shape(&FONT_B, 0, Font::Regular, 16.0f, U"word", measure);
+        cache.shape(&FONT_A, 1, Font::Regular, 16.0f, U"word", measure);
+        cache.shape(&FONT_A, 0, Font::Bold, 16.0f, U"word", measure);
+        cache.shape(&FONT_A, 0, Font::Regular, 18.0f, U"word", measure);
+        cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"Word", measure);
+        expect(cache.misses() == 6_u);
+        expect(cache.hits() == 0_u);
+        expect(cache.size() == 6_u);
+    };
+
+    "missing glyphs have negative advances and no width"_test = [] {
+        TextLayoutCache cache;
+        auto run = cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"a?b", Measure{});
+        expect(run->advances[1] < 0.0f);
+        expect(run->width == 20.0f);
+    };
+
+    "budget evicts least recently used runs"_test = [] {
+        TextLayoutCache cache(1);  // Keeps only the newest entry
+        Measure measure;
+        auto first = cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"first", measure);
+        cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"second", measure);
+        expect(cache.size() == 1_u);
+        expect(first->advances.size() == 5_u) << "evicted run still usable";
+
+        cache.shape(&FONT_A, 0, Font::Regular, 16.0f, U"first", measure);
+        expect(cache.misses() == 3_u);
+    };
+
+    "callers share one cache"_test = [] {
+        auto& shared = TextLayoutCache::shared();
+        expect(&shared == &TextLayoutCache::shared());
+        uint64_t hits = shared.hits();
+        Measure measure;
+        // Two widgets laying out the same heading
+        shared.shape(&FONT_A, 7, Font::Bold, 24.0f, U"Changelog", measure);
+        shared.shape(&FONT_A, 7, Font::Bold, 24.0f, U"Changelog", measure);
+        expect(shared.hits() == hits + 1);
+    };
+
+    "concurrent shaping is consistent"_test = [] {
+        TextLayoutCache cache;
+        std::vector<std::thread> threads;
+        std::vector<int> wrong(4, 0);
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 2000; i++) {
+                    std::u32string word(1 + i % 13, U'x');
+                    auto run = cache.shape(&FONT_A, 0, Font::Regular, 16.0f, word,
+                                           [](uint32_t) { return 10.0f; });
+                    if (run->width != 10.0f * word.size()) wrong[t]++;
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        expect(wrong == std::vector<int>(4, 0));
+        expect(cache.hits() + cache.misses() == 8000_u);
+        expect(cache.size() == 13_u);
+    };
+};
@@ -0,0 +1,201 @@
+//=============================================================================
+// Widget Visibility Tests
+//
+// Tests for how a terminal places child widgets and switches them off when
+// they leave the view, through the same GPUScreen + ChildWidgetLayout frame
+// path Terminal::prepareFrame/render use
+// Covers: on-screen test edges, output scrolling a widget into history,
+// scrolling back to it, absolute widgets, screen types, removed widgets,
+// many widgets in history
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "harness/mock_plugin.h"
+#include "yetty/child-widget-layout.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+using namespace yetty::test;
+
+namespace {
+
+constexpr float CELL_W = 10.0f;
+constexpr float CELL_H = 20.0f;
+constexpr int COLS = 80;
+constexpr int ROWS = 25;
+
+std::shared_ptr<MockPluginWidget> makeWidget(int x, int y, uint32_t w, uint32_t h,
+                                             PositionMode mode = PositionMode::Relative) {
+    auto widget = std::static_pointer_cast<MockPluginWidget>(*MockPluginWidget::create(""));
+    widget->setPosition(x, y);
+    widget->setCellSize(w, h);
+    widget->setPositionMode(mode);
+    return widget;
+}
+
+// The child widget side of a Terminal: vterm output goes through GPUScreen,
+// which tracks the widget markers, and each frame lays the widgets out
+struct TerminalFrame {
+    VTerm* vt;
+    GPUScreen screen;
+    ChildWidgetLayout layout;
+    std::vector<WidgetPtr> widgets;
+    ScreenType currentScreen = ScreenType::Main;
+
+    TerminalFrame() : vt(vterm_new(ROWS, COLS)), screen(ROWS, COLS, nullptr) {
+        vterm_set_utf8(vt, 1);
+        screen.attach(vt);
+    }
+    ~TerminalFrame() { vterm_free(vt); }
+
+    void feed(const std::string& data) { vterm_input_write(vt, data.data(), data.size()); }
+
+    // Shell output: `lines` lines printed at the bottom of the screen
+    void output(int lines) {
+        feed("\033[" + std::to_string(ROWS) + ";1H");
+        for (int i = 0; i < lines; i++) feed("\n");
+    }
+
+    // Like Terminal::addChildWidget + markWidgetGridCells for relative widgets
+    void add(const std::shared_ptr<MockPluginWidget>& widget) {
+        widgets.push_back(widget);
+        if (widget->getPositionMode() == PositionMode::Relative) {
+            screen.setWidgetMarker(widget->getY(), widget->getX(),
+                                   static_cast<uint16_t>(widget->id()));
+        }
+        layout.invalidate();
+    }
+
+    // One frame: Terminal::prepareFrame lays the widgets out, then render()
+    // hands each placed widget its on flag (the mock needs no GPU context)
+    void frame() {
+        layout.place(screen, widgets, currentScreen, CELL_W, CELL_H);
+        for (const auto& [widget, on] : layout.placed()) {
+            static_cast<MockPluginWidget&>(*widget).noteFrame(on);
+        }
+    }
+};
+
+} // namespace
+
+suite widget_visibility_tests = [] {
+    "pixel rect follows the grid and the scroll offset"_test = [] {
+        auto widget = makeWidget(2, 3, 10, 5);
+        widget->placeOnGrid(CELL_W, CELL_H, 0);
+        expect(widget->getPixelX() == 20.0f && widget->getPixelY() == 60.0f);
+        expect(widget->getPixelWidth() == 100_u && widget->getPixelHeight() == 100_u);
+
+        widget->placeOnGrid(CELL_W, CELL_H, 4);
+        expect(widget->getPixelY() == 140.0f);
+
+        auto fixed = makeWidget(2, 3, 10, 5, PositionMode::Absolute);
+        fixed->placeOnGrid(CELL_W, CELL_H, 4);
+        expect(fixed->getPixelY() == 60.0f) << "absolute widgets do not scroll";
+    };
+
+    "widgets touching the view edge are off, overlapping by a row are on"_test = [] {
+        TerminalFrame term;
+        auto widget = makeWidget(0, 0, 10, 5, PositionMode::Absolute);
+        term.add(widget);
+
+        auto onAt = [&](int x, int y) {
+            widget->setPosition(x, y);
+            term.frame();
+            return widget->lastOn();
+        };
+        expect(!onAt(0, -5)) << "bottom edge at the view top";
+        expect(onAt(0, -4));
+        expect(!onAt(0, ROWS)) << "top edge at the view bottom";
+        expect(onAt(0, ROWS - 1));
+        expect(!onAt(COLS, 0)) << "right of the view";
+    };
+
+    "output scrolls a widget off and scrolling back brings it on"_test = [] {
+        TerminalFrame term;
+        term.output(40);  // Earlier history above the widget
+        auto widget = makeWidget(0, 10, 20, 8);
+        term.add(widget);
+
+        // Shell output pushes the widget's marker up one row per line
+        std::vector<bool> states;
+        for (int lines = 0; lines <= 30; lines++) {
+            if (lines > 0) term.output(1);
+            term.frame();
+            states.push_back(widget->lastOn());
+        }
+        expect(widget->getY() == -20_i) << "marker followed into history";
+        expect(states[17]) << "last row still showing";
+        expect(!states[18]) << "fully in history";
+        expect(widget->onTransitions() == 1_i);
+
+        // The user scrolls back through history
+        int firstOn = -1, lastOn = -1;
+        for (int scroll = 1; scroll <= 50; scroll++) {
+            term.screen.scrollUp(1);
+            term.frame();
+            if (widget->lastOn()) {
+                if (firstOn < 0) firstOn = scroll;
+                lastOn = scroll;
+            }
+        }
+        expect(firstOn == 13_i) << "on as soon as a row is visible";
+        expect(lastOn == 44_i) << "off once below the view";
+        expect(!widget->lastOn()) << "scrolled past it again";
+        expect(widget->onTransitions() == 3_i);
+
+        term.screen.scrollToBottom();
+        term.frame();
+        expect(!widget->lastOn());
+    };
+
+    "only widgets of the current screen are placed"_test = [] {
+        TerminalFrame term;
+        auto main = makeWidget(0, 2, 10, 4);
+        auto alt = makeWidget(0, 2, 10, 4, PositionMode::Absolute);
+        alt->setScreenType(ScreenType::Alternate);
+        term.add(main);
+        term.add(alt);
+
+        term.frame();
+        expect(main->renderCount() == 1_i && alt->renderCount() == 0_i);
+
+        term.currentScreen = ScreenType::Alternate;
+        term.frame();
+        expect(main->renderCount() == 1_i && alt->renderCount() == 1_i);
+    };
+
+    "a removed widget is not drawn"_test = [] {
+        TerminalFrame term;
+        auto widget = makeWidget(0, 2, 10, 4);
+        term.add(widget);
+        term.layout.place(term.screen, term.widgets, ScreenType::Main, CELL_W, CELL_H);
+        term.layout.remove(widget->id());
+        expect(term.layout.placed().empty());
+    };
+
+    "widgets in history are not rendered"_test = [] {
+        TerminalFrame term;
+        std::vector<std::shared_ptr<MockPluginWidget>> plots;
+        for (int i = 0; i < 30; i++) {
+            auto plot = makeWidget(0, 0, 40, 12);
+            term.add(plot);
+            plots.push_back(plot);
+            term.output(30);  // Each plot scrolls out under the next one's output
+        }
+        auto live = makeWidget(0, 5, 40, 12);
+        term.add(live);
+
+        for (int f = 0; f < 60; f++) {
+            term.frame();
+        }
+
+        int rendered = 0;
+        for (auto& plot : plots) rendered += plot->renderCount();
+        expect(rendered == 0_i) << "history costs nothing per frame";
+        expect(live->renderCount() == 60_i);
+        expect(plots.front()->getY() == -900_i);
+    };
+};
@@ -0,0 +1,291 @@
+//=============================================================================
+// YDraw SVG Loader Unit Tests
+//
+// Tests for the regex-free SVG tokenizer and the compiled scene cache
+// Covers: attributes, styles, comments, path commands, arcs, fills of closed
+// outlines, cache hits, a large generated document
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/ydraw-scene-cache.h"
+#include "yetty/ydraw-svg.h"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+bool near(float a, float b, float eps = 1e-3f) { return std::abs(a - b) < eps; }
+
+YDrawPrimitiveType typeOf(const YDrawPrimitiveGPU& p) {
+    return static_cast<YDrawPrimitiveType>(p.type);
+}
+
+// A flame-graph like document: rows of boxes, labels as paths, connectors
+std::string generateSvg(int elements) {
+    std::string svg = "<?xml version=\"1.0\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\">\n";
+    char buf[256];
+    for (int i = 0; i < elements; ++i) {
+        float x = static_cast<float>((i * 37) % 1900);
+        float y = static_cast<float>((i / 50) * 18 % 1000);
+        switch (i % 4) {
+            case 0:
+                std::snprintf(buf, sizeof(buf),
+                              "  <rect x=\"%.1f\" y=\"%.1f\" width=\"%.1f\" height=\"16\" rx=\"2\" "
+                              "fill=\"#%06x\" stroke=\"#202020\" stroke-width=\"0.5\"/>\n",
+                              x, y, 20.0f + i % 90, (i * 2654435761u) & 0xFFFFFF);
+                break;
+            case 1:
+                std::snprintf(buf, sizeof(buf),
+                              "  <path d=\"M%.1f %.1fC%.1f,%.1f %.1f,%.1f %.1f,%.1fL%.1f %.1fz\" "
+                              "style=\"fill:none;stroke:#336699;stroke-width:1.5\"/>\n",
+                              x, y, x + 10, y - 8, x + 20, y + 8, x + 30, y, x + 30, y + 10);
+                break;
+            case 2:
+                std::snprintf(buf, sizeof(buf),
+                              "  <circle cx=\"%.1f\" cy=\"%.1f\" r=\"4\" fill=\"red\"/>\n", x, y);
+                break;
+            default:
+                std::snprintf(buf, sizeof(buf),
+                              "  <line x1=\"%.1f\" y1=\"%.1f\" x2=\"%.1f\" y2=\"%.1f\" stroke=\"black\"/>\n",
+                              x, y, x + 40, y + 18);
+                break;
+        }
+        svg += buf;
+    }
+    svg += "</svg>\n";
+    return svg;
+}
+
+} // namespace
+
+suite ydraw_svg_tests = [] {
+    "SVG basic shapes"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        size_t n = ydraw::parseSvg(
+            "<svg><circle cx=\"10\" cy=\"20\" r=\"5\"/>"
+            "<ellipse cx='1' cy='2' rx='3' ry='4'/>"
+            "<rect x=\"0\" y=\"0\" width=\"40\" height=\"20\" rx=\"30\"/>"
+            "<line x1=\"1\" y1=\"2\" x2=\"3\" y2=\"4\"/></svg>",
+            prims);
+
+        expect(n == 4_u);
+        expect(typeOf(prims[0]) == YDrawPrimitiveType::Circle2D);
+        expect(prims[0].params[0] == 10.0f && prims[0].params[2] == 5.0f);
+        expect(typeOf(prims[1]) == YDrawPrimitiveType::Ellipse2D);
+        expect(prims[1].params[3] == 4.0f);
+        expect(typeOf(prims[2]) == YDrawPrimitiveType::Box2D);
+        expect(prims[2].params[0] == 20.0f && prims[2].params[3] == 10.0f);
+        expect(prims[2].style.round == 10.0f) << "Corner radius is clamped to the short side";
+        expect(typeOf(prims[3]) == YDrawPrimitiveType::Segment2D);
+        expect(prims[3].params[4] == 3.0f);
+    };
+
+    "SVG attribute names match exactly"_test = [] {
+        // A substring search for x=" would find rx=" first
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<rect rx=\"3\" x=\"100\" y=\"0\" width=\"10\" height=\"10\"/>", prims);
+        expect(prims.size() == 1_u);
+        expect(prims[0].params[0] == 105.0f);
+    };
+
+    "SVG skips comments and closing tags"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<!-- <circle r=\"1\"/> --><g></g><circle r=\"2\"/>", prims);
+        expect(prims.size() == 1_u);
+        expect(prims[0].params[2] == 2.0f);
+    };
+
+    "SVG styles from attributes and style"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<circle r=\"1\" fill=\"#f00\" stroke=\"blue\" stroke-width=\"3\"/>"
+                        "<circle r=\"1\" fill=\"red\" style=\"fill: none; stroke:#00ff0080\"/>",
+                        prims);
+        expect(prims.size() == 2_u);
+        expect(prims[0].style.fill[0] == 1.0f && prims[0].style.fill[1] == 0.0f);
+        expect(prims[0].style.stroke[2] == 1.0f);
+        expect(prims[0].style.stroke_width == 3.0f);
+
+        expect(prims[1].style.fill[3] == 0.0f) << "fill:none is transparent";
+        expect(prims[1].style.stroke[1] == 1.0f);
+        expect(near(prims[1].style.stroke[3], 128 / 255.0f));
+        expect(prims[1].style.stroke_width == 1.0f);
+    };
+
+    "SVG colors"_test = [] {
+        float c[4];
+        expect(ydraw::parseSvgColor("#123456", c) && near(c[0], 0x12 / 255.0f) && c[3] == 1.0f);
+        expect(ydraw::parseSvgColor("#fff", c) && c[0] == 1.0f);
+        expect(ydraw::parseSvgColor(" none ", c) && c[3] == 0.0f);
+        expect(!ydraw::parseSvgColor("#12", c));
+        expect(!ydraw::parseSvgColor("url(#grad)", c));
+    };
+
+    "SVG path lines, relative moves and close"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<path d=\"M10,10 20,10 v10 h-10z m5-5 l1 1\" stroke=\"black\" fill=\"none\"/>",
+                        prims);
+
+        expect(prims.size() == 5_u);
+        for (const auto& p : prims) {
+            expect(typeOf(p) == YDrawPrimitiveType::Segment2D);
+            expect(p.style.fill[3] == 0.0f) << "fill=none draws the outline only";
+        }
+        // Implicit line-to after M
+        expect(prims[0].params[2] == 10.0f && prims[0].params[4] == 20.0f);
+        // z closes back to (10, 10)
+        expect(prims[3].params[4] == 10.0f && prims[3].params[5] == 10.0f);
+        // m after z is relative to the subpath start
+        expect(prims[4].params[2] == 15.0f && prims[4].params[3] == 5.0f);
+        expect(prims[4].params[4] == 16.0f && prims[4].params[5] == 6.0f);
+    };
+
+    "SVG path curves and smooth reflections"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<path d=\"M0 0Q5 10 10 0T20 0C20 5 30 5 30 0S40-5 40 0\" fill=\"#000\"/>", prims);
+
+        expect(prims.size() == 4_u);
+        expect(typeOf(prims[0]) == YDrawPrimitiveType::Bezier2D);
+        expect(typeOf(prims[1]) == YDrawPrimitiveType::Bezier2D);
+        // T reflects (5, 10) around (10, 0)
+        expect(prims[1].params[4] == 15.0f && prims[1].params[5] == -10.0f);
+        expect(typeOf(prims[3]) == YDrawPrimitiveType::CubicBezier2D);
+        // S reflects (30, 5) around (30, 0)
+        expect(prims[3].params[4] == 30.0f && prims[3].params[5] == -5.0f);
+        // No stroke: the fill color outlines the path
+        expect(prims[0].style.stroke[3] == 1.0f && prims[0].style.stroke_width == 1.0f);
+    };
+
+    "SVG arcs convert to center form"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        // Half circle of radius 10 from (0, 0) to (20, 0), compact flags
+        ydraw::parseSvg("<path d=\"M0 0A10 10 0 0120 0\" stroke=\"black\"/>", prims);
+
+        expect(prims.size() == 1_u);
+        const auto& p = prims[0];
+        expect(typeOf(p) == YDrawPrimitiveType::EllipseArc2D);
+        expect(near(p.params[0], 10.0f) && near(p.params[1], 0.0f)) << "center";
+        expect(near(p.params[2], 10.0f) && near(p.params[3], 10.0f)) << "radii";
+        expect(p.params[6] >= p.params[5]) << "Shader sweeps upwards";
+
+        // Both endpoints lie on the swept range
+        auto at = [&](float t) {
+            return std::pair{p.params[0] + p.params[2] * std::cos(t), p.params[1] + p.params[3] * std::sin(t)};
+        };
+        auto [ax, ay] = at(p.params[5]);
+        auto [bx, by] = at(p.params[6]);
+        bool forward = near(ax, 0.0f) && near(bx, 20.0f);
+        bool backward = near(ax, 20.0f) && near(bx, 0.0f);
+        expect(forward || backward);
+        expect(near(ay, 0.0f) && near(by, 0.0f));
+    };
+
+    "SVG polygon closes, polyline does not"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<polygon points=\"0,0 10,0 10,10\" fill=\"none\" stroke=\"red\"/>", prims);
+        expect(prims.size() == 3_u);
+        prims.clear();
+        ydraw::parseSvg("<polyline points=\"0,0 10,0 10,10\" fill=\"red\"/>", prims);
+        expect(prims.size() == 2_u) << "Open outlines are not filled";
+        for (const auto& p : prims) expect(typeOf(p) == YDrawPrimitiveType::Segment2D);
+    };
+
+    "SVG closed paths and polygons are filled below their outline"_test = [] {
+        // Concave L shape, area 400
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<path d=\"M0 0H20V10H10V30H0Z\" fill=\"#00f\" stroke=\"black\"/>", prims);
+
+        size_t triangles = 0;
+        float area = 0.0f;
+        bool fillsFirst = true;
+        for (size_t i = 0; i < prims.size(); ++i) {
+            const auto& p = prims[i];
+            if (typeOf(p) != YDrawPrimitiveType::Triangle2D) continue;
+            fillsFirst = fillsFirst && i == triangles;
+            triangles++;
+            expect(p.style.fill[2] == 1.0f && p.style.fill[3] == 1.0f);
+            expect(p.style.stroke[3] == 0.0f) << "The outline carries the stroke";
+            expect(p.style.round > 0.0f) << "Triangles overlap across shared edges";
+            area += std::abs((p.params[4] - p.params[2]) * (p.params[7] - p.params[3]) -
+                             (p.params[5] - p.params[3]) * (p.params[6] - p.params[2])) / 2;
+        }
+        expect(triangles == 4_u) << "n - 2 ear triangles";
+        expect(near(area, 400.0f)) << "The ears tile the concave shape exactly";
+        expect(fillsFirst);
+        expect(prims.size() == 10_u) << "4 triangles + 6 outline segments";
+
+        // Curved and polygon outlines fill too, open subpaths do not
+        prims.clear();
+        ydraw::parseSvg("<path d=\"M0 0A10 10 0 0 1 20 0Z M0 50 L10 60 L20 50\" fill=\"red\"/>"
+                        "<polygon points=\"0,0 10,0 10,10\" fill=\"red\"/>", prims);
+        area = 0.0f;
+        for (const auto& p : prims) {
+            if (typeOf(p) != YDrawPrimitiveType::Triangle2D) continue;
+            area += std::abs((p.params[4] - p.params[2]) * (p.params[7] - p.params[3]) -
+                             (p.params[5] - p.params[3]) * (p.params[6] - p.params[2])) / 2;
+        }
+        // Chords stay within 0.25 of the arc, which is 10 pi long
+        float halfDisc = 3.14159265f * 100.0f / 2;
+        expect(area > halfDisc - 0.25f * 3.14159265f * 10.0f + 50.0f && area < halfDisc + 50.0f)
+            << "half disc + triangle, area" << area;
+        expect(typeOf(prims.back()) == YDrawPrimitiveType::Segment2D);
+    };
+
+    "SVG malformed input stops cleanly"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        ydraw::parseSvg("<path d=\"M0 0 L10\"/><circle r=\"1\"", prims);
+        ydraw::parseSvg("<path d=\"12 13 L1 1\"/><!-- <circle/>", prims);
+        ydraw::parseSvg("<", prims);
+        expect(prims.size() == 1_u) << "Only the unterminated circle is complete enough";
+    };
+
+    "YDrawSceneCache returns inserted scenes"_test = [] {
+        YDrawSceneCache cache(1024 * 1024);
+        expect(cache.find("a") == nullptr);
+
+        auto scene = std::make_shared<YDrawCompiledScene>();
+        scene->primitives.resize(3);
+        cache.insert("a", scene);
+
+        auto hit = cache.find("a");
+        expect(hit != nullptr && hit->primitives.size() == 3_u);
+        expect(cache.find("b") == nullptr);
+        expect(cache.hits() == 1_u);
+        expect(cache.misses() == 2_u);
+    };
+
+    "YDrawSceneCache evicts over budget"_test = [] {
+        YDrawSceneCache cache(3 * sizeof(YDrawPrimitiveGPU));
+        for (const char* key : {"a", "b", "c"}) {
+            auto scene = std::make_shared<YDrawCompiledScene>();
+            scene->primitives.resize(1);
+            cache.insert(key, scene);
+        }
+        expect(cache.find("a") == nullptr) << "Oldest scene should be evicted";
+        expect(cache.find("c") != nullptr);
+    };
+
+    "SVG large document parses and round-trips through the cache"_test = [] {
+        constexpr int ELEMENTS = 20000;
+        std::string svg = generateSvg(ELEMENTS);
+
+        std::vector<YDrawPrimitiveGPU> prims;
+        prims.reserve(ELEMENTS * 2);
+        ydraw::parseSvg(svg, prims);
+
+        // rect, cubic + line + close, circle, line
+        expect(prims.size() == static_cast<size_t>(ELEMENTS / 4 * 6));
+
+        YDrawSceneCache cache;
+        auto scene = std::make_shared<YDrawCompiledScene>();
+        scene->primitives = prims;
+        cache.insert(svg, scene);
+        auto hit = cache.find(svg);
+        expect(hit != nullptr && hit->primitives.size() == prims.size());
+    };
+};
@@ -0,0 +1,398 @@
+//=============================================================================
+// YDrawTileBins Unit Tests
+//
+// Tests for the per-tile primitive binning of the YDraw 2D fragment pass
+// Covers: list layout, draw order, culling, 3D detection, and binned vs
+// unbinned shading using a CPU port of the fragment shader's 2D loop
+//=============================================================================
+
+#include <boost/ut.hpp>
+#include "yetty/ydraw-tiles.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+using namespace yetty;
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// CPU port of the 2D part of YDRAW_SHADER
+//-----------------------------------------------------------------------------
+
+struct V2 { float x, y; };
+V2 operator+(V2 a, V2 b) { return {a.x + b.x, a.y + b.y}; }
+V2 operator-(V2 a, V2 b) { return {a.x - b.x, a.y - b.y}; }
+V2 operator*(V2 a, float s) { return {a.x * s, a.y * s}; }
+float dot(V2 a, V2 b) { return a.x * b.x + a.y * b.y; }
+float length(V2 a) { return std::sqrt(dot(a, a)); }
+float sgn(float v) { return v > 0.0f ? 1.0f : (v < 0.0f ? -1.0f : 0.0f); }
+
+V2 rotate2d(V2 p, float angle) {
+    float c = std::cos(angle), s = std::sin(angle);
+    return {c * p.x - s * p.y, s * p.x + c * p.y};
+}
+
+float sdBox(V2 p, V2 b, float r) {
+    V2 d = V2{std::abs(p.x), std::abs(p.y)} - b + V2{r, r};
+    V2 m{std::max(d.x, 0.0f), std::max(d.y, 0.0f)};
+    return length(m) + std::min(std::max(d.x, d.y), 0.0f) - r;
+}
+
+float sdSegment(V2 p, V2 a, V2 b) {
+    V2 pa = p - a, ba = b - a;
+    float h = std::clamp(dot(pa, ba) / dot(ba, ba), 0.0f, 1.0f);
+    return length(pa - ba * h);
+}
+
+float sdTriangle(V2 p, V2 p0, V2 p1, V2 p2) {
+    V2 e0 = p1 - p0, e1 = p2 - p1, e2 = p0 - p2;
+    V2 v0 = p - p0, v1 = p - p1, v2 = p - p2;
+    V2 pq0 = v0 - e0 * std::clamp(dot(v0, e0) / dot(e0, e0), 0.0f, 1.0f);
+    V2 pq1 = v1 - e1 * std::clamp(dot(v1, e1) / dot(e1, e1), 0.0f, 1.0f);
+    V2 pq2 = v2 - e2 * std::clamp(dot(v2, e2) / dot(e2, e2), 0.0f, 1.0f);
+    float s = sgn(e0.x * e2.y - e0.y * e2.x);
+    float dx = std::min({dot(pq0, pq0), dot(pq1, pq1), dot(pq2, pq2)});
+    float dy = std::min({s * (v0.x * e0.y - v0.y * e0.x),
+                         s * (v1.x * e1.y - v1.y * e1.x),
+                         s * (v2.x * e2.y - v2.y * e2.x)});
+    return -std::sqrt(dx) * sgn(dy);
+}
+
+// Curves are evaluated by dense sampling, close enough to the shader's
+// distance to catch a bound that is too tight
+template <typename F>
+float sdCurve(V2 p, F&& at) {
+    float best = 1e10f;
+    for (int i = 0; i <= 256; ++i) {
+        best = std::min(best, length(p - at(i / 256.0f)));
+    }
+    return best;
+}
+
+float sdEllipse(V2 p, V2 ab) {
+    // Signed, via the normalized radius - close to the exact distance
+    // for the mild eccentricities generated below
+    float k = length(V2{p.x / ab.x, p.y / ab.y});
+    float onEdge = sdCurve(p, [&](float t) {
+        float a = t * 6.28318530718f;
+        return V2{ab.x * std::cos(a), ab.y * std::sin(a)};
+    });
+    return k < 1.0f ? -onEdge : onEdge;
+}
+
+float evalPrimitive2D(V2 p, const YDrawPrimitiveGPU& prim) {
+    const float* pr = prim.params;
+    V2 c{pr[0], pr[1]};
+    V2 q = p - c;
+    if (prim.style.rotate != 0.0f) {
+        q = rotate2d(q, prim.style.rotate * 3.14159265f / 180.0f);
+    }
+    switch (static_cast<YDrawPrimitiveType>(prim.type)) {
+        case YDrawPrimitiveType::Circle2D:
+            return length(q) - pr[2];
+        case YDrawPrimitiveType::Box2D:
+            return sdBox(q, {pr[2], pr[3]}, prim.style.round);
+        case YDrawPrimitiveType::Segment2D:
+            return sdSegment(q, V2{pr[2], pr[3]} - c, V2{pr[4], pr[5]} - c);
+        case YDrawPrimitiveType::Triangle2D:
+            return sdTriangle(q, V2{pr[2], pr[3]} - c, V2{pr[4], pr[5]} - c, V2{pr[6], pr[7]} - c) -
+                   prim.style.round;
+        case YDrawPrimitiveType::Bezier2D: {
+            V2 A = V2{pr[2], pr[3]} - c, B = V2{pr[4], pr[5]} - c, C = V2{pr[6], pr[7]} - c;
+            return sdCurve(q, [&](float t) {
+                return A * ((1 - t) * (1 - t)) + B * (2 * t * (1 - t)) + C * (t * t);
+            });
+        }
+        case YDrawPrimitiveType::Arc2D: {
+            V2 sc{pr[2], pr[3]};
+            V2 a{std::abs(q.x), q.y};
+            if (sc.y * a.x > sc.x * a.y) return length(a - sc * pr[4]) - pr[5];
+            return std::abs(length(a) - pr[4]) - pr[5];
+        }
+        case YDrawPrimitiveType::Ellipse2D:
+            return sdEllipse(q, {pr[2], pr[3]});
+        case YDrawPrimitiveType::CubicBezier2D: {
+            V2 P0 = V2{pr[2], pr[3]} - c, P1 = V2{pr[4], pr[5]} - c;
+            V2 P2 = V2{pr[6], pr[7]} - c, P3 = V2{pr[8], pr[9]} - c;
+            return sdCurve(q, [&](float t) {
+                float u = 1 - t;
+                return P0 * (u * u * u) + P1 * (3 * u * u * t) + P2 * (3 * u * t * t) + P3 * (t * t * t);
+            });
+        }
+        case YDrawPrimitiveType::EllipseArc2D: {
+            float rx = pr[2], ry = pr[3], rot = pr[4], t1 = pr[5], t2 = pr[6];
+            if (t2 < t1) t2 += 6.28318530718f;
+            return sdCurve(q, [&](float t) {
+                float th = t1 + t * (t2 - t1);
+                return rotate2d({rx * std::cos(th), ry * std::sin(th)}, rot);
+            });
+        }
+        default:
+            return 1e10f;
+    }
+}
+
+float smoothstep(float e0, float e1, float x) {
+    float t = std::clamp((x - e0) / (e1 - e0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+struct Color { float r, g, b, a; };
+
+void mixInto(Color& c, const float to[4], float t) {
+    c.r = c.r + (to[0] - c.r) * t;
+    c.g = c.g + (to[1] - c.g) * t;
+    c.b = c.b + (to[2] - c.b) * t;
+    c.a = c.a + (to[3] - c.a) * t;
+}
+
+void shade(Color& color, V2 frag, const YDrawPrimitiveGPU& prim) {
+    float d = evalPrimitive2D(frag, prim);
+    if (prim.style.fill[3] > 0.0f) {
+        mixInto(color, prim.style.fill, (1.0f - smoothstep(-1.0f, 1.0f, d)) * prim.style.fill[3]);
+    }
+    if (prim.style.stroke[3] > 0.0f && prim.style.stroke_width > 0.0f) {
+        float sd = std::abs(d) - prim.style.stroke_width * 0.5f;
+        mixInto(color, prim.style.stroke, (1.0f - smoothstep(-1.0f, 1.0f, sd)) * prim.style.stroke[3]);
+    }
+}
+
+// Same as fs_main: every 2D primitive, in order
+Color shadeUnbinned(const std::vector<YDrawPrimitiveGPU>& prims, V2 frag) {
+    Color color{0.95f, 0.95f, 0.95f, 1.0f};
+    for (const auto& prim : prims) {
+        if (prim.type < 100) shade(color, frag, prim);
+    }
+    return color;
+}
+
+// Same as fs_main with tile lists
+Color shadeBinned(const std::vector<YDrawPrimitiveGPU>& prims,
+                  const YDrawTileBins& bins, V2 frag) {
+    float ts = static_cast<float>(YDrawTileBins::TILE_SIZE);
+    auto tx = static_cast<uint32_t>(std::clamp(std::floor(frag.x / ts), 0.0f, bins.tilesX() - 1.0f));
+    auto ty = static_cast<uint32_t>(std::clamp(std::floor(frag.y / ts), 0.0f, bins.tilesY() - 1.0f));
+    Color color{0.95f, 0.95f, 0.95f, 1.0f};
+    for (const uint32_t* it = bins.tileBegin(tx, ty); it != bins.tileEnd(tx, ty); ++it) {
+        shade(color, frag, prims[*it]);
+    }
+    return color;
+}
+
+//-----------------------------------------------------------------------------
+// Scene generation
+//-----------------------------------------------------------------------------
+
+// Local builders, the ydraw:: ones live in the GPU renderer translation unit
+YDrawPrimitiveGPU circle(float x, float y, float r, const YDrawStyle& style = {}) {
+    YDrawPrimitiveGPU p = {};
+    p.type = static_cast<uint32_t>(YDrawPrimitiveType::Circle2D);
+    p.params[0] = x; p.params[1] = y; p.params[2] = r;
+    p.style = style;
+    return p;
+}
+
+YDrawPrimitiveGPU box(float x, float y, float hw, float hh) {
+    YDrawPrimitiveGPU p = {};
+    p.type = static_cast<uint32_t>(YDrawPrimitiveType::Box2D);
+    p.params[0] = x; p.params[1] = y; p.params[2] = hw; p.params[3] = hh;
+    return p;
+}
+
+YDrawPrimitiveGPU sphere(float r) {
+    YDrawPrimitiveGPU p = {};
+    p.type = static_cast<uint32_t>(YDrawPrimitiveType::Sphere3D);
+    p.params[3] = r;
+    return p;
+}
+
+YDrawPrimitiveGPU randomPrimitive(std::mt19937& rng, float w, float h) {
+    std::uniform_real_distribution<float> x(-20.0f, w + 20.0f);
+    std::uniform_real_distribution<float> y(-20.0f, h + 20.0f);
+    std::uniform_real_distribution<float> size(2.0f, 30.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    YDrawPrimitiveGPU p = {};
+    p.type = std::uniform_int_distribution<uint32_t>(0, 8)(rng);
+    p.params[0] = x(rng);
+    p.params[1] = y(rng);
+    for (int i = 2; i < 10; i += 2) {
+        // Control points near the origin keep the shapes tile sized
+        p.params[i] = p.params[0] + size(rng) * (unit(rng) - 0.5f) * 2.0f;
+        p.params[i + 1] = p.params[1] + size(rng) * (unit(rng) - 0.5f) * 2.0f;
+    }
+
+    switch (static_cast<YDrawPrimitiveType>(p.type)) {
+        case YDrawPrimitiveType::Circle2D:
+            p.params[2] = size(rng);
+            break;
+        case YDrawPrimitiveType::Box2D:
+        case YDrawPrimitiveType::Ellipse2D:
+            p.params[2] = size(rng);
+            p.params[3] = p.params[2] * (0.6f + 0.8f * unit(rng));
+            break;
+        case YDrawPrimitiveType::Arc2D: {
+            float a = unit(rng) * 3.0f;
+            p.params[2] = std::sin(a);
+            p.params[3] = std::cos(a);
+            p.params[4] = size(rng);
+            p.params[5] = 1.0f + unit(rng) * 4.0f;
+            break;
+        }
+        case YDrawPrimitiveType::EllipseArc2D:
+            p.params[2] = size(rng);
+            p.params[3] = size(rng);
+            p.params[4] = unit(rng) * 6.28f;
+            p.params[5] = unit(rng) * 6.28f;
+            p.params[6] = unit(rng) * 6.28f;
+            break;
+        default:
+            break;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        p.style.fill[i] = unit(rng);
+        p.style.stroke[i] = unit(rng);
+    }
+    if (unit(rng) < 0.3f) p.style.fill[3] = 0.0f;
+    if (unit(rng) < 0.5f) p.style.stroke_width = 1.0f + unit(rng) * 6.0f;
+    if (unit(rng) < 0.3f) p.style.round = unit(rng) * 4.0f;
+    if (unit(rng) < 0.4f) p.style.rotate = unit(rng) * 360.0f;
+    return p;
+}
+
+} // namespace
+
+suite ydraw_tiles_tests = [] {
+    "YDrawTileBins covers the widget with tiles"_test = [] {
+        YDrawTileBins bins;
+        bins.build({}, 100.0f, 33.0f);
+        expect(bins.tilesX() == 7_u);
+        expect(bins.tilesY() == 3_u);
+        expect(bins.data().size() == 22_u) << "Offsets only, no indices";
+        expect(!bins.has3D());
+
+        bins.build({}, 0.0f, 0.0f);
+        expect(bins.tilesX() == 1_u && bins.tilesY() == 1_u);
+    };
+
+    "YDrawTileBins lists a primitive only in the tiles it touches"_test = [] {
+        YDrawStyle style;
+        std::vector<YDrawPrimitiveGPU> prims = {
+            circle(8.0f, 8.0f, 4.0f, style),   // Tile (0, 0) only
+            circle(40.0f, 8.0f, 4.0f, style),  // Tile (2, 0) only
+        };
+        YDrawTileBins bins;
+        bins.build(prims, 64.0f, 64.0f);
+
+        expect(bins.tileEnd(0, 0) - bins.tileBegin(0, 0) == 1);
+        expect(*bins.tileBegin(0, 0) == 0_u);
+        expect(bins.tileEnd(1, 0) - bins.tileBegin(1, 0) == 0);
+        expect(*bins.tileBegin(2, 0) == 1_u);
+        expect(bins.tileEnd(0, 1) - bins.tileBegin(0, 1) == 0);
+    };
+
+    "YDrawTileBins keeps draw order within a tile"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims;
+        for (int i = 0; i < 10; ++i) {
+            prims.push_back(box(32.0f, 32.0f, 30.0f - i, 30.0f - i));
+        }
+        YDrawTileBins bins;
+        bins.build(prims, 64.0f, 64.0f);
+
+        std::vector<uint32_t> list(bins.tileBegin(1, 1), bins.tileEnd(1, 1));
+        expect(list.size() == 10_u);
+        expect(std::is_sorted(list.begin(), list.end()));
+    };
+
+    "YDrawTileBins culls off-widget and invisible primitives"_test = [] {
+        YDrawStyle hidden;
+        hidden.fill[3] = 0.0f;
+        std::vector<YDrawPrimitiveGPU> prims = {
+            circle(-100.0f, -100.0f, 10.0f),
+            circle(500.0f, 20.0f, 10.0f),
+            circle(20.0f, 20.0f, 10.0f, hidden),
+        };
+        YDrawTileBins bins;
+        bins.build(prims, 64.0f, 64.0f);
+        expect(bins.data().size() == 17_u) << "No primitive should be binned";
+    };
+
+    "YDrawTileBins bounds grow with stroke width and rotation"_test = [] {
+        auto b = box(50.0f, 50.0f, 20.0f, 5.0f);
+        float plain[4];
+        expect(YDrawTileBins::bounds(b, plain));
+
+        b.style.stroke[3] = 1.0f;
+        b.style.stroke_width = 10.0f;
+        float stroked[4];
+        expect(YDrawTileBins::bounds(b, stroked));
+        expect(stroked[0] == plain[0] - 5.0f);
+        expect(stroked[3] == plain[3] + 5.0f);
+
+        b.style.stroke_width = 0.0f;
+        b.style.rotate = 90.0f;
+        float rotated[4];
+        expect(YDrawTileBins::bounds(b, rotated));
+        expect(std::abs((rotated[3] - rotated[1]) - (plain[2] - plain[0])) < 1e-3f)
+            << "A quarter turn swaps the extents";
+
+        YDrawPrimitiveGPU tri = {};
+        tri.type = static_cast<uint32_t>(YDrawPrimitiveType::Triangle2D);
+        tri.params[4] = 10.0f;
+        tri.params[7] = 10.0f;
+        tri.style.fill[3] = 1.0f;
+        float sharp[4];
+        expect(YDrawTileBins::bounds(tri, sharp));
+        tri.style.round = 2.0f;
+        float rounded[4];
+        expect(YDrawTileBins::bounds(tri, rounded));
+        expect(rounded[0] == sharp[0] - 2.0f && rounded[2] == sharp[2] + 2.0f)
+            << "Rounded triangles grow outwards";
+    };
+
+    "YDrawTileBins leaves 3D primitives to the raymarcher"_test = [] {
+        std::vector<YDrawPrimitiveGPU> prims = {
+            circle(8.0f, 8.0f, 4.0f),
+            sphere(1.0f),
+        };
+        float b[4];
+        expect(!YDrawTileBins::bounds(prims[1], b));
+
+        YDrawTileBins bins;
+        bins.build(prims, 32.0f, 32.0f);
+        expect(bins.has3D());
+        expect(bins.tileEnd(0, 0) - bins.tileBegin(0, 0) == 1);
+    };
+
+    "YDrawTileBins binned shading matches unbinned shading"_test = [] {
+        std::mt19937 rng(1234);
+        const float w = 203.0f;
+        const float h = 141.0f;
+
+        for (int scene = 0; scene < 6; ++scene) {
+            std::vector<YDrawPrimitiveGPU> prims;
+            for (int i = 0; i < 40; ++i) {
+                prims.push_back(randomPrimitive(rng, w, h));
+            }
+            YDrawTileBins bins;
+            bins.build(prims, w, h);
+
+            size_t mismatches = 0;
+            for (int y = 0; y < static_cast<int>(h); ++y) {
+                for (int x = 0; x < static_cast<int>(w); ++x) {
+                    V2 frag{x + 0.5f, y + 0.5f};
+                    Color a = shadeUnbinned(prims, frag);
+                    Color b = shadeBinned(prims, bins, frag);
+                    if (a.r != b.r || a.g != b.g || a.b != b.b || a.a != b.a) {
+                        ++mismatches;
+                    }
+                }
+            }
+            expect(mismatches == 0_u) << "scene" << scene;
+        }
+    };
+};
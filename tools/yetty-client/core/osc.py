@@ -11,6 +11,10 @@ Generic args (Unix-like command line):
   - stop --id ID | --plugin NAME
   - start --id ID | --plugin NAME
   - update --id ID
+  - append --id ID           (incremental data, e.g. streaming plot samples)
+
+Large payloads can bypass base94 via shared memory (see shm.py):
+  - create ... --shm TOKEN --shm-size N --shm-crc HEX
 
 When running inside tmux, sequences are wrapped in DCS passthrough:
   ESC P tmux; <escaped_content> ESC \\
@@ -18,7 +22,7 @@ Where ESC characters in content are doubled (ESC -> ESC ESC).
 """
 
 import os
-from . import base94
+from . import base94, shm
 
 VENDOR_ID = 999999
 
@@ -91,6 +95,24 @@ def create_sequence_bytes(
     return f"\033]{VENDOR_ID};{args};{plugin_args};{encoded_payload}\033\\"
 
 
+def create_sequence_shm(
+    plugin: str,
+    x: int = 0,
+    y: int = 0,
+    w: int = 0,
+    h: int = 0,
+    relative: bool = True,
+    payload_bytes: bytes = b"",
+    plugin_args: str = ""
+) -> str:
+    """Create an OSC sequence whose payload is passed via shared memory."""
+    args = f"create -p {plugin} -x {x} -y {y} -w {w} -h {h}"
+    if relative:
+        args += " -r"
+    args += " " + shm.write(payload_bytes)
+    return f"\033]{VENDOR_ID};{args};{plugin_args};\033\\"
+
+
 def list_sequence(all: bool = False) -> str:
     """Create an OSC sequence to list active layers."""
     args = "ls --all" if all else "ls"
@@ -140,3 +162,10 @@ def update_sequence(id: str, payload: str = "", plugin_args: str = "") -> str:
     args = f"update --id {id}"
     encoded_payload = base94.encode_string(payload) if payload else ""
     return f"\033]{VENDOR_ID};{args};{plugin_args};{encoded_payload}\033\\"
+
+
+def append_sequence(id: str, payload_bytes: bytes = b"") -> str:
+    """Create an OSC sequence appending binary data to a layer."""
+    args = f"append --id {id}"
+    encoded_payload = base94.encode(payload_bytes) if payload_bytes else ""
+    return f"\033]{VENDOR_ID};{args};;{encoded_payload}\033\\"
@@ -0,0 +1,56 @@
+"""Shared memory side channel for large yetty payloads.
+
+Instead of base94-encoding multi-megabyte payloads into the OSC sequence,
+the raw bytes are written to a POSIX shared memory object and the OSC only
+carries a reference:
+
+    --shm TOKEN --shm-size N --shm-crc HEX
+
+The terminal opens "/yetty-TOKEN", checks that it is owned by the same user,
+unlinks it (tokens are one-shot), verifies size and CRC-32 and hands
+the mapping to the widget without copying.
+
+Only available when the terminal runs on the same host (Linux /dev/shm).
+"""
+
+import os
+import secrets
+import zlib
+
+SHM_DIR = '/dev/shm'
+
+# Payloads at or above this size use shared memory when available
+DEFAULT_THRESHOLD = 1024 * 1024
+
+
+def is_available() -> bool:
+    """Shared memory needs a local terminal (not over ssh) and /dev/shm."""
+    if 'SSH_CONNECTION' in os.environ:
+        return False
+    return os.path.isdir(SHM_DIR) and os.access(SHM_DIR, os.W_OK)
+
+
+def threshold() -> int:
+    """Size threshold, overridable via YETTY_SHM_THRESHOLD."""
+    try:
+        return int(os.environ.get('YETTY_SHM_THRESHOLD', DEFAULT_THRESHOLD))
+    except ValueError:
+        return DEFAULT_THRESHOLD
+
+
+def write(payload: bytes) -> str:
+    """Write payload to a fresh shm object, return the generic-args fragment."""
+    token = secrets.token_hex(16)
+    path = os.path.join(SHM_DIR, f"yetty-{token}")
+    fd = os.open(path, os.O_CREAT | os.O_EXCL | os.O_WRONLY, 0o600)
+    try:
+        view = memoryview(payload)
+        while view:
+            written = os.write(fd, view)
+            view = view[written:]
+    except BaseException:
+        os.close(fd)
+        os.unlink(path)
+        raise
+    os.close(fd)
+    return f"--shm {token} --shm-size {len(payload)} --shm-crc {zlib.crc32(payload):x}"
@@ -8,6 +8,7 @@ Usage:
     yetty-client kill --id ID | --plugin NAME  # Kill layer(s)
     yetty-client stop --id ID | --plugin NAME  # Stop layer(s)
     yetty-client start --id ID | --plugin NAME # Start layer(s)
+    yetty-client append --id ID [-i FILE]      # Stream data into a layer
 
 Examples:
     yetty-client create image -f logo.png -w 40 -h 20
@@ -21,7 +22,7 @@ from pathlib import Path
 sys.path.insert(0, str(Path(__file__).parent))
 
 import click
-from core import osc, base94
+from core import osc, base94, shm
 from plugins import discover_plugins, get_plugin
 
 
@@ -47,8 +48,10 @@ def cli(ctx, verbose, dry_run):
 @click.option('--height', '-H', 'height', default=0, type=int, help='Height in cells (0=stretch)')
 @click.option('--absolute', '-a', is_flag=True, help='Use absolute positioning')
 @click.option('--output', '-o', type=click.Path(), help='Save to file instead of stdout')
+@click.option('--shm/--no-shm', 'use_shm', default=None,
+              help='Pass payload via shared memory (default: auto for large payloads)')
 @click.pass_context
-def cmd_create(ctx, plugin_name, pos_x, pos_y, width, height, absolute, output):
+def cmd_create(ctx, plugin_name, pos_x, pos_y, width, height, absolute, output, use_shm):
     """Create a plugin layer.
 
     Example:
@@ -69,6 +72,7 @@ def cmd_create(ctx, plugin_name, pos_x, pos_y, width, height, absolute, output):
         click.echo("  -H INTEGER       Height in cells (default: 0, stretch)")
         click.echo("  -a, --absolute   Use absolute positioning")
         click.echo("  -o, --output     Save to file instead of stdout")
+        click.echo("  --shm/--no-shm   Pass payload via shared memory (default: auto)")
         click.echo("")
         with click.Context(plugin_cmd, info_name=plugin_name) as plugin_ctx:
             click.echo(plugin_cmd.get_help(plugin_ctx))
@@ -86,7 +90,22 @@ def cmd_create(ctx, plugin_name, pos_x, pos_y, width, height, absolute, output):
     if payload is None and payload_bytes is None:
         raise click.ClickException(f"Plugin '{plugin_name}' did not set a payload")
 
-    if payload_bytes is not None:
+    if use_shm is None:
+        # Auto: large payloads on a local terminal skip base94 entirely.
+        # A sequence saved to a file must be self-contained.
+        size = len(payload_bytes) if payload_bytes is not None else len(payload.encode('utf-8'))
+        use_shm = (not output and not ctx.obj['dry_run'] and
+                   size >= shm.threshold() and shm.is_available())
+
+    if use_shm:
+        if payload_bytes is None:
+            payload_bytes = payload.encode('utf-8')
+        sequence = osc.create_sequence_shm(
+            plugin=actual_plugin, x=pos_x, y=pos_y, w=width, h=height,
+            relative=not absolute, payload_bytes=payload_bytes,
+            plugin_args=plugin_args
+        )
+    elif payload_bytes is not None:
         sequence = osc.create_sequence_bytes(
             plugin=actual_plugin, x=pos_x, y=pos_y, w=width, h=height,
             relative=not absolute, payload_bytes=payload_bytes,
@@ -187,6 +206,68 @@ def cmd_start(ctx, layer_id, plugin_name):
     sys.stdout.flush()
 
 
+@cli.command('append')
+@click.option('--id', 'layer_id', required=True, help='Layer ID to append to')
+@click.option('--input', '-i', 'input_', default='-',
+              help='Samples, one CSV/whitespace line per time step (default: stdin)')
+@click.option('--binary', '-b', is_flag=True,
+              help='Input is one ready-made binary append payload')
+@click.option('--interval', default=1.0 / 60, type=float,
+              help='Max seconds to batch lines before sending (default: 1/60)')
+@click.pass_context
+def cmd_append(ctx, layer_id, input_, binary, interval):
+    """Append streaming data to a layer (e.g. a plot created with --stream).
+
+    Each text line holds one value per series. Lines are batched and sent
+    as [uint32 N][uint32 K][N*K floats], at most one sequence per interval.
+
+    Example:
+        sensor-reader | yetty-client append --id ab12cd34
+    """
+    import struct
+    import time
+
+    def emit(payload_bytes):
+        sequence = osc.append_sequence(layer_id, payload_bytes)
+        if ctx.obj['dry_run']:
+            click.echo(f"Would send append ({len(payload_bytes)} bytes)")
+            return
+        sys.stdout.write(osc.maybe_wrap_for_tmux(sequence))
+        sys.stdout.flush()
+
+    stream = sys.stdin if input_ == '-' else open(input_, 'r')
+
+    if binary:
+        emit(stream.buffer.read() if stream is sys.stdin else Path(input_).read_bytes())
+        return
+
+    rows = []
+    deadline = time.monotonic() + interval
+
+    def flush():
+        if not rows:
+            return
+        n = len(rows[0])
+        # Plot-major: all samples of series 0, then series 1, ...
+        values = [row[i] for i in range(n) for row in rows]
+        emit(struct.pack(f'<II{len(values)}f', n, len(rows), *values))
+        rows.clear()
+
+    for line in stream:
+        line = line.strip()
+        if not line:
+            continue
+        sep = ',' if ',' in line else None
+        values = [float(v) for v in line.split(sep) if v.strip()]
+        if rows and len(values) != len(rows[0]):
+            flush()
+        rows.append(values)
+        if time.monotonic() >= deadline:
+            flush()
+            deadline = time.monotonic() + interval
+    flush()
+
+
 @cli.command('decode')
 @click.argument('input_file', type=click.Path(exists=True))
 @click.option('--output', '-o', type=click.Path(), help='Output file')
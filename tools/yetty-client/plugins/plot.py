@@ -120,8 +120,10 @@ def pack_binary(data: List[List[float]], num_plots: int, num_points: int,
               help='Generate test data instead of reading from file')
 @click.option('--plots', '-n', type=int, default=3, help='Number of plots for generated data')
 @click.option('--points', '-m', type=int, default=100, help='Number of points for generated data')
+@click.option('--stream', is_flag=True,
+              help='Create an empty ring of --points samples per plot, fed by "append"')
 @click.pass_context
-def plot(ctx, input_, fmt, xmin, xmax, ymin, ymax, generate, plots, points):
+def plot(ctx, input_, fmt, xmin, xmax, ymin, ymax, generate, plots, points, stream):
     """Plot data visualization plugin.
 
     Displays line plots in the terminal using GPU rendering.
@@ -137,9 +139,19 @@ def plot(ctx, input_, fmt, xmin, xmax, ymin, ymax, generate, plots, points):
         yetty-client run plot -i data.json --ymin=-1 --ymax=1
         yetty-client run plot -g sine -n 3 -m 200
         cat data.csv | yetty-client run plot -i -
+        yetty-client run plot --stream -n 2 -m 100000 --ymin=-1 --ymax=1
     """
     ctx.ensure_object(dict)
 
+    if stream:
+        # Text header only: N,M,xmin,xmax,ymin,ymax - samples arrive via append
+        header = f"{plots},{points},0,{max(points - 1, 1)},"
+        header += f"{ymin if ymin is not None else -1.0},{ymax if ymax is not None else 1.0}"
+        ctx.obj['payload'] = header
+        ctx.obj['plugin_name'] = 'plot'
+        ctx.obj['plugin_args'] = '--stream'
+        return
+
     import math
     import random
 